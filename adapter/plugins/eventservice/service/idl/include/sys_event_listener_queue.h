@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_HIVIEWDFX_SYS_EVENT_LISTENER_QUEUE_H
+#define OHOS_HIVIEWDFX_SYS_EVENT_LISTENER_QUEUE_H
+
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "ffrt.h"
+#include "isys_event_callback.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+struct SysEventListenerItem {
+    std::string domain;
+    std::string eventName;
+    uint32_t eventType = 0;
+    std::shared_ptr<const std::string> eventDetail; // shared by all listeners of the same event
+};
+
+struct SysEventListenerStat {
+    uint64_t deliveredCnt = 0;
+    uint64_t droppedCnt = 0;
+    size_t pendingCnt = 0;
+};
+
+class SysEventListenerQueue : public std::enable_shared_from_this<SysEventListenerQueue> {
+public:
+    SysEventListenerQueue(const sptr<ISysEventCallback>& callback, int32_t pid);
+    ~SysEventListenerQueue() = default;
+
+public:
+    bool Enqueue(SysEventListenerItem item);
+    void Stop();
+    SysEventListenerStat GetStat() const;
+
+private:
+    void SubmitDrainTask();
+    void Drain();
+
+private:
+    sptr<ISysEventCallback> callback_;
+    int32_t pid_ = 0;
+    mutable ffrt::mutex mutex_;
+    std::deque<SysEventListenerItem> items_;
+    bool isDraining_ = false;
+    bool isStopped_ = false;
+    SysEventListenerStat stat_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // OHOS_HIVIEWDFX_SYS_EVENT_LISTENER_QUEUE_H
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_HIVIEWDFX_SYS_EVENT_RULE_MATCHER_H
+#define OHOS_HIVIEWDFX_SYS_EVENT_RULE_MATCHER_H
+
+#include <map>
+#include <memory>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "iremote_object.h"
+#include "sys_event_rule.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+using MatchedListeners = std::vector<sptr<IRemoteObject>>;
+
+class SysEventRuleMatcher {
+public:
+    SysEventRuleMatcher() = default;
+    ~SysEventRuleMatcher() = default;
+
+public:
+    void AddListener(const sptr<IRemoteObject>& listener, const std::vector<SysEventRule>& rules);
+    void RemoveListener(const sptr<IRemoteObject>& listener);
+    std::shared_ptr<const MatchedListeners> GetMatchedListeners(const std::string& domain,
+        const std::string& eventName, const std::string& tag, uint32_t eventType);
+
+private:
+    struct CompiledRule {
+        sptr<IRemoteObject> listener;
+        uint32_t ruleType = RuleType::WHOLE_WORD;
+        uint32_t eventType = 0;
+        std::string domain;
+        std::string eventName;
+        std::string tag;
+        std::shared_ptr<std::regex> domainRegex;
+        std::shared_ptr<std::regex> eventNameRegex;
+        std::shared_ptr<std::regex> tagRegex;
+        bool isValid = true;
+    };
+    using RuleIndex = std::unordered_map<std::string, std::vector<size_t>>;
+
+private:
+    void Rebuild();
+    CompiledRule CompileRule(const sptr<IRemoteObject>& listener, const SysEventRule& rule);
+    bool MatchCompiledRule(const CompiledRule& rule, const std::string& domain, const std::string& eventName,
+        const std::string& tag, uint32_t eventType) const;
+    void CollectExactCandidates(const RuleIndex& index, const std::string& key,
+        std::vector<size_t>& candidates) const;
+    void CollectPrefixCandidates(const RuleIndex& index, const std::string& key,
+        std::vector<size_t>& candidates) const;
+    std::shared_ptr<const MatchedListeners> Match(const std::string& domain, const std::string& eventName,
+        const std::string& tag, uint32_t eventType) const;
+
+private:
+    std::map<sptr<IRemoteObject>, std::vector<SysEventRule>> listenerRules_;
+    std::vector<CompiledRule> compiledRules_;
+    RuleIndex exactRules_; // whole word rules indexed by domain
+    RuleIndex exactTagRules_; // whole word rules indexed by tag
+    RuleIndex prefixRules_; // prefix rules indexed by domain prefix
+    RuleIndex prefixTagRules_; // prefix rules indexed by tag prefix
+    std::vector<size_t> regexRules_;
+    std::unordered_map<std::string, std::shared_ptr<const MatchedListeners>> matchedCache_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // OHOS_HIVIEWDFX_SYS_EVENT_RULE_MATCHER_H
@@ -29,9 +29,11 @@
 #include "query_argument.h"
 #include "singleton.h"
 #include "sys_event_dao.h"
+#include "sys_event_listener_queue.h"
 #include "sys_event_query.h"
 #include "sys_event_query_rule.h"
 #include "sys_event_rule.h"
+#include "sys_event_rule_matcher.h"
 #include "sys_event_service_stub.h"
 #include "system_ability.h"
 #include "type/base_types.h"
@@ -91,6 +93,7 @@ private:
         int32_t pid = 0;
         int32_t uid = 0;
         std::vector<SysEventRule> rules;
+        std::shared_ptr<SysEventListenerQueue> queue;
     };
 
 private:
@@ -103,6 +106,7 @@ private:
     sptr<CallbackDeathRecipient> deathRecipient_;
     std::mutex listenersMutex_;
     std::map<OHOS::sptr<OHOS::IRemoteObject>, ListenerInfo> registeredListeners_;
+    SysEventRuleMatcher ruleMatcher_;
     std::mutex publisherMutex_;
     std::shared_ptr<DataPublisher> dataPublisher_;
     std::shared_ptr<ListenerStatusMonitor> statusMonitor_;
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sys_event_listener_queue.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <vector>
+
+#include "hiview_logger.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+DEFINE_LOG_TAG("HiView-SysEventListenerQueue");
+constexpr size_t QUEUE_CAPACITY = 1000; // max count of events waiting to be delivered to one listener
+constexpr size_t DRAIN_BATCH_SIZE = 32; // max count of events delivered in one task
+constexpr uint64_t DROP_LOG_INTERVAL = 100;
+}
+
+SysEventListenerQueue::SysEventListenerQueue(const sptr<ISysEventCallback>& callback, int32_t pid)
+    : callback_(callback), pid_(pid)
+{}
+
+bool SysEventListenerQueue::Enqueue(SysEventListenerItem item)
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    if (isStopped_) {
+        return false;
+    }
+    if (items_.size() >= QUEUE_CAPACITY) {
+        if ((stat_.droppedCnt++ % DROP_LOG_INTERVAL) == 0) {
+            HIVIEW_LOGW("queue of listener with pid %{public}d overflows, %{public}" PRIu64 " events dropped",
+                pid_, stat_.droppedCnt);
+        }
+        return false;
+    }
+    items_.emplace_back(std::move(item));
+    if (!isDraining_) {
+        isDraining_ = true;
+        SubmitDrainTask();
+    }
+    return true;
+}
+
+void SysEventListenerQueue::Stop()
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    isStopped_ = true;
+    items_.clear();
+}
+
+SysEventListenerStat SysEventListenerQueue::GetStat() const
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    SysEventListenerStat stat = stat_;
+    stat.pendingCnt = items_.size();
+    return stat;
+}
+
+void SysEventListenerQueue::SubmitDrainTask()
+{
+    ffrt::submit([queue = shared_from_this()] {
+        queue->Drain();
+    }, {}, {}, ffrt::task_attr().name("dft_sys_listener"));
+}
+
+void SysEventListenerQueue::Drain()
+{
+    std::vector<SysEventListenerItem> batch;
+    {
+        std::unique_lock<ffrt::mutex> lock(mutex_);
+        size_t batchSize = std::min(items_.size(), DRAIN_BATCH_SIZE);
+        batch.reserve(batchSize);
+        for (size_t i = 0; i < batchSize; ++i) {
+            batch.emplace_back(std::move(items_.front()));
+            items_.pop_front();
+        }
+    }
+    for (const auto& item : batch) {
+        callback_->Handle(item.domain, item.eventName, item.eventType, *(item.eventDetail));
+    }
+
+    // deliver the rest in another task so that one busy listener does not occupy the worker
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    stat_.deliveredCnt += batch.size();
+    if (isStopped_ || items_.empty()) {
+        isDraining_ = false;
+        return;
+    }
+    SubmitDrainTask();
+}
+} // namespace HiviewDFX
+} // namespace OHOS
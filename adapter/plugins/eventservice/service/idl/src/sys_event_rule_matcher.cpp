@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sys_event_rule_matcher.h"
+
+#include <set>
+
+#include "event_json_parser.h"
+#include "hiview_logger.h"
+#include "string_util.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+DEFINE_LOG_TAG("HiView-SysEventRuleMatcher");
+constexpr size_t REGEX_LEN_LIMIT = 32; // max(domainLen, nameLen, tagLen)
+constexpr size_t MATCHED_CACHE_CAPACITY = 1024;
+constexpr char CACHE_KEY_SEPARATOR = '\n';
+
+bool CompileRegex(const std::string& rule, std::shared_ptr<std::regex>& pattern)
+{
+    if (rule.empty()) {
+        return true;
+    }
+    if ((rule.length() > REGEX_LEN_LIMIT) || !StringUtil::IsValidRegex(rule)) {
+        return false;
+    }
+    pattern = std::make_shared<std::regex>(rule, std::regex::extended);
+    return true;
+}
+
+bool MatchContent(uint32_t type, const std::string& rule, const std::shared_ptr<std::regex>& pattern,
+    const std::string& match)
+{
+    if (match.empty()) {
+        return false;
+    }
+    switch (type) {
+        case RuleType::WHOLE_WORD:
+            return rule.empty() || match.compare(rule) == 0;
+        case RuleType::PREFIX:
+            return rule.empty() || match.compare(0, rule.length(), rule) == 0;
+        case RuleType::REGULAR:
+            return pattern == nullptr || std::regex_search(match, *pattern);
+        default:
+            return false;
+    }
+}
+
+bool MatchEventType(uint32_t rule, uint32_t match)
+{
+    return rule == DEFAULT_EVENT_TYPE || rule == match;
+}
+}
+
+void SysEventRuleMatcher::AddListener(const sptr<IRemoteObject>& listener, const std::vector<SysEventRule>& rules)
+{
+    listenerRules_[listener] = rules;
+    Rebuild();
+}
+
+void SysEventRuleMatcher::RemoveListener(const sptr<IRemoteObject>& listener)
+{
+    if (listenerRules_.erase(listener) == 0) {
+        return;
+    }
+    Rebuild();
+}
+
+std::shared_ptr<const MatchedListeners> SysEventRuleMatcher::GetMatchedListeners(const std::string& domain,
+    const std::string& eventName, const std::string& tag, uint32_t eventType)
+{
+    std::string cacheKey;
+    cacheKey.reserve(domain.size() + eventName.size() + tag.size() + 16); // 16: size of separators and type
+    cacheKey.append(domain).append(1, CACHE_KEY_SEPARATOR).append(eventName).append(1, CACHE_KEY_SEPARATOR)
+        .append(tag).append(1, CACHE_KEY_SEPARATOR).append(std::to_string(eventType));
+    if (auto iter = matchedCache_.find(cacheKey); iter != matchedCache_.end()) {
+        return iter->second;
+    }
+    auto matchedListeners = Match(domain, eventName, tag, eventType);
+    if (matchedCache_.size() >= MATCHED_CACHE_CAPACITY) {
+        HIVIEW_LOGD("matched cache is full, clear it");
+        matchedCache_.clear();
+    }
+    matchedCache_.emplace(std::move(cacheKey), matchedListeners);
+    return matchedListeners;
+}
+
+void SysEventRuleMatcher::Rebuild()
+{
+    compiledRules_.clear();
+    exactRules_.clear();
+    exactTagRules_.clear();
+    prefixRules_.clear();
+    prefixTagRules_.clear();
+    regexRules_.clear();
+    matchedCache_.clear();
+    for (const auto& [listener, rules] : listenerRules_) {
+        for (const auto& rule : rules) {
+            CompiledRule compiledRule = CompileRule(listener, rule);
+            if (!compiledRule.isValid) {
+                continue;
+            }
+            size_t index = compiledRules_.size();
+            bool isTagRule = !compiledRule.tag.empty();
+            switch (compiledRule.ruleType) {
+                case RuleType::WHOLE_WORD:
+                    (isTagRule ? exactTagRules_[compiledRule.tag] : exactRules_[compiledRule.domain])
+                        .emplace_back(index);
+                    break;
+                case RuleType::PREFIX:
+                    (isTagRule ? prefixTagRules_[compiledRule.tag] : prefixRules_[compiledRule.domain])
+                        .emplace_back(index);
+                    break;
+                default:
+                    regexRules_.emplace_back(index);
+                    break;
+            }
+            compiledRules_.emplace_back(std::move(compiledRule));
+        }
+    }
+    HIVIEW_LOGD("rules of %{public}zu listeners are compiled, valid rule count is %{public}zu",
+        listenerRules_.size(), compiledRules_.size());
+}
+
+SysEventRuleMatcher::CompiledRule SysEventRuleMatcher::CompileRule(const sptr<IRemoteObject>& listener,
+    const SysEventRule& rule)
+{
+    CompiledRule compiledRule;
+    compiledRule.listener = listener;
+    compiledRule.ruleType = rule.ruleType;
+    compiledRule.eventType = rule.eventType;
+    compiledRule.domain = rule.domain;
+    compiledRule.eventName = rule.eventName;
+    compiledRule.tag = rule.tag;
+    switch (rule.ruleType) {
+        case RuleType::WHOLE_WORD:
+        case RuleType::PREFIX:
+            break;
+        case RuleType::REGULAR:
+            if (rule.tag.empty()) {
+                compiledRule.isValid = CompileRegex(rule.domain, compiledRule.domainRegex) &&
+                    CompileRegex(rule.eventName, compiledRule.eventNameRegex);
+            } else {
+                compiledRule.isValid = CompileRegex(rule.tag, compiledRule.tagRegex);
+            }
+            break;
+        default:
+            HIVIEW_LOGE("invalid rule type %{public}u.", rule.ruleType);
+            compiledRule.isValid = false;
+            break;
+    }
+    return compiledRule;
+}
+
+bool SysEventRuleMatcher::MatchCompiledRule(const CompiledRule& rule, const std::string& domain,
+    const std::string& eventName, const std::string& tag, uint32_t eventType) const
+{
+    if (rule.tag.empty()) {
+        return MatchContent(rule.ruleType, rule.domain, rule.domainRegex, domain)
+            && MatchContent(rule.ruleType, rule.eventName, rule.eventNameRegex, eventName)
+            && MatchEventType(rule.eventType, eventType);
+    }
+    return MatchContent(rule.ruleType, rule.tag, rule.tagRegex, tag)
+        && MatchEventType(rule.eventType, eventType);
+}
+
+void SysEventRuleMatcher::CollectExactCandidates(const RuleIndex& index, const std::string& key,
+    std::vector<size_t>& candidates) const
+{
+    if (index.empty() || key.empty()) {
+        return;
+    }
+    if (auto iter = index.find(key); iter != index.end()) {
+        candidates.insert(candidates.end(), iter->second.begin(), iter->second.end());
+    }
+    if (auto iter = index.find(""); iter != index.end()) {
+        candidates.insert(candidates.end(), iter->second.begin(), iter->second.end());
+    }
+}
+
+void SysEventRuleMatcher::CollectPrefixCandidates(const RuleIndex& index, const std::string& key,
+    std::vector<size_t>& candidates) const
+{
+    if (index.empty() || key.empty()) {
+        return;
+    }
+    std::string prefix;
+    prefix.reserve(key.size());
+    for (size_t len = 0; len <= key.size(); ++len) {
+        if (len > 0) {
+            prefix.push_back(key[len - 1]);
+        }
+        if (auto iter = index.find(prefix); iter != index.end()) {
+            candidates.insert(candidates.end(), iter->second.begin(), iter->second.end());
+        }
+    }
+}
+
+std::shared_ptr<const MatchedListeners> SysEventRuleMatcher::Match(const std::string& domain,
+    const std::string& eventName, const std::string& tag, uint32_t eventType) const
+{
+    std::vector<size_t> candidates;
+    CollectExactCandidates(exactRules_, domain, candidates);
+    CollectExactCandidates(exactTagRules_, tag, candidates);
+    CollectPrefixCandidates(prefixRules_, domain, candidates);
+    CollectPrefixCandidates(prefixTagRules_, tag, candidates);
+    candidates.insert(candidates.end(), regexRules_.begin(), regexRules_.end());
+
+    std::set<sptr<IRemoteObject>> listeners;
+    for (auto index : candidates) {
+        const auto& rule = compiledRules_[index];
+        if (listeners.find(rule.listener) != listeners.end()) {
+            continue;
+        }
+        if (MatchCompiledRule(rule, domain, eventName, tag, eventType)) {
+            HIVIEW_LOGD("rule type is %{public}u, domain is %{public}s, eventName is %{public}s, "
+                "tag is %{public}s, eventType is %{public}u for matched",
+                rule.ruleType, rule.domain.empty() ? "empty" : rule.domain.c_str(),
+                rule.eventName.empty() ? "empty" : rule.eventName.c_str(),
+                rule.tag.empty() ? "empty" : rule.tag.c_str(), eventType);
+            listeners.emplace(rule.listener);
+        }
+    }
+    return std::make_shared<const MatchedListeners>(listeners.begin(), listeners.end());
+}
+} // namespace HiviewDFX
+} // namespace OHOS
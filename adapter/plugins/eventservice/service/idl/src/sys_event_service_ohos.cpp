@@ -15,8 +15,8 @@
 
 #include "sys_event_service_ohos.h"
 
+#include <cinttypes>
 #include <codecvt>
-#include <regex>
 #include <set>
 
 #include "accesstoken_kit.h"
@@ -34,7 +34,6 @@
 #include "ret_code.h"
 #include "running_status_log_util.h"
 #include "string_ex.h"
-#include "string_util.h"
 #include "system_ability_definition.h"
 #include "sys_event_sequence_mgr.h"
 #include "time_util.h"
@@ -52,71 +51,6 @@ constexpr size_t WATCHER_TOTAL_CNT_LIMIT = 30; // count of total watches
 constexpr pid_t HID_ROOT = 0;
 constexpr pid_t HID_SHELL = 2000;
 constexpr pid_t HID_OHOS = 1000;
-constexpr size_t REGEX_LEN_LIMIT = 32; // max(domainLen, nameLen, tagLen)
-
-bool IsMatchedWithRegex(const string& rule, const string& match)
-{
-    if (rule.empty()) {
-        return true;
-    }
-    if ((rule.length() > REGEX_LEN_LIMIT) || !StringUtil::IsValidRegex(rule)) {
-        return false;
-    }
-    smatch result;
-    const regex pattern(rule, std::regex::extended);
-    return regex_search(match, result, pattern);
-}
-
-bool MatchContent(int type, const string& rule, const string& match)
-{
-    if (match.empty()) {
-        return false;
-    }
-    switch (type) {
-        case RuleType::WHOLE_WORD:
-            return rule.empty() || match.compare(rule) == 0;
-        case RuleType::PREFIX:
-            return rule.empty() || match.find(rule) == 0;
-        case RuleType::REGULAR:
-            return IsMatchedWithRegex(rule, match);
-        default:
-            HIVIEW_LOGE("invalid rule type %{public}d.", type);
-            return false;
-    }
-}
-
-bool MatchEventType(int rule, int match)
-{
-    return rule == DEFAULT_EVENT_TYPE || rule == match;
-}
-
-bool IsMatchedRule(const OHOS::HiviewDFX::SysEventRule& rule, const string& domain,
-    const string& eventName, const string& tag, uint32_t eventType)
-{
-    if (rule.tag.empty()) {
-        return MatchContent(rule.ruleType, rule.domain, domain)
-            && MatchContent(rule.ruleType, rule.eventName, eventName)
-            && MatchEventType(rule.eventType, eventType);
-    }
-    return MatchContent(rule.ruleType, rule.tag, tag)
-        && MatchEventType(rule.eventType, eventType);
-}
-
-bool MatchRules(const std::vector<SysEventRule>& rules, const string& domain, const string& eventName,
-    const string& tag, uint32_t eventType)
-{
-    return any_of(rules.begin(), rules.end(), [domain, eventName, tag, eventType] (auto& rule) {
-        if (IsMatchedRule(rule, domain, eventName, tag, eventType)) {
-            HIVIEW_LOGD("rule type is %{public}d, domain is %{public}s, eventName is %{public}s, "
-                "tag is %{public}s, eventType is %{public}u for matched",
-                rule.ruleType, rule.domain.empty() ? "empty" : rule.domain.c_str(),
-                rule.eventName.empty() ? "empty" : rule.eventName.c_str(),
-                rule.tag.empty() ? "empty" : rule.tag.c_str(), eventType);
-            return true;
-        }
-        return false;
-    });
-}
 
 int32_t CheckEventSubscriberAddingValidity(const std::vector<std::string>& events)
 {
@@ -189,11 +123,19 @@ void SysEventServiceOhos::OnSysEvent(std::shared_ptr<SysEvent>& event)
         dataPublisher_->OnSysEvent(event);
     }
     lock_guard<mutex> lock(listenersMutex_);
+    if (registeredListeners_.empty()) {
+        return;
+    }
+    auto matchedListeners = ruleMatcher_.GetMatchedListeners(event->domain_, event->eventName_,
+        event->GetTag(), event->eventType_);
+    if (matchedListeners->empty()) {
+        return;
+    }
     CompliantEventChecker compliantEventChecker;
-    for (auto listener = registeredListeners_.begin(); listener != registeredListeners_.end(); ++listener) {
-        OHOS::sptr<ISysEventCallback> callback = iface_cast<ISysEventCallback>(listener->first);
-        if (callback == nullptr) {
-            HIVIEW_LOGE("interface is null, no need to match rules.");
+    std::shared_ptr<const std::string> eventDetail;
+    for (const auto& matchedListener : *matchedListeners) {
+        auto listener = registeredListeners_.find(matchedListener);
+        if (listener == registeredListeners_.end() || listener->second.queue == nullptr) {
             continue;
         }
         if ((listener->second.uid == HID_SHELL) &&
@@ -202,13 +144,12 @@ void SysEventServiceOhos::OnSysEvent(std::shared_ptr<SysEvent>& event)
                 event->domain_.c_str(), event->eventName_.c_str(), listener->second.uid);
             continue;
         }
-        bool isMatched = MatchRules(listener->second.rules, event->domain_, event->eventName_,
-            event->GetTag(), event->eventType_);
-        HIVIEW_LOGD("pid %{public}d rules match %{public}s.", listener->second.pid, isMatched ? "success" : "fail");
-        if (isMatched) {
-            callback->Handle(event->domain_, event->eventName_,
-                static_cast<uint32_t>(event->eventType_), event->AsJsonStr());
+        HIVIEW_LOGD("pid %{public}d rules match success.", listener->second.pid);
+        if (eventDetail == nullptr) {
+            eventDetail = std::make_shared<const std::string>(event->AsJsonStr());
         }
+        listener->second.queue->Enqueue({event->domain_, event->eventName_,
+            static_cast<uint32_t>(event->eventType_), eventDetail});
     }
 }
 
@@ -228,6 +169,10 @@ void SysEventServiceOhos::OnRemoteDied(const wptr<IRemoteObject>& remote)
     if (listener != registeredListeners_.end()) {
         listener->first->RemoveDeathRecipient(deathRecipient_);
         HIVIEW_LOGE("pid %{public}d has died and remove listener.", listener->second.pid);
+        if (listener->second.queue != nullptr) {
+            listener->second.queue->Stop();
+        }
+        ruleMatcher_.RemoveListener(listener->first);
         registeredListeners_.erase(listener);
     }
 }
@@ -278,8 +223,11 @@ ErrCode SysEventServiceOhos::AddListener(const std::vector<SysEventRule>& rules,
     }
     ListenerInfo listenerInfo {IPCSkeleton::GetCallingPid(),
         (EventServiceBaseUtil::IsCustomSandboxAppCaller() ? HID_SHELL : IPCSkeleton::GetCallingUid()), rules};
-    if (registeredListeners_.find(callbackObject) != registeredListeners_.end()) {
-        registeredListeners_[callbackObject] = listenerInfo;
+    if (auto registeredListener = registeredListeners_.find(callbackObject);
+        registeredListener != registeredListeners_.end()) {
+        listenerInfo.queue = registeredListener->second.queue;
+        registeredListener->second = listenerInfo;
+        ruleMatcher_.AddListener(callbackObject, rules);
         HIVIEW_LOGD("uid %{public}d pid %{public}d listener has been added and update rules.",
             listenerInfo.uid, listenerInfo.pid);
         statusMonitor_->RecordAddListener(ListenerStatusUtil::GetListenerCallerInfo(rules), true);
@@ -289,7 +237,9 @@ ErrCode SysEventServiceOhos::AddListener(const std::vector<SysEventRule>& rules,
         HIVIEW_LOGE("subscribe fail, can not add death recipient.");
         return ERR_ADD_DEATH_RECIPIENT;
     }
+    listenerInfo.queue = std::make_shared<SysEventListenerQueue>(callback, listenerInfo.pid);
     registeredListeners_.insert(make_pair(callbackObject, listenerInfo));
+    ruleMatcher_.AddListener(callbackObject, rules);
     HIVIEW_LOGD("uid %{public}d pid %{public}d listener is added successfully, total is %{public}zu.",
         listenerInfo.uid, listenerInfo.pid, registeredListeners_.size());
     statusMonitor_->RecordAddListener(ListenerStatusUtil::GetListenerCallerInfo(rules), true);
@@ -334,6 +284,10 @@ ErrCode SysEventServiceOhos::RemoveListener(const OHOS::sptr<ISysEventCallback>&
             return ERR_ADD_DEATH_RECIPIENT;
         }
         auto rules = registeredListener->second.rules;
+        if (registeredListener->second.queue != nullptr) {
+            registeredListener->second.queue->Stop();
+        }
+        ruleMatcher_.RemoveListener(registeredListener->first);
         registeredListeners_.erase(registeredListener);
         HIVIEW_LOGD("uid %{public}d pid %{public}d has found listener and removes it.", uid, pid);
         statusMonitor_->RecordRemoveListener(ListenerStatusUtil::GetListenerCallerInfo(rules), true);
@@ -445,6 +399,15 @@ int SysEventServiceOhos::Dump(int32_t fd, const std::vector<std::u16string> &arg
         return -1;
     }
     dprintf(fd, "%s\n", "Hiview SysEventService");
+    lock_guard<mutex> lock(listenersMutex_);
+    for (const auto& [object, info] : registeredListeners_) {
+        if (info.queue == nullptr) {
+            continue;
+        }
+        SysEventListenerStat stat = info.queue->GetStat();
+        dprintf(fd, "listener pid=%d uid=%d: delivered=%" PRIu64 ", dropped=%" PRIu64 ", pending=%zu\n",
+            info.pid, info.uid, stat.deliveredCnt, stat.droppedCnt, stat.pendingCnt);
+    }
     return 0;
 }
 
@@ -15,9 +15,11 @@
 
 #include "sys_event_service_ohos_test.h"
 
+#include <atomic>
 #include <cstdlib>
 #include <semaphore.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ash_mem_utils.h"
@@ -29,6 +31,7 @@
 #include "if_system_ability_manager.h"
 #include "ipc_skeleton.h"
 #include "iquery_sys_event_callback.h"
+#include "ipc_object_stub.h"
 #include "iservice_registry.h"
 #include "isys_event_callback.h"
 #include "isys_event_service.h"
@@ -40,7 +43,9 @@
 #include "running_status_log_util.h"
 #include "string_ex.h"
 #include "sys_event.h"
+#include "sys_event_listener_queue.h"
 #include "sys_event_rule.h"
+#include "sys_event_rule_matcher.h"
 #include "sys_event_service_adapter.h"
 #include "sys_event_service_ohos.h"
 #include "system_ability.h"
@@ -107,6 +112,18 @@ public:
     };
 };
 
+class TestSysEventCallbackStub : public IPCObjectStub {
+public:
+    TestSysEventCallbackStub() : IPCObjectStub(u"OHOS.HiviewDFX.ISysEventCallback") {}
+    int OnRemoteRequest(uint32_t code, MessageParcel& data, MessageParcel& reply, MessageOption& option) override
+    {
+        ++handledCnt;
+        return 0;
+    }
+
+    std::atomic<uint32_t> handledCnt {0};
+};
+
 class HiviewTestContext : public HiviewContext {
 public:
     std::string GetHiViewDirectory(DirectoryType type __UNUSED)
@@ -615,5 +632,85 @@ HWTEST_F(SysEventServiceOhosTest, SysEventServiceOhosInstanceTest004, testing::e
     service->OnRemoteDied(remote);
     service->SetWorkLoop(nullptr);
 }
+
+/**
+ * @tc.name: SysEventRuleMatcherTest001
+ * @tc.desc: test matching events with compiled listener rules.
+ * @tc.type: FUNC
+ * @tc.require: issueICJ952
+ */
+HWTEST_F(SysEventServiceOhosTest, SysEventRuleMatcherTest001, testing::ext::TestSize.Level1)
+{
+    SysEventRuleMatcher matcher;
+    sptr<IRemoteObject> listener1 = new IPCObjectStub(u"listener1");
+    sptr<IRemoteObject> listener2 = new IPCObjectStub(u"listener2");
+    sptr<IRemoteObject> listener3 = new IPCObjectStub(u"listener3");
+    matcher.AddListener(listener1, { SysEventRule("AAFWK", "START", RuleType::WHOLE_WORD) });
+    matcher.AddListener(listener2, { SysEventRule("AA", "ST", RuleType::PREFIX), SysEventRule("TAG1") });
+    matcher.AddListener(listener3, { SysEventRule("^A.*K$", "", RuleType::REGULAR, 2) }); // 2: statistic type
+
+    ASSERT_EQ(matcher.GetMatchedListeners("AAFWK", "START", "", 1)->size(), 2); // 1: fault type
+    ASSERT_EQ(matcher.GetMatchedListeners("AAFWK", "START", "", 2)->size(), 3); // 2: statistic type
+    ASSERT_EQ(matcher.GetMatchedListeners("AAFWK", "STOP", "", 2)->size(), 2); // 2: statistic type
+    ASSERT_EQ(matcher.GetMatchedListeners("BUNDLE", "START", "TAG1", 1)->size(), 1); // 1: fault type
+    ASSERT_TRUE(matcher.GetMatchedListeners("BUNDLE", "START", "", 1)->empty()); // 1: fault type
+
+    // the same matched result is shared between the repeated events
+    auto matched = matcher.GetMatchedListeners("AAFWK", "START", "", 1); // 1: fault type
+    ASSERT_EQ(matched, matcher.GetMatchedListeners("AAFWK", "START", "", 1)); // 1: fault type
+}
+
+/**
+ * @tc.name: SysEventRuleMatcherTest002
+ * @tc.desc: test matched result is updated after listeners changed.
+ * @tc.type: FUNC
+ * @tc.require: issueICJ952
+ */
+HWTEST_F(SysEventServiceOhosTest, SysEventRuleMatcherTest002, testing::ext::TestSize.Level1)
+{
+    SysEventRuleMatcher matcher;
+    sptr<IRemoteObject> listener1 = new IPCObjectStub(u"listener1");
+    sptr<IRemoteObject> listener2 = new IPCObjectStub(u"listener2");
+    matcher.AddListener(listener1, { SysEventRule("AAFWK", "START", RuleType::WHOLE_WORD) });
+    matcher.AddListener(listener2, { SysEventRule("AAFWK", "", RuleType::WHOLE_WORD) });
+    ASSERT_EQ(matcher.GetMatchedListeners("AAFWK", "START", "", 1)->size(), 2); // 1: fault type
+
+    matcher.RemoveListener(listener2);
+    ASSERT_EQ(matcher.GetMatchedListeners("AAFWK", "START", "", 1)->size(), 1); // 1: fault type
+
+    // invalid regular rule never matches
+    matcher.AddListener(listener1, { SysEventRule("(", "", RuleType::REGULAR) });
+    ASSERT_TRUE(matcher.GetMatchedListeners("AAFWK", "START", "", 1)->empty()); // 1: fault type
+}
+
+/**
+ * @tc.name: SysEventListenerQueueTest001
+ * @tc.desc: test delivering events to listener asynchronously.
+ * @tc.type: FUNC
+ * @tc.require: issueICJ952
+ */
+HWTEST_F(SysEventServiceOhosTest, SysEventListenerQueueTest001, testing::ext::TestSize.Level1)
+{
+    sptr<TestSysEventCallbackStub> stub = new TestSysEventCallbackStub();
+    sptr<ISysEventCallback> callback = new SysEventCallbackProxy(stub);
+    auto queue = std::make_shared<SysEventListenerQueue>(callback, getpid());
+    auto eventDetail = std::make_shared<const std::string>("{\"domain_\":\"DEMO\",\"name_\":\"NAME1\"}");
+    constexpr uint32_t eventCnt = 100;
+    for (uint32_t i = 0; i < eventCnt; ++i) {
+        ASSERT_TRUE(queue->Enqueue({"DEMO", "NAME1", 1, eventDetail})); // 1: fault type
+    }
+    constexpr int maxWaitCnt = 100;
+    for (int i = 0; i < maxWaitCnt && queue->GetStat().deliveredCnt < eventCnt; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10: wait for 10ms
+    }
+    SysEventListenerStat stat = queue->GetStat();
+    ASSERT_EQ(stat.deliveredCnt, eventCnt);
+    ASSERT_EQ(stat.droppedCnt, 0);
+    ASSERT_EQ(stat.pendingCnt, 0);
+    ASSERT_EQ(stub->handledCnt, eventCnt);
+
+    queue->Stop();
+    ASSERT_FALSE(queue->Enqueue({"DEMO", "NAME1", 1, eventDetail})); // 1: fault type
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
@@ -34,7 +34,10 @@ EventDispatchQueue::~EventDispatchQueue()
 void EventDispatchQueue::ProcessUnorderedEvent(const Event& event)
 {
     auto listeners = context_->GetListenerInfo(event.messageType_, event.eventName_, event.domain_);
-    for (auto& listener : listeners) {
+    if (listeners == nullptr) {
+        return;
+    }
+    for (const auto& listener : *listeners) {
         auto ptr = listener.lock();
         auto timePtr = std::make_shared<uint64_t>(0);
         {
@@ -72,6 +72,22 @@ RawData::RawData(uint8_t* data, size_t dataLen)
     len_ = dataLen;
 }
 
+RawData::RawData(std::unique_ptr<uint8_t[]> data, size_t dataLen, size_t capacity)
+{
+    if (data == nullptr || dataLen > capacity) {
+        data_ = new(std::nothrow) uint8_t[EXPAND_BUF_SIZE];
+        if (data_ == nullptr) {
+            return;
+        }
+        capacity_ = EXPAND_BUF_SIZE;
+        len_ = 0;
+        return;
+    }
+    data_ = data.release();
+    capacity_ = capacity;
+    len_ = dataLen;
+}
+
 RawData::RawData(const RawData& data)
 {
     auto dataLen = data.GetDataLength();
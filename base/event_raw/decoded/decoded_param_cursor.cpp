@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "decoded/decoded_param_cursor.h"
+
+#include <cstring>
+
+#include "decoded/raw_data_decoder.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventRaw {
+namespace {
+constexpr size_t MAX_BLOCK_SIZE = 384 * 1024; // 384K
+constexpr size_t MAX_PARAM_CNT = 128 + 10; // 128 for Write, 10 for hiview
+
+bool ParseDataCodedType(const struct ParamValueType& valueType, DataCodedType& codedType)
+{
+    bool isArray = (valueType.isArray == 1);
+    switch (ValueType(valueType.valueType)) {
+        case ValueType::STRING:
+            codedType = isArray ? DataCodedType::DSTRING_ARRAY : DataCodedType::DSTRING;
+            return true;
+        case ValueType::FLOAT:
+        case ValueType::DOUBLE:
+            codedType = isArray ? DataCodedType::FLOATING_ARRAY : DataCodedType::FLOATING;
+            return true;
+        case ValueType::UINT8:
+        case ValueType::UINT16:
+        case ValueType::UINT32:
+        case ValueType::UINT64:
+            codedType = isArray ? DataCodedType::UNSIGNED_VARINT_ARRAY : DataCodedType::UNSIGNED_VARINT;
+            return true;
+        case ValueType::BOOL:
+        case ValueType::INT8:
+        case ValueType::INT16:
+        case ValueType::INT32:
+        case ValueType::INT64:
+            codedType = isArray ? DataCodedType::SIGNED_VARINT_ARRAY : DataCodedType::SIGNED_VARINT;
+            return true;
+        default:
+            return false;
+    }
+}
+}
+
+DecodedParamCursor::DecodedParamCursor(uint8_t* data, size_t len)
+{
+    if (data == nullptr || len < sizeof(int32_t)) {
+        return;
+    }
+    size_t blockSize = static_cast<size_t>(*(reinterpret_cast<int32_t*>(data)));
+    if (blockSize != len || blockSize < GetValidDataMinimumByteCount() || blockSize > MAX_BLOCK_SIZE) {
+        return;
+    }
+    rawData_ = data;
+    maxLen_ = blockSize;
+    ParseHeader();
+}
+
+DecodedParamCursor::DecodedParamCursor(uint8_t* params, size_t len, size_t paramCnt)
+{
+    if (params == nullptr || len > MAX_BLOCK_SIZE || paramCnt > MAX_PARAM_CNT) {
+        return;
+    }
+    rawData_ = params;
+    maxLen_ = len;
+    remainParamCnt_ = paramCnt;
+    isValid_ = true;
+}
+
+void DecodedParamCursor::ParseHeader()
+{
+    pos_ = sizeof(int32_t);
+    if ((pos_ + sizeof(struct HiSysEventHeader)) > maxLen_) {
+        return;
+    }
+    auto header = reinterpret_cast<struct HiSysEventHeader*>(rawData_ + pos_);
+    pos_ += sizeof(struct HiSysEventHeader);
+    if (header->isTraceOpened == 1) { // 1: include trace info, 0: exclude trace info
+        if ((pos_ + sizeof(struct TraceInfo)) > maxLen_) {
+            return;
+        }
+        pos_ += sizeof(struct TraceInfo);
+    }
+    if ((pos_ + sizeof(int32_t)) > maxLen_) {
+        return;
+    }
+    int32_t paramCnt = 0;
+    (void)memcpy_s(&paramCnt, sizeof(paramCnt), rawData_ + pos_, sizeof(int32_t));
+    if (paramCnt < 0 || static_cast<size_t>(paramCnt) > MAX_PARAM_CNT) {
+        return;
+    }
+    pos_ += sizeof(int32_t);
+    remainParamCnt_ = static_cast<size_t>(paramCnt);
+    isValid_ = true;
+}
+
+bool DecodedParamCursor::IsValid() const
+{
+    return isValid_;
+}
+
+bool DecodedParamCursor::Next()
+{
+    if (!isValid_ || remainParamCnt_ == 0) {
+        return false;
+    }
+    if (hasParam_ && !SkipValue()) {
+        isValid_ = false;
+        return false;
+    }
+    uint64_t keyLen = 0;
+    if (!RawDataDecoder::UnsignedVarintDecoded(rawData_, maxLen_, pos_, keyLen) || keyLen > maxLen_ - pos_) {
+        isValid_ = false;
+        return false;
+    }
+    keyPos_ = pos_;
+    keyLen_ = static_cast<size_t>(keyLen);
+    pos_ += keyLen_;
+    struct ParamValueType valueType {
+        .isArray = 0,
+        .valueType = static_cast<uint8_t>(ValueType::UNKNOWN),
+        .valueByteCnt = 0,
+    };
+    if (!RawDataDecoder::ValueTypeDecoded(rawData_, maxLen_, pos_, valueType) ||
+        !ParseDataCodedType(valueType, codedType_)) {
+        isValid_ = false;
+        return false;
+    }
+    valuePos_ = pos_;
+    hasParam_ = true;
+    --remainParamCnt_;
+    return true;
+}
+
+bool DecodedParamCursor::SkipValue()
+{
+    uint64_t itemCnt = 1; // the value which is not an array holds one item
+    if ((codedType_ == DataCodedType::UNSIGNED_VARINT_ARRAY || codedType_ == DataCodedType::SIGNED_VARINT_ARRAY ||
+        codedType_ == DataCodedType::FLOATING_ARRAY || codedType_ == DataCodedType::DSTRING_ARRAY) &&
+        !RawDataDecoder::UnsignedVarintDecoded(rawData_, maxLen_, pos_, itemCnt)) {
+        return false;
+    }
+    // the floating number and string are encoded with the byte count ahead
+    bool isLengthDelimited = (codedType_ == DataCodedType::FLOATING || codedType_ == DataCodedType::FLOATING_ARRAY ||
+        codedType_ == DataCodedType::DSTRING || codedType_ == DataCodedType::DSTRING_ARRAY);
+    for (; itemCnt > 0; --itemCnt) {
+        uint64_t val = 0;
+        if (!RawDataDecoder::UnsignedVarintDecoded(rawData_, maxLen_, pos_, val)) {
+            return false;
+        }
+        if (!isLengthDelimited) {
+            continue;
+        }
+        if (val > maxLen_ - pos_) {
+            return false;
+        }
+        pos_ += static_cast<size_t>(val);
+    }
+    return true;
+}
+
+bool DecodedParamCursor::IsKeyOf(const std::string& key) const
+{
+    return hasParam_ && key.length() == keyLen_ && memcmp(rawData_ + keyPos_, key.c_str(), keyLen_) == 0;
+}
+
+DataCodedType DecodedParamCursor::GetDataCodedType() const
+{
+    return codedType_;
+}
+
+bool DecodedParamCursor::AsUint64(uint64_t& dest) const
+{
+    if (!hasParam_ || codedType_ != DataCodedType::UNSIGNED_VARINT) {
+        return false;
+    }
+    size_t pos = valuePos_;
+    return RawDataDecoder::UnsignedVarintDecoded(rawData_, maxLen_, pos, dest);
+}
+
+bool DecodedParamCursor::AsInt64(int64_t& dest) const
+{
+    if (!hasParam_ || codedType_ != DataCodedType::SIGNED_VARINT) {
+        return false;
+    }
+    size_t pos = valuePos_;
+    return RawDataDecoder::SignedVarintDecoded(rawData_, maxLen_, pos, dest);
+}
+
+bool DecodedParamCursor::AsDouble(double& dest) const
+{
+    if (!hasParam_ || codedType_ != DataCodedType::FLOATING) {
+        return false;
+    }
+    size_t pos = valuePos_;
+    return RawDataDecoder::FloatingNumberDecoded(rawData_, maxLen_, pos, dest);
+}
+
+bool DecodedParamCursor::AsString(std::string& dest) const
+{
+    if (!hasParam_ || codedType_ != DataCodedType::DSTRING) {
+        return false;
+    }
+    size_t pos = valuePos_;
+    dest.clear();
+    return RawDataDecoder::StringValueDecoded(rawData_, maxLen_, pos, dest);
+}
+} // namespace EventRaw
+} // namespace HiviewDFX
+} // namespace OHOS
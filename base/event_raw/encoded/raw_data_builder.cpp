@@ -16,8 +16,10 @@
 #include "encoded/raw_data_builder.h"
 
 #include <cinttypes>
+#include <iterator>
 #include <securec.h>
 #include <sstream>
+#include <string_view>
 #include <vector>
 
 #include "decoded/decoded_event.h"
@@ -27,12 +29,6 @@ namespace OHOS {
 namespace HiviewDFX {
 namespace EventRaw {
 DEFINE_LOG_TAG("HiView-RawDataBuilder");
-template void RawDataBuilder::InitIdInfoAppendHandlers<char const*>(
-    std::unordered_map<std::string, std::function<RawDataBuilder&(char const*)>>&);
-template void RawDataBuilder::InitIdInfoAppendHandlers<std::string>(
-    std::unordered_map<std::string, std::function<RawDataBuilder&(std::string)>>&);
-template void RawDataBuilder::InitIdInfoAppendHandlers<uint64_t>(
-    std::unordered_map<std::string, std::function<RawDataBuilder&(uint64_t)>>&);
 template RawDataBuilder& RawDataBuilder::AppendValue<double>(const std::string&, double);
 template RawDataBuilder& RawDataBuilder::AppendValue<std::string>(const std::string&, std::string);
 template RawDataBuilder& RawDataBuilder::AppendValue<int64_t>(const std::string&, int64_t);
@@ -116,14 +112,39 @@ std::shared_ptr<RawData> RawDataBuilder::Build()
     return rawData;
 }
 
+RawDataBuilder::BaseInfoType RawDataBuilder::GetBaseInfoType(const std::string& key)
+{
+    static constexpr std::pair<std::string_view, BaseInfoType> allBaseInfoKeys[] = {
+        {BASE_INFO_KEY_DOMAIN, BaseInfoType::KEY_DOMAIN},
+        {BASE_INFO_KEY_NAME, BaseInfoType::KEY_NAME},
+        {BASE_INFO_KEY_TYPE, BaseInfoType::KEY_TYPE},
+        {BASE_INFO_KEY_TIME_STAMP, BaseInfoType::KEY_TIME_STAMP},
+        {BASE_INFO_KEY_TIME_ZONE, BaseInfoType::KEY_TIME_ZONE},
+        {BASE_INFO_KEY_ID, BaseInfoType::KEY_ID},
+        {BASE_INFO_KEY_PID, BaseInfoType::KEY_PID},
+        {BASE_INFO_KEY_TID, BaseInfoType::KEY_TID},
+        {BASE_INFO_KEY_UID, BaseInfoType::KEY_UID},
+        {BASE_INFO_KEY_LOG, BaseInfoType::KEY_LOG},
+        {BASE_INFO_KEY_TRACE_ID, BaseInfoType::KEY_TRACE_ID},
+        {BASE_INFO_KEY_SPAN_ID, BaseInfoType::KEY_SPAN_ID},
+        {BASE_INFO_KEY_PARENT_SPAN_ID, BaseInfoType::KEY_PARENT_SPAN_ID},
+        {BASE_INFO_KEY_TRACE_FLAG, BaseInfoType::KEY_TRACE_FLAG},
+    };
+    // all keys of base info end with '_', most of the customized keys are filtered out here
+    if (key.empty() || key.back() != '_') {
+        return BaseInfoType::NONE;
+    }
+    for (const auto& [baseInfoKey, type] : allBaseInfoKeys) {
+        if (key == baseInfoKey) {
+            return type;
+        }
+    }
+    return BaseInfoType::NONE;
+}
+
 bool RawDataBuilder::IsBaseInfo(const std::string& key)
 {
-    std::vector<const std::string> allBaseInfoKeys = {
-        BASE_INFO_KEY_DOMAIN, BASE_INFO_KEY_NAME, BASE_INFO_KEY_TYPE, BASE_INFO_KEY_TIME_STAMP, BASE_INFO_KEY_LOG,
-        BASE_INFO_KEY_TIME_ZONE, BASE_INFO_KEY_ID, BASE_INFO_KEY_PID, BASE_INFO_KEY_TID, BASE_INFO_KEY_UID,
-        BASE_INFO_KEY_TRACE_ID, BASE_INFO_KEY_SPAN_ID, BASE_INFO_KEY_PARENT_SPAN_ID, BASE_INFO_KEY_TRACE_FLAG
-    };
-    return find(allBaseInfoKeys.begin(), allBaseInfoKeys.end(), key) != allBaseInfoKeys.end();
+    return GetBaseInfoType(key) != BaseInfoType::NONE;
 }
 
 RawDataBuilder& RawDataBuilder::AppendDomain(const std::string& domain)
@@ -260,30 +281,21 @@ RawDataBuilder& RawDataBuilder::AppendValue(std::shared_ptr<EncodedParam> param)
     }
     auto paramKey = param->GetKey();
     std::lock_guard<std::mutex> lock(paramsOptMtx_);
-    for (auto iter = allParams_.begin(); iter != allParams_.end(); ++iter) {
-        if ((*iter) == nullptr) {
-            continue;
-        }
-        if ((*iter)->GetKey() == paramKey) {
-            *iter = param;
-            return *this;
-        }
+    if (auto indexIter = paramIndex_.find(paramKey); indexIter != paramIndex_.end()) {
+        *(indexIter->second) = param;
+        return *this;
     }
     allParams_.emplace_back(param);
+    paramIndex_.emplace(paramKey, std::prev(allParams_.end()));
     return *this;
 }
 
 RawDataBuilder& RawDataBuilder::RemoveParam(const std::string& paramName)
 {
     std::lock_guard<std::mutex> lock(paramsOptMtx_);
-    for (auto iter = allParams_.begin(); iter != allParams_.end(); ++iter) {
-        if ((*iter) == nullptr) {
-            continue;
-        }
-        if ((*iter)->GetKey() == paramName) {
-            allParams_.erase(iter);
-            break;
-        }
+    if (auto indexIter = paramIndex_.find(paramName); indexIter != paramIndex_.end()) {
+        allParams_.erase(indexIter->second);
+        paramIndex_.erase(indexIter);
     }
     return *this;
 }
@@ -291,15 +303,8 @@ RawDataBuilder& RawDataBuilder::RemoveParam(const std::string& paramName)
 std::shared_ptr<EncodedParam> RawDataBuilder::GetValue(const std::string& key)
 {
     std::lock_guard<std::mutex> lock(paramsOptMtx_);
-    for (auto iter = allParams_.begin(); iter != allParams_.end(); ++iter) {
-        if ((*iter) == nullptr) {
-            continue;
-        }
-        if ((*iter)->GetKey() == key) {
-            return *iter;
-        }
-    }
-    return nullptr;
+    auto indexIter = paramIndex_.find(key);
+    return (indexIter == paramIndex_.end()) ? nullptr : *(indexIter->second);
 }
 
 std::string RawDataBuilder::GetDomain()
@@ -19,6 +19,7 @@
 #include <cstdarg>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 
 namespace OHOS {
@@ -29,6 +30,8 @@ public:
     RawData();
     RawData(size_t dataLen);
     RawData(uint8_t* data, size_t dataLen);
+    // take over the buffer without copying, capacity is the allocated size of data
+    RawData(std::unique_ptr<uint8_t[]> data, size_t dataLen, size_t capacity);
     RawData(const RawData& data);
     ~RawData();
 
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENT_RAW_DECODE_INCLUDE_DECODED_PARAM_CURSOR_H
+#define BASE_EVENT_RAW_DECODE_INCLUDE_DECODED_PARAM_CURSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/raw_data_base_def.h"
+#include "base/value_param.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventRaw {
+/*
+ * Walks the customized params of the raw data one by one without copying the data, only the value of
+ * the current param is decoded on demand.
+ */
+class DecodedParamCursor {
+public:
+    DecodedParamCursor(uint8_t* data, size_t len);
+    // walks the encoded params directly, which are not led by the block size and the header of the raw data
+    DecodedParamCursor(uint8_t* params, size_t len, size_t paramCnt);
+    ~DecodedParamCursor() = default;
+
+public:
+    bool IsValid() const;
+    bool Next();
+    bool IsKeyOf(const std::string& key) const;
+    DataCodedType GetDataCodedType() const;
+
+public:
+    bool AsUint64(uint64_t& dest) const;
+    bool AsInt64(int64_t& dest) const;
+    bool AsDouble(double& dest) const;
+    bool AsString(std::string& dest) const;
+
+private:
+    void ParseHeader();
+    bool SkipValue();
+
+private:
+    uint8_t* rawData_ = nullptr;
+    size_t maxLen_ = 0;
+    size_t pos_ = 0;
+    size_t remainParamCnt_ = 0;
+    size_t keyPos_ = 0;
+    size_t keyLen_ = 0;
+    size_t valuePos_ = 0;
+    DataCodedType codedType_ = DataCodedType::UNSIGNED_VARINT;
+    bool hasParam_ = false;
+    bool isValid_ = false;
+};
+} // namespace EventRaw
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // BASE_EVENT_RAW_DECODE_INCLUDE_DECODED_PARAM_CURSOR_H
@@ -78,8 +78,8 @@ public:
     template<typename T>
     bool ParseValueByKey(const std::string& key, T& dest)
     {
-        if (IsBaseInfo(key)) {
-            return GetBaseInfoValueByKey(key, dest);
+        if (auto type = GetBaseInfoType(key); type != BaseInfoType::NONE) {
+            return GetBaseInfoValueByType(type, dest);
         }
         return GetValueByKey(key, dest);
     }
@@ -87,8 +87,8 @@ public:
     template<typename T>
     RawDataBuilder& AppendValue(const std::string& key, T val)
     {
-        if (IsBaseInfo(key)) {
-            return AppendBaseInfoValue(key, val);
+        if (auto type = GetBaseInfoType(key); type != BaseInfoType::NONE) {
+            return AppendBaseInfoValue(type, val);
         }
         if constexpr (isString<T>) {
             return AppendValue(std::make_shared<StringEncodedParam>(key, val));
@@ -107,6 +107,25 @@ public:
     }
 
 private:
+    enum class BaseInfoType : uint8_t {
+        NONE = 0,
+        KEY_DOMAIN,
+        KEY_NAME,
+        KEY_TYPE,
+        KEY_TIME_STAMP,
+        KEY_TIME_ZONE,
+        KEY_ID,
+        KEY_PID,
+        KEY_TID,
+        KEY_UID,
+        KEY_LOG,
+        KEY_TRACE_ID,
+        KEY_SPAN_ID,
+        KEY_PARENT_SPAN_ID,
+        KEY_TRACE_FLAG,
+    };
+    static BaseInfoType GetBaseInfoType(const std::string& key);
+
     template<typename T>
     RawDataBuilder& UpdateType(const T val)
     {
@@ -254,119 +273,94 @@ private:
     }
 
     template<typename T>
-    void InitBaseAppendHandlers(std::unordered_map<std::string, std::function<RawDataBuilder&(T)>>& handlers)
+    RawDataBuilder& AppendBaseInfoValue(BaseInfoType type, T val)
     {
-        handlers.emplace(BASE_INFO_KEY_DOMAIN, [this] (T val) -> decltype(auto) {
-            if constexpr (isString<T>) {
-                return this->AppendDomain(val);
-            }
-            return *this;
-        });
-        handlers.emplace(BASE_INFO_KEY_NAME, [this] (T val) -> decltype(auto) {
-            if constexpr (isString<T>) {
-                return this->AppendName(val);
-            }
-            return *this;
-        });
-        handlers.emplace(BASE_INFO_KEY_TYPE, [this] (T val) -> decltype(auto) {
-            return this->UpdateType(val);
-        });
-        handlers.emplace(BASE_INFO_KEY_TIME_STAMP, [this] (T val) -> decltype(auto) {
-            if constexpr (std::is_same_v<std::decay_t<T>, uint64_t>) {
-                return this->AppendTimeStamp(val);
-            }
-            return *this;
-        });
-        handlers.emplace(BASE_INFO_KEY_TIME_ZONE, [this] (T val) -> decltype(auto) {
-            if constexpr (isString<T>) {
-                return this->AppendTimeZone(val);
-            }
-            return *this;
-        });
-    }
-
-    template<typename T>
-    void InitIdInfoAppendHandlers(std::unordered_map<std::string, std::function<RawDataBuilder&(T)>>& handlers)
-    {
-        handlers.emplace(BASE_INFO_KEY_ID, [this] (T val) -> decltype(auto) {
-            return this->UpdateId(val);
-        });
-        handlers.emplace(BASE_INFO_KEY_PID, [this] (T val) -> decltype(auto) {
-            return this->UpdatePid(val);
-        });
-        handlers.emplace(BASE_INFO_KEY_TID, [this] (T val) -> decltype(auto) {
-            return this->UpdateTid(val);
-        });
-        handlers.emplace(BASE_INFO_KEY_UID, [this] (T val) -> decltype(auto) {
-            return this->UpdateUid(val);
-        });
-        handlers.emplace(BASE_INFO_KEY_LOG, [this] (T val) -> decltype(auto) {
-            return this->UpdateLog(val);
-        });
-        handlers.emplace(BASE_INFO_KEY_TRACE_ID, [this] (T val) -> decltype(auto) {
-            return this->UpdateTraceId(val);
-        });
-        handlers.emplace(BASE_INFO_KEY_SPAN_ID, [this] (T val) -> decltype(auto) {
-            return this->UpdateSpanId(val);
-        });
-        handlers.emplace(BASE_INFO_KEY_PARENT_SPAN_ID, [this] (T val) -> decltype(auto) {
-            return this->UpdatePSpanId(val);
-        });
-        handlers.emplace(BASE_INFO_KEY_TRACE_FLAG, [this] (T val) -> decltype(auto) {
-            return this->UpdateTraceFlag(val);
-        });
+        switch (type) {
+            case BaseInfoType::KEY_DOMAIN:
+                if constexpr (isString<T>) {
+                    return AppendDomain(val);
+                }
+                return *this;
+            case BaseInfoType::KEY_NAME:
+                if constexpr (isString<T>) {
+                    return AppendName(val);
+                }
+                return *this;
+            case BaseInfoType::KEY_TYPE:
+                return UpdateType(val);
+            case BaseInfoType::KEY_TIME_STAMP:
+                if constexpr (std::is_same_v<std::decay_t<T>, uint64_t>) {
+                    return AppendTimeStamp(val);
+                }
+                return *this;
+            case BaseInfoType::KEY_TIME_ZONE:
+                if constexpr (isString<T>) {
+                    return AppendTimeZone(val);
+                }
+                return *this;
+            default:
+                return AppendIdInfoValue(type, val);
+        }
     }
 
     template<typename T>
-    RawDataBuilder& AppendBaseInfoValue(const std::string& key, T val)
+    RawDataBuilder& AppendIdInfoValue(BaseInfoType type, T val)
     {
-        std::unordered_map<std::string, std::function<RawDataBuilder&(T)>> appendHandlers;
-        InitBaseAppendHandlers(appendHandlers);
-        InitIdInfoAppendHandlers(appendHandlers);
-        auto iter = appendHandlers.find(key);
-        return (iter == appendHandlers.end()) ? *this : iter->second(val);
+        switch (type) {
+            case BaseInfoType::KEY_ID:
+                return UpdateId(val);
+            case BaseInfoType::KEY_PID:
+                return UpdatePid(val);
+            case BaseInfoType::KEY_TID:
+                return UpdateTid(val);
+            case BaseInfoType::KEY_UID:
+                return UpdateUid(val);
+            case BaseInfoType::KEY_LOG:
+                return UpdateLog(val);
+            case BaseInfoType::KEY_TRACE_ID:
+                return UpdateTraceId(val);
+            case BaseInfoType::KEY_SPAN_ID:
+                return UpdateSpanId(val);
+            case BaseInfoType::KEY_PARENT_SPAN_ID:
+                return UpdatePSpanId(val);
+            case BaseInfoType::KEY_TRACE_FLAG:
+                return UpdateTraceFlag(val);
+            default:
+                return *this;
+        }
     }
 
     template<typename T>
     bool GetArrayValueByKey(std::shared_ptr<EncodedParam> encodedParam, T& val)
     {
-        std::unordered_map<DataCodedType,
-            std::function<bool(std::shared_ptr<EncodedParam>, T&)>> getFuncs = {
-            {DataCodedType::UNSIGNED_VARINT_ARRAY, [] (std::shared_ptr<EncodedParam> param, T& val) {
-                    if constexpr (std::is_same_v<std::decay_t<T>, std::vector<uint64_t>>) {
-                        param->AsUint64Vec(val);
-                        return true;
-                    }
-                    return false;
+        switch (encodedParam->GetDataCodedType()) {
+            case DataCodedType::UNSIGNED_VARINT_ARRAY:
+                if constexpr (std::is_same_v<std::decay_t<T>, std::vector<uint64_t>>) {
+                    encodedParam->AsUint64Vec(val);
+                    return true;
                 }
-            },
-            {DataCodedType::SIGNED_VARINT_ARRAY, [] (std::shared_ptr<EncodedParam> param, T& val) {
-                    if constexpr (std::is_same_v<std::decay_t<T>, std::vector<int64_t>>) {
-                        param->AsInt64Vec(val);
-                        return true;
-                    }
-                    return false;
+                return false;
+            case DataCodedType::SIGNED_VARINT_ARRAY:
+                if constexpr (std::is_same_v<std::decay_t<T>, std::vector<int64_t>>) {
+                    encodedParam->AsInt64Vec(val);
+                    return true;
                 }
-            },
-            {DataCodedType::FLOATING_ARRAY, [] (std::shared_ptr<EncodedParam> param, T& val) {
-                    if constexpr (std::is_same_v<std::decay_t<T>, std::vector<double>>) {
-                        param->AsDoubleVec(val);
-                        return true;
-                    }
-                    return false;
+                return false;
+            case DataCodedType::FLOATING_ARRAY:
+                if constexpr (std::is_same_v<std::decay_t<T>, std::vector<double>>) {
+                    encodedParam->AsDoubleVec(val);
+                    return true;
                 }
-            },
-            {DataCodedType::DSTRING_ARRAY, [] (std::shared_ptr<EncodedParam> param, T& val) {
-                    if constexpr (std::is_same_v<std::decay_t<T>, std::vector<std::string>>) {
-                        param->AsStringVec(val);
-                        return true;
-                    }
-                    return false;
+                return false;
+            case DataCodedType::DSTRING_ARRAY:
+                if constexpr (std::is_same_v<std::decay_t<T>, std::vector<std::string>>) {
+                    encodedParam->AsStringVec(val);
+                    return true;
                 }
-            }
-        };
-        auto iter = getFuncs.find(encodedParam->GetDataCodedType());
-        return (iter == getFuncs.end()) ? false : iter->second(encodedParam, val);
+                return false;
+            default:
+                return false;
+        }
     }
 
     template<typename T>
@@ -376,42 +370,34 @@ private:
         if (encodedParam == nullptr) {
             return false;
         }
-        std::unordered_map<DataCodedType, std::function<bool(std::shared_ptr<EncodedParam>, T&)>> getFuncs = {
-            {DataCodedType::UNSIGNED_VARINT, [] (std::shared_ptr<EncodedParam> param, T& val) {
-                    if constexpr (std::is_same_v<std::decay_t<T>, uint64_t>) {
-                        param->AsUint64(val);
-                        return true;
-                    }
-                    return false;
+        switch (encodedParam->GetDataCodedType()) {
+            case DataCodedType::UNSIGNED_VARINT:
+                if constexpr (std::is_same_v<std::decay_t<T>, uint64_t>) {
+                    encodedParam->AsUint64(val);
+                    return true;
                 }
-            },
-            {DataCodedType::SIGNED_VARINT, [] (std::shared_ptr<EncodedParam> param, T& val) {
-                    if constexpr (std::is_same_v<std::decay_t<T>, int64_t>) {
-                        param->AsInt64(val);
-                        return true;
-                    }
-                    return false;
+                return false;
+            case DataCodedType::SIGNED_VARINT:
+                if constexpr (std::is_same_v<std::decay_t<T>, int64_t>) {
+                    encodedParam->AsInt64(val);
+                    return true;
                 }
-            },
-            {DataCodedType::FLOATING, [] (std::shared_ptr<EncodedParam> param, T& val) {
-                    if constexpr (std::is_same_v<std::decay_t<T>, double>) {
-                        param->AsDouble(val);
-                        return true;
-                    }
-                    return false;
+                return false;
+            case DataCodedType::FLOATING:
+                if constexpr (std::is_same_v<std::decay_t<T>, double>) {
+                    encodedParam->AsDouble(val);
+                    return true;
                 }
-            },
-            {DataCodedType::DSTRING, [] (std::shared_ptr<EncodedParam> param, T& val) {
-                    if constexpr (isString<T>) {
-                        param->AsString(val);
-                        return true;
-                    }
-                    return false;
+                return false;
+            case DataCodedType::DSTRING:
+                if constexpr (isString<T>) {
+                    encodedParam->AsString(val);
+                    return true;
                 }
-            }
-        };
-        auto iter = getFuncs.find(encodedParam->GetDataCodedType());
-        return (iter == getFuncs.end()) ? GetArrayValueByKey(encodedParam, val) : iter->second(encodedParam, val);\
+                return false;
+            default:
+                return GetArrayValueByKey(encodedParam, val);
+        }
     }
 
     template<typename T, typename V>
@@ -425,54 +411,40 @@ private:
     }
 
     template<typename T>
-    bool GetBaseInfoValueByKey(const std::string& key, T& val)
+    bool GetBaseInfoValueByType(BaseInfoType type, T& val)
     {
-        std::unordered_map<std::string, std::function<bool(T&)>> parseFuncs;
-        parseFuncs.emplace(BASE_INFO_KEY_DOMAIN, [this] (T& val) -> bool {
-            return this->ParseValue(val, std::string(header_.domain));
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_NAME, [this] (T& val) -> bool {
-            return this->ParseValue(val, std::string(header_.name));
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_TYPE, [this] (T& val) -> bool {
-            int type = static_cast<int>(header_.type) + 1;
-            return this->ParseValue(val, type);
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_TIME_STAMP, [this] (T& val) -> bool {
-            return this->ParseValue(val, header_.timestamp);
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_TIME_ZONE, [this] (T& val) -> bool {
-            return this->ParseTimeZoneFromHeader(val);
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_ID, [this] (T& val) -> bool {
-            return this->ParseValue(val, header_.id);
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_PID, [this] (T& val) -> bool {
-            return this->ParseValue(val, header_.pid);
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_TID, [this] (T& val) -> bool {
-            return this->ParseValue(val, header_.tid);
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_UID, [this] (T& val) -> bool {
-            return this->ParseValue(val, header_.uid);
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_LOG, [this] (T& val) -> bool {
-            return this->ParseValue(val, header_.log);
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_TRACE_ID, [this] (T& val) -> bool {
-            return this->ParseAndSetTraceInfo(val, traceInfo_.traceId);
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_SPAN_ID, [this] (T& val) -> bool {
-            return this->ParseAndSetTraceInfo(val, traceInfo_.spanId);
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_PARENT_SPAN_ID, [this] (T& val) -> bool {
-            return this->ParseAndSetTraceInfo(val, traceInfo_.pSpanId);
-        });
-        parseFuncs.emplace(BASE_INFO_KEY_TRACE_FLAG, [this] (T& val) -> bool {
-            return this->PareTraceFlagFromHeader(val);
-        });
-        auto iter = parseFuncs.find(key);
-        return (iter == parseFuncs.end()) ? false : iter->second(val);
+        switch (type) {
+            case BaseInfoType::KEY_DOMAIN:
+                return ParseValue(val, std::string(header_.domain));
+            case BaseInfoType::KEY_NAME:
+                return ParseValue(val, std::string(header_.name));
+            case BaseInfoType::KEY_TYPE:
+                return ParseValue(val, static_cast<int>(header_.type) + 1);
+            case BaseInfoType::KEY_TIME_STAMP:
+                return ParseValue(val, header_.timestamp);
+            case BaseInfoType::KEY_TIME_ZONE:
+                return ParseTimeZoneFromHeader(val);
+            case BaseInfoType::KEY_ID:
+                return ParseValue(val, header_.id);
+            case BaseInfoType::KEY_PID:
+                return ParseValue(val, header_.pid);
+            case BaseInfoType::KEY_TID:
+                return ParseValue(val, header_.tid);
+            case BaseInfoType::KEY_UID:
+                return ParseValue(val, header_.uid);
+            case BaseInfoType::KEY_LOG:
+                return ParseValue(val, header_.log);
+            case BaseInfoType::KEY_TRACE_ID:
+                return ParseAndSetTraceInfo(val, traceInfo_.traceId);
+            case BaseInfoType::KEY_SPAN_ID:
+                return ParseAndSetTraceInfo(val, traceInfo_.spanId);
+            case BaseInfoType::KEY_PARENT_SPAN_ID:
+                return ParseAndSetTraceInfo(val, traceInfo_.pSpanId);
+            case BaseInfoType::KEY_TRACE_FLAG:
+                return PareTraceFlagFromHeader(val);
+            default:
+                return false;
+        }
     }
 
     template<typename T, typename V>
@@ -539,14 +511,10 @@ private:
         .pSpanId = 0,
     };
     std::list<std::shared_ptr<EncodedParam>> allParams_;
+    // index of the params in allParams_ by key
+    std::unordered_map<std::string, std::list<std::shared_ptr<EncodedParam>>::iterator> paramIndex_;
     std::mutex paramsOptMtx_;
 };
-extern template void RawDataBuilder::InitIdInfoAppendHandlers<char const*>(
-    std::unordered_map<std::string, std::function<RawDataBuilder&(char const*)>>&);
-extern template void RawDataBuilder::InitIdInfoAppendHandlers<std::string>(
-    std::unordered_map<std::string, std::function<RawDataBuilder&(std::string)>>&);
-extern template void RawDataBuilder::InitIdInfoAppendHandlers<uint64_t>(
-    std::unordered_map<std::string, std::function<RawDataBuilder&(uint64_t)>>&);
 extern template RawDataBuilder& RawDataBuilder::AppendValue<double>(const std::string&, double);
 extern template RawDataBuilder& RawDataBuilder::AppendValue<std::string>(const std::string&, std::string);
 extern template RawDataBuilder& RawDataBuilder::AppendValue<int64_t>(const std::string&, int64_t);
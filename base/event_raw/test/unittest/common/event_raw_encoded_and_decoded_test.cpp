@@ -15,11 +15,14 @@
 
 #include "event_raw_encoded_and_decoded_test.h"
 
+#include <chrono>
+#include <iostream>
 #include <memory>
 #include <vector>
 
 #include "decoded/decoded_event.h"
 #include "decoded/decoded_param.h"
+#include "decoded/decoded_param_cursor.h"
 #include "decoded/raw_data_decoder.h"
 #include "encoded/encoded_param.h"
 #include "encoded/raw_data_builder_json_parser.h"
@@ -911,5 +914,144 @@ HWTEST_F(EventRawEncodedTest, RawDataBuilderTest002, testing::ext::TestSize.Leve
     ASSERT_TRUE(builder->IsBaseInfo("domain_")); // test value
     ASSERT_TRUE(!builder->IsBaseInfo("TEST_KEY")); // test value
 }
+
+/**
+ * @tc.name: RawDataBuilderTest003
+ * @tc.desc: Test base info dispatch and param index of RawDataBuilder class
+ * @tc.type: FUNC
+ * @tc.require: issueI7X274
+ */
+HWTEST_F(EventRawEncodedTest, RawDataBuilderTest003, testing::ext::TestSize.Level1)
+{
+    RawDataBuilder builder;
+    builder.AppendValue("domain_", std::string("DEMO")).AppendValue("name_", std::string("EVENT_NAME_A"));
+    builder.AppendValue("pid_", static_cast<uint64_t>(100)); // test value
+    builder.AppendValue("traceid_", std::string("a1b2"));
+    builder.AppendValue("PARAM_A", static_cast<int64_t>(1)).AppendValue("PARAM_B", std::string("abc"));
+    builder.AppendValue("PARAM_C", 3.4); // test value
+    ASSERT_EQ(builder.GetDomain(), "DEMO");
+    ASSERT_EQ(builder.GetHeader().pid, 100); // test value
+    ASSERT_EQ(builder.GetTraceInfo().traceId, 0xa1b2); // test value
+    ASSERT_EQ(builder.GetParamCnt(), 3); // test value
+    ASSERT_TRUE(builder.GetValue("pid_") == nullptr);
+
+    uint64_t pid = 0;
+    ASSERT_TRUE(builder.ParseValueByKey("pid_", pid));
+    ASSERT_EQ(pid, 100); // test value
+    std::string traceId;
+    ASSERT_TRUE(builder.ParseValueByKey("traceid_", traceId));
+    ASSERT_EQ(traceId, "a1b2");
+
+    // the replaced param keeps its position
+    builder.AppendValue("PARAM_A", static_cast<int64_t>(2)); // test value
+    ASSERT_EQ(builder.GetParamCnt(), 3); // test value
+    int64_t paramA = 0;
+    ASSERT_TRUE(builder.ParseValueByKey("PARAM_A", paramA));
+    ASSERT_EQ(paramA, 2); // test value
+    builder.RemoveParam("PARAM_B");
+    ASSERT_TRUE(builder.GetValue("PARAM_B") == nullptr);
+    ASSERT_EQ(builder.GetParamCnt(), 2); // test value
+    auto rawData = builder.Build();
+    ASSERT_TRUE(rawData != nullptr);
+    DecodedEvent event(rawData->GetData(), rawData->GetDataLength());
+    ASSERT_TRUE(event.IsValid());
+    auto& params = event.GetAllCustomizedValues();
+    ASSERT_EQ(params.size(), 2); // test value
+    ASSERT_EQ(params[0]->GetKey(), "PARAM_A");
+    ASSERT_EQ(params[1]->GetKey(), "PARAM_C");
+}
+
+/**
+ * @tc.name: RawDataBuilderTest004
+ * @tc.desc: Test the time of building the raw data from the json event with the growing param count
+ * @tc.type: PERF
+ * @tc.require: issueI7X274
+ */
+HWTEST_F(EventRawEncodedTest, RawDataBuilderTest004, testing::ext::TestSize.Level1)
+{
+    constexpr int buildCnt = 2000; // test value
+    for (int paramCnt : { 8, 32, 128 }) { // 128 is the max param count of the written event
+        std::string rawSysEventStr = R"~({"domain_":"DEMO","name_":"EVENT_NAME_A","type_":4,"time_":1742021943126,)~";
+        rawSysEventStr.append(R"~("tz_":"+0800","pid_":92,"tid_":92,"uid_":0)~");
+        for (int i = 0; i < paramCnt; ++i) {
+            rawSysEventStr.append(",\"PARAM_").append(std::to_string(i)).append("\":").append(std::to_string(i));
+        }
+        rawSysEventStr.append("}");
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < buildCnt; ++i) {
+            auto builder = RawDataBuilderJsonParser(rawSysEventStr).Parse();
+            ASSERT_TRUE(builder != nullptr);
+            ASSERT_TRUE(builder->Build() != nullptr);
+        }
+        auto costTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+        std::cout << "build " << buildCnt << " events with " << paramCnt << " params cost " <<
+            costTime / buildCnt << " ns per event, " << costTime / buildCnt / paramCnt << " ns per param" << std::endl;
+
+        auto rawData = RawDataBuilderJsonParser(rawSysEventStr).Parse()->Build();
+        ASSERT_TRUE(rawData != nullptr);
+        DecodedEvent event(rawData->GetData(), rawData->GetDataLength());
+        ASSERT_TRUE(event.IsValid());
+        ASSERT_EQ(event.GetAllCustomizedValues().size(), static_cast<size_t>(paramCnt));
+    }
+}
+
+/**
+ * @tc.name: DecodedParamCursorTest001
+ * @tc.desc: Test api interfaces of DecodedParamCursor class
+ * @tc.type: FUNC
+ * @tc.require: issueI7X274
+ */
+HWTEST_F(EventRawEncodedTest, DecodedParamCursorTest001, testing::ext::TestSize.Level1)
+{
+    DecodedParamCursor cursor1(nullptr, 0);
+    ASSERT_TRUE(!cursor1.IsValid());
+    ASSERT_TRUE(!cursor1.Next());
+
+    std::string rawSysEventStr = R"~({"domain_":"DEMO","name_":"EVENT_NAME_A","type_":4,)~";
+    rawSysEventStr.append(R"~("PARAM_A":3.4,"UINT64_T":18446744073709551610,"INT64_T":-9223372036854775800,)~");
+    rawSysEventStr.append(R"~("PARAM_B":["123","456","789"],"PARAM_C":[],"PARAM_D":"abc"})~");
+    auto parser = std::make_shared<RawDataBuilderJsonParser>(rawSysEventStr);
+    ASSERT_TRUE(parser != nullptr);
+    auto builder = parser->Parse();
+    ASSERT_TRUE(builder != nullptr);
+    auto rawData = builder->Build();
+    ASSERT_TRUE(rawData != nullptr);
+    DecodedEvent event(rawData->GetData(), rawData->GetDataLength());
+    ASSERT_TRUE(event.IsValid());
+    DecodedParamCursor cursor2(rawData->GetData(), rawData->GetDataLength());
+    ASSERT_TRUE(cursor2.IsValid());
+    for (auto& param : event.GetAllCustomizedValues()) {
+        ASSERT_TRUE(cursor2.Next());
+        ASSERT_TRUE(cursor2.IsKeyOf(param->GetKey()));
+        ASSERT_EQ(cursor2.GetDataCodedType(), param->GetDataCodedType());
+    }
+    ASSERT_TRUE(!cursor2.Next());
+    ASSERT_TRUE(cursor2.IsValid());
+
+    DecodedParamCursor cursor3(rawData->GetData(), rawData->GetDataLength());
+    ASSERT_TRUE(cursor3.Next());
+    double dVal = 0;
+    ASSERT_TRUE(cursor3.AsDouble(dVal));
+    ASSERT_EQ(dVal, 3.4); // test value
+    ASSERT_TRUE(cursor3.Next());
+    uint64_t uVal = 0;
+    ASSERT_TRUE(cursor3.AsUint64(uVal));
+    ASSERT_EQ(uVal, 18446744073709551610ULL); // test value
+    ASSERT_TRUE(cursor3.Next());
+    int64_t iVal = 0;
+    ASSERT_TRUE(!cursor3.AsUint64(uVal));
+    ASSERT_TRUE(cursor3.AsInt64(iVal));
+    ASSERT_EQ(iVal, -9223372036854775800LL); // test value
+    ASSERT_TRUE(cursor3.Next());
+    std::string sVal;
+    ASSERT_TRUE(cursor3.IsKeyOf("PARAM_B"));
+    ASSERT_TRUE(!cursor3.AsString(sVal));
+    ASSERT_TRUE(cursor3.Next());
+    ASSERT_TRUE(cursor3.Next());
+    ASSERT_TRUE(cursor3.IsKeyOf("PARAM_D"));
+    ASSERT_TRUE(cursor3.AsString(sVal));
+    ASSERT_EQ(sVal, "abc");
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
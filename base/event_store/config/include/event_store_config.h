@@ -17,7 +17,9 @@
 #define HIVIEW_BASE_EVENT_STORE_CONFIG_EVENT_STORE_CONFIG_H
 
 #include <cstdint>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "singleton.h"
 
@@ -33,6 +35,11 @@ public:
     uint32_t GetMaxFileNum(int eventType);
     uint32_t GetPageSize(int eventType);
     uint32_t GetMaxFileSize(int eventType);
+    uint32_t GetMaxStagedSize(int eventType);
+    uint32_t GetMaxStagedDelay(int eventType);
+    // the smallest non-zero staged delay of all event types, 0 if no event is staged
+    uint32_t GetMinStagedDelay();
+    std::vector<std::string> GetIndexedParams(const std::string& domain);
 
 private:
     struct StoreConfig {
@@ -41,11 +48,14 @@ private:
         uint32_t maxFileSize;
         uint32_t maxFileNum;
         uint32_t maxSize;
+        uint32_t maxStagedSize;
+        uint32_t maxStagedDelay;
     };
     void Init();
     bool Contain(int eventType);
 
     std::unordered_map<int, StoreConfig> configMap_;
+    std::unordered_map<std::string, std::vector<std::string>> indexedParamsMap_;
 };
 } // EventStore
 } // HiviewDFX
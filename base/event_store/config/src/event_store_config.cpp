@@ -28,6 +28,9 @@ const char KEY_PAGE_SIZE[] = "PageSize";
 const char KEY_MAX_SIZE[] = "MaxSize";
 const char KEY_MAX_FILE_NUM[] = "MaxFileNum";
 const char KEY_MAX_FILE_SIZE[] = "MaxFileSize";
+const char KEY_MAX_STAGED_SIZE[] = "MaxStagedSize";
+const char KEY_MAX_STAGED_DELAY[] = "MaxStagedDelay";
+const char KEY_INDEXED_PARAMS[] = "IndexedParams";
 const std::map<std::string, int> EVENT_TYPE_MAP = {
     {"FAULT", 1}, {"STATISTIC", 2}, {"SECURITY", 3}, {"BEHAVIOR", 4}
 };
@@ -36,6 +39,30 @@ uint32_t ParseUint32(const Json::Value& root, const std::string& key)
 {
     return (root.isMember(key) && root[key].isUInt()) ? root[key].asUInt() : 0;
 }
+
+void ParseIndexedParams(const Json::Value& root,
+    std::unordered_map<std::string, std::vector<std::string>>& indexedParamsMap)
+{
+    if (!root.isMember(KEY_INDEXED_PARAMS) || !root[KEY_INDEXED_PARAMS].isObject()) {
+        return;
+    }
+    const Json::Value& indexedRoot = root[KEY_INDEXED_PARAMS];
+    std::vector<std::string> domains = indexedRoot.getMemberNames();
+    for (const auto& domain : domains) {
+        if (!indexedRoot[domain].isArray()) {
+            continue;
+        }
+        std::vector<std::string> params;
+        for (const auto& param : indexedRoot[domain]) {
+            if (param.isString() && !param.asString().empty()) {
+                params.emplace_back(param.asString());
+            }
+        }
+        if (!params.empty()) {
+            indexedParamsMap.emplace(domain, params);
+        }
+    }
+}
 }
 EventStoreConfig::EventStoreConfig()
 {
@@ -68,10 +95,13 @@ void EventStoreConfig::Init()
                 .maxFileSize = ParseUint32(node, KEY_MAX_FILE_SIZE),
                 .maxFileNum = ParseUint32(node, KEY_MAX_FILE_NUM),
                 .maxSize = ParseUint32(node, KEY_MAX_SIZE),
+                .maxStagedSize = ParseUint32(node, KEY_MAX_STAGED_SIZE),
+                .maxStagedDelay = ParseUint32(node, KEY_MAX_STAGED_DELAY),
             };
             configMap_.emplace(EVENT_TYPE_MAP.at(*iter), config);
         }
     }
+    ParseIndexedParams(root, indexedParamsMap_);
 }
 
 bool EventStoreConfig::Contain(int eventType)
@@ -103,6 +133,34 @@ uint32_t EventStoreConfig::GetMaxFileSize(int eventType)
 {
     return Contain(eventType) ? configMap_[eventType].maxFileSize : 0;
 }
+
+uint32_t EventStoreConfig::GetMaxStagedSize(int eventType)
+{
+    return Contain(eventType) ? configMap_[eventType].maxStagedSize : 0;
+}
+
+uint32_t EventStoreConfig::GetMaxStagedDelay(int eventType)
+{
+    return Contain(eventType) ? configMap_[eventType].maxStagedDelay : 0;
+}
+
+uint32_t EventStoreConfig::GetMinStagedDelay()
+{
+    uint32_t minStagedDelay = 0;
+    for (const auto& config : configMap_) {
+        uint32_t stagedDelay = config.second.maxStagedDelay;
+        if (stagedDelay > 0 && (minStagedDelay == 0 || stagedDelay < minStagedDelay)) {
+            minStagedDelay = stagedDelay;
+        }
+    }
+    return minStagedDelay;
+}
+
+std::vector<std::string> EventStoreConfig::GetIndexedParams(const std::string& domain)
+{
+    auto iter = indexedParamsMap_.find(domain);
+    return iter == indexedParamsMap_.end() ? std::vector<std::string>() : iter->second;
+}
 } // EventStore
 } // HiviewDFX
 } // OHOS
@@ -14,9 +14,10 @@
 */
 #include "doc_query.h"
 
+#include <algorithm>
 #include <set>
 
-#include "decoded/decoded_event.h"
+#include "decoded/decoded_param_cursor.h"
 #include "hiview_logger.h"
 #include "sys_event_query.h"
 
@@ -24,6 +25,9 @@ namespace OHOS {
 namespace HiviewDFX {
 namespace EventStore {
 DEFINE_LOG_TAG("HiView-DocQuery");
+namespace {
+constexpr size_t MAX_EXTRA_COND_NUM_PER_WALK = 64;
+}
 
 void DocQuery::And(const Cond& cond)
 {
@@ -103,36 +107,122 @@ bool DocQuery::IsContainInnerConds(uint8_t* content) const
     });
 }
 
+bool DocQuery::IsRangeContainCond(const Cond& cond, int64_t minValue, int64_t maxValue) const
+{
+    FieldValue minFieldValue = minValue;
+    FieldValue maxFieldValue = maxValue;
+    switch (cond.op_) {
+        case EQ:
+            return minFieldValue <= cond.fieldValue_ && maxFieldValue >= cond.fieldValue_;
+        case GT:
+            return maxFieldValue > cond.fieldValue_;
+        case GE:
+            return maxFieldValue >= cond.fieldValue_;
+        case LT:
+            return minFieldValue < cond.fieldValue_;
+        case LE:
+            return minFieldValue <= cond.fieldValue_;
+        default:
+            return true;
+    }
+}
+
+bool DocQuery::IsContainInnerConds(const PageSummary& summary) const
+{
+    if (summary.eventNum == 0) {
+        return false;
+    }
+    return std::all_of(innerConds_.begin(), innerConds_.end(), [this, &summary] (auto& cond) {
+        if (cond.col_ == EventCol::SEQ) {
+            return IsRangeContainCond(cond, summary.minSeq, summary.maxSeq);
+        }
+        if (cond.col_ == EventCol::TS) {
+            return IsRangeContainCond(cond, summary.minTs, summary.maxTs);
+        }
+        return true;
+    });
+}
+
 bool DocQuery::IsContainExtraConds(uint8_t* content, size_t len) const
 {
     if (extraConds_.empty()) {
         return true;
     }
-    EventRaw::DecodedEvent decodedEvent(content, len);
-    return std::all_of(extraConds_.begin(), extraConds_.end(), [this, &decodedEvent] (auto& cond) {
-        const auto& extraParams = decodedEvent.GetAllCustomizedValues();
-        for (auto& param : extraParams) {
-            if (cond.col_ != param->GetKey()) {
+    return IsContainExtraConds(EventRaw::DecodedParamCursor(content, len));
+}
+
+bool DocQuery::IsContainExtraConds(const EventRaw::DecodedParamCursor& cursor) const
+{
+    if (extraConds_.empty()) {
+        return true;
+    }
+    // the matched state of the conditions is kept in a bit mask, so walk the params once every 64 conditions
+    for (size_t begin = 0; begin < extraConds_.size(); begin += MAX_EXTRA_COND_NUM_PER_WALK) {
+        size_t end = std::min(begin + MAX_EXTRA_COND_NUM_PER_WALK, extraConds_.size());
+        if (!IsContainExtraConds(cursor, begin, end)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DocQuery::IsContainExtraConds(EventRaw::DecodedParamCursor cursor, size_t begin, size_t end) const
+{
+    const size_t condNum = end - begin;
+    uint64_t matchedMask = 0;
+    size_t matchedNum = 0;
+    while (matchedNum < condNum && cursor.Next()) {
+        for (size_t i = 0; i < condNum; ++i) {
+            uint64_t condBit = 1ULL << i;
+            if ((matchedMask & condBit) != 0 || !cursor.IsKeyOf(extraConds_[begin + i].col_)) {
                 continue;
             }
+            // only the first param with the key is compared
             FieldValue paramValue;
-            if (int64_t intValue = 0; param->AsInt64(intValue)) {
-                paramValue = intValue;
-            } else if (uint64_t uintValue = 0; param->AsUint64(uintValue)) {
-                paramValue = uintValue;
-            } else if (double dValue = 0; param->AsDouble(dValue)) {
-                paramValue = dValue;
-            } else if (std::string sValue; param->AsString(sValue)) {
-                paramValue = sValue;
-            } else {
+            if (!GetParamValue(cursor, paramValue) || !IsContainCond(extraConds_[begin + i], paramValue)) {
                 return false;
             }
-            return IsContainCond(cond, paramValue);
+            matchedMask |= condBit;
+            ++matchedNum;
         }
-        return false;
+    }
+    return matchedNum == condNum;
+}
+
+bool DocQuery::HasExtraCondsOnAppendedParams() const
+{
+    return std::any_of(extraConds_.begin(), extraConds_.end(), [] (auto& cond) {
+        return cond.col_ == EventCol::LEVEL || cond.col_ == EventCol::TAG;
     });
 }
 
+bool DocQuery::GetParamValue(const EventRaw::DecodedParamCursor& cursor, FieldValue& value)
+{
+    if (int64_t intValue = 0; cursor.AsInt64(intValue)) {
+        value = intValue;
+    } else if (uint64_t uintValue = 0; cursor.AsUint64(uintValue)) {
+        value = uintValue;
+    } else if (double dValue = 0; cursor.AsDouble(dValue)) {
+        value = dValue;
+    } else if (std::string sValue; cursor.AsString(sValue)) {
+        value = sValue;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::vector<std::pair<std::string, FieldValue>> DocQuery::GetEqualConds(const std::vector<std::string>& cols) const
+{
+    std::vector<std::pair<std::string, FieldValue>> equalConds;
+    for (const auto& cond : extraConds_) {
+        if (cond.op_ == EQ && std::find(cols.begin(), cols.end(), cond.col_) != cols.end()) {
+            equalConds.emplace_back(cond.col_, cond.fieldValue_);
+        }
+    }
+    return equalConds;
+}
+
 std::string DocQuery::ToString() const
 {
     std::string output;
@@ -16,6 +16,7 @@
 
 #include <cinttypes>
 
+#include "event_store_config.h"
 #include "file_util.h"
 #include "hisysevent_util.h"
 #include "hiview_logger.h"
@@ -108,6 +109,7 @@ void SysEventDao::ClearDirtyEventFiles()
     }
     SysEventBackup backup(BACKUP_DIR);
     std::string clearResult = backup.ClearDirtyEventFiles(GetDatabaseDir());
+    SysEventDatabase::GetInstance().ReloadFileCatalog();
     int createFlagRet = FileUtil::CreateFile(DIRTY_EVENT_CLEAR_FLAG_PATH);
     Parameter::SetProperty(DIRTY_EVENT_CLEARED_PROP, "true");
     HiSysEventParam params[] = {
@@ -124,6 +126,16 @@ void SysEventDao::Clear()
     SysEventDatabase::GetInstance().Clear();
 }
 
+void SysEventDao::Flush()
+{
+    SysEventDatabase::GetInstance().Flush();
+}
+
+uint32_t SysEventDao::GetFlushInterval()
+{
+    return EventStoreConfig::GetInstance().GetMinStagedDelay();
+}
+
 std::string SysEventDao::GetDatabaseDir()
 {
     return SysEventDatabase::GetInstance().GetDatabaseDir();
@@ -16,6 +16,7 @@
 #ifndef HIVIEW_BASE_EVENT_STORE_INCLUDE_BASE_DEF_H
 #define HIVIEW_BASE_EVENT_STORE_INCLUDE_BASE_DEF_H
 
+#include <cstdint>
 #include <string>
 
 namespace OHOS {
@@ -116,6 +117,15 @@ using DocHeader = struct DocHeader;
 
 #pragma pack()
 
+/* Range of the events in one page, lets the reader skip the pages out of the queried range */
+struct PageSummary {
+    int64_t minSeq = INT64_MAX;
+    int64_t maxSeq = INT64_MIN;
+    int64_t minTs = INT64_MAX;
+    int64_t maxTs = INT64_MIN;
+    uint32_t eventNum = 0;
+};
+
 } // EventStore
 } // HiviewDFX
 } // OHOS
@@ -16,9 +16,16 @@
 #define HIVIEW_BASE_EVENT_STORE_INCLUDE_DOC_QUERY_H
 
 #include <string>
+#include <utility>
+#include <vector>
+
+#include "base_def.h"
 
 namespace OHOS {
 namespace HiviewDFX {
+namespace EventRaw {
+class DecodedParamCursor;
+}
 namespace EventStore {
 class Cond;
 class FieldValue;
@@ -28,9 +35,19 @@ public:
     std::pair<std::string, bool> GetOrderField();
     void And(const Cond& cond);
     bool IsContainExtraConds(uint8_t* content, size_t len) const;
+    bool IsContainExtraConds(const EventRaw::DecodedParamCursor& cursor) const;
+    // the level and the tag are appended to the params only when the raw data is built from the stored content
+    bool HasExtraCondsOnAppendedParams() const;
     bool IsContainInnerConds(uint8_t* content) const;
+    // false if none of the events in the range can match the inner conditions
+    bool IsContainInnerConds(const PageSummary& summary) const;
+    // the values of the equality conditions on the given params, in the order of the conditions
+    std::vector<std::pair<std::string, FieldValue>> GetEqualConds(const std::vector<std::string>& cols) const;
     std::string ToString() const;
 
+public:
+    static bool GetParamValue(const EventRaw::DecodedParamCursor& cursor, FieldValue& value);
+
 private:
 #pragma pack(1)
     /* for internal field query */
@@ -47,6 +64,8 @@ private:
 
     bool IsContainInnerCond(const InnerFieldStruct& innerField, const Cond& cond) const;
     bool IsContainCond(const Cond& cond, const FieldValue& value) const;
+    bool IsContainExtraConds(EventRaw::DecodedParamCursor cursor, size_t begin, size_t end) const;
+    bool IsRangeContainCond(const Cond& cond, int64_t minValue, int64_t maxValue) const;
     bool IsInnerCond(const Cond& cond) const;
 
     std::vector<Cond> innerConds_;
@@ -44,6 +44,8 @@ public:
     static void Restore();
     static std::string GetDatabaseDir();
     static void Clear();
+    static void Flush();
+    static uint32_t GetFlushInterval();
     static void ClearDirtyEventFiles();
 }; // SysEventDao
 } // EventStore
@@ -17,6 +17,8 @@
 #define BASE_EVENT_STORE_SYS_EVENT_SEQ_MGR_H
 
 #include <atomic>
+#include <mutex>
+#include <string>
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -27,6 +29,7 @@ constexpr char SEQ_PERSISTS_BACKUP_FILE_NAME[] = "event_sequence_backup";
 class SysEventSequenceManager {
 public:
     static SysEventSequenceManager& GetInstance();
+    int64_t AllocSequence();
     void SetSequence(int64_t seq);
     int64_t GetSequence();
     int64_t GetStartSequence();
@@ -36,12 +39,15 @@ private:
    ~SysEventSequenceManager() = default;
 
 private:
+    void ReserveSequence(int64_t seq);
     void WriteSeqToFile(int64_t seq);
     void ReadSeqFromFile(int64_t& seq);
     std::string GetSequenceFile() const;
 
 private:
     std::atomic<int64_t> curSeq_ = 0;
+    std::atomic<int64_t> reservedSeq_ = 0; // the sequences below it are safe to be allocated without persisting
+    std::mutex reserveMutex_;
     int64_t startSeq_ = 0; // keep the initial sequence when hiview started, for event restore use
 };
 } // namespace EventStore
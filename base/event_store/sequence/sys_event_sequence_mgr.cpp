@@ -15,7 +15,11 @@
 
 #include "sys_event_sequence_mgr.h"
 
-#include <fstream>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "event_db_file_util.h"
 #include "file_util.h"
@@ -34,23 +38,38 @@ namespace {
 DEFINE_LOG_TAG("HiView-SysEventSeqMgr");
 constexpr int64_t SEQ_INCREMENT = 100; // increment of seq each time it is read from the file
 
-bool SaveStringToFile(const std::string& filePath, const std::string& content)
+const char SEQ_TMP_FILE_SUFFIX[] = ".tmp";
+
+bool SyncDir(const std::string& dir)
 {
-    std::ofstream file;
-    file.open(filePath.c_str(), std::ios::in | std::ios::out);
-    if (!file.is_open()) {
-        file.open(filePath.c_str(), std::ios::out);
-        if (!file.is_open()) {
-            return false;
-        }
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
     }
-    file.seekp(0);
-    file.write(content.c_str(), content.length() + 1);
-    bool ret = !file.fail();
-    file.close();
+    bool ret = (fsync(fd) == 0);
+    close(fd);
     return ret;
 }
 
+// the content is written to a temporary file and renamed to the target, so the target is never torn
+bool SaveStringToFile(const std::string& filePath, const std::string& content)
+{
+    std::string tmpFilePath = filePath + SEQ_TMP_FILE_SUFFIX;
+    int fd = open(tmpFilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        return false;
+    }
+    size_t contentLen = content.length() + 1; // keep the '\0' as before
+    bool ret = (write(fd, content.c_str(), contentLen) == static_cast<ssize_t>(contentLen)) && (fsync(fd) == 0);
+    close(fd);
+    if (!ret || rename(tmpFilePath.c_str(), filePath.c_str()) != 0) {
+        HIVIEW_LOGE("failed to save %{public}s, errno=%{public}d", filePath.c_str(), errno);
+        (void)unlink(tmpFilePath.c_str());
+        return false;
+    }
+    return SyncDir(FileUtil::ExtractFilePath(filePath));
+}
+
 inline std::string GetSequenceBackupFile()
 {
     return EventStore::SysEventDao::GetDatabaseDir() + SEQ_PERSISTS_BACKUP_FILE_NAME;
@@ -64,13 +83,21 @@ void WriteEventSeqToFile(int64_t seq, const std::string& file)
     }
 }
 
-inline void ReadEventSeqFromFile(int64_t& seq, const std::string& file)
+bool ReadEventSeqFromFile(int64_t& seq, const std::string& file)
 {
     std::string content;
     if (!FileUtil::LoadStringFromFile(file, content)) {
         HIVIEW_LOGE("failed to read sequence value from %{public}s", file.c_str());
+        return false;
+    }
+    char* end = nullptr;
+    seq = static_cast<int64_t>(strtoll(content.c_str(), &end, 0));
+    if (end == content.c_str() || seq < 0) {
+        HIVIEW_LOGE("invalid sequence value in %{public}s", file.c_str());
+        seq = 0;
+        return false;
     }
-    seq = static_cast<int64_t>(strtoll(content.c_str(), nullptr, 0));
+    return true;
 }
 
 void LogEventSeqReadException(int64_t seq, int64_t backupSeq)
@@ -99,14 +126,14 @@ void WriteSeqReadExceptionEvent(bool isSeqFileExist, int64_t seq, bool isSeqBack
     }
 }
 
-void CheckFileExistThenReadSeq(const std::string& filePath, bool& isFileExist, int64_t& seq)
+bool CheckFileExistThenReadSeq(const std::string& filePath, bool& isFileExist, int64_t& seq)
 {
     isFileExist = FileUtil::FileExists(filePath);
     if (!isFileExist) {
         HIVIEW_LOGI("%{public}s is not exist", filePath.c_str());
-        return;
+        return false;
     }
-    ReadEventSeqFromFile(seq, filePath);
+    return ReadEventSeqFromFile(seq, filePath);
 }
 
 void UpdateFileInfos(std::map<std::string, std::pair<int64_t, std::string>>& dbFileInfos,
@@ -176,7 +203,7 @@ int64_t GetEventMaxSeqFromLocalDbFiles()
     std::vector<std::string> eventDbFiles;
     GetEventMaxSeqFileList(eventDbFiles);
     for (const auto& eventDbFile : eventDbFiles) {
-        SysEventDocReader reader(eventDbFile);
+        SysEventDocReader reader(eventDbFile, true);
         int64_t curSeq = reader.ReadMaxEventSequence();
         if (seq < curSeq) {
             seq = curSeq;
@@ -204,18 +231,38 @@ SysEventSequenceManager::SysEventSequenceManager()
     ReadSeqFromFile(seq);
     startSeq_ = seq + SEQ_INCREMENT;
     HIVIEW_LOGI("start seq=%{public}" PRId64, startSeq_);
-    WriteSeqToFile(startSeq_);
     curSeq_.store(startSeq_, std::memory_order_release);
+    ReserveSequence(startSeq_);
+}
+
+int64_t SysEventSequenceManager::AllocSequence()
+{
+    int64_t seq = curSeq_.fetch_add(1, std::memory_order_acq_rel);
+    if (seq >= reservedSeq_.load(std::memory_order_acquire)) {
+        ReserveSequence(seq);
+    }
+    return seq;
 }
 
 void SysEventSequenceManager::SetSequence(int64_t seq)
 {
     curSeq_.store(seq, std::memory_order_release);
-    static int64_t setCount = 0;
-    ++setCount;
-    if (setCount % SEQ_INCREMENT == 0) {
-        WriteSeqToFile(seq);
+    if (seq >= reservedSeq_.load(std::memory_order_acquire)) {
+        ReserveSequence(seq);
+    }
+}
+
+void SysEventSequenceManager::ReserveSequence(int64_t seq)
+{
+    std::lock_guard<std::mutex> lock(reserveMutex_);
+    if (seq < reservedSeq_.load(std::memory_order_acquire)) {
+        return; // already reserved by another thread
     }
+
+    // the sequences below the persisted value plus SEQ_INCREMENT are reserved, so the sequence read
+    // from the file on next start is always beyond the ones allocated before
+    WriteSeqToFile(seq);
+    reservedSeq_.store(seq + SEQ_INCREMENT, std::memory_order_release);
 }
 
 int64_t SysEventSequenceManager::GetSequence()
@@ -238,29 +285,28 @@ void SysEventSequenceManager::ReadSeqFromFile(int64_t& seq)
 {
     std::string seqFilePath = GetSequenceFile();
     bool isSeqFileExist = false;
-    CheckFileExistThenReadSeq(seqFilePath, isSeqFileExist, seq);
+    bool isSeqValid = CheckFileExistThenReadSeq(seqFilePath, isSeqFileExist, seq);
     std::string seqBackupFilePath = GetSequenceBackupFile();
     bool isSeqBackupFileExist = false;
     int64_t seqBackup = 0;
-    CheckFileExistThenReadSeq(seqBackupFilePath, isSeqBackupFileExist, seqBackup);
-    if ((seq == seqBackup) && (!isSeqFileExist || seq != 0)) {
+    bool isSeqBackupValid = CheckFileExistThenReadSeq(seqBackupFilePath, isSeqBackupFileExist, seqBackup);
+
+    // the sequence files are replaced atomically and the backup one is written later, so any valid one
+    // is reliable and the greater one is the latest
+    if (isSeqValid || isSeqBackupValid) {
+        seq = std::max(seq, seqBackup);
         HIVIEW_LOGI("succeed to read event sequence, value is %{public}" PRId64 "", seq);
         return;
     }
-    LogEventSeqReadException(seq, seqBackup);
-    HIVIEW_LOGW("seq[%{public}" PRId64 "] is different with backup seq[%{public}" PRId64 "]", seq, seqBackup);
-    if ((seq - seqBackup) == SEQ_INCREMENT) {
-        HIVIEW_LOGI("valid diff between seq and back up seq");
-    } else {
-        int64_t seqReadFromLocalFile = GetEventMaxSeqFromLocalDbFiles();
-        WriteSeqReadExceptionEvent(isSeqFileExist, seq, isSeqBackupFileExist, seqBackup, seqReadFromLocalFile);
-        seq = seqReadFromLocalFile;
-        WriteEventSeqToFile(seq, seqFilePath);
-        HIVIEW_LOGI("adjust seq to %{public}" PRId64, seq);
+    if (!isSeqFileExist && !isSeqBackupFileExist) {
+        HIVIEW_LOGI("no event sequence file, first start");
+        return;
     }
-    seqBackup = seq;
-    WriteEventSeqToFile(seq, seqBackupFilePath);
-    HIVIEW_LOGI("adjust backup seq to %{public}" PRId64, seqBackup);
+    LogEventSeqReadException(seq, seqBackup);
+    int64_t seqReadFromLocalFile = GetEventMaxSeqFromLocalDbFiles();
+    WriteSeqReadExceptionEvent(isSeqFileExist, seq, isSeqBackupFileExist, seqBackup, seqReadFromLocalFile);
+    seq = seqReadFromLocalFile;
+    HIVIEW_LOGI("adjust seq to %{public}" PRId64, seq);
 }
 
 std::string SysEventSequenceManager::GetSequenceFile() const
@@ -16,6 +16,7 @@
 #ifndef HIVIEW_BASE_EVENT_STORE_SYS_EVENT_DATABASE_H
 #define HIVIEW_BASE_EVENT_STORE_SYS_EVENT_DATABASE_H
 
+#include <atomic>
 #include <queue>
 #include <memory>
 #include <shared_mutex>
@@ -26,6 +27,7 @@
 #include "singleton.h"
 #include "sys_event_query.h"
 #include "sys_event_doc_lru_cache.h"
+#include "sys_event_file_catalog.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -36,15 +38,18 @@ public:
     ~SysEventDatabase();
     int Insert(const std::shared_ptr<SysEvent>& sysEvent);
     void Clear();
+    void Flush();
     int Query(SysEventQuery& query, EntryQueue& entries);
     void CheckRepeat(SysEvent& event);
     std::string GetDatabaseDir();
     bool Backup(const std::string& zipFilePath);
     bool Restore(const std::string& zipFilePath, const std::string& restoreDir);
+    SysEventFileCatalog& GetFileCatalog();
+    void ReloadFileCatalog();
 
 private:
-    using FileQueue = std::priority_queue<std::string, std::vector<std::string>,
-        bool(*)(const std::string&, const std::string&)>;
+    using FileQueue = std::priority_queue<SysEventFileInfoPtr, std::vector<SysEventFileInfoPtr>,
+        bool(*)(const SysEventFileInfoPtr&, const SysEventFileInfoPtr&)>;
     // <eventType, <maxSize, maxFileNum>>
     using EventQuotaMap = std::unordered_map<int, std::pair<uint64_t, uint32_t>>;
     // <eventType, <totalFileSize, fileQueue that is normal, fileQueue that is over limit>>
@@ -52,17 +57,19 @@ private:
 
     void GetClearMap(ClearFilesMap& clearMap);
     void ClearCache();
+    void FlushStagedEvents();
     uint32_t GetMaxFileNum(int type);
     uint64_t GetMaxSize(int type);
     void GetQueryFiles(const SysEventQueryArg& queryArg, FileQueue& queryFiles);
-    void GetQueryDirsByDomain(const std::string& domain, std::vector<std::string>& queryDirs);
-    bool IsContainQueryArg(const std::string& file, const SysEventQueryArg& queryArg,
+    bool IsContainQueryArg(const SysEventFileInfo& fileInfo, const SysEventQueryArg& queryArg,
         std::unordered_map<std::string, long long>& nameSeqMap);
     int QueryByFiles(SysEventQuery& query, EntryQueue& entries, FileQueue& queryFiles);
 
     EventQuotaMap quotaMap_;
     std::unique_ptr<SysEventDocLruCache> lruCache_;
+    SysEventFileCatalog fileCatalog_;
     mutable std::shared_mutex mutex_;
+    std::atomic<bool> hasStagedEvents_ = false;
 }; // SysEventDatabase
 } // EventStore
 } // HiviewDFX
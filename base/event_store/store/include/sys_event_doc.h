@@ -35,13 +35,15 @@ public:
 
     int Insert(const std::shared_ptr<SysEvent>& sysEvent);
     int Query(const DocQuery& query, EntryQueue& entries, int& num);
+    int Flush();
+    bool HasStagedEvents() const;
 
 private:
     int InitWriter(const std::shared_ptr<SysEvent>& sysEvent);
     int InitReader();
     std::string CreateFile();
     std::string GetDir();
-    std::string GetCurFile(const std::string& dir);
+    std::string GetCurFile();
     uint32_t GetMaxFileSize();
     bool IsFileFull(const std::string& file);
     bool IsNeedUpdateCurFile();
@@ -40,6 +40,7 @@ public:
     bool Add(const LruCacheKey& key, const LruCacheValue& value);
     bool Remove(const LruCacheKey& key);
     void Clear();
+    void Flush();
 
 private:
     typedef std::pair<std::list<LruCacheKey>::iterator, LruCacheValue> LruCacheValuePair;
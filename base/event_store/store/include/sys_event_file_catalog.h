@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIVIEW_BASE_EVENT_STORE_SYS_EVENT_FILE_CATALOG_H
+#define HIVIEW_BASE_EVENT_STORE_SYS_EVENT_FILE_CATALOG_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "event_db_file_util.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventStore {
+struct SysEventFileInfo {
+    std::string path;
+    std::string domain;
+    // name, type, level, begin seq and report interval parsed from the file name
+    SplitedEventInfo eventInfo;
+};
+using SysEventFileInfoPtr = std::shared_ptr<const SysEventFileInfo>;
+// <file info, file size>
+using SysEventFileList = std::vector<std::pair<SysEventFileInfoPtr, uint64_t>>;
+
+/*
+ * In-memory catalog of the event files under the database directory. The directory tree is walked only
+ * once, after that the catalog is kept up to date by the doc writer and the clear path, so that selecting
+ * files for a query and accounting the quota need not touch the file system.
+ */
+class SysEventFileCatalog {
+public:
+    SysEventFileCatalog() = default;
+    ~SysEventFileCatalog() = default;
+
+    void Load(const std::string& dbDir);
+    void Invalidate();
+    bool AddFile(const std::string& domain, const std::string& file);
+    void MarkWritingFile(const std::string& domain, const std::string& file);
+    // called once all the writers are closed
+    void ResetWritingFiles();
+    uint64_t RemoveFile(const SysEventFileInfoPtr& info);
+    std::string GetLatestFile(const std::string& domain, const std::string& name);
+
+    // files grouped by domain, and sorted by seq in descending order within a domain
+    void GetFiles(const std::string& domain, SysEventFileList& files);
+    size_t GetFileCount();
+
+private:
+    struct FileEntry {
+        SysEventFileInfoPtr info;
+        uint64_t size = 0;
+        // the file may still grow, its size need to be refreshed before using
+        bool isWriting = false;
+    };
+    // <begin seq, file path>
+    using FileKey = std::pair<int64_t, std::string>;
+    using DomainFiles = std::map<FileKey, FileEntry, std::greater<FileKey>>;
+
+    void LoadDomain(const std::string& domainDir);
+    bool AddFileEntry(const std::string& domain, const std::string& file, uint64_t size, bool isWriting);
+    void AppendDomainFiles(DomainFiles& domainFiles, SysEventFileList& files);
+
+    std::string dbDir_;
+    bool isLoaded_ = false;
+    size_t fileCount_ = 0;
+    // <domain, files of the domain>
+    std::map<std::string, DomainFiles> files_;
+    std::mutex mutex_;
+}; // SysEventFileCatalog
+} // EventStore
+} // HiviewDFX
+} // OHOS
+#endif // HIVIEW_BASE_EVENT_STORE_SYS_EVENT_FILE_CATALOG_H
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SYS_EVENT_REPEAT_CACHE_H
+#define SYS_EVENT_REPEAT_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "singleton.h"
+#include "sys_event_repeat_db.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+struct SysEventRepeatCacheStats {
+    uint64_t hitCount = 0; // answered in memory
+    uint64_t missCount = 0; // answered by querying the db
+    uint64_t writeCount = 0; // records written to the db
+};
+
+/*
+ * Answers whether a fault event is repeated in memory. The happen time of the recent hashes are kept in a
+ * bounded lru, and all the hashes in the db are tracked by a bloom filter, so only the hashes which may be
+ * in the db but not in the lru need to query the db. The new happen time is written to the db in batches.
+ * The bloom filter is rebuilt from the db once per valid time window, so the hashes cleared from the db are
+ * dropped from it.
+ */
+class SysEventRepeatCache : public OHOS::DelayedRefSingleton<SysEventRepeatCache> {
+public:
+    SysEventRepeatCache();
+    ~SysEventRepeatCache() = default;
+    bool IsRepeat(SysEventHashRecord& record, int64_t minValidTime);
+    void Flush();
+    void Reset();
+    void Clear(int64_t happentime);
+    SysEventRepeatCacheStats GetStats();
+
+private:
+    struct LruItem {
+        std::list<std::string>::iterator iter;
+        int64_t happentime = 0;
+    };
+    bool IsBloomFilterExpired(int64_t minValidTime) const;
+    void LoadBloomFilter(int64_t minValidTime);
+    void AddToBloomFilter(const std::string& key);
+    bool MayContainInBloomFilter(const std::string& key) const;
+    void UpdateLru(const std::string& key, int64_t happentime);
+    void AddPendingRecord(const SysEventHashRecord& record);
+    void FlushPendingRecords();
+
+private:
+    std::mutex mutex_;
+    std::vector<uint64_t> bloomBits_;
+    bool isBloomLoaded_ = false;
+    int64_t bloomLoadTime_ = 0;
+    std::list<std::string> lruList_;
+    std::unordered_map<std::string, LruItem> lruMap_;
+    std::vector<SysEventHashRecord> pendingRecords_;
+    bool isFlushScheduled_ = false;
+    int64_t minValidTime_ = 0;
+    SysEventRepeatCacheStats stats_;
+};
+} // HiviewDFX
+} // OHOS
+#endif // SYS_EVENT_REPEAT_CACHE_H
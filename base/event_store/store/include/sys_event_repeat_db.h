@@ -18,6 +18,7 @@
 
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "rdb_store.h"
 #include "singleton.h"
@@ -40,6 +41,8 @@ public:
     bool Insert(const SysEventHashRecord &sysEventHashRecord);
     int64_t QueryHappentime(SysEventHashRecord &sysEventHashRecord);
     bool Update(const SysEventHashRecord &sysEventHashRecord);
+    bool BatchUpdate(const std::vector<SysEventHashRecord>& sysEventHashRecords);
+    void QueryRecords(const int64_t happentime, std::vector<SysEventHashRecord>& sysEventHashRecords);
     void CheckAndClearDb(const int64_t happentime);
     void Clear(const int64_t happentime);
     void Release();
@@ -47,6 +50,8 @@ public:
 private:
     bool CheckDbStoreValid();
     void InitDbStore();
+    bool InsertRecord(const SysEventHashRecord &sysEventHashRecord);
+    bool UpdateRecord(const SysEventHashRecord &sysEventHashRecord, int& updateRowNum);
     void ClearHistory(const int64_t happentime);
     void RefreshDbCount();
     void CheckAndRepairDbFile(const int32_t errCode);
@@ -14,6 +14,7 @@
  */
 #include "sys_event_database.h"
 
+#include <algorithm>
 #include <sstream>
 #include <unordered_map>
 
@@ -24,8 +25,9 @@
 #include "hiview_global.h"
 #include "hiview_logger.h"
 #include "hiview_zip_util.h"
-#include "string_util.h"
 #include "sys_event_dao.h"
+#include "sys_event_page_summary.h"
+#include "sys_event_param_index.h"
 #include "sys_event_sequence_mgr.h"
 #include "sys_event_repeat_guard.h"
 
@@ -40,43 +42,14 @@ constexpr size_t INDEX_FILE_SIZE = 0;
 constexpr size_t INDEX_NORMAL_QUEUE = 1;
 constexpr size_t INDEX_LIMIT_QUEUE = 2;
 
-int64_t GetFileSeq(const std::string& file)
+bool CompareFileLessFunc(const SysEventFileInfoPtr& fileA, const SysEventFileInfoPtr& fileB)
 {
-    std::string fileName(FileUtil::ExtractFileName(file));
-    SplitedEventInfo eventInfo;
-    if (!EventDbFileUtil::ParseEventInfoFromDbFileName(fileName, eventInfo, SEQ_ONLY)) {
-        HIVIEW_LOGD("failed to parse event info from: %{public}s", fileName.c_str());
-        return 0;
-    }
-    return eventInfo.seq;
+    return fileA->eventInfo.seq < fileB->eventInfo.seq;
 }
 
-std::string GetFileDomain(const std::string& file)
+bool CompareFileGreaterFunc(const SysEventFileInfoPtr& fileA, const SysEventFileInfoPtr& fileB)
 {
-    std::vector<std::string> dirNames;
-    StringUtil::SplitStr(file, FILE_DELIMIT_STR, dirNames);
-    constexpr size_t domainOffset = 2;
-    return dirNames.size() < domainOffset ? "" : dirNames[dirNames.size() - domainOffset];
-}
-
-bool CompareFileLessFunc(const std::string& fileA, const std::string& fileB)
-{
-    return GetFileSeq(fileA) < GetFileSeq(fileB);
-}
-
-bool CompareFileGreaterFunc(const std::string& fileA, const std::string& fileB)
-{
-    return GetFileSeq(fileA) > GetFileSeq(fileB);
-}
-
-uint8_t GetEventTypeFromFileName(const std::string& fileName)
-{
-    SplitedEventInfo eventInfo;
-    if (!EventDbFileUtil::ParseEventInfoFromDbFileName(fileName, eventInfo, TYPE_ONLY)) {
-        HIVIEW_LOGD("failed to parse event info from: %{public}s", fileName.c_str());
-        return 0;
-    }
-    return eventInfo.type;
+    return fileA->eventInfo.seq > fileB->eventInfo.seq;
 }
 }
 
@@ -115,6 +88,19 @@ std::string SysEventDatabase::GetDatabaseDir()
     return dir;
 }
 
+SysEventFileCatalog& SysEventDatabase::GetFileCatalog()
+{
+    fileCatalog_.Load(GetDatabaseDir());
+    return fileCatalog_;
+}
+
+void SysEventDatabase::ReloadFileCatalog()
+{
+    fileCatalog_.Invalidate();
+    SysEventPageSummaryCache::GetInstance().Clear();
+    SysEventParamIndexCache::GetInstance().Clear();
+}
+
 int SysEventDatabase::Insert(const std::shared_ptr<SysEvent>& event)
 {
     std::unique_lock<std::shared_mutex> lock(mutex_);
@@ -126,7 +112,20 @@ int SysEventDatabase::Insert(const std::shared_ptr<SysEvent>& event)
         sysEventDoc = std::make_shared<SysEventDoc>(event->domain_, event->eventName_);
         lruCache_->Add(keyOfCache, sysEventDoc);
     }
-    return sysEventDoc->Insert(event);
+    int ret = sysEventDoc->Insert(event);
+    if (sysEventDoc->HasStagedEvents()) {
+        hasStagedEvents_ = true;
+    }
+    return ret;
+}
+
+void SysEventDatabase::Flush()
+{
+    if (!hasStagedEvents_) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    FlushStagedEvents();
 }
 
 void SysEventDatabase::CheckRepeat(SysEvent& event)
@@ -137,11 +136,12 @@ void SysEventDatabase::CheckRepeat(SysEvent& event)
 bool SysEventDatabase::Backup(const std::string& zipFilePath)
 {
     HIVIEW_LOGI("start backup.");
+    Flush(); // the staged events need to be backed up too
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    std::vector<std::string> domainDirs;
+    SysEventFileList eventFiles;
+    GetFileCatalog().GetFiles("", eventFiles);
     std::string dbDir(GetDatabaseDir());
-    FileUtil::GetDirDirs(dbDir, domainDirs);
-    if (domainDirs.empty()) {
+    if (eventFiles.empty()) {
         HIVIEW_LOGI("no event files exist.");
         return false;
     }
@@ -164,18 +164,15 @@ bool SysEventDatabase::Backup(const std::string& zipFilePath)
     }
 
     const uint8_t faultType = static_cast<uint8_t>(HiSysEvent::EventType::FAULT);
-    for (const auto& domainDir : domainDirs) {
-        std::vector<std::string> eventFiles;
-        FileUtil::GetDirFiles(domainDir, eventFiles, false);
-        for (const auto& eventFile : eventFiles) {
-            std::string fileName(FileUtil::ExtractFileName(eventFile));
-            if (GetEventTypeFromFileName(fileName) != faultType) {
-                continue;
-            }
-            if (int32_t ret = zipUnit.AddFileInZip(eventFile, ZipFileLevel::KEEP_ONE_PARENT_PATH); ret != 0) {
-                HIVIEW_LOGW("zip file failed: %{public}s, ret: %{public}d", fileName.c_str(), ret);
-                return false;
-            }
+    for (const auto& eventFile : eventFiles) {
+        const auto& fileInfo = eventFile.first;
+        if (fileInfo->eventInfo.type != faultType) {
+            continue;
+        }
+        if (int32_t ret = zipUnit.AddFileInZip(fileInfo->path, ZipFileLevel::KEEP_ONE_PARENT_PATH); ret != 0) {
+            HIVIEW_LOGW("zip file failed: %{public}s, ret: %{public}d",
+                FileUtil::ExtractFileName(fileInfo->path).c_str(), ret);
+            return false;
         }
     }
     HIVIEW_LOGI("finish backup.");
@@ -197,6 +194,7 @@ bool SysEventDatabase::Restore(const std::string& zipFilePath, const std::string
         HIVIEW_LOGW("seq id file not exist in zip file.");
         return false;
     }
+    ReloadFileCatalog();
     HIVIEW_LOGI("finish restore.");
     return true;
 }
@@ -204,10 +202,12 @@ bool SysEventDatabase::Restore(const std::string& zipFilePath, const std::string
 void SysEventDatabase::Clear()
 {
     std::unique_lock<std::shared_mutex> lock(mutex_);
+    FlushStagedEvents(); // the file sizes need to include the staged events
     ClearFilesMap clearMap;
     GetClearMap(clearMap);
     if (!clearMap.empty()) {
         ClearCache(); // need to close the open files before clear
+        fileCatalog_.ResetWritingFiles();
     }
     for (auto it = clearMap.begin(); it != clearMap.end(); ++it) {
         const double delPct = 0.1;
@@ -222,7 +222,7 @@ void SysEventDatabase::Clear()
         auto& normalQueue = std::get<INDEX_NORMAL_QUEUE>(it->second);
         auto& limitQueue = std::get<INDEX_LIMIT_QUEUE>(it->second);
         while (totalFileSize >= maxSize) {
-            std::string delFile;
+            SysEventFileInfoPtr delFile;
             if (!limitQueue.empty()) {
                 delFile = limitQueue.top();
                 limitQueue.pop();
@@ -233,12 +233,14 @@ void SysEventDatabase::Clear()
                 break;
             }
 
-            auto fileSize = FileUtil::GetFileSize(delFile);
-            if (!FileUtil::RemoveFile(delFile)) {
-                HIVIEW_LOGI("failed to remove file=%{public}s", delFile.c_str());
+            if (!FileUtil::RemoveFile(delFile->path)) {
+                HIVIEW_LOGI("failed to remove file=%{public}s", delFile->path.c_str());
                 continue;
             }
-            HIVIEW_LOGD("success to remove file=%{public}s", delFile.c_str());
+            auto fileSize = fileCatalog_.RemoveFile(delFile);
+            SysEventPageSummaryCache::GetInstance().Remove(delFile->path);
+            SysEventParamIndexCache::GetInstance().Remove(delFile->path);
+            HIVIEW_LOGD("success to remove file=%{public}s", delFile->path.c_str());
             totalFileSize = totalFileSize >= fileSize ? (totalFileSize - fileSize) : 0;
         }
         HIVIEW_LOGI("end to clear type=%{public}d, curSize=%{public}" PRIu64 ", maxSize=%{public}" PRIu64,
@@ -248,6 +250,7 @@ void SysEventDatabase::Clear()
 
 int SysEventDatabase::Query(SysEventQuery& sysEventQuery, EntryQueue& entries)
 {
+    Flush(); // the staged events need to be visible to the query
     std::shared_lock<std::shared_mutex> lock(mutex_);
     FileQueue queryFiles(CompareFileLessFunc);
     const auto& queryArg = sysEventQuery.queryArg_;
@@ -263,29 +266,22 @@ int SysEventDatabase::Query(SysEventQuery& sysEventQuery, EntryQueue& entries)
 
 void SysEventDatabase::GetClearMap(ClearFilesMap& clearMap)
 {
-    // get all event files
-    FileQueue files(CompareFileLessFunc);
-    GetQueryFiles(SysEventQueryArg(), files);
+    // get all event files with their sizes, the newer files are counted first
+    SysEventFileList files;
+    GetFileCatalog().GetFiles("", files);
+    std::sort(files.begin(), files.end(), [] (const auto& fileA, const auto& fileB) {
+        return CompareFileGreaterFunc(fileA.first, fileB.first);
+    });
 
     // build clear map
     std::unordered_map<std::string, uint32_t> nameLimitMap;
-    while (!files.empty()) {
-        std::string file = files.top();
-        files.pop();
-        std::string fileName = file.substr(file.rfind(FILE_DELIMIT_STR) + 1); // 1 for skipping '/'
-        SplitedEventInfo eventInfo;
-        if (!EventDbFileUtil::ParseEventInfoFromDbFileName(fileName, eventInfo, NAME_ONLY | TYPE_ONLY)) {
-            HIVIEW_LOGD("failed to parse event info from %{public}s", fileName.c_str());
-            continue;
-        }
-
-        std::string domainNameStr = GetFileDomain(file) + eventInfo.name;
-        uint64_t type = eventInfo.type;
+    for (const auto& [fileInfo, fileSize] : files) {
+        std::string domainNameStr = fileInfo->domain + fileInfo->eventInfo.name;
+        uint64_t type = fileInfo->eventInfo.type;
         nameLimitMap[domainNameStr]++;
-        uint64_t fileSize = FileUtil::GetFileSize(file);
         if (clearMap.find(type) == clearMap.end()) {
             FileQueue fileQueue(CompareFileGreaterFunc);
-            fileQueue.emplace(file);
+            fileQueue.emplace(fileInfo);
             clearMap.insert({type, std::make_tuple(fileSize, fileQueue, FileQueue(CompareFileGreaterFunc))});
             continue;
         }
@@ -293,9 +289,9 @@ void SysEventDatabase::GetClearMap(ClearFilesMap& clearMap)
         auto& clearTuple = clearMap.at(type);
         std::get<INDEX_FILE_SIZE>(clearTuple) += fileSize;
         if (nameLimitMap[domainNameStr] > GetMaxFileNum(type)) {
-            std::get<INDEX_LIMIT_QUEUE>(clearTuple).emplace(file);
+            std::get<INDEX_LIMIT_QUEUE>(clearTuple).emplace(fileInfo);
         } else {
-            std::get<INDEX_NORMAL_QUEUE>(clearTuple).emplace(file);
+            std::get<INDEX_NORMAL_QUEUE>(clearTuple).emplace(fileInfo);
         }
     }
 }
@@ -304,6 +300,16 @@ void SysEventDatabase::ClearCache()
 {
     HIVIEW_LOGI("start to clear lru cache");
     lruCache_->Clear();
+    hasStagedEvents_ = false;
+}
+
+void SysEventDatabase::FlushStagedEvents()
+{
+    if (!hasStagedEvents_) {
+        return;
+    }
+    lruCache_->Flush();
+    hasStagedEvents_ = false;
 }
 
 uint32_t SysEventDatabase::GetMaxFileNum(int type)
@@ -318,52 +324,32 @@ uint64_t SysEventDatabase::GetMaxSize(int type)
 
 void SysEventDatabase::GetQueryFiles(const SysEventQueryArg& queryArg, FileQueue& queryFiles)
 {
-    std::vector<std::string> queryDirs;
-    GetQueryDirsByDomain(queryArg.domain, queryDirs);
-    if (queryDirs.empty()) {
-        return;
-    }
-
-    for (const auto& queryDir : queryDirs) {
-        std::vector<std::string> files;
-        FileUtil::GetDirFiles(queryDir, files);
-        sort(files.begin(), files.end(), CompareFileGreaterFunc);
-        std::unordered_map<std::string, long long> nameSeqMap;
-        for (const auto& file : files) {
-            if (IsContainQueryArg(file, queryArg, nameSeqMap)) {
-                queryFiles.emplace(file);
-                HIVIEW_LOGD("add query file=%{public}s", file.c_str());
-            }
+    SysEventFileList files;
+    GetFileCatalog().GetFiles(queryArg.domain, files);
+
+    // files of the same domain are adjacent and sorted by seq in descending order
+    std::string curDomain;
+    std::unordered_map<std::string, long long> nameSeqMap;
+    for (const auto& file : files) {
+        const auto& fileInfo = file.first;
+        if (fileInfo->domain != curDomain) {
+            curDomain = fileInfo->domain;
+            nameSeqMap.clear();
         }
-    }
-}
-
-void SysEventDatabase::GetQueryDirsByDomain(const std::string& domain, std::vector<std::string>& queryDirs)
-{
-    if (domain.empty()) {
-        FileUtil::GetDirDirs(GetDatabaseDir(), queryDirs);
-    } else {
-        std::string domainDir = GetDatabaseDir() + domain;
-        if (FileUtil::IsDirectory(domainDir)) {
-            queryDirs.push_back(domainDir + FILE_DELIMIT_STR);
+        if (IsContainQueryArg(*fileInfo, queryArg, nameSeqMap)) {
+            queryFiles.emplace(fileInfo);
+            HIVIEW_LOGD("add query file=%{public}s", fileInfo->path.c_str());
         }
     }
 }
 
-bool SysEventDatabase::IsContainQueryArg(const std::string& file, const SysEventQueryArg& queryArg,
+bool SysEventDatabase::IsContainQueryArg(const SysEventFileInfo& fileInfo, const SysEventQueryArg& queryArg,
     std::unordered_map<std::string, long long>& nameSeqMap)
 {
     if (queryArg.names.empty() && queryArg.type == 0 && queryArg.toSeq == INVALID_VALUE_INT) {
         return true;
     }
-    std::string fileName = file.substr(file.rfind(FILE_DELIMIT_STR) + 1); // 1 for next char
-    SplitedEventInfo eventInfo;
-    if (!EventDbFileUtil::ParseEventInfoFromDbFileName(fileName, eventInfo,
-        NAME_ONLY | TYPE_ONLY | SEQ_ONLY | REPORT_INTERVAL_ONLY)) {
-        HIVIEW_LOGD("failed to parse event info from %{public}s", fileName.c_str());
-        return false;
-    }
-
+    const auto& eventInfo = fileInfo.eventInfo;
     std::string eventName = eventInfo.name;
     auto iter = nameSeqMap.find(eventInfo.name);
     if (iter != nameSeqMap.end() && iter->second <= queryArg.fromSeq) {
@@ -396,15 +382,16 @@ int SysEventDatabase::QueryByFiles(SysEventQuery& sysEventQuery, EntryQueue& ent
     sysEventQuery.BuildDocQuery(docQuery);
     int totalNum = 0;
     while (!queryFiles.empty()) {
-        std::string file = queryFiles.top();
+        auto fileInfo = queryFiles.top();
         queryFiles.pop();
-        auto sysEventDoc = std::make_shared<SysEventDoc>(file);
+        auto sysEventDoc = std::make_shared<SysEventDoc>(fileInfo->path);
         if (auto res = sysEventDoc->Query(docQuery, entries, totalNum); res != DOC_STORE_SUCCESS) {
-            HIVIEW_LOGE("failed to query event from doc, file=%{public}s, res=%{public}d", file.c_str(), res);
+            HIVIEW_LOGE("failed to query event from doc, file=%{public}s, res=%{public}d", fileInfo->path.c_str(),
+                res);
             continue;
         }
         if (totalNum >= sysEventQuery.limit_) {
-            sysEventQuery.queryArg_.toSeq = GetFileSeq(file);
+            sysEventQuery.queryArg_.toSeq = fileInfo->eventInfo.seq;
             break;
         }
     }
@@ -84,6 +84,16 @@ int SysEventDoc::Query(const DocQuery& query, EntryQueue& entries, int& num)
     return reader_->Read(query, entries, num);
 }
 
+int SysEventDoc::Flush()
+{
+    return writer_ == nullptr ? DOC_STORE_SUCCESS : writer_->Flush();
+}
+
+bool SysEventDoc::HasStagedEvents() const
+{
+    return writer_ != nullptr && writer_->HasStagedEvents();
+}
+
 int SysEventDoc::InitWriter(const std::shared_ptr<SysEvent>& sysEvent)
 {
     if (writer_ == nullptr || IsNeedUpdateCurFile()) {
@@ -105,7 +115,7 @@ int SysEventDoc::InitReader()
         HIVIEW_LOGE("failed to init reader from file=%{public}s", curFile_.c_str());
         return DOC_STORE_ERROR_IO;
     }
-    reader_ = std::make_shared<SysEventDocReader>(curFile_);
+    reader_ = std::make_shared<SysEventDocReader>(curFile_, true);
     return DOC_STORE_SUCCESS;
 }
 
@@ -125,11 +135,12 @@ int SysEventDoc::UpdateCurFile(const std::shared_ptr<SysEvent>& sysEvent)
     if (dir.empty()) {
         return DOC_STORE_ERROR_IO;
     }
-    std::string filePath = GetCurFile(dir);
+    std::string filePath = GetCurFile();
     if (filePath.empty() || !EventDbFileUtil::IsMatchedDbFilePath(filePath, sysEvent) || IsFileFull(filePath)) {
         return CreateCurFile(dir, sysEvent);
     }
     curFile_ = filePath;
+    SysEventDatabase::GetInstance().GetFileCatalog().MarkWritingFile(domain_, curFile_);
     return DOC_STORE_SUCCESS;
 }
 
@@ -143,18 +154,12 @@ std::string SysEventDoc::GetDir()
     return dir;
 }
 
-std::string SysEventDoc::GetCurFile(const std::string& dir)
+std::string SysEventDoc::GetCurFile()
 {
-    std::vector<std::string> files;
-    FileUtil::GetDirFiles(dir, files);
-    std::string curFile;
-    for (auto& file : files) {
-        if (file.find(FILE_SEPARATOR + name_ + FILE_NAME_SEPARATOR) == std::string::npos) {
-            continue;
-        }
-        if ((file.size() == curFile.size() && file > curFile) || file.size() > curFile.size()) {
-            curFile = file;
-        }
+    std::string curFile = SysEventDatabase::GetInstance().GetFileCatalog().GetLatestFile(domain_, name_);
+    if (!curFile.empty() && !FileUtil::FileExists(curFile)) {
+        HIVIEW_LOGW("latest file=%{public}s in catalog not exist", curFile.c_str());
+        return "";
     }
     return curFile;
 }
@@ -177,6 +182,7 @@ int SysEventDoc::CreateCurFile(const std::string& dir, const std::shared_ptr<Sys
         return DOC_STORE_ERROR_IO;
     }
     curFile_ = filePath;
+    SysEventDatabase::GetInstance().GetFileCatalog().AddFile(domain_, curFile_);
     return DOC_STORE_SUCCESS;
 }
 } // EventStore
@@ -71,6 +71,15 @@ void SysEventDocLruCache::Clear()
     lruList_.clear();
     lruCache_.clear();
 }
+
+void SysEventDocLruCache::Flush()
+{
+    for (const auto& item : lruCache_) {
+        if (auto doc = item.second.second; doc != nullptr) {
+            doc->Flush();
+        }
+    }
+}
 } // EventStore
 } // HiviewDFX
 } // OHOS
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sys_event_file_catalog.h"
+
+#include <sys/stat.h>
+
+#include "file_util.h"
+#include "hiview_logger.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventStore {
+DEFINE_LOG_TAG("HiView-SysEventFileCatalog");
+void SysEventFileCatalog::Load(const std::string& dbDir)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isLoaded_ && dbDir == dbDir_) {
+        return;
+    }
+    files_.clear();
+    fileCount_ = 0;
+    dbDir_ = dbDir;
+    std::vector<std::string> domainDirs;
+    FileUtil::GetDirDirs(dbDir_, domainDirs);
+    for (const auto& domainDir : domainDirs) {
+        LoadDomain(domainDir);
+    }
+    isLoaded_ = true;
+    HIVIEW_LOGI("load catalog, domain num=%{public}zu, file num=%{public}zu", files_.size(), fileCount_);
+}
+
+void SysEventFileCatalog::LoadDomain(const std::string& domainDir)
+{
+    std::string domain = FileUtil::ExtractFileName(domainDir);
+    std::vector<std::pair<std::string, struct stat>> fileInfos;
+    FileUtil::GetDirFileInfos(domainDir, fileInfos);
+    for (const auto& fileInfo : fileInfos) {
+        AddFileEntry(domain, fileInfo.first, static_cast<uint64_t>(fileInfo.second.st_size), false);
+    }
+}
+
+void SysEventFileCatalog::Invalidate()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isLoaded_ = false;
+}
+
+bool SysEventFileCatalog::AddFile(const std::string& domain, const std::string& file)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return AddFileEntry(domain, file, 0, true);
+}
+
+bool SysEventFileCatalog::AddFileEntry(const std::string& domain, const std::string& file, uint64_t size,
+    bool isWriting)
+{
+    auto info = std::make_shared<SysEventFileInfo>();
+    if (!EventDbFileUtil::ParseEventInfoFromDbFileName(FileUtil::ExtractFileName(file), info->eventInfo,
+        NAME_ONLY | TYPE_ONLY | SEQ_ONLY | REPORT_INTERVAL_ONLY)) {
+        HIVIEW_LOGD("failed to parse event info from: %{public}s", file.c_str());
+        return false;
+    }
+    info->path = file;
+    info->domain = domain;
+    auto result = files_[domain].insert_or_assign(FileKey(info->eventInfo.seq, file),
+        FileEntry { info, size, isWriting });
+    if (result.second) {
+        ++fileCount_;
+    }
+    return true;
+}
+
+void SysEventFileCatalog::MarkWritingFile(const std::string& domain, const std::string& file)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    SplitedEventInfo eventInfo;
+    if (!EventDbFileUtil::ParseEventInfoFromDbFileName(FileUtil::ExtractFileName(file), eventInfo, SEQ_ONLY)) {
+        return;
+    }
+    if (auto domainIter = files_.find(domain); domainIter != files_.end()) {
+        if (auto fileIter = domainIter->second.find(FileKey(eventInfo.seq, file));
+            fileIter != domainIter->second.end()) {
+            fileIter->second.isWriting = true;
+            return;
+        }
+    }
+    AddFileEntry(domain, file, 0, true);
+}
+
+void SysEventFileCatalog::ResetWritingFiles()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& domainFiles : files_) {
+        for (auto& fileEntry : domainFiles.second) {
+            if (fileEntry.second.isWriting) {
+                fileEntry.second.size = FileUtil::GetFileSize(fileEntry.first.second);
+                fileEntry.second.isWriting = false;
+            }
+        }
+    }
+}
+
+uint64_t SysEventFileCatalog::RemoveFile(const SysEventFileInfoPtr& info)
+{
+    if (info == nullptr) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto domainIter = files_.find(info->domain);
+    if (domainIter == files_.end()) {
+        return 0;
+    }
+    auto fileIter = domainIter->second.find(FileKey(info->eventInfo.seq, info->path));
+    if (fileIter == domainIter->second.end()) {
+        return 0;
+    }
+    uint64_t size = fileIter->second.isWriting ? FileUtil::GetFileSize(info->path) : fileIter->second.size;
+    domainIter->second.erase(fileIter);
+    --fileCount_;
+    if (domainIter->second.empty()) {
+        files_.erase(domainIter);
+    }
+    return size;
+}
+
+std::string SysEventFileCatalog::GetLatestFile(const std::string& domain, const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto domainIter = files_.find(domain);
+    if (domainIter == files_.end()) {
+        return "";
+    }
+    for (const auto& fileEntry : domainIter->second) {
+        if (fileEntry.second.info->eventInfo.name == name) {
+            return fileEntry.first.second;
+        }
+    }
+    return "";
+}
+
+void SysEventFileCatalog::GetFiles(const std::string& domain, SysEventFileList& files)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!domain.empty()) {
+        if (auto domainIter = files_.find(domain); domainIter != files_.end()) {
+            AppendDomainFiles(domainIter->second, files);
+        }
+        return;
+    }
+    files.reserve(fileCount_);
+    for (auto& domainFiles : files_) {
+        AppendDomainFiles(domainFiles.second, files);
+    }
+}
+
+void SysEventFileCatalog::AppendDomainFiles(DomainFiles& domainFiles, SysEventFileList& files)
+{
+    for (auto& fileEntry : domainFiles) {
+        if (fileEntry.second.isWriting) {
+            fileEntry.second.size = FileUtil::GetFileSize(fileEntry.first.second);
+        }
+        files.emplace_back(fileEntry.second.info, fileEntry.second.size);
+    }
+}
+
+size_t SysEventFileCatalog::GetFileCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return fileCount_;
+}
+} // EventStore
+} // HiviewDFX
+} // OHOS
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sys_event_repeat_cache.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <ctime>
+
+#include "ffrt.h"
+#include "hiview_logger.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+DEFINE_LOG_TAG("HiView-SysEvent-Repeat-Cache");
+namespace {
+constexpr size_t BLOOM_BIT_CNT = 1 << 17; // 16KB, the false positive rate is about 1% with 10000 hashes
+constexpr size_t BLOOM_WORD_BITS = 64;
+constexpr size_t BLOOM_HASH_CNT = 3;
+constexpr uint64_t BLOOM_HASH_SEED = 0x9E3779B97F4A7C15;
+constexpr size_t MAX_LRU_SIZE = 256;
+constexpr size_t MAX_PENDING_CNT = 32;
+constexpr uint64_t FLUSH_DELAY = 5 * 1000 * 1000; // 5s in us
+constexpr char KEY_SEPARATOR = '|';
+
+inline std::string GetRecordKey(const SysEventHashRecord& record)
+{
+    std::string key;
+    key.reserve(record.domain.size() + record.name.size() + record.eventHash.size() + 2); // 2: two separators
+    return key.append(record.domain).append(1, KEY_SEPARATOR).append(record.name).append(1, KEY_SEPARATOR)
+        .append(record.eventHash);
+}
+
+template<typename Func>
+void ForEachBloomBit(const std::string& key, Func func)
+{
+    uint64_t hash1 = std::hash<std::string>()(key);
+    uint64_t hash2 = ((hash1 * BLOOM_HASH_SEED) >> 32) | 1; // 32: take the high bits, keep it odd
+    for (size_t i = 0; i < BLOOM_HASH_CNT; ++i) {
+        func((hash1 + i * hash2) % BLOOM_BIT_CNT);
+    }
+}
+}
+
+SysEventRepeatCache::SysEventRepeatCache() : bloomBits_(BLOOM_BIT_CNT / BLOOM_WORD_BITS, 0)
+{}
+
+bool SysEventRepeatCache::IsRepeat(SysEventHashRecord& record, int64_t minValidTime)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    minValidTime_ = minValidTime;
+    if (!isBloomLoaded_ || IsBloomFilterExpired(minValidTime)) {
+        LoadBloomFilter(minValidTime);
+    }
+    std::string key = GetRecordKey(record);
+    int64_t happentime = 0;
+    if (auto iter = lruMap_.find(key); iter != lruMap_.end()) {
+        happentime = iter->second.happentime;
+        ++stats_.hitCount;
+    } else if (!MayContainInBloomFilter(key)) {
+        ++stats_.hitCount; // the hash has never been stored
+    } else {
+        ++stats_.missCount;
+        FlushPendingRecords(); // the records of the hashes evicted from lru need to be visible to the query
+        happentime = SysEventRepeatDb::GetInstance().QueryHappentime(record);
+        SysEventRepeatDb::GetInstance().Release();
+    }
+    if (happentime > minValidTime) { // event repeat
+        UpdateLru(key, happentime);
+        return true;
+    }
+
+    record.happentime = time(nullptr);
+    UpdateLru(key, record.happentime);
+    AddToBloomFilter(key);
+    AddPendingRecord(record);
+    return false;
+}
+
+void SysEventRepeatCache::Flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    FlushPendingRecords();
+    SysEventRepeatDb::GetInstance().Release();
+}
+
+void SysEventRepeatCache::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    FlushPendingRecords();
+    SysEventRepeatDb::GetInstance().Release();
+    lruList_.clear();
+    lruMap_.clear();
+    std::fill(bloomBits_.begin(), bloomBits_.end(), 0);
+    isBloomLoaded_ = false;
+}
+
+void SysEventRepeatCache::Clear(int64_t happentime)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pendingRecords_.clear();
+    lruList_.clear();
+    lruMap_.clear();
+    std::fill(bloomBits_.begin(), bloomBits_.end(), 0);
+    isBloomLoaded_ = false;
+    SysEventRepeatDb::GetInstance().Clear(happentime);
+    SysEventRepeatDb::GetInstance().Release();
+}
+
+SysEventRepeatCacheStats SysEventRepeatCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+bool SysEventRepeatCache::IsBloomFilterExpired(int64_t minValidTime) const
+{
+    // all the hashes added before loading are out of the valid time window now
+    return minValidTime >= bloomLoadTime_;
+}
+
+void SysEventRepeatCache::LoadBloomFilter(int64_t minValidTime)
+{
+    FlushPendingRecords(); // the pending hashes need to be loaded from the db too
+    std::fill(bloomBits_.begin(), bloomBits_.end(), 0);
+    std::vector<SysEventHashRecord> records;
+    SysEventRepeatDb::GetInstance().QueryRecords(minValidTime, records);
+    SysEventRepeatDb::GetInstance().Release();
+    for (const auto& record : records) {
+        AddToBloomFilter(GetRecordKey(record));
+    }
+    isBloomLoaded_ = true;
+    bloomLoadTime_ = time(nullptr);
+    HIVIEW_LOGI("load %{public}zu hashes to bloom filter", records.size());
+}
+
+void SysEventRepeatCache::AddToBloomFilter(const std::string& key)
+{
+    ForEachBloomBit(key, [this] (size_t bit) {
+        bloomBits_[bit / BLOOM_WORD_BITS] |= (1ULL << (bit % BLOOM_WORD_BITS));
+    });
+}
+
+bool SysEventRepeatCache::MayContainInBloomFilter(const std::string& key) const
+{
+    bool isContained = true;
+    ForEachBloomBit(key, [this, &isContained] (size_t bit) {
+        isContained = isContained && ((bloomBits_[bit / BLOOM_WORD_BITS] & (1ULL << (bit % BLOOM_WORD_BITS))) != 0);
+    });
+    return isContained;
+}
+
+void SysEventRepeatCache::UpdateLru(const std::string& key, int64_t happentime)
+{
+    if (auto iter = lruMap_.find(key); iter != lruMap_.end()) {
+        lruList_.splice(lruList_.begin(), lruList_, iter->second.iter);
+        iter->second.happentime = happentime;
+        return;
+    }
+    lruList_.push_front(key);
+    lruMap_[key] = { lruList_.begin(), happentime };
+    if (lruList_.size() > MAX_LRU_SIZE) {
+        lruMap_.erase(lruList_.back());
+        lruList_.pop_back();
+    }
+}
+
+void SysEventRepeatCache::AddPendingRecord(const SysEventHashRecord& record)
+{
+    pendingRecords_.emplace_back(record);
+    bool isFull = pendingRecords_.size() >= MAX_PENDING_CNT;
+    if (!isFull && isFlushScheduled_) {
+        return;
+    }
+    isFlushScheduled_ = true;
+    ffrt::submit([this] () {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isFlushScheduled_ = false;
+        FlushPendingRecords();
+        SysEventRepeatDb::GetInstance().Release();
+        }, {}, {}, ffrt::task_attr().name("repeat_cache_flush").qos(ffrt::qos_default)
+        .delay(isFull ? 0 : FLUSH_DELAY));
+}
+
+void SysEventRepeatCache::FlushPendingRecords()
+{
+    if (pendingRecords_.empty()) {
+        return;
+    }
+    if (SysEventRepeatDb::GetInstance().BatchUpdate(pendingRecords_)) {
+        stats_.writeCount += pendingRecords_.size();
+    } else {
+        HIVIEW_LOGW("failed to flush %{public}zu records", pendingRecords_.size());
+    }
+    SysEventRepeatDb::GetInstance().CheckAndClearDb(minValidTime_);
+    HIVIEW_LOGD("flush %{public}zu records, hit=%{public}" PRIu64 ", miss=%{public}" PRIu64,
+        pendingRecords_.size(), stats_.hitCount, stats_.missCount);
+    pendingRecords_.clear();
+}
+} // HiviewDFX
+} // OHOS
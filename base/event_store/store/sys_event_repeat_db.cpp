@@ -164,6 +164,11 @@ bool SysEventRepeatDb::Insert(const SysEventHashRecord &sysEventHashRecord)
         HIVIEW_LOGE("dbStore_ not valid.");
         return false;
     }
+    return InsertRecord(sysEventHashRecord);
+}
+
+bool SysEventRepeatDb::InsertRecord(const SysEventHashRecord &sysEventHashRecord)
+{
     NativeRdb::ValuesBucket bucket;
     bucket.PutString(COLUMN_DOMAIN, sysEventHashRecord.domain);
     bucket.PutString(COLUMN_NAME, sysEventHashRecord.name);
@@ -185,13 +190,47 @@ bool SysEventRepeatDb::Update(const SysEventHashRecord &sysEventHashRecord)
     if (!CheckDbStoreValid()) {
         return false;
     }
+    int updateRowNum = 0;
+    return UpdateRecord(sysEventHashRecord, updateRowNum);
+}
+
+bool SysEventRepeatDb::BatchUpdate(const std::vector<SysEventHashRecord>& sysEventHashRecords)
+{
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    if (!CheckDbStoreValid()) {
+        return false;
+    }
+    if (int32_t ret = dbStore_->BeginTransaction(); ret != NativeRdb::E_OK) {
+        HIVIEW_LOGE("failed to begin transaction, ret=%{public}d", ret);
+        CheckAndRepairDbFile(ret);
+        return false;
+    }
+    for (const auto& record : sysEventHashRecords) {
+        // insert the record only if it does not exist
+        int updateRowNum = 0;
+        if (!UpdateRecord(record, updateRowNum) || (updateRowNum == 0 && !InsertRecord(record))) {
+            if (dbStore_ != nullptr) {
+                dbStore_->RollBack();
+            }
+            return false;
+        }
+    }
+    if (int32_t ret = dbStore_->Commit(); ret != NativeRdb::E_OK) {
+        HIVIEW_LOGE("failed to commit transaction, ret=%{public}d", ret);
+        CheckAndRepairDbFile(ret);
+        return false;
+    }
+    return true;
+}
+
+bool SysEventRepeatDb::UpdateRecord(const SysEventHashRecord &sysEventHashRecord, int& updateRowNum)
+{
     NativeRdb::AbsRdbPredicates predicates(TABLE_NAME);
     predicates.EqualTo(COLUMN_DOMAIN, sysEventHashRecord.domain);
     predicates.EqualTo(COLUMN_NAME, sysEventHashRecord.name);
     predicates.EqualTo(COLUMN_EVENT_HASH, sysEventHashRecord.eventHash);
     NativeRdb::ValuesBucket bucket;
     bucket.PutLong(COLUMN_HAPPENTIME, sysEventHashRecord.happentime);
-    int updateRowNum = 0;
     if (int32_t ret = dbStore_->Update(updateRowNum, bucket, predicates); ret != NativeRdb::E_OK) {
         HIVIEW_LOGE("failed to update table.");
         CheckAndRepairDbFile(ret);
@@ -265,5 +304,28 @@ int64_t SysEventRepeatDb::QueryHappentime(SysEventHashRecord &sysEventHashRecord
     return happentime;
 }
 
+void SysEventRepeatDb::QueryRecords(const int64_t happentime, std::vector<SysEventHashRecord>& sysEventHashRecords)
+{
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    if (!CheckDbStoreValid()) {
+        return;
+    }
+    NativeRdb::AbsRdbPredicates predicates(TABLE_NAME);
+    predicates.GreaterThanOrEqualTo(COLUMN_HAPPENTIME, happentime);
+    auto resultSet = dbStore_->Query(predicates, {COLUMN_DOMAIN, COLUMN_NAME, COLUMN_EVENT_HASH});
+    if (resultSet == nullptr) {
+        HIVIEW_LOGE("failed to query from table %{public}s, db is null", TABLE_NAME);
+        return;
+    }
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        SysEventHashRecord record("", "");
+        resultSet->GetString(0, record.domain);   // 0 is result of domain
+        resultSet->GetString(1, record.name);   // 1 is result of name
+        resultSet->GetString(2, record.eventHash);   // 2 is result of eventHash
+        sysEventHashRecords.emplace_back(record);
+    }
+    resultSet->Close();
+}
+
 } // HiviewDFX
 } // OHOS
\ No newline at end of file
@@ -22,6 +22,7 @@
 #include "parameter_ex.h"
 #include "setting_observer_manager.h"
 #include "string_util.h"
+#include "sys_event_repeat_cache.h"
 #include "sys_event_repeat_db.h"
 
 namespace OHOS {
@@ -103,22 +104,7 @@ bool SysEventRepeatGuard::IsEventRepeat(SysEvent& event)
         HIVIEW_LOGE("GetShaStr failed.");
         return false;
     }
-    auto happentime = SysEventRepeatDb::GetInstance().QueryHappentime(sysEventHashRecord);
-    int64_t minValidTime = GetMinValidTime();
-    if (happentime > minValidTime) {    // event repeat
-        SysEventRepeatDb::GetInstance().Release();
-        return true;
-    }
-
-    sysEventHashRecord.happentime = time(nullptr);
-    if (happentime > 0) {   // > 0 means has record
-        SysEventRepeatDb::GetInstance().Update(sysEventHashRecord);
-    } else {
-        SysEventRepeatDb::GetInstance().Insert(sysEventHashRecord);
-        SysEventRepeatDb::GetInstance().CheckAndClearDb(minValidTime);
-    }
-    SysEventRepeatDb::GetInstance().Release();
-    return false;
+    return SysEventRepeatCache::GetInstance().IsRepeat(sysEventHashRecord, GetMinValidTime());
 }
 
 void SysEventRepeatGuard::UnregisterListeningUeSwitch()
@@ -135,8 +121,7 @@ void SysEventRepeatGuard::RegisterListeningUeSwitch()
             HIVIEW_LOGI("value of param key[%{public}s] is %{public}s", paramKey.c_str(), val.c_str());
             if (val == KEY_ON) {
                 int64_t curTime = time(nullptr);
-                SysEventRepeatDb::GetInstance().Clear(curTime);
-                SysEventRepeatDb::GetInstance().Release();
+                SysEventRepeatCache::GetInstance().Clear(curTime);
             }
         };
         bool success = false;
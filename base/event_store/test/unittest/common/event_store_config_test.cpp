@@ -121,5 +121,23 @@ HWTEST_F(EventStoreConfigTest, EventStoreConfigTest005, TestSize.Level1)
     ASSERT_EQ(EventStoreConfig::GetInstance().GetMaxFileSize(TestEventType::SECURITY), 256); // 256 is expected value
     ASSERT_EQ(EventStoreConfig::GetInstance().GetMaxFileSize(TestEventType::BEHAVIOR), 256); // 256 is expected value
 }
+
+/**
+ * @tc.name: EventStoreConfigTest006
+ * @tc.desc: test GetMaxStagedSize and GetMaxStagedDelay of EventStoreConfig
+ * @tc.type: FUNC
+ * @tc.require: issueIBT9BB
+ */
+HWTEST_F(EventStoreConfigTest, EventStoreConfigTest006, TestSize.Level1)
+{
+    ASSERT_EQ(EventStoreConfig::GetInstance().GetMaxStagedSize(0), 0); // 0 is expected value
+    ASSERT_EQ(EventStoreConfig::GetInstance().GetMaxStagedSize(TestEventType::FAULT), 0); // 0 is expected value
+    ASSERT_EQ(EventStoreConfig::GetInstance().GetMaxStagedSize(TestEventType::STATISTIC), 16); // 16 is expected value
+    ASSERT_EQ(EventStoreConfig::GetInstance().GetMaxStagedSize(TestEventType::SECURITY), 0); // 0 is expected value
+    ASSERT_EQ(EventStoreConfig::GetInstance().GetMaxStagedSize(TestEventType::BEHAVIOR), 16); // 16 is expected value
+    ASSERT_EQ(EventStoreConfig::GetInstance().GetMaxStagedDelay(TestEventType::FAULT), 0); // 0 is expected value
+    ASSERT_EQ(EventStoreConfig::GetInstance().GetMaxStagedDelay(TestEventType::STATISTIC), 2); // 2 is expected value
+    ASSERT_EQ(EventStoreConfig::GetInstance().GetMinStagedDelay(), 2); // 2 is expected value
+}
 }
 }
\ No newline at end of file
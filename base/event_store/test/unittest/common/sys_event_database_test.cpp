@@ -23,13 +23,22 @@
 
 #include <gmock/gmock.h>
 #include "event.h"
+#include "file_util.h"
 #include "hiview_global.h"
 #include "sys_event.h"
 #include "sys_event_dao.h"
 #include "sys_event_database.h"
+#include "sys_event_file_catalog.h"
 
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+const std::string TEST_DB_DIR = "/data/test/sys_event_catalog/";
+const std::string TEST_DOMAIN = "CATALOG_DOMAIN";
+const std::string TEST_DOMAIN_DIR = TEST_DB_DIR + TEST_DOMAIN + "/";
+const std::string TEST_CONTENT = "test_content";
+}
+
 void SysEventDatabaseTest::SetUpTestCase()
 {
 }
@@ -65,5 +74,89 @@ HWTEST_F(SysEventDatabaseTest, EventDatabaseTest001, testing::ext::TestSize.Leve
     ASSERT_EQ(EventStore::SysEventDatabase::GetInstance().Insert(sysEvent), 0);
     EventStore::SysEventDatabase::GetInstance().Clear();
 }
+
+/**
+ * @tc.name: EventDatabaseTest002
+ * @tc.desc: test the file catalog of SysEventDatabase.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SysEventDatabaseTest, EventDatabaseTest002, testing::ext::TestSize.Level1)
+{
+    FileUtil::ForceRemoveDirectory(TEST_DB_DIR);
+    FileUtil::ForceCreateDirectory(TEST_DOMAIN_DIR);
+    FileUtil::SaveStringToFile(TEST_DOMAIN_DIR + "EVENT_A-1-CRITICAL-10-0.db", TEST_CONTENT);
+    FileUtil::SaveStringToFile(TEST_DOMAIN_DIR + "EVENT_A-1-CRITICAL-20-0.db", TEST_CONTENT);
+    FileUtil::SaveStringToFile(TEST_DOMAIN_DIR + "EVENT_B-4-MINOR-15.db", TEST_CONTENT);
+    FileUtil::SaveStringToFile(TEST_DOMAIN_DIR + "invalid_file", TEST_CONTENT);
+
+    EventStore::SysEventFileCatalog catalog;
+    catalog.Load(TEST_DB_DIR);
+    ASSERT_EQ(catalog.GetFileCount(), 3); // 3 valid event files
+    EventStore::SysEventFileList files;
+    catalog.GetFiles(TEST_DOMAIN, files);
+    ASSERT_EQ(files.size(), 3); // 3 valid event files
+    ASSERT_EQ(files[0].first->eventInfo.seq, 20); // 20: the newest file
+    ASSERT_EQ(files[0].first->domain, TEST_DOMAIN);
+    ASSERT_EQ(files[0].second, TEST_CONTENT.size());
+    ASSERT_EQ(files[1].first->eventInfo.name, "EVENT_B");
+    ASSERT_EQ(files[1].first->eventInfo.reportInterval, NOT_CFG_REPORT_INTERVAL);
+    ASSERT_EQ(files[2].first->eventInfo.seq, 10); // 10: the oldest file
+    ASSERT_EQ(catalog.GetLatestFile(TEST_DOMAIN, "EVENT_A"), TEST_DOMAIN_DIR + "EVENT_A-1-CRITICAL-20-0.db");
+
+    // new file is visible without reloading
+    std::string newFile = TEST_DOMAIN_DIR + "EVENT_A-1-CRITICAL-30-0.db";
+    FileUtil::SaveStringToFile(newFile, TEST_CONTENT + TEST_CONTENT);
+    ASSERT_TRUE(catalog.AddFile(TEST_DOMAIN, newFile));
+    ASSERT_FALSE(catalog.AddFile(TEST_DOMAIN, TEST_DOMAIN_DIR + "invalid_file"));
+    ASSERT_EQ(catalog.GetLatestFile(TEST_DOMAIN, "EVENT_A"), newFile);
+    files.clear();
+    catalog.GetFiles("", files);
+    ASSERT_EQ(files.size(), 4); // 4 valid event files
+    ASSERT_EQ(files[0].second, TEST_CONTENT.size() * 2); // 2: size of file being written is refreshed
+
+    // removed file is invisible
+    ASSERT_EQ(catalog.RemoveFile(files[3].first), TEST_CONTENT.size());
+    ASSERT_EQ(catalog.GetFileCount(), 3); // 3 files left
+    ASSERT_EQ(catalog.RemoveFile(files[3].first), 0);
+    files.clear();
+    catalog.GetFiles("OTHER_DOMAIN", files);
+    ASSERT_TRUE(files.empty());
+    FileUtil::ForceRemoveDirectory(TEST_DB_DIR);
+}
+
+/**
+ * @tc.name: EventDatabaseTest003
+ * @tc.desc: test the staged events of SysEventDatabase are visible to the query.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SysEventDatabaseTest, EventDatabaseTest003, testing::ext::TestSize.Level1)
+{
+    constexpr int64_t baseSeq = 1000; // test value
+    constexpr int eventCnt = 10; // test value
+    for (int i = 0; i < eventCnt; ++i) {
+        SysEventCreator sysEventCreator("STAGED_DOMAIN", "STAGED_EVENT", SysEventCreator::STATISTIC);
+        sysEventCreator.SetKeyValue("INDEX", i);
+        auto sysEvent = std::make_shared<SysEvent>("test", nullptr, sysEventCreator);
+        sysEvent->SetLevel("MINOR");
+        sysEvent->SetEventSeq(baseSeq + i);
+        ASSERT_EQ(EventStore::SysEventDao::Insert(sysEvent), 0);
+    }
+
+    // query before flushing explicitly
+    auto sysEventQuery = EventStore::SysEventDao::BuildQuery("STAGED_DOMAIN", {"STAGED_EVENT"});
+    EventStore::ResultSet resultSet = sysEventQuery->Where(EventStore::EventCol::SEQ, EventStore::Op::GE, baseSeq).
+        Execute();
+    int count = 0;
+    while (resultSet.HasNext()) {
+        auto it = resultSet.Next();
+        ASSERT_GE(it->GetSeq(), baseSeq);
+        count++;
+    }
+    ASSERT_EQ(count, eventCnt);
+
+    // flush without staged events is a no-op
+    EventStore::SysEventDao::Flush();
+    EventStore::SysEventDatabase::GetInstance().Clear();
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
@@ -26,6 +26,7 @@
 #include "hiview_global.h"
 #include "sys_event.h"
 #include "sys_event_dao.h"
+#include "sys_event_repeat_cache.h"
 #include "sys_event_repeat_db.h"
 
 namespace OHOS {
@@ -121,6 +122,7 @@ HWTEST_F(SysEventRepeatTest, CheckEventRepeatTest_02, testing::ext::TestSize.Lev
     SysEventHashRecord sysEventHashRecord("WINDOWMANAGER", "NO_FOCUS_WINDOW");
     sysEventHashRecord.eventHash = testHash;
     sysEventHashRecord.happentime = time(nullptr) - TWO_HOURS;
+    SysEventRepeatCache::GetInstance().Reset(); // write the cached records to db before updating it
     ASSERT_TRUE(SysEventRepeatDb::GetInstance().Update(sysEventHashRecord));
     SysEvent repackSysEvent("test", nullptr, sysEventCreator);
     testSeq++;
@@ -181,5 +183,37 @@ HWTEST_F(SysEventRepeatTest, CheckEventRepeatTest_04, testing::ext::TestSize.Lev
     ASSERT_EQ(SysEventRepeatDb::GetInstance().QueryHappentime(sysEventHashRecord), 0);
     SysEventRepeatDb::GetInstance().Clear(now);
 }
+
+/**
+ * @tc.name: CheckEventRepeatTest_05
+ * @tc.desc: test the repeated event is answered by SysEventRepeatCache.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SysEventRepeatTest, CheckEventRepeatTest_05, testing::ext::TestSize.Level1)
+{
+    TestContext context;
+    HiviewGlobal::CreateInstance(context);
+    SysEventCreator sysEventCreator("WINDOWMANAGER", "NO_FOCUS_WINDOW", SysEventCreator::FAULT);
+    auto testHash = "cachedhash" + std::to_string(time(nullptr));
+    sysEventCreator.SetKeyValue("FINGERPRINT", testHash);
+    auto statsBefore = SysEventRepeatCache::GetInstance().GetStats();
+    constexpr int checkCnt = 10; // test value
+    for (int i = 0; i < checkCnt; ++i) {
+        SysEvent sysEvent("test", nullptr, sysEventCreator);
+        sysEvent.SetLevel("CRITICAL");
+        sysEvent.SetEventSeq(i);
+        EventStore::SysEventDao::CheckRepeat(sysEvent);
+        ASSERT_EQ(sysEvent.log_, i == 0 ? (LOG_ALLOW_PACK|LOG_PACKED) : (LOG_NOT_ALLOW_PACK|LOG_REPEAT));
+    }
+    auto statsAfter = SysEventRepeatCache::GetInstance().GetStats();
+    ASSERT_GE(statsAfter.hitCount - statsBefore.hitCount, checkCnt - 1);
+
+    // the record is visible in db after flushing
+    SysEventRepeatCache::GetInstance().Flush();
+    ASSERT_GE(SysEventRepeatCache::GetInstance().GetStats().writeCount - statsBefore.writeCount, 1U);
+    SysEventHashRecord sysEventHashRecord("WINDOWMANAGER", "NO_FOCUS_WINDOW");
+    sysEventHashRecord.eventHash = testHash;
+    ASSERT_GT(SysEventRepeatDb::GetInstance().QueryHappentime(sysEventHashRecord), 0);
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
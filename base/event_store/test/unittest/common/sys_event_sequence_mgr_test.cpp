@@ -15,6 +15,10 @@
 
 #include "sys_event_sequence_mgr_test.h"
 
+#include <set>
+#include <thread>
+#include <vector>
+
 #include <gmock/gmock.h>
 
 #include "file_util.h"
@@ -124,5 +128,40 @@ HWTEST_F(SysEventSequenceMgrTest, SysEventSequenceMgrTest003, testing::ext::Test
     auto eventSeqNew = EventStore::SysEventSequenceManager::GetInstance().GetSequence();
     ASSERT_NE(eventSeq, eventSeqNew);
 }
+
+/**
+ * @tc.name: SysEventSequenceMgrTest004
+ * @tc.desc: test allocating sequences concurrently
+ * @tc.type: FUNC
+ * @tc.require: issueI9U6IV
+ */
+HWTEST_F(SysEventSequenceMgrTest, SysEventSequenceMgrTest004, testing::ext::TestSize.Level3)
+{
+    HiviewTestContext hiviewTestContext;
+    HiviewGlobal::CreateInstance(hiviewTestContext);
+    auto& seqMgr = EventStore::SysEventSequenceManager::GetInstance();
+    int64_t startSeq = seqMgr.GetSequence();
+    constexpr size_t threadCnt = 4; // test value
+    constexpr size_t allocCnt = 1000; // test value
+    std::vector<std::vector<int64_t>> allocSeqs(threadCnt);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCnt; ++i) {
+        threads.emplace_back([&seqMgr, &seqs = allocSeqs[i]] {
+            for (size_t j = 0; j < allocCnt; ++j) {
+                seqs.emplace_back(seqMgr.AllocSequence());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::set<int64_t> uniqueSeqs;
+    for (const auto& seqs : allocSeqs) {
+        uniqueSeqs.insert(seqs.begin(), seqs.end());
+    }
+    ASSERT_EQ(uniqueSeqs.size(), threadCnt * allocCnt);
+    ASSERT_EQ(*uniqueSeqs.begin(), startSeq);
+    ASSERT_EQ(seqMgr.GetSequence(), startSeq + static_cast<int64_t>(threadCnt * allocCnt));
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
@@ -15,6 +15,7 @@
 
 #include "sys_event_store_utility_test.h"
 
+#include <chrono>
 #include <gmock/gmock.h>
 
 #include "base_def.h"
@@ -23,10 +24,15 @@
 #include "content_reader_version_1.h"
 #include "content_reader_version_2.h"
 #include "content_reader_version_3.h"
+#include "decoded/decoded_event.h"
 #include "event_db_file_util.h"
+#include "file_util.h"
 #include "hiview_logger.h"
+#include "securec.h"
 #include "sys_event_doc_reader.h"
 #include "sys_event_doc_writer.h"
+#include "sys_event_page_summary.h"
+#include "sys_event_param_index.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -157,6 +163,36 @@ void TestEventsOfDocReader(const std::string& path, bool isVersionEmpty = false)
     }
 }
 
+void TestMmapModeOfDocReader(const std::string& path)
+{
+    SysEventDocReader streamReader(path);
+    DocQuery streamQuery;
+    EntryQueue streamEntries(CompareSeqFuncGreater);
+    int streamNum = 0;
+    ASSERT_EQ(streamReader.Read(streamQuery, streamEntries, streamNum), DOC_STORE_SUCCESS);
+
+    SysEventDocReader mmapReader(path, true);
+    DocQuery mmapQuery;
+    EntryQueue mmapEntries(CompareSeqFuncGreater);
+    int mmapNum = 0;
+    ASSERT_EQ(mmapReader.Read(mmapQuery, mmapEntries, mmapNum), DOC_STORE_SUCCESS);
+    ASSERT_GT(mmapNum, 0);
+    ASSERT_EQ(mmapNum, streamNum);
+    while (!streamEntries.empty() && !mmapEntries.empty()) {
+        auto& streamEntry = streamEntries.top();
+        auto& mmapEntry = mmapEntries.top();
+        ASSERT_EQ(streamEntry.id, mmapEntry.id);
+        ASSERT_EQ(streamEntry.ts, mmapEntry.ts);
+        ASSERT_EQ(streamEntry.data->GetDataLength(), mmapEntry.data->GetDataLength());
+        ASSERT_EQ(memcmp(streamEntry.data->GetData(), mmapEntry.data->GetData(),
+            streamEntry.data->GetDataLength()), 0);
+        streamEntries.pop();
+        mmapEntries.pop();
+    }
+    ASSERT_TRUE(streamEntries.empty());
+    ASSERT_TRUE(mmapEntries.empty());
+}
+
 std::shared_ptr<SysEvent> InitNewEvent(int64_t eventSeq)
 {
     std::string eventContent = R"({"domain_":"TEST_DOMAIN","name_":"TEST_VERSION1","type_":1,)";
@@ -166,6 +202,108 @@ std::shared_ptr<SysEvent> InitNewEvent(int64_t eventSeq)
     eventContent.append(R"(})");
     return std::make_shared<SysEvent>("", nullptr, eventContent);
 }
+
+std::shared_ptr<SysEvent> InitNewEventWithParams(int64_t eventSeq)
+{
+    std::string eventContent = R"({"domain_":"TEST_DOMAIN","name_":"TEST_VERSION1","type_":1,)";
+    eventContent.append(R"("time_":1742021943126,"tz_":"+0800","pid_":92,"tid_":92,"uid_":0,"log_":0,)");
+    eventContent.append(R"("id_":"12254568215815823881","MSG":"none","level_":"CRITICAL","seq_":)");
+    eventContent.append(std::to_string(eventSeq));
+    eventContent.append(R"(,"ARR":[1,2,3],"P1":)").append(std::to_string(eventSeq));
+    eventContent.append(R"(,"P2":"str)").append(std::to_string(eventSeq % 2)); // 2 is a test modulus
+    eventContent.append(R"(","P3":1.5,"P4":-1,"P5":18446744073709551610})");
+    return std::make_shared<SysEvent>("", nullptr, eventContent);
+}
+
+std::shared_ptr<SysEvent> InitNewEventWithModule(int64_t eventSeq)
+{
+    std::string eventContent = R"({"domain_":"RELIABILITY","name_":"TEST_INDEX","type_":1,)";
+    eventContent.append(R"("time_":1742021943126,"tz_":"+0800","pid_":92,"tid_":92,"uid_":0,"log_":0,)");
+    eventContent.append(R"("id_":"12254568215815823881","level_":"CRITICAL","seq_":)");
+    eventContent.append(std::to_string(eventSeq));
+    eventContent.append(R"(,"MODULE_UID":)").append(std::to_string(eventSeq % 10)); // 10 is a test modulus
+    eventContent.append(R"(,"MODULE_NAME":"module)").append(std::to_string(eventSeq % 5)); // 5 is a test modulus
+    eventContent.append(R"("})");
+    return std::make_shared<SysEvent>("", nullptr, eventContent);
+}
+
+std::vector<int64_t> QueryEventSeqs(const std::string& path, bool isMmapMode, const DocQuery& query)
+{
+    EntryQueue entries(CompareSeqFuncGreater);
+    int num = 0;
+    std::vector<int64_t> seqs;
+    if (SysEventDocReader(path, isMmapMode).Read(query, entries, num) != DOC_STORE_SUCCESS) {
+        return seqs;
+    }
+    while (!entries.empty()) {
+        seqs.emplace_back(entries.top().id);
+        entries.pop();
+    }
+    return seqs;
+}
+
+struct TestCond {
+    std::string col;
+    Op op;
+    FieldValue value;
+};
+
+// the extra conditions matched by walking all the decoded params, as DocQuery used to do
+bool IsMatchedByDecodedEvent(EventRaw::DecodedEvent& decodedEvent, const std::vector<TestCond>& conds)
+{
+    const auto& params = decodedEvent.GetAllCustomizedValues();
+    return std::all_of(conds.begin(), conds.end(), [&params] (const auto& cond) {
+        auto iter = std::find_if(params.begin(), params.end(), [&cond] (const auto& param) {
+            return param->GetKey() == cond.col;
+        });
+        FieldValue paramValue;
+        if (iter == params.end()) {
+            return false;
+        } else if (int64_t intValue = 0; (*iter)->AsInt64(intValue)) {
+            paramValue = intValue;
+        } else if (uint64_t uintValue = 0; (*iter)->AsUint64(uintValue)) {
+            paramValue = uintValue;
+        } else if (double dValue = 0; (*iter)->AsDouble(dValue)) {
+            paramValue = dValue;
+        } else if (std::string sValue; (*iter)->AsString(sValue)) {
+            paramValue = sValue;
+        } else {
+            return false;
+        }
+        switch (cond.op) {
+            case Op::EQ:
+                return paramValue == cond.value;
+            case Op::NE:
+                return paramValue != cond.value;
+            case Op::LT:
+                return paramValue < cond.value;
+            case Op::LE:
+                return paramValue <= cond.value;
+            case Op::GT:
+                return paramValue > cond.value;
+            case Op::GE:
+                return paramValue >= cond.value;
+            case Op::SW:
+                return paramValue.IsStartWith(cond.value);
+            default:
+                return false;
+        }
+    });
+}
+
+// the event stored in the db file: blockSize + seq + raw data without the leading blockSize, domain and name + crc
+std::vector<uint8_t> BuildStoredContent(std::shared_ptr<EventRaw::RawData> rawData, int64_t eventSeq)
+{
+    constexpr uint32_t rawDataOffset = HIVIEW_BLOCK_SIZE + MAX_DOMAIN_LEN + MAX_EVENT_NAME_LEN;
+    uint32_t dataSize = rawData->GetDataLength() - rawDataOffset;
+    uint32_t contentSize = HIVIEW_BLOCK_SIZE + SEQ_SIZE + dataSize + CRC_SIZE;
+    std::vector<uint8_t> content(contentSize, 0);
+    (void)memcpy_s(content.data(), contentSize, &contentSize, HIVIEW_BLOCK_SIZE);
+    (void)memcpy_s(content.data() + HIVIEW_BLOCK_SIZE, contentSize - HIVIEW_BLOCK_SIZE, &eventSeq, SEQ_SIZE);
+    (void)memcpy_s(content.data() + HIVIEW_BLOCK_SIZE + SEQ_SIZE, contentSize - HIVIEW_BLOCK_SIZE - SEQ_SIZE,
+        rawData->GetData() + rawDataOffset, dataSize);
+    return content;
+}
 }
 
 void SysEventStoreUtilityTest::SetUpTestCase()
@@ -294,6 +432,7 @@ HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest004, testing::ext::Te
         }
 
         TestEventsOfDocReader(dbPath);
+        TestMmapModeOfDocReader(dbPath);
     }
 }
 
@@ -307,6 +446,8 @@ HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest005, testing::ext::Te
 {
     SysEventDocReader reader(TEST_DB_VERSION1_FILE);
     ASSERT_EQ(reader.ReadMaxEventSequence(), 544); // 544 is expected event sequence value
+    SysEventDocReader mmapReader(TEST_DB_VERSION1_FILE, true);
+    ASSERT_EQ(mmapReader.ReadMaxEventSequence(), 544); // 544 is expected event sequence value
 }
 
 /**
@@ -409,5 +550,294 @@ HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest010, testing::ext::Te
     sysEvent->SetReportInterval(1800); // 1800 is a test report interval
     ASSERT_TRUE(EventDbFileUtil::IsMatchedDbFilePath("*/HIVIEW-3-MINOR-101-1800.db", sysEvent));
 }
+
+/**
+ * @tc.name: SysEventStoreUtilityTest011
+ * @tc.desc: Test the page summary based range check of DocQuery
+ * @tc.type: FUNC
+ * @tc.require: issueICT59K
+ */
+HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest011, testing::ext::TestSize.Level3)
+{
+    PageSummary page;
+    DocQuery emptyQuery;
+    ASSERT_FALSE(emptyQuery.IsContainInnerConds(page));
+    DocPageSummary::AddEvent(page, 100, 1742021943126); // 100 is a test event sequence
+    DocPageSummary::AddEvent(page, 200, 1742021943226); // 200 is a test event sequence
+    ASSERT_TRUE(emptyQuery.IsContainInnerConds(page));
+
+    DocQuery seqQuery;
+    seqQuery.And(Cond(EventCol::SEQ, Op::GT, 200)); // 200 is a test event sequence
+    ASSERT_FALSE(seqQuery.IsContainInnerConds(page));
+    DocQuery seqRangeQuery;
+    seqRangeQuery.And(Cond(EventCol::SEQ, Op::GE, 150)); // 150 is a test event sequence
+    seqRangeQuery.And(Cond(EventCol::SEQ, Op::LT, 300)); // 300 is a test event sequence
+    ASSERT_TRUE(seqRangeQuery.IsContainInnerConds(page));
+
+    DocQuery tsQuery;
+    tsQuery.And(Cond(EventCol::TS, Op::LT, 1742021943126)); // 1742021943126 is a test timestamp
+    ASSERT_FALSE(tsQuery.IsContainInnerConds(page));
+    DocQuery otherQuery;
+    otherQuery.And(Cond(EventCol::PID, Op::EQ, 1)); // 1 is a test pid
+    ASSERT_TRUE(otherQuery.IsContainInnerConds(page));
+}
+
+/**
+ * @tc.name: SysEventStoreUtilityTest012
+ * @tc.desc: Test the extra conditions of DocQuery on a synthetic db file against the decoded event
+ * @tc.type: FUNC
+ * @tc.require: issueICT59K
+ */
+HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest012, testing::ext::TestSize.Level3)
+{
+    const std::string testPath = "/data/test/TEST_DOMAIN/TEST_QUERY-1-CRITICAL-1.db";
+    FileUtil::RemoveFile(testPath);
+    constexpr int64_t eventNum = 200;
+    {
+        SysEventDocWriter writer(testPath);
+        for (int64_t seq = 0; seq < eventNum; ++seq) {
+            ASSERT_EQ(writer.Write(InitNewEventWithParams(seq)), DOC_STORE_SUCCESS);
+        }
+    }
+    EntryQueue allEntries(CompareSeqFuncGreater);
+    int allNum = 0;
+    ASSERT_EQ(SysEventDocReader(testPath, true).Read(DocQuery(), allEntries, allNum), DOC_STORE_SUCCESS);
+    ASSERT_EQ(allNum, eventNum);
+    std::vector<std::pair<int64_t, std::shared_ptr<EventRaw::RawData>>> rawDatas;
+    while (!allEntries.empty()) {
+        rawDatas.emplace_back(allEntries.top().id, allEntries.top().data);
+        allEntries.pop();
+    }
+
+    const std::vector<std::vector<TestCond>> condGroups = {
+        { { "P1", Op::GE, FieldValue(100) } }, // 100 is a test param value
+        { { "P1", Op::LT, FieldValue(150) }, { "P2", Op::EQ, FieldValue(std::string("str1")) } }, // 150: test value
+        { { "P2", Op::SW, FieldValue(std::string("str")) }, { "P3", Op::LT, FieldValue(2.0) } }, // 2.0: test value
+        { { "P4", Op::EQ, FieldValue(-1) }, { "P5", Op::GT, FieldValue(1) } }, // -1 and 1 are test values
+        { { "P2", Op::NE, FieldValue(std::string("str0")) }, { "P1", Op::LE, FieldValue(10) } }, // 10: test value
+        { { "P2", Op::EQ, FieldValue(1) } }, // the type of the value mismatches the param
+        { { "ARR", Op::EQ, FieldValue(1) } },
+        { { "P6", Op::EQ, FieldValue(1) } },
+    };
+    const std::vector<int> expectedNums = { 100, 75, 200, 200, 5, 0, 0, 0 };
+    for (size_t i = 0; i < condGroups.size(); ++i) {
+        DocQuery query;
+        for (const auto& cond : condGroups[i]) {
+            query.And(Cond(cond.col, cond.op, cond.value));
+        }
+        EntryQueue entries(CompareSeqFuncGreater);
+        int num = 0;
+        ASSERT_EQ(SysEventDocReader(testPath, true).Read(query, entries, num), DOC_STORE_SUCCESS);
+        std::vector<int64_t> seqs;
+        while (!entries.empty()) {
+            seqs.emplace_back(entries.top().id);
+            entries.pop();
+        }
+        std::vector<int64_t> expectedSeqs;
+        for (const auto& [seq, rawData] : rawDatas) {
+            EventRaw::DecodedEvent decodedEvent(rawData->GetData(), rawData->GetDataLength());
+            if (IsMatchedByDecodedEvent(decodedEvent, condGroups[i])) {
+                expectedSeqs.emplace_back(seq);
+            }
+        }
+        ASSERT_EQ(seqs, expectedSeqs);
+        ASSERT_EQ(num, expectedNums[i]);
+    }
+    FileUtil::RemoveFile(testPath);
+}
+
+/**
+ * @tc.name: SysEventStoreUtilityTest013
+ * @tc.desc: Test the secondary index on the customized params and the equality conditions of DocQuery
+ * @tc.type: FUNC
+ * @tc.require: issueICT59K
+ */
+HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest013, testing::ext::TestSize.Level3)
+{
+    DocParamIndex index;
+    index.params = { "P1", "P2", "P3", "ARR" };
+    constexpr int64_t eventNum = 100;
+    for (int64_t seq = 0; seq < eventNum; ++seq) {
+        auto rawData = InitNewEventWithParams(seq)->GetRawData();
+        ASSERT_NE(rawData, nullptr);
+        index.AddEvent(static_cast<uint64_t>(seq), rawData->GetData(), rawData->GetDataLength());
+    }
+    std::string key;
+    ASSERT_TRUE(DocParamIndex::GetKey(FieldValue(10), key)); // 10 is a test param value
+    ASSERT_EQ(index.GetPositions("P1", key), std::vector<uint64_t>({ 10 })); // 10 is the expected position
+    ASSERT_TRUE(DocParamIndex::GetKey(FieldValue(static_cast<uint64_t>(10)), key)); // 10 is a test param value
+    ASSERT_EQ(index.GetPositions("P1", key).size(), 1); // 1 is the expected position num
+    ASSERT_TRUE(DocParamIndex::GetKey(FieldValue(std::string("str1")), key));
+    ASSERT_EQ(index.GetPositions("P2", key).size(), 50); // 50 is the expected position num
+    ASSERT_TRUE(DocParamIndex::GetKey(FieldValue(std::string("10")), key));
+    ASSERT_TRUE(index.GetPositions("P1", key).empty());
+
+    // the floating number has no key, the events holding it are always the candidates
+    ASSERT_FALSE(DocParamIndex::GetKey(FieldValue(1.5), key)); // 1.5 is a test param value
+    ASSERT_TRUE(DocParamIndex::GetKey(FieldValue(1), key)); // 1 is a test param value
+    ASSERT_EQ(index.GetPositions("P3", key).size(), eventNum);
+    ASSERT_TRUE(index.GetPositions("ARR", key).empty());
+
+    DocQuery query;
+    query.And(Cond("P1", Op::GE, 1)); // 1 is a test param value
+    query.And(Cond("P3", Op::EQ, 1.5)); // 1.5 is a test param value
+    query.And(Cond("P2", Op::EQ, std::string("str1")));
+    auto equalConds = query.GetEqualConds(index.params);
+    ASSERT_EQ(equalConds.size(), 2); // 2 is the expected condition num
+    ASSERT_EQ(equalConds[0].first, "P3");
+    ASSERT_EQ(equalConds[1].first, "P2");
+
+    const std::string testPath = "/data/test/TEST_DOMAIN/TEST_INDEX-1-CRITICAL-1.db";
+    SysEventParamIndexCache::GetInstance().Put(testPath, std::make_shared<DocParamIndex>(index));
+    ASSERT_NE(SysEventParamIndexCache::GetInstance().Get(testPath), nullptr);
+    SysEventParamIndexCache::GetInstance().Remove(testPath);
+    ASSERT_EQ(SysEventParamIndexCache::GetInstance().Get(testPath), nullptr);
+}
+
+/**
+ * @tc.name: SysEventStoreUtilityTest014
+ * @tc.desc: Test the extra conditions checked on the stored content before the raw data is built
+ * @tc.type: FUNC
+ * @tc.require: issueICT59K
+ */
+HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest014, testing::ext::TestSize.Level3)
+{
+    auto reader = ContentReaderFactory::GetInstance().Get(EventStore::EVENT_DATA_FORMATE_VERSION::VERSION4);
+    ASSERT_NE(reader, nullptr);
+    EventInfo info;
+    ASSERT_EQ(strcpy_s(info.domain, MAX_DOMAIN_LEN, "TEST_DOMAIN"), EOK);
+    ASSERT_EQ(strcpy_s(info.name, MAX_EVENT_NAME_LEN, "TEST_VERSION1"), EOK);
+    info.level = "CRITICAL";
+    std::vector<DocQuery> queries(6); // 6 is the test query num
+    queries[0].And(Cond("P1", Op::GE, 50)); // 50 is a test param value
+    queries[1].And(Cond("P2", Op::EQ, std::string("str1")));
+    queries[2].And(Cond("P3", Op::LT, 2.0)); // 2.0 is a test param value
+    queries[2].And(Cond("P5", Op::GT, 1)); // 1 is a test param value
+    queries[3].And(Cond("ARR", Op::EQ, 1));
+    queries[4].And(Cond("P6", Op::EQ, 1));
+    queries[5].And(Cond(EventCol::LEVEL, Op::EQ, std::string("CRITICAL")));
+    const std::vector<int> expectedNums = { 50, 50, 100, 0, 0, 100 };
+    std::vector<int> matchedNums(queries.size(), 0);
+    constexpr int64_t eventNum = 100;
+    for (int64_t seq = 0; seq < eventNum; ++seq) {
+        auto content = BuildStoredContent(InitNewEventWithParams(seq)->GetRawData(), seq);
+        info.seq = seq;
+        auto rawData = reader->ReadRawData(info, content.data(), content.size());
+        ASSERT_NE(rawData, nullptr);
+        auto cursor = reader->ReadParamCursor(content.data(), content.size());
+        ASSERT_TRUE(cursor.IsValid());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            bool isMatched = queries[i].IsContainExtraConds(rawData->GetData(), rawData->GetDataLength());
+            matchedNums[i] += isMatched ? 1 : 0;
+            if (!queries[i].HasExtraCondsOnAppendedParams()) {
+                ASSERT_EQ(queries[i].IsContainExtraConds(cursor), isMatched);
+            }
+        }
+    }
+    ASSERT_EQ(matchedNums, expectedNums);
+    ASSERT_TRUE(queries[5].HasExtraCondsOnAppendedParams());
+
+    // the broken content has no params to walk
+    auto content = BuildStoredContent(InitNewEventWithParams(1)->GetRawData(), 1); // 1 is a test event sequence
+    ASSERT_FALSE(reader->ReadParamCursor(content.data(), HIVIEW_BLOCK_SIZE + SEQ_SIZE).IsValid());
+    ASSERT_FALSE(queries[1].IsContainExtraConds(reader->ReadParamCursor(content.data(), 0)));
+}
+
+/**
+ * @tc.name: SysEventStoreUtilityTest015
+ * @tc.desc: Test the query on the indexed params of SysEventDocReader while the db file grows
+ * @tc.type: FUNC
+ * @tc.require: issueICT59K
+ */
+HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest015, testing::ext::TestSize.Level3)
+{
+    const std::string testDir = "/data/test/RELIABILITY/";
+    const std::string testPath = testDir + "TEST_INDEX-1-CRITICAL-1.db";
+    ASSERT_TRUE(FileUtil::ForceCreateDirectory(testDir));
+    FileUtil::RemoveFile(testPath);
+    SysEventParamIndexCache::GetInstance().Remove(testPath);
+    constexpr int64_t batchNum = 100;
+    int64_t seq = 0;
+    auto writeEvents = [&testPath, &seq] (int64_t eventNum) {
+        SysEventDocWriter writer(testPath);
+        for (int64_t i = 0; i < eventNum; ++i, ++seq) {
+            ASSERT_EQ(writer.Write(InitNewEventWithModule(seq)), DOC_STORE_SUCCESS);
+        }
+    };
+    DocQuery uidQuery;
+    uidQuery.And(Cond("MODULE_UID", Op::EQ, 3)); // 3 is a test module uid
+    DocQuery nameQuery;
+    nameQuery.And(Cond("MODULE_NAME", Op::EQ, std::string("module1")));
+    nameQuery.And(Cond("MODULE_UID", Op::GT, 5)); // 5 is a test module uid
+
+    // the mmap reader reads by the index, the stream reader walks all the events
+    writeEvents(batchNum);
+    auto uidSeqs = QueryEventSeqs(testPath, true, uidQuery);
+    ASSERT_EQ(uidSeqs.size(), 10); // 10 is the expected event num
+    ASSERT_EQ(uidSeqs, QueryEventSeqs(testPath, false, uidQuery));
+    auto nameSeqs = QueryEventSeqs(testPath, true, nameQuery);
+    ASSERT_EQ(nameSeqs.size(), 10); // 10 is the expected event num
+    ASSERT_EQ(nameSeqs, QueryEventSeqs(testPath, false, nameQuery));
+    auto index = SysEventParamIndexCache::GetInstance().Get(testPath);
+    ASSERT_NE(index, nullptr);
+    ASSERT_EQ(index->segments.size(), 1); // 1 is the expected segment num
+
+    // the pages finished since the file grows are indexed into a new segment
+    writeEvents(batchNum);
+    uidSeqs = QueryEventSeqs(testPath, true, uidQuery);
+    ASSERT_EQ(uidSeqs.size(), 20); // 20 is the expected event num
+    ASSERT_EQ(uidSeqs, QueryEventSeqs(testPath, false, uidQuery));
+    auto grownIndex = SysEventParamIndexCache::GetInstance().Get(testPath);
+    ASSERT_NE(grownIndex, nullptr);
+    ASSERT_EQ(grownIndex->segments.size(), 2); // 2 is the expected segment num
+    ASSERT_EQ(grownIndex->segments[0], index->segments[0]);
+    ASSERT_GT(grownIndex->indexedSize, index->indexedSize);
+
+    SysEventParamIndexCache::GetInstance().Remove(testPath);
+    FileUtil::RemoveFile(testPath);
+}
+
+/**
+ * @tc.name: SysEventStoreUtilityTest016
+ * @tc.desc: Test the query throughput of DocQuery with 1 to 5 extra conditions on a large synthetic db file
+ * @tc.type: PERF
+ * @tc.require: issueICT59K
+ */
+HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest016, testing::ext::TestSize.Level3)
+{
+    const std::string testPath = "/data/test/TEST_DOMAIN/TEST_QUERY_PERF-1-CRITICAL-1.db";
+    FileUtil::RemoveFile(testPath);
+    constexpr int64_t eventNum = 10000;
+    {
+        SysEventDocWriter writer(testPath);
+        for (int64_t seq = 0; seq < eventNum; ++seq) {
+            ASSERT_EQ(writer.Write(InitNewEventWithParams(seq)), DOC_STORE_SUCCESS);
+        }
+    }
+    const std::vector<Cond> conds = {
+        Cond("P1", Op::GE, 5000), // 5000 is a test param value
+        Cond("P2", Op::EQ, std::string("str1")),
+        Cond("P3", Op::LT, 2.0), // 2.0 is a test param value
+        Cond("P4", Op::EQ, -1), // -1 is a test param value
+        Cond("P5", Op::GT, 1), // 1 is a test param value
+    };
+    const std::vector<int> expectedNums = { 5000, 2500, 2500, 2500, 2500 };
+    DocQuery query;
+    for (size_t i = 0; i < conds.size(); ++i) {
+        query.And(conds[i]);
+        for (bool isMmapMode : { true, false }) {
+            EntryQueue entries(CompareSeqFuncGreater);
+            int num = 0;
+            auto begin = std::chrono::steady_clock::now();
+            ASSERT_EQ(SysEventDocReader(testPath, isMmapMode).Read(query, entries, num), DOC_STORE_SUCCESS);
+            auto costTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - begin).count();
+            HIVIEW_LOGI("cond num=%{public}zu, mmap=%{public}d, event num=%{public}" PRId64 ", cost=%{public}" PRId64
+                "us", i + 1, isMmapMode, eventNum, static_cast<int64_t>(costTime));
+            ASSERT_EQ(num, expectedNums[i]);
+        }
+    }
+    FileUtil::RemoveFile(testPath);
+}
 } // namespace HiviewDFX
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
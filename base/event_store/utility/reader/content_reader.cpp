@@ -88,6 +88,29 @@ std::shared_ptr<RawData> ContentReader::ReadRawData(const EventInfo& eventInfo,
     return rawData;
 }
 
+EventRaw::DecodedParamCursor ContentReader::ReadParamCursor(uint8_t* content, uint32_t contentSize)
+{
+    EventStore::ContentHeader contentHeader;
+    size_t pos = HIVIEW_BLOCK_SIZE + GetContentHeaderSize();
+    if (contentSize < pos + CRC_SIZE || GetContentHeader(content, contentHeader) != DOC_STORE_SUCCESS) {
+        return EventRaw::DecodedParamCursor(nullptr, 0);
+    }
+    if (contentHeader.isTraceOpened == 1) { // 1: include trace info, 0: exclude trace info
+        pos += sizeof(struct EventRaw::TraceInfo);
+    }
+    size_t paramsEnd = contentSize - CRC_SIZE;
+    if (pos + sizeof(int32_t) > paramsEnd) {
+        return EventRaw::DecodedParamCursor(nullptr, 0);
+    }
+    int32_t paramCnt = 0;
+    (void)memcpy_s(&paramCnt, sizeof(paramCnt), content + pos, sizeof(int32_t));
+    if (paramCnt < 0) {
+        return EventRaw::DecodedParamCursor(nullptr, 0);
+    }
+    pos += sizeof(int32_t);
+    return EventRaw::DecodedParamCursor(content + pos, paramsEnd - pos, static_cast<size_t>(paramCnt));
+}
+
 int ContentReader::AppendDomainAndName(std::shared_ptr<RawData> rawData, const EventInfo& eventInfo)
 {
     if (!rawData->Append(reinterpret_cast<uint8_t*>(const_cast<char*>(eventInfo.domain)), MAX_DOMAIN_LEN)) {
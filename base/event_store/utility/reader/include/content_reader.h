@@ -20,6 +20,7 @@
 #include <string>
 
 #include "base_def.h"
+#include "decoded/decoded_param_cursor.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -55,6 +56,8 @@ public:
 public:
     static uint8_t ReadFmtVersion(std::ifstream& docStream);
     std::shared_ptr<RawData> ReadRawData(const EventInfo& eventInfo, uint8_t* content, uint32_t contentSize);
+    // walks the customized params stored in the content, the cursor is invalid if the content is broken
+    EventRaw::DecodedParamCursor ReadParamCursor(uint8_t* content, uint32_t contentSize);
     virtual int ReadDocDetails(std::ifstream& docStream, EventStore::DocHeader& header,
         uint64_t& docHeaderSize, HeadExtraInfo& headExtra) = 0;
     virtual bool IsValidMagicNum(const uint64_t magicNum) = 0;
@@ -22,6 +22,8 @@
 
 #include "content_reader_factory.h"
 #include "event_doc_reader.h"
+#include "sys_event_page_summary.h"
+#include "sys_event_param_index.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -29,7 +31,8 @@ namespace EventStore {
 using ReadCallback = std::function<bool(uint8_t* content, uint32_t& contentSize)>;
 class SysEventDocReader : public EventDocReader {
 public:
-    SysEventDocReader(const std::string& path);
+    // in mmap mode the events are walked in the mapped file directly, without copying each of them
+    SysEventDocReader(const std::string& path, bool isMmapMode = false);
     ~SysEventDocReader();
     int Read(const DocQuery& query, EntryQueue& entries, int& num) override;
     int ReadFileSize();
@@ -41,9 +44,17 @@ public:
 private:
     void Init(const std::string& path);
     void InitEventInfo(const std::string& path);
-    int Read(ReadCallback callback);
+    int Read(ReadCallback callback, const DocQuery* query = nullptr);
     int ReadContent(uint8_t** content, uint32_t& contentSize, uint32_t pageIndex);
     int ReadPages(ReadCallback callback);
+    void MapFile(const std::string& path);
+    void UnmapFile();
+    int ReadMappedPages(ReadCallback callback, const DocQuery* query);
+    uint64_t ReadMappedPage(uint64_t pagePos, uint64_t pageEnd, ReadCallback& callback, PageSummary& page);
+    DocPageSummaryPtr GetPageSummary();
+    bool GetIndexedCond(const DocQuery& query, std::string& param, std::string& key);
+    int ReadIndexedPages(ReadCallback callback, const std::string& param, const std::string& key);
+    DocParamIndexPtr GetParamIndex(const std::vector<std::string>& params);
     bool HasReadFileEnd();
     bool HasReadPageEnd(uint32_t pageIndex);
     bool IsValidHeader(const DocHeader& header);
@@ -61,6 +72,8 @@ private:
     uint64_t docHeaderSize_ = 0;
     HeadExtraInfo headExtra_;
     EventInfo info_;
+    uint8_t* mappedData_ = nullptr;
+    uint64_t mappedSize_ = 0;
 }; // EventDocWriter
 } // EventStore
 } // HiviewDFX
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIVIEW_BASE_EVENT_STORE_UTILITY_SYS_EVENT_PAGE_SUMMARY_H
+#define HIVIEW_BASE_EVENT_STORE_UTILITY_SYS_EVENT_PAGE_SUMMARY_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base_def.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventStore {
+struct DocPageSummary {
+    uint64_t headerSize = 0;
+    uint64_t pageSize = 0;
+    // size of the file when summarized, the pages ending before it will not change anymore
+    uint64_t fileSize = 0;
+    PageSummary total;
+    std::vector<PageSummary> pages;
+
+    size_t GetFinishedPageNum() const;
+    void AddPage(const PageSummary& page);
+    static void AddEvent(PageSummary& page, int64_t seq, int64_t timestamp);
+};
+using DocPageSummaryPtr = std::shared_ptr<const DocPageSummary>;
+
+/*
+ * Page summaries of the recently read event files, built while the file is read for the first time and
+ * extended when the file grows, so that the later queries only need to walk the pages in their range.
+ */
+class SysEventPageSummaryCache : public OHOS::DelayedRefSingleton<SysEventPageSummaryCache> {
+public:
+    DocPageSummaryPtr Get(const std::string& path);
+    void Put(const std::string& path, DocPageSummaryPtr summary);
+    void Remove(const std::string& path);
+    void Clear();
+
+private:
+    using SummaryPair = std::pair<std::list<std::string>::iterator, DocPageSummaryPtr>;
+
+    std::list<std::string> lruList_;
+    std::unordered_map<std::string, SummaryPair> summaries_;
+    std::mutex mutex_;
+}; // SysEventPageSummaryCache
+} // EventStore
+} // HiviewDFX
+} // OHOS
+#endif // HIVIEW_BASE_EVENT_STORE_UTILITY_SYS_EVENT_PAGE_SUMMARY_H
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIVIEW_BASE_EVENT_STORE_UTILITY_SYS_EVENT_PARAM_INDEX_H
+#define HIVIEW_BASE_EVENT_STORE_UTILITY_SYS_EVENT_PARAM_INDEX_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "singleton.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventStore {
+class FieldValue;
+
+// the positions of the events in a range of the pages, never changed once the index holding it is shared
+struct DocParamIndexSegment {
+    // <param, <key of the value, positions of the events in the file>>
+    std::unordered_map<std::string, std::unordered_map<std::string, std::vector<uint64_t>>> positions;
+    // <param, positions of the events whose value has no key, such as the floating number>
+    std::unordered_map<std::string, std::vector<uint64_t>> unkeyedPositions;
+};
+
+struct DocParamIndex {
+    uint64_t headerSize = 0;
+    uint64_t pageSize = 0;
+    // the events ending before it, which are in the finished pages, have been indexed
+    uint64_t indexedSize = 0;
+    std::vector<std::string> params;
+    // the pages indexed since the file grows are kept in a new segment, the former ones are shared with
+    // the index before the growth instead of being copied
+    std::vector<std::shared_ptr<DocParamIndexSegment>> segments;
+
+    // the event is added to the last segment
+    void AddEvent(uint64_t pos, uint8_t* rawData, size_t len);
+    // the positions of the events which may hold the value of the key, in ascending order
+    std::vector<uint64_t> GetPositions(const std::string& param, const std::string& key) const;
+    // the equal values share the same key, the floating number has no key since it is compared with epsilon
+    static bool GetKey(const FieldValue& value, std::string& key);
+};
+using DocParamIndexPtr = std::shared_ptr<const DocParamIndex>;
+
+/*
+ * Secondary indexes on the customized params configured for the domain, built while the file is queried
+ * by the equality condition of these params for the first time and extended when the file grows.
+ */
+class SysEventParamIndexCache : public OHOS::DelayedRefSingleton<SysEventParamIndexCache> {
+public:
+    DocParamIndexPtr Get(const std::string& path);
+    void Put(const std::string& path, DocParamIndexPtr index);
+    void Remove(const std::string& path);
+    void Clear();
+
+private:
+    using IndexPair = std::pair<std::list<std::string>::iterator, DocParamIndexPtr>;
+
+    std::list<std::string> lruList_;
+    std::unordered_map<std::string, IndexPair> indexes_;
+    std::mutex mutex_;
+}; // SysEventParamIndexCache
+} // EventStore
+} // HiviewDFX
+} // OHOS
+#endif // HIVIEW_BASE_EVENT_STORE_UTILITY_SYS_EVENT_PARAM_INDEX_H
@@ -14,9 +14,15 @@
  */
 #include "sys_event_doc_reader.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <cinttypes>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include "event_db_file_util.h"
+#include "event_store_config.h"
 #include "hiview_logger.h"
 #include "securec.h"
 #include "string_util.h"
@@ -40,20 +46,57 @@ void ReadValueAndReset(std::ifstream& in, T& value)
     in.read(reinterpret_cast<char*>(&value), sizeof(T));
     in.seekg(GetNegativeNum(sizeof(T)), std::ios::cur);
 }
+
+constexpr uint32_t MIN_CONTENT_SIZE = HIVIEW_BLOCK_SIZE + sizeof(ContentHeader) + CRC_SIZE;
 }
 
-SysEventDocReader::SysEventDocReader(const std::string& path): EventDocReader(path)
+SysEventDocReader::SysEventDocReader(const std::string& path, bool isMmapMode): EventDocReader(path)
 {
     Init(path);
+    if (isMmapMode) {
+        MapFile(path);
+    }
 }
 
 SysEventDocReader::~SysEventDocReader()
 {
+    UnmapFile();
     if (in_.is_open()) {
         in_.close();
     }
 }
 
+void SysEventDocReader::MapFile(const std::string& path)
+{
+    if (fileSize_ <= 0) {
+        return;
+    }
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        HIVIEW_LOGW("failed to open file=%{public}s, errno=%{public}d", path.c_str(), errno);
+        return;
+    }
+    // only the part existing while the reader inits is visible, the same as reading by stream
+    void* data = mmap(nullptr, static_cast<size_t>(fileSize_), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        HIVIEW_LOGW("failed to map file=%{public}s, errno=%{public}d", path.c_str(), errno);
+        return;
+    }
+    (void)madvise(data, static_cast<size_t>(fileSize_), MADV_SEQUENTIAL);
+    mappedData_ = static_cast<uint8_t*>(data);
+    mappedSize_ = static_cast<uint64_t>(fileSize_);
+}
+
+void SysEventDocReader::UnmapFile()
+{
+    if (mappedData_ != nullptr) {
+        munmap(mappedData_, static_cast<size_t>(mappedSize_));
+        mappedData_ = nullptr;
+        mappedSize_ = 0;
+    }
+}
+
 void SysEventDocReader::Init(const std::string& path)
 {
     in_.open(path, std::ios::binary);
@@ -114,10 +157,15 @@ int SysEventDocReader::Read(const DocQuery& query, EntryQueue& entries, int& num
         TryToAddEntry(content, contentSize, query, entries, num);
         return true;
     };
-    return Read(saveFunc);
+    // none of the events in the file is in the queried range
+    if (auto summary = GetPageSummary(); summary != nullptr && summary->fileSize == mappedSize_ &&
+        !query.IsContainInnerConds(summary->total)) {
+        return DOC_STORE_SUCCESS;
+    }
+    return Read(saveFunc, &query);
 }
 
-int SysEventDocReader::Read(ReadCallback callback)
+int SysEventDocReader::Read(ReadCallback callback, const DocQuery* query)
 {
     // read the header
     DocHeader header;
@@ -138,6 +186,9 @@ int SysEventDocReader::Read(ReadCallback callback)
     pageSize_ = header.pageSize * NUM_OF_BYTES_IN_KB;
 
     // read the events
+    if (mappedData_ != nullptr) {
+        return ReadMappedPages(callback, query);
+    }
     if (pageSize_ == 0) {
         uint8_t* content = nullptr;
         uint32_t contentSize = 0;
@@ -191,6 +242,180 @@ int SysEventDocReader::ReadPages(ReadCallback callback)
     return DOC_STORE_SUCCESS;
 }
 
+DocPageSummaryPtr SysEventDocReader::GetPageSummary()
+{
+    if (mappedData_ == nullptr) {
+        return nullptr;
+    }
+    auto summary = SysEventPageSummaryCache::GetInstance().Get(docPath_);
+    // the file has been recreated since summarized
+    if (summary != nullptr && summary->fileSize > mappedSize_) {
+        return nullptr;
+    }
+    return summary;
+}
+
+int SysEventDocReader::ReadMappedPages(ReadCallback callback, const DocQuery* query)
+{
+    if (docHeaderSize_ >= mappedSize_) {
+        return DOC_STORE_SUCCESS;
+    }
+    // the file without page holds only one event
+    if (pageSize_ == 0) {
+        PageSummary page;
+        (void)ReadMappedPage(docHeaderSize_, mappedSize_, callback, page);
+        return DOC_STORE_SUCCESS;
+    }
+    if (std::string param, key; query != nullptr && GetIndexedCond(*query, param, key)) {
+        return ReadIndexedPages(callback, param, key);
+    }
+
+    auto summary = GetPageSummary();
+    if (summary != nullptr && (summary->headerSize != docHeaderSize_ || summary->pageSize != pageSize_)) {
+        summary = nullptr;
+    }
+    // the last page of a summary taken before the file grows may be incomplete, summarize it again
+    size_t summarizedPageNum = 0;
+    std::shared_ptr<DocPageSummary> newSummary = nullptr;
+    if (summary != nullptr && summary->fileSize == mappedSize_) {
+        summarizedPageNum = summary->pages.size();
+    } else {
+        summarizedPageNum = (summary == nullptr) ? 0 : summary->GetFinishedPageNum();
+        newSummary = std::make_shared<DocPageSummary>();
+        newSummary->headerSize = docHeaderSize_;
+        newSummary->pageSize = pageSize_;
+        newSummary->fileSize = mappedSize_;
+    }
+    size_t pageIndex = 0;
+    for (uint64_t pagePos = docHeaderSize_; pagePos < mappedSize_; pagePos += pageSize_, ++pageIndex) {
+        uint64_t pageEnd = std::min(pagePos + pageSize_, mappedSize_);
+        PageSummary page;
+        if (pageIndex < summarizedPageNum) {
+            page = summary->pages[pageIndex];
+            if (query == nullptr || query->IsContainInnerConds(page)) {
+                PageSummary readPage;
+                (void)ReadMappedPage(pagePos, pageEnd, callback, readPage);
+            }
+        } else {
+            uint64_t readEnd = ReadMappedPage(pagePos, pageEnd, callback, page);
+            HIVIEW_LOGD("end to read page, remain size=%{public}" PRIu64 ", file=%{public}s", pageEnd - readEnd,
+                docPath_.c_str());
+        }
+        if (newSummary != nullptr) {
+            newSummary->AddPage(page);
+        }
+    }
+    if (newSummary != nullptr) {
+        SysEventPageSummaryCache::GetInstance().Put(docPath_, newSummary);
+    }
+    return DOC_STORE_SUCCESS;
+}
+
+bool SysEventDocReader::GetIndexedCond(const DocQuery& query, std::string& param, std::string& key)
+{
+    auto indexedParams = EventStoreConfig::GetInstance().GetIndexedParams(info_.domain);
+    if (indexedParams.empty()) {
+        return false;
+    }
+    auto equalConds = query.GetEqualConds(indexedParams);
+    for (const auto& [col, value] : equalConds) {
+        if (DocParamIndex::GetKey(value, key)) {
+            param = col;
+            return true;
+        }
+    }
+    return false;
+}
+
+int SysEventDocReader::ReadIndexedPages(ReadCallback callback, const std::string& param, const std::string& key)
+{
+    auto indexedParams = EventStoreConfig::GetInstance().GetIndexedParams(info_.domain);
+    auto index = GetParamIndex(indexedParams);
+    for (auto pos : index->GetPositions(param, key)) {
+        // the positions are checked again in case the index does not match the mapped file
+        if (pos < docHeaderSize_ || pos + HIVIEW_BLOCK_SIZE > index->indexedSize) {
+            HIVIEW_LOGW("invalid indexed position=%{public}" PRIu64 ", file=%{public}s", pos, docPath_.c_str());
+            continue;
+        }
+        uint32_t contentSize = 0;
+        (void)memcpy_s(&contentSize, sizeof(contentSize), mappedData_ + pos, HIVIEW_BLOCK_SIZE);
+        if (contentSize < MIN_CONTENT_SIZE || contentSize > MAX_NEW_SIZE || contentSize > index->indexedSize - pos) {
+            HIVIEW_LOGW("invalid indexed content size=%{public}u, file=%{public}s", contentSize, docPath_.c_str());
+            continue;
+        }
+        callback(mappedData_ + pos, contentSize);
+    }
+    // the events in the unfinished page are not indexed, walk them one by one
+    for (uint64_t pagePos = index->indexedSize; pagePos < mappedSize_; pagePos += pageSize_) {
+        PageSummary page;
+        (void)ReadMappedPage(pagePos, std::min(pagePos + pageSize_, mappedSize_), callback, page);
+    }
+    return DOC_STORE_SUCCESS;
+}
+
+DocParamIndexPtr SysEventDocReader::GetParamIndex(const std::vector<std::string>& params)
+{
+    auto index = SysEventParamIndexCache::GetInstance().Get(docPath_);
+    // the file has been recreated since indexed
+    if (index != nullptr && (index->headerSize != docHeaderSize_ || index->pageSize != pageSize_ ||
+        index->indexedSize > mappedSize_ || index->params != params)) {
+        index = nullptr;
+    }
+    uint64_t finishedSize = docHeaderSize_ + (mappedSize_ - docHeaderSize_) / pageSize_ * pageSize_;
+    if (index != nullptr && index->indexedSize == finishedSize) {
+        return index;
+    }
+    // only the segments are shared with the former index, the new pages are indexed into a new segment
+    auto newIndex = (index == nullptr) ? std::make_shared<DocParamIndex>() : std::make_shared<DocParamIndex>(*index);
+    newIndex->segments.emplace_back(std::make_shared<DocParamIndexSegment>());
+    if (index == nullptr) {
+        newIndex->headerSize = docHeaderSize_;
+        newIndex->pageSize = pageSize_;
+        newIndex->indexedSize = docHeaderSize_;
+        newIndex->params = params;
+    }
+    ReadCallback indexFunc = [this, &newIndex](uint8_t* content, uint32_t& contentSize) {
+        if (!CheckEventInfo(content)) {
+            return true;
+        }
+        if (auto rawData = BuildRawData(content, contentSize); rawData != nullptr) {
+            newIndex->AddEvent(static_cast<uint64_t>(content - mappedData_), rawData->GetData(),
+                rawData->GetDataLength());
+        }
+        return true;
+    };
+    for (uint64_t pagePos = newIndex->indexedSize; pagePos < finishedSize; pagePos += pageSize_) {
+        PageSummary page;
+        (void)ReadMappedPage(pagePos, pagePos + pageSize_, indexFunc, page);
+    }
+    newIndex->indexedSize = finishedSize;
+    SysEventParamIndexCache::GetInstance().Put(docPath_, newIndex);
+    return newIndex;
+}
+
+uint64_t SysEventDocReader::ReadMappedPage(uint64_t pagePos, uint64_t pageEnd, ReadCallback& callback,
+    PageSummary& page)
+{
+    uint64_t pos = pagePos;
+    while (pos + HIVIEW_BLOCK_SIZE <= pageEnd) {
+        uint32_t contentSize = 0;
+        (void)memcpy_s(&contentSize, sizeof(contentSize), mappedData_ + pos, HIVIEW_BLOCK_SIZE);
+        // the rest of the page is filled with zero, or the event is not written completely
+        if (contentSize < MIN_CONTENT_SIZE || contentSize > MAX_NEW_SIZE || contentSize > pageEnd - pos) {
+            break;
+        }
+        int64_t seq = 0;
+        int64_t timestamp = 0;
+        (void)memcpy_s(&seq, sizeof(seq), mappedData_ + pos + HIVIEW_BLOCK_SIZE, SEQ_SIZE);
+        (void)memcpy_s(&timestamp, sizeof(timestamp), mappedData_ + pos + HIVIEW_BLOCK_SIZE + SEQ_SIZE,
+            sizeof(int64_t));
+        DocPageSummary::AddEvent(page, seq, timestamp);
+        callback(mappedData_ + pos, contentSize);
+        pos += contentSize;
+    }
+    return pos;
+}
+
 bool SysEventDocReader::HasReadFileEnd()
 {
     if (!in_.is_open()) {
@@ -225,8 +450,7 @@ int SysEventDocReader::ReadContent(uint8_t** content, uint32_t& contentSize, uin
         return DOC_STORE_READ_EMPTY;
     }
     ReadValueAndReset(in_, contentSize);
-    constexpr uint32_t minContentSize = HIVIEW_BLOCK_SIZE + sizeof(ContentHeader) + CRC_SIZE;
-    if (contentSize < minContentSize) {
+    if (contentSize < MIN_CONTENT_SIZE) {
         HIVIEW_LOGD("invalid content size=%{public}u, file=%{public}s", contentSize, docPath_.c_str());
         return DOC_STORE_READ_EMPTY;
     }
@@ -307,13 +531,21 @@ void SysEventDocReader::TryToAddEntry(uint8_t* content, uint32_t contentSize, co
     if (!query.IsContainInnerConds(content)) {
         return;
     }
+    // check extra condition on the stored content, so only the matched events are copied out
+    bool isExtraCondsChecked = !query.HasExtraCondsOnAppendedParams();
+    if (isExtraCondsChecked) {
+        auto reader = ContentReaderFactory::GetInstance().Get(dataFmtVersion_);
+        if (reader == nullptr || !query.IsContainExtraConds(reader->ReadParamCursor(content, contentSize))) {
+            return;
+        }
+    }
     // build raw data
     auto rawData = BuildRawData(content, contentSize);
     if (rawData == nullptr) {
         return;
     }
-    // check extra condition
-    if (!query.IsContainExtraConds(rawData->GetData(), rawData->GetDataLength())) {
+    // the conditions on the level or the tag can only be checked on the raw data
+    if (!isExtraCondsChecked && !query.IsContainExtraConds(rawData->GetData(), rawData->GetDataLength())) {
         return;
     }
     // add to entry queue
@@ -329,14 +561,16 @@ bool SysEventDocReader::CheckEventInfo(uint8_t* content)
         return false;
     }
 
-    int64_t seq = *(reinterpret_cast<int64_t*>(content + HIVIEW_BLOCK_SIZE));
+    int64_t seq = 0;
+    (void)memcpy_s(&seq, sizeof(seq), content + HIVIEW_BLOCK_SIZE, SEQ_SIZE);
     if (seq < 0) {
         HIVIEW_LOGE("event seq is invalid, seq=%{public}" PRId64, seq);
         return false;
     }
     info_.seq = seq;
 
-    int64_t timestamp = *(reinterpret_cast<int64_t*>(content + HIVIEW_BLOCK_SIZE + SEQ_SIZE));
+    int64_t timestamp = 0;
+    (void)memcpy_s(&timestamp, sizeof(timestamp), content + HIVIEW_BLOCK_SIZE + SEQ_SIZE, sizeof(int64_t));
     if (timestamp < 0) {
         HIVIEW_LOGE("event seq is invalid, timestamp=%{public}" PRId64, timestamp);
         return false;
@@ -354,7 +588,8 @@ int64_t SysEventDocReader::ReadMaxEventSequence()
             HIVIEW_LOGE("invalid event, content size is %{public}" PRIu32 "", contentSize);
             return false;
         }
-        int64_t seq = *(reinterpret_cast<int64_t*>(content + HIVIEW_BLOCK_SIZE));
+        int64_t seq = 0;
+        (void)memcpy_s(&seq, sizeof(seq), content + HIVIEW_BLOCK_SIZE, SEQ_SIZE);
         if (maxSeq < seq) {
             maxSeq = seq;
         }
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sys_event_page_summary.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventStore {
+namespace {
+// a file holds 64 pages at most with the default config, about 2.5KB of summaries
+constexpr size_t MAX_SUMMARY_NUM = 1024;
+}
+
+size_t DocPageSummary::GetFinishedPageNum() const
+{
+    if (pageSize == 0 || fileSize <= headerSize) {
+        return 0;
+    }
+    return std::min(pages.size(), static_cast<size_t>((fileSize - headerSize) / pageSize));
+}
+
+void DocPageSummary::AddPage(const PageSummary& page)
+{
+    pages.emplace_back(page);
+    if (page.eventNum == 0) {
+        return;
+    }
+    total.minSeq = std::min(total.minSeq, page.minSeq);
+    total.maxSeq = std::max(total.maxSeq, page.maxSeq);
+    total.minTs = std::min(total.minTs, page.minTs);
+    total.maxTs = std::max(total.maxTs, page.maxTs);
+    total.eventNum += page.eventNum;
+}
+
+void DocPageSummary::AddEvent(PageSummary& page, int64_t seq, int64_t timestamp)
+{
+    page.minSeq = std::min(page.minSeq, seq);
+    page.maxSeq = std::max(page.maxSeq, seq);
+    page.minTs = std::min(page.minTs, timestamp);
+    page.maxTs = std::max(page.maxTs, timestamp);
+    page.eventNum++;
+}
+
+DocPageSummaryPtr SysEventPageSummaryCache::Get(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = summaries_.find(path);
+    if (iter == summaries_.end()) {
+        return nullptr;
+    }
+    lruList_.splice(lruList_.begin(), lruList_, iter->second.first);
+    return iter->second.second;
+}
+
+void SysEventPageSummaryCache::Put(const std::string& path, DocPageSummaryPtr summary)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto iter = summaries_.find(path); iter != summaries_.end()) {
+        lruList_.splice(lruList_.begin(), lruList_, iter->second.first);
+        iter->second.second = summary;
+        return;
+    }
+    lruList_.push_front(path);
+    summaries_.emplace(path, SummaryPair(lruList_.begin(), summary));
+    if (lruList_.size() > MAX_SUMMARY_NUM) {
+        summaries_.erase(lruList_.back());
+        lruList_.pop_back();
+    }
+}
+
+void SysEventPageSummaryCache::Remove(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = summaries_.find(path);
+    if (iter == summaries_.end()) {
+        return;
+    }
+    lruList_.erase(iter->second.first);
+    summaries_.erase(iter);
+}
+
+void SysEventPageSummaryCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    lruList_.clear();
+    summaries_.clear();
+}
+} // EventStore
+} // HiviewDFX
+} // OHOS
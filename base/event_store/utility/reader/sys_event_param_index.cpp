@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sys_event_param_index.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "decoded/decoded_param_cursor.h"
+#include "doc_query.h"
+#include "sys_event_query.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventStore {
+namespace {
+// the indexed domains are few and their files are small, so the indexes of the recent files are kept
+constexpr size_t MAX_INDEX_NUM = 128;
+const std::string STRING_KEY_PREFIX = "s:";
+const std::string NUMBER_KEY_PREFIX = "n:";
+}
+
+void DocParamIndex::AddEvent(uint64_t pos, uint8_t* rawData, size_t len)
+{
+    if (segments.empty()) {
+        segments.emplace_back(std::make_shared<DocParamIndexSegment>());
+    }
+    auto& segment = *segments.back();
+    EventRaw::DecodedParamCursor cursor(rawData, len);
+    std::vector<bool> isIndexed(params.size(), false);
+    size_t indexedNum = 0;
+    while (indexedNum < params.size() && cursor.Next()) {
+        for (size_t i = 0; i < params.size(); ++i) {
+            if (isIndexed[i] || !cursor.IsKeyOf(params[i])) {
+                continue;
+            }
+            // only the first param with the key is indexed, the same as the one compared by the query
+            isIndexed[i] = true;
+            ++indexedNum;
+            FieldValue value;
+            // the array value never matches the equality condition
+            if (!DocQuery::GetParamValue(cursor, value)) {
+                break;
+            }
+            if (std::string key; GetKey(value, key)) {
+                segment.positions[params[i]][key].emplace_back(pos);
+            } else {
+                segment.unkeyedPositions[params[i]].emplace_back(pos);
+            }
+            break;
+        }
+    }
+}
+
+std::vector<uint64_t> DocParamIndex::GetPositions(const std::string& param, const std::string& key) const
+{
+    static const std::vector<uint64_t> emptyPos;
+    std::vector<uint64_t> allPos;
+    // the segments are in the order of the pages, so merging each of them keeps the positions ascending
+    for (const auto& segment : segments) {
+        const std::vector<uint64_t>* keyedPos = &emptyPos;
+        if (auto paramIter = segment->positions.find(param); paramIter != segment->positions.end()) {
+            if (auto keyIter = paramIter->second.find(key); keyIter != paramIter->second.end()) {
+                keyedPos = &(keyIter->second);
+            }
+        }
+        const std::vector<uint64_t>* unkeyedPos = &emptyPos;
+        if (auto unkeyedIter = segment->unkeyedPositions.find(param); unkeyedIter != segment->unkeyedPositions.end()) {
+            unkeyedPos = &(unkeyedIter->second);
+        }
+        std::merge(keyedPos->begin(), keyedPos->end(), unkeyedPos->begin(), unkeyedPos->end(),
+            std::back_inserter(allPos));
+    }
+    return allPos;
+}
+
+bool DocParamIndex::GetKey(const FieldValue& value, std::string& key)
+{
+    if (value.IsString()) {
+        key = STRING_KEY_PREFIX + value.GetString();
+        return true;
+    }
+    // the int and uint numbers with the same value are equal
+    auto number = value.GetFieldNumber();
+    if (number.Index() == FieldNumber::DOUBLE) {
+        return false;
+    }
+    key = NUMBER_KEY_PREFIX + number.FormatAsString();
+    return true;
+}
+
+DocParamIndexPtr SysEventParamIndexCache::Get(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = indexes_.find(path);
+    if (iter == indexes_.end()) {
+        return nullptr;
+    }
+    lruList_.splice(lruList_.begin(), lruList_, iter->second.first);
+    return iter->second.second;
+}
+
+void SysEventParamIndexCache::Put(const std::string& path, DocParamIndexPtr index)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto iter = indexes_.find(path); iter != indexes_.end()) {
+        lruList_.splice(lruList_.begin(), lruList_, iter->second.first);
+        iter->second.second = index;
+        return;
+    }
+    lruList_.push_front(path);
+    indexes_.emplace(path, IndexPair(lruList_.begin(), index));
+    if (lruList_.size() > MAX_INDEX_NUM) {
+        indexes_.erase(lruList_.back());
+        lruList_.pop_back();
+    }
+}
+
+void SysEventParamIndexCache::Remove(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = indexes_.find(path);
+    if (iter == indexes_.end()) {
+        return;
+    }
+    lruList_.erase(iter->second.first);
+    indexes_.erase(iter);
+}
+
+void SysEventParamIndexCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    lruList_.clear();
+    indexes_.clear();
+}
+} // EventStore
+} // HiviewDFX
+} // OHOS
@@ -30,6 +30,8 @@ public:
     EventDocWriter(const std::string& path): docPath_(path) {}
     virtual ~EventDocWriter() {}
     virtual int Write(const std::shared_ptr<SysEvent>& sysEvent) = 0;
+    virtual int Flush() { return DOC_STORE_SUCCESS; }
+    virtual bool HasStagedEvents() const { return false; }
 
 protected:
     std::string docPath_;
@@ -19,6 +19,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "event_doc_writer.h"
 
@@ -29,18 +30,28 @@ class SysEventDocWriter : public EventDocWriter {
 public:
     SysEventDocWriter(const std::string& path);
     ~SysEventDocWriter();
-    int Write(const std::shared_ptr<SysEvent>& sysEvent);
+    int Write(const std::shared_ptr<SysEvent>& sysEvent) override;
+    int Flush() override;
+    bool HasStagedEvents() const override;
 
 private:
+    int InitFileState(const std::shared_ptr<SysEvent>& sysEvent, uint32_t contentSize, bool& isNewFile);
     int WriteHeader(const std::shared_ptr<SysEvent>& sysEvent, uint32_t contentSize);
-    int WriteContent(const std::shared_ptr<SysEvent>& sysEvent, uint32_t contentSize);
-    uint32_t GetCurrPageRemainSize(int fileSize, uint32_t pageSize);
-    int FillCurrPageWithZero(uint32_t remainSize);
+    int StageContent(const std::shared_ptr<SysEvent>& sysEvent, uint32_t contentSize, uint32_t paddingSize);
+    bool IsNeedFlush() const;
+    uint32_t GetCurrPageRemainSize() const;
     int GetContentSize(const std::shared_ptr<SysEvent>& sysEvent, uint32_t& contentSize);
 
 private:
     std::ofstream out_;
+    bool isFileStateInited_ = false;
     uint32_t headerSize_ = 0;
+    uint32_t pageSize_ = 0;
+    uint64_t fileSize_ = 0; // include the staged content which has not been written to the file yet
+    uint32_t maxStagedSize_ = 0; // 0 means writing through
+    uint64_t maxStagedDelay_ = 0;
+    uint64_t firstStagedTime_ = 0;
+    std::vector<uint8_t> stagedContent_;
 }; // EventDocWriter
 } // EventStore
 } // HiviewDFX
@@ -19,6 +19,7 @@
 #include "parameter_ex.h"
 #include "securec.h"
 #include "sys_event_doc_reader.h"
+#include "time_util.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -26,6 +27,7 @@ namespace EventStore {
 DEFINE_LOG_TAG("HiView-SysEventDocWriter");
 namespace {
 constexpr uint32_t RAW_DATA_OFFSET = HIVIEW_BLOCK_SIZE + MAX_DOMAIN_LEN + MAX_EVENT_NAME_LEN;
+constexpr uint64_t MS_PER_SECOND = 1000;
 }
 SysEventDocWriter::SysEventDocWriter(const std::string& path): EventDocWriter(path)
 {
@@ -35,6 +37,7 @@ SysEventDocWriter::SysEventDocWriter(const std::string& path): EventDocWriter(pa
 SysEventDocWriter::~SysEventDocWriter()
 {
     if (out_.is_open()) {
+        Flush();
         out_.close();
     }
 }
@@ -53,19 +56,73 @@ int SysEventDocWriter::Write(const std::shared_ptr<SysEvent>& sysEvent)
     if (int ret = GetContentSize(sysEvent, contentSize); ret != DOC_STORE_SUCCESS) {
         return ret;
     }
+
+    // the file state is read only once, later writes depend on the cached state
+    if (!isFileStateInited_) {
+        bool isNewFile = false;
+        if (int ret = InitFileState(sysEvent, contentSize, isNewFile); ret != DOC_STORE_SUCCESS) {
+            return ret;
+        }
+        if (isNewFile) {
+            return StageContent(sysEvent, contentSize, 0);
+        }
+    }
+
+    // if the current file is full, need to create a new file
+    if (pageSize_ == 0 || pageSize_ < contentSize) {
+        HIVIEW_LOGD("the current page is full, page=%{public}u, content=%{public}u", pageSize_, contentSize);
+        return DOC_STORE_NEW_FILE;
+    }
+
+    // if the current page is full, need to add zero
+    uint32_t remainSize = GetCurrPageRemainSize();
+    return StageContent(sysEvent, contentSize, remainSize < contentSize ? remainSize : 0);
+}
+
+int SysEventDocWriter::Flush()
+{
+    if (stagedContent_.empty()) {
+        return DOC_STORE_SUCCESS;
+    }
+    out_.write(reinterpret_cast<const char*>(stagedContent_.data()), stagedContent_.size());
+    out_.flush();
+    if (!out_.good()) {
+        HIVIEW_LOGE("failed to flush %{public}zu bytes to file=%{public}s", stagedContent_.size(), docPath_.c_str());
+        out_.clear();
+        stagedContent_.clear();
+        isFileStateInited_ = false; // reload the file state from the file on next write
+        return DOC_STORE_ERROR_IO;
+    }
+    HIVIEW_LOGD("flush content size=%{public}zu, file=%{public}s", stagedContent_.size(), docPath_.c_str());
+    stagedContent_.clear();
+    return DOC_STORE_SUCCESS;
+}
+
+bool SysEventDocWriter::HasStagedEvents() const
+{
+    return !stagedContent_.empty();
+}
+
+int SysEventDocWriter::InitFileState(const std::shared_ptr<SysEvent>& sysEvent, uint32_t contentSize,
+    bool& isNewFile)
+{
     SysEventDocReader reader(docPath_);
     int fileSize = reader.ReadFileSize();
     if (fileSize < 0) {
         HIVIEW_LOGE("failed to get the size of file=%{public}s", docPath_.c_str());
         return DOC_STORE_ERROR_IO;
     }
+    maxStagedSize_ = EventStoreConfig::GetInstance().GetMaxStagedSize(sysEvent->eventType_) * NUM_OF_BYTES_IN_KB;
+    maxStagedDelay_ = EventStoreConfig::GetInstance().GetMaxStagedDelay(sysEvent->eventType_) * MS_PER_SECOND;
 
     // if file is empty, write header to the file first
     if (fileSize == 0) {
         if (auto ret = WriteHeader(sysEvent, contentSize); ret != DOC_STORE_SUCCESS) {
             return ret;
         }
-        return WriteContent(sysEvent, contentSize);
+        isNewFile = true;
+        isFileStateInited_ = true;
+        return DOC_STORE_SUCCESS;
     }
 
     DocHeader header;
@@ -79,49 +136,18 @@ int SysEventDocWriter::Write(const std::shared_ptr<SysEvent>& sysEvent)
     }
 
     // if file is not empty, read the file header for writing
-    uint32_t pageSize = 0;
-    if (int ret = reader.ReadPageSize(pageSize); ret != DOC_STORE_SUCCESS) {
+    if (int ret = reader.ReadPageSize(pageSize_); ret != DOC_STORE_SUCCESS) {
         HIVIEW_LOGE("failed to get pageSize from the file=%{public}s", docPath_.c_str());
         return ret;
     }
-
-    // if the current file is full, need to create a new file
-    if (pageSize == 0 || pageSize < contentSize) {
-        HIVIEW_LOGD("the current page is full, page=%{public}u, content=%{public}u", pageSize, contentSize);
-        return DOC_STORE_NEW_FILE;
-    }
-
-    // if the current page is full, need to add zero
-    if (auto remainSize = GetCurrPageRemainSize(fileSize, pageSize); remainSize < contentSize) {
-        if (int ret = FillCurrPageWithZero(remainSize); ret != DOC_STORE_SUCCESS) {
-            return ret;
-        }
-    }
-    return WriteContent(sysEvent, contentSize);
-}
-
-uint32_t SysEventDocWriter::GetCurrPageRemainSize(int fileSize, uint32_t pageSize)
-{
-    return (pageSize - ((static_cast<uint32_t>(fileSize) - headerSize_) % pageSize));
+    fileSize_ = static_cast<uint64_t>(fileSize);
+    isFileStateInited_ = true;
+    return DOC_STORE_SUCCESS;
 }
 
-int SysEventDocWriter::FillCurrPageWithZero(uint32_t remainSize)
+uint32_t SysEventDocWriter::GetCurrPageRemainSize() const
 {
-    if (remainSize == 0) {
-        return DOC_STORE_SUCCESS;
-    }
-    if (remainSize > MAX_NEW_SIZE) {
-        HIVIEW_LOGE("invalid new size=%{public}u", remainSize);
-        return DOC_STORE_ERROR_MEMORY;
-    }
-    uint8_t* fillData = new(std::nothrow) uint8_t[remainSize]{ 0x0 };
-    if (fillData == nullptr) {
-        HIVIEW_LOGE("failed to new memory for fillData, size=%{public}u", remainSize);
-        return DOC_STORE_ERROR_MEMORY;
-    }
-    out_.write(reinterpret_cast<char*>(fillData), remainSize);
-    delete[] fillData;
-    return DOC_STORE_SUCCESS;
+    return (pageSize_ - ((fileSize_ - headerSize_) % pageSize_));
 }
 
 int SysEventDocWriter::GetContentSize(const std::shared_ptr<SysEvent>& sysEvent, uint32_t& contentSize)
@@ -148,6 +174,7 @@ int SysEventDocWriter::WriteHeader(const std::shared_ptr<SysEvent>& sysEvent, ui
         return DOC_STORE_ERROR_IO;
     }
     pageSize = contentSize > (pageSize * NUM_OF_BYTES_IN_KB) ? 0 : pageSize;
+    pageSize_ = pageSize * NUM_OF_BYTES_IN_KB;
 
     DocHeader header = {
         .magicNum = MAGIC_NUM,
@@ -170,40 +197,48 @@ int SysEventDocWriter::WriteHeader(const std::shared_ptr<SysEvent>& sysEvent, ui
     out_.write(sysVersion.c_str(), sysVersionSize); // append system version
     out_.write(reinterpret_cast<char*>(&patchVersionSize), sizeof(uint32_t)); // append size of patch version string
     out_.write(patchVersion.c_str(), patchVersionSize); // append patch version
+    fileSize_ = headerSize_;
     return DOC_STORE_SUCCESS;
 }
 
-int SysEventDocWriter::WriteContent(const std::shared_ptr<SysEvent>& sysEvent, uint32_t contentSize)
+int SysEventDocWriter::StageContent(const std::shared_ptr<SysEvent>& sysEvent, uint32_t contentSize,
+    uint32_t paddingSize)
 {
-    // move to the end
-    out_.seekp(0, std::ios::end);
-
-    // content.blockSize
-    out_.write(reinterpret_cast<const char*>(&contentSize), sizeof(contentSize));
-
-    // content.seq
-    const auto eventSeq = sysEvent->GetEventSeq();
-    out_.write(reinterpret_cast<const char*>(&eventSeq), sizeof(eventSeq));
-
-    // content.rawData
     uint8_t* rawData = sysEvent->AsRawData();
     if (rawData == nullptr) {
         HIVIEW_LOGE("The raw data of event is null");
         return DOC_STORE_ERROR_NULL;
     }
-    uint32_t dataSize = *(reinterpret_cast<uint32_t*>(rawData)) - RAW_DATA_OFFSET;
-    out_.write(reinterpret_cast<const char*>(rawData + RAW_DATA_OFFSET), dataSize);
+    if (stagedContent_.empty()) {
+        firstStagedTime_ = TimeUtil::GetSteadyClockTimeMs();
+    }
 
-    // content.crc
-    const uint32_t crcDefault = 0;
-    out_.write(reinterpret_cast<const char*>(&crcDefault), CRC_SIZE);
+    // the padding of the current page and the crc are left as zero
+    size_t offset = stagedContent_.size() + paddingSize;
+    stagedContent_.resize(offset + contentSize, 0);
+    uint8_t* content = stagedContent_.data() + offset;
 
-    // flush the file
-    out_.flush();
+    // content.blockSize + content.seq + content.rawData
+    const auto eventSeq = sysEvent->GetEventSeq();
+    uint32_t dataSize = *(reinterpret_cast<uint32_t*>(rawData)) - RAW_DATA_OFFSET;
+    if (memcpy_s(content, contentSize, &contentSize, HIVIEW_BLOCK_SIZE) != EOK ||
+        memcpy_s(content + HIVIEW_BLOCK_SIZE, contentSize - HIVIEW_BLOCK_SIZE, &eventSeq, SEQ_SIZE) != EOK ||
+        memcpy_s(content + HIVIEW_BLOCK_SIZE + SEQ_SIZE, contentSize - HIVIEW_BLOCK_SIZE - SEQ_SIZE,
+            rawData + RAW_DATA_OFFSET, dataSize) != EOK) {
+        HIVIEW_LOGE("failed to copy content of event, size=%{public}u", contentSize);
+        stagedContent_.resize(offset - paddingSize);
+        return DOC_STORE_ERROR_MEMORY;
+    }
+    fileSize_ += (paddingSize + contentSize);
+    HIVIEW_LOGD("stage content size=%{public}u, seq=%{public}" PRId64 ", file=%{public}s", contentSize,
+        eventSeq, docPath_.c_str());
+    return IsNeedFlush() ? Flush() : DOC_STORE_SUCCESS;
+}
 
-    HIVIEW_LOGD("write content size=%{public}u, seq=%{public}" PRId64 ", file=%{public}s", contentSize,
-        sysEvent->GetEventSeq(), docPath_.c_str());
-    return DOC_STORE_SUCCESS;
+bool SysEventDocWriter::IsNeedFlush() const
+{
+    return stagedContent_.size() >= maxStagedSize_ ||
+        (TimeUtil::GetSteadyClockTimeMs() - firstStagedTime_) >= maxStagedDelay_;
 }
 } // EventStore
 } // HiviewDFX
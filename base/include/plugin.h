@@ -194,6 +194,9 @@ private:
     std::atomic<bool> loaded_;
     std::atomic<int64_t> useCount_;
 };
+
+using EventListenerList = std::vector<std::weak_ptr<EventListener>>;
+using PluginList = std::vector<std::weak_ptr<Plugin>>;
 class HiviewContext {
 public:
     virtual ~HiviewContext(){};
@@ -286,20 +289,20 @@ public:
 
     virtual void AddListenerInfo(uint32_t type, const std::string& name) {};
 
-    virtual std::vector<std::weak_ptr<EventListener>> GetListenerInfo(uint32_t type,
+    virtual std::shared_ptr<const EventListenerList> GetListenerInfo(uint32_t type,
         const std::string& eventName, const std::string& domain)
     {
-        return {};
+        return std::make_shared<const EventListenerList>();
     }
 
     virtual void AddDispatchInfo(std::weak_ptr<Plugin> plugin, const std::unordered_set<uint8_t>& types,
         const std::unordered_set<std::string>& eventNames, const std::unordered_set<std::string>& tags,
             const std::unordered_map<std::string, DomainRule>& domainRulesMap) {};
 
-    virtual std::vector<std::weak_ptr<Plugin>> GetDisPatcherInfo(uint32_t type,
+    virtual std::shared_ptr<const PluginList> GetDisPatcherInfo(uint32_t type,
         const std::string& eventName, const std::string& tag, const std::string& domain)
     {
-        return {};
+        return std::make_shared<const PluginList>();
     }
 };
 } // namespace HiviewDFX
@@ -19,9 +19,14 @@
 #include "log_file.h"
 
 #include <cinttypes>
+#include <deque>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <ostream>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <sys/stat.h>
@@ -46,6 +51,7 @@ public:
     void SetLogFileComparator(LogFileComparator comparator);
 
     // Get all files in log store, sorted by last modify time by default
+    // the files are served from an in-memory index which is rebuilt when the directories are changed outside
     std::vector<LogFile> GetLogFiles();
     std::vector<LogFile> GetLogFiles(LogFileFilter filter);
 
@@ -77,7 +83,33 @@ protected:
     std::string path_;
 
 private:
-    void DoDeleteLogFiles(const std::vector<LogFile> &fileList, uint32_t removeFileNums) const;
+    using LogFileIndex = std::multiset<LogFile, LogFileComparator>;
+    struct DirTime {
+        struct timespec mtime;
+        bool isRacy;
+    };
+
+    void DoDeleteLogFiles(const std::vector<LogFile> &fileList, uint32_t removeFileNums);
+    void DoClearOldestFiles();
+    std::vector<LogFile> GetIndexedFiles(LogFileFilter filter) const;
+    void UpdateIndex();
+    void RebuildIndex();
+    void SyncIndex();
+    void RefreshIndexedFiles();
+    void AddToIndex(const std::string& filePath);
+    void RemoveFromIndex(const std::string& filePath);
+    void RecordDirTime(const std::string& dir);
+    bool IsDirChanged() const;
+
+    std::mutex indexMutex_;
+    bool isIndexValid_ = false;
+    time_t indexTime_ = 0;
+    uint64_t totalSize_ = 0;
+    LogFileIndex sortedFiles_;
+    std::unordered_map<std::string, LogFileIndex::iterator> fileIndex_;
+    std::map<std::string, DirTime> dirTimes_;
+    // the files created lately may be still in writing, their sizes are refreshed on every update
+    std::deque<std::string> unsettledFiles_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
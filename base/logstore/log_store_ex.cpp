@@ -14,9 +14,13 @@
  */
 #include "log_store_ex.h"
 
+#include <algorithm>
+#include <ctime>
 #include <fstream>
 #include <functional>
+#include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <fcntl.h>
@@ -34,6 +38,36 @@ constexpr int32_t DEFAULT_LOGSTORE_SIZE = 1024 * 1024 * 10;
 constexpr int32_t DEFAULT_LOGSTORE_MIN_KEEP_FILE_COUNT = 100;
 constexpr mode_t DEFAULT_LOG_FILE_MODE = 0664;
 constexpr mode_t DEFAULT_LOG_DIR_MODE = 0770;
+constexpr size_t MAX_UNSETTLED_FILE_COUNT = 8;
+// changes inside files do not touch the directory, rebuild the index regularly to pick them up
+constexpr time_t MAX_INDEX_AGE = 600; // 600s
+constexpr int64_t NS_PER_SEC = 1000000000;
+constexpr int64_t RACY_DIR_TIME_NS = 50 * 1000 * 1000; // 50ms
+// the sizes of the indexed files are stat again only once their total is close to the quota
+constexpr uint64_t REFRESH_SIZE_PCT_OF_QUOTA = 90;
+constexpr uint64_t PCT_BASE = 100;
+
+namespace {
+std::string GetParentDir(const std::string& filePath)
+{
+    auto pos = filePath.find_last_not_of('/');
+    if (pos == std::string::npos) {
+        return "/";
+    }
+    pos = filePath.rfind('/', pos);
+    if (pos == std::string::npos) {
+        return ".";
+    }
+    return filePath.substr(0, pos);
+}
+
+std::string TrimTrailingDelimiter(const std::string& path)
+{
+    auto pos = path.find_last_not_of('/');
+    return (pos == std::string::npos) ? "/" : path.substr(0, pos + 1);
+}
+}
+
 LogStoreEx::LogStoreEx(const std::string& path, bool autoDeleteFiles)
     : autoDeleteFiles_(autoDeleteFiles),
       maxSize_(DEFAULT_LOGSTORE_SIZE),
@@ -59,7 +93,9 @@ bool LogStoreEx::Init(bool createDir)
 
 void LogStoreEx::SetLogFileComparator(LogFileComparator comparator)
 {
+    std::lock_guard<std::mutex> lock(indexMutex_);
     comparator_ = comparator;
+    isIndexValid_ = false;
 }
 
 void LogStoreEx::SetMaxSize(uint32_t size)
@@ -79,44 +115,170 @@ const std::string& LogStoreEx::GetPath() const
 
 std::vector<LogFile> LogStoreEx::GetLogFiles()
 {
-    std::vector<std::string> fileVec;
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    UpdateIndex();
+    return GetIndexedFiles(nullptr);
+}
+
+std::vector<LogFile> LogStoreEx::GetLogFiles(LogFileFilter filter)
+{
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    UpdateIndex();
+    return GetIndexedFiles(filter);
+}
+
+std::vector<LogFile> LogStoreEx::GetIndexedFiles(LogFileFilter filter) const
+{
     std::vector<LogFile> logFileList;
+    logFileList.reserve(sortedFiles_.size());
+    for (const auto& file : sortedFiles_) {
+        if (filter == nullptr || filter(file)) {
+            logFileList.push_back(file);
+        }
+    }
+    return logFileList;
+}
+
+void LogStoreEx::UpdateIndex()
+{
+    time_t now = time(nullptr);
+    if (!isIndexValid_ || now < indexTime_ || now - indexTime_ > MAX_INDEX_AGE) {
+        RebuildIndex();
+        return;
+    }
+    if (IsDirChanged()) {
+        SyncIndex();
+    }
+    for (const auto& filePath : unsettledFiles_) {
+        if (fileIndex_.find(filePath) != fileIndex_.end()) {
+            AddToIndex(filePath);
+        }
+    }
+}
+
+void LogStoreEx::RebuildIndex()
+{
+    LogFileComparator comparator = comparator_;
+    if (comparator == nullptr) {
+        comparator = [](const LogFile& lhs, const LogFile& rhs) {
+            return lhs < rhs;
+        };
+    }
+    sortedFiles_ = LogFileIndex(comparator);
+    fileIndex_.clear();
+    totalSize_ = 0;
+    SyncIndex();
+    isIndexValid_ = true;
+    indexTime_ = time(nullptr);
+}
+
+void LogStoreEx::SyncIndex()
+{
+    // only the names are compared, the files already in index are not stat again
+    std::vector<std::string> fileVec;
     FileUtil::GetDirFiles(path_, fileVec);
-    for (auto& filePath : fileVec) {
-        logFileList.push_back(LogFile(filePath));
+    std::unordered_set<std::string> listedFiles(fileVec.begin(), fileVec.end());
+    std::vector<std::string> removedFiles;
+    for (const auto& [filePath, iter] : fileIndex_) {
+        if (listedFiles.find(filePath) == listedFiles.end()) {
+            removedFiles.push_back(filePath);
+        }
+    }
+    for (const auto& filePath : removedFiles) {
+        RemoveFromIndex(filePath);
     }
 
-    if (comparator_ != nullptr) {
-        std::sort(logFileList.begin(), logFileList.end(), comparator_);
-    } else {
-        std::sort(logFileList.begin(), logFileList.end());
+    std::set<std::string> dirs = { TrimTrailingDelimiter(path_) };
+    for (const auto& filePath : fileVec) {
+        if (fileIndex_.find(filePath) == fileIndex_.end()) {
+            AddToIndex(filePath);
+        }
+        dirs.insert(GetParentDir(filePath));
+    }
+    dirTimes_.clear();
+    for (const auto& dir : dirs) {
+        RecordDirTime(dir);
     }
-    return logFileList;
 }
 
-std::vector<LogFile> LogStoreEx::GetLogFiles(LogFileFilter filter)
+void LogStoreEx::RefreshIndexedFiles()
 {
-    auto logFileList = GetLogFiles();
-    auto iter = logFileList.begin();
-    while (iter != logFileList.end()) {
-        if (!filter(*iter)) {
-            iter = logFileList.erase(iter);
-            continue;
+    // the files written in place by other writers are not told by the directory mtime, stat them all again
+    std::vector<std::string> indexedFiles;
+    indexedFiles.reserve(fileIndex_.size());
+    for (const auto& fileInfo : fileIndex_) {
+        indexedFiles.push_back(fileInfo.first);
+    }
+    for (const auto& filePath : indexedFiles) {
+        AddToIndex(filePath);
+    }
+}
+
+void LogStoreEx::AddToIndex(const std::string& filePath)
+{
+    RemoveFromIndex(filePath);
+    LogFile file(filePath);
+    if (!file.isValid_) {
+        return;
+    }
+    totalSize_ += static_cast<uint64_t>(file.size_);
+    fileIndex_[filePath] = sortedFiles_.insert(file);
+}
+
+void LogStoreEx::RemoveFromIndex(const std::string& filePath)
+{
+    auto it = fileIndex_.find(filePath);
+    if (it == fileIndex_.end()) {
+        return;
+    }
+    uint64_t size = static_cast<uint64_t>(it->second->size_);
+    totalSize_ = (totalSize_ > size) ? (totalSize_ - size) : 0;
+    sortedFiles_.erase(it->second);
+    fileIndex_.erase(it);
+}
+
+void LogStoreEx::RecordDirTime(const std::string& dir)
+{
+    struct stat sb;
+    if (stat(dir.c_str(), &sb) != 0) {
+        dirTimes_.erase(dir);
+        return;
+    }
+    // the mtime of directory is coarse, a change in the same tick after now could not be told by the mtime,
+    // so the directory recorded too close to its mtime is synced once more at the next update
+    struct timespec now = {0, 0};
+    clock_gettime(CLOCK_REALTIME, &now);
+    int64_t elapsedNs = (static_cast<int64_t>(now.tv_sec) - static_cast<int64_t>(sb.st_mtim.tv_sec)) * NS_PER_SEC +
+        (static_cast<int64_t>(now.tv_nsec) - static_cast<int64_t>(sb.st_mtim.tv_nsec));
+    dirTimes_[dir] = { sb.st_mtim, elapsedNs < RACY_DIR_TIME_NS };
+}
+
+bool LogStoreEx::IsDirChanged() const
+{
+    for (const auto& [dir, dirTime] : dirTimes_) {
+        struct stat sb;
+        if (dirTime.isRacy || stat(dir.c_str(), &sb) != 0) {
+            return true;
+        }
+        if (sb.st_mtim.tv_sec != dirTime.mtime.tv_sec || sb.st_mtim.tv_nsec != dirTime.mtime.tv_nsec) {
+            return true;
         }
-        iter++;
     }
-    return logFileList;
+    return dirTimes_.empty();
 }
 
 bool LogStoreEx::Clear()
 {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    isIndexValid_ = false;
+    unsettledFiles_.clear();
     if (!FileUtil::ForceRemoveDirectory(path_)) {
         return false;
     }
     return Init();
 }
 
-void LogStoreEx::DoDeleteLogFiles(const std::vector<LogFile> &fileList, uint32_t removeFileNums) const
+void LogStoreEx::DoDeleteLogFiles(const std::vector<LogFile> &fileList, uint32_t removeFileNums)
 {
     uint32_t deleteCount = 0;
     for (auto it = fileList.rbegin(); it != fileList.rend(); ++it) {
@@ -124,9 +286,13 @@ void LogStoreEx::DoDeleteLogFiles(const std::vector<LogFile> &fileList, uint32_t
             break;
         }
 
-        if (!FileUtil::RemoveFile(it->path_)) {
+        if (FileUtil::RemoveFile(it->path_)) {
+            RemoveFromIndex(it->path_);
+        } else {
             HIVIEW_LOGW("Failed to remove file: %{public}s, errno: %{public}d", it->path_.c_str(), errno);
+            AddToIndex(it->path_); // keep the file in index if it is still there
         }
+        RecordDirTime(GetParentDir(it->path_));
         if (it->path_.find("/data/log/faultlog/faultlogger") != std::string::npos) {
             HIVIEW_LOGI("Remove file:%{public}s.", it->path_.c_str());
         }
@@ -136,12 +302,22 @@ void LogStoreEx::DoDeleteLogFiles(const std::vector<LogFile> &fileList, uint32_t
 
 void LogStoreEx::ClearOldestFilesIfNeeded()
 {
-    auto size = FileUtil::GetFolderSize(path_);
-    if (size < maxSize_) {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    DoClearOldestFiles();
+}
+
+void LogStoreEx::DoClearOldestFiles()
+{
+    // the total size is kept by the index incrementally, including the unsettled files refreshed by the update
+    UpdateIndex();
+    if (totalSize_ * PCT_BASE >= static_cast<uint64_t>(maxSize_) * REFRESH_SIZE_PCT_OF_QUOTA) {
+        RefreshIndexedFiles();
+    }
+    if (totalSize_ < maxSize_) {
         return;
     }
 
-    auto fileList = GetLogFiles();
+    auto fileList = GetIndexedFiles(nullptr);
     uint32_t removeFileNumber = 0;
     if (fileList.size() < minKeepingNumberOfFiles_) {
         removeFileNumber = fileList.size() / 2; // 2 : remove half of the total
@@ -153,7 +329,9 @@ void LogStoreEx::ClearOldestFilesIfNeeded()
 
 void LogStoreEx::ClearSameLogFilesIfNeeded(LogFileFilter filter, uint32_t maxCount)
 {
-    auto fileList = GetLogFiles(filter);
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    UpdateIndex();
+    auto fileList = GetIndexedFiles(filter);
     uint32_t removeFileNumber = 0;
     if (fileList.size() > maxCount) {
         removeFileNumber = fileList.size() - maxCount;
@@ -163,26 +341,49 @@ void LogStoreEx::ClearSameLogFilesIfNeeded(LogFileFilter filter, uint32_t maxCou
 
 LogStoreEx::FileHandle LogStoreEx::CreateLogFile(const std::string& name)
 {
+    std::lock_guard<std::mutex> lock(indexMutex_);
     if (autoDeleteFiles_) {
-        ClearOldestFilesIfNeeded();
+        DoClearOldestFiles();
     }
 
     auto path = path_ + "/" + name;
     auto fd = open(path.c_str(), O_CREAT | O_WRONLY | O_TRUNC, DEFAULT_LOG_FILE_MODE);
     if (fd < 0) {
         HIVIEW_LOGI("Fail to create %s.", name.c_str());
+        return fd;
+    }
+    if (isIndexValid_) {
+        // keep the key same as the path listed from the directory
+        auto filePath = FileUtil::IncludeTrailingPathDelimiter(path_) + name;
+        AddToIndex(filePath);
+        RecordDirTime(GetParentDir(filePath));
+        unsettledFiles_.push_back(filePath);
+        if (unsettledFiles_.size() > MAX_UNSETTLED_FILE_COUNT) {
+            unsettledFiles_.pop_front();
+        }
     }
     return fd;
 }
 
 bool LogStoreEx::RemoveLogFile(const std::string& name)
 {
+    std::lock_guard<std::mutex> lock(indexMutex_);
     auto path = path_ + "/" + name;
     std::string realPath;
     if (!FileUtil::PathToRealPath(path, realPath)) {
         return false;
     }
-    return FileUtil::RemoveFile(path);
+    bool ret = FileUtil::RemoveFile(path);
+    if (isIndexValid_) {
+        auto filePath = FileUtil::IncludeTrailingPathDelimiter(path_) + name;
+        if (ret) {
+            RemoveFromIndex(filePath);
+        } else {
+            AddToIndex(filePath); // keep the file in index if it is still there
+        }
+        RecordDirTime(GetParentDir(filePath));
+    }
+    return ret;
 }
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -154,5 +154,69 @@ HWTEST_F(LogStoreUnitTest, LogStoreUnitTest002, testing::ext::TestSize.Level3)
     auto ret4 = logStoreEx.RemoveLogFile("logfile1");
     ASSERT_EQ(false, ret4);
 }
+
+/**
+ * @tc.name: LogStoreUnitTest003
+ * @tc.desc: Test the file index of LogStoreEx follows the changes of the store
+ * @tc.type: FUNC
+ */
+HWTEST_F(LogStoreUnitTest, LogStoreUnitTest003, testing::ext::TestSize.Level3)
+{
+    const std::string logStorePath = GetLogDir();
+    LogStoreEx logStoreEx(logStorePath);
+    ASSERT_TRUE(logStoreEx.Init());
+    ASSERT_EQ(0, logStoreEx.GetLogFiles().size());
+
+    auto fd = logStoreEx.CreateLogFile("logfile0");
+    ASSERT_GE(fd, 0);
+    (void)FileUtil::SaveStringToFd(fd, LOG_CONTENT);
+    close(fd);
+    auto allLogFiles = logStoreEx.GetLogFiles();
+    ASSERT_EQ(1, allLogFiles.size());
+    ASSERT_EQ(std::string(LOG_CONTENT).size(), allLogFiles[0].size_);
+
+    // the files changed outside the store are picked up as well
+    (void)FileUtil::SaveStringToFile(GenerateLogFileName(1), LOG_CONTENT); // 1: index of the file
+    ASSERT_EQ(2, logStoreEx.GetLogFiles().size()); // 2: files in store
+    (void)FileUtil::RemoveFile(GenerateLogFileName(1)); // 1: index of the file
+    ASSERT_EQ(1, logStoreEx.GetLogFiles().size());
+
+    ASSERT_TRUE(logStoreEx.RemoveLogFile("logfile0"));
+    ASSERT_EQ(0, logStoreEx.GetLogFiles().size());
+    std::vector<std::string> files;
+    FileUtil::GetDirFiles(logStorePath, files);
+    ASSERT_TRUE(files.empty());
+}
+
+/**
+ * @tc.name: LogStoreUnitTest004
+ * @tc.desc: Test the quota of LogStoreEx counts the files rewritten in place
+ * @tc.type: FUNC
+ */
+HWTEST_F(LogStoreUnitTest, LogStoreUnitTest004, testing::ext::TestSize.Level3)
+{
+    const std::string logStorePath = GetLogDir();
+    LogStoreEx logStoreEx(logStorePath);
+    ASSERT_TRUE(logStoreEx.Init());
+    (void)FileUtil::SaveStringToFile(GenerateLogFileName(0), LOG_CONTENT); // 0: index of the file
+    (void)FileUtil::SaveStringToFile(GenerateLogFileName(1), LOG_CONTENT); // 1: index of the file
+    ASSERT_EQ(2, logStoreEx.GetLogFiles().size()); // 2: files in store
+
+    const size_t contentSize = std::string(LOG_CONTENT).size();
+    // 2, 10: the quota is a little larger than the files indexed, so their total is close to the quota
+    logStoreEx.SetMaxSize(contentSize * 2 + contentSize / 10);
+    logStoreEx.SetMinKeepingFileNumber(1);
+    logStoreEx.ClearOldestFilesIfNeeded();
+    ASSERT_EQ(2, logStoreEx.GetLogFiles().size()); // 2: files in store
+
+    // the size of the file rewritten in place is stat again when the total is close to the quota
+    std::string largeContent;
+    for (int i = 0; i < 4; ++i) { // 4: repeat times of the content
+        largeContent.append(LOG_CONTENT);
+    }
+    (void)FileUtil::SaveStringToFile(GenerateLogFileName(0), largeContent); // 0: index of the file
+    logStoreEx.ClearOldestFilesIfNeeded();
+    ASSERT_EQ(1, logStoreEx.GetLogFiles().size());
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
@@ -352,7 +352,7 @@ HWTEST_F(PluginTest, HiviewContextTest010, testing::ext::TestSize.Level0)
 {
     HiviewContext context;
     // GetListenerInfo
-    ASSERT_TRUE(context.GetListenerInfo(0, "", "").empty());
+    ASSERT_TRUE(context.GetListenerInfo(0, "", "")->empty());
 }
 
 /**
@@ -365,7 +365,7 @@ HWTEST_F(PluginTest, HiviewContextTest011, testing::ext::TestSize.Level0)
 {
     HiviewContext context;
     // GetDisPatcherInfo
-    ASSERT_TRUE(context.GetDisPatcherInfo(0, "", "", "").empty());
+    ASSERT_TRUE(context.GetDisPatcherInfo(0, "", "", "")->empty());
 }
 
 /**
@@ -15,6 +15,12 @@
 
 #include "hiview_zip_util.h"
 
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "ffrt.h"
 #include "file_util.h"
 #include "hiview_logger.h"
 
@@ -30,6 +36,70 @@ constexpr int32_t ERROR_GET_HANDLE = 1001;
 constexpr int32_t ERROR_INVALID_FILE = 1003;
 constexpr int32_t ERROR_OPEN_NEW_FILE = 1004;
 constexpr int32_t ERROR_CREATE_ZIP = 1005;
+constexpr int32_t ERROR_WRITE_FILE = 1006;
+constexpr int32_t ERROR_DEFLATE = 1007;
+constexpr size_t DEFLATE_BLOCK_SIZE = 1024 * 1024;
+// the tail of a block primes the deflate of the next one, so the matches still reach back a whole window
+constexpr size_t DEFLATE_DICT_SIZE = 32 * 1024;
+constexpr size_t DEFLATE_OUTPUT_MARGIN = 64;
+constexpr int DEFLATE_MEM_LEVEL = 8;
+constexpr uint32_t MAX_DEFLATE_THREAD_COUNT = 8;
+
+struct DeflateBlock {
+    std::vector<Bytef> input;
+    std::vector<Bytef> dict;
+    std::vector<Bytef> output;
+    uLong inputLen = 0;
+    uLong crc = 0;
+    bool isLast = false;
+    bool isDone = false;
+    bool isSuccess = false;
+};
+
+struct DeflateContext {
+    ffrt::mutex mutex;
+    ffrt::condition_variable cond;
+};
+
+bool DeflateBlockData(DeflateBlock& block, int32_t level)
+{
+    block.inputLen = static_cast<uLong>(block.input.size());
+    block.crc = crc32(0L, block.input.data(), static_cast<uInt>(block.inputLen));
+    z_stream stream {};
+    // raw deflate without the zlib header and trailer, so the outputs of the blocks are one deflate stream
+    if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, DEFLATE_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    if (!block.dict.empty() &&
+        deflateSetDictionary(&stream, block.dict.data(), static_cast<uInt>(block.dict.size())) != Z_OK) {
+        (void)deflateEnd(&stream);
+        return false;
+    }
+    block.output.resize(deflateBound(&stream, block.inputLen) + DEFLATE_OUTPUT_MARGIN);
+    stream.next_in = block.input.data();
+    stream.avail_in = static_cast<uInt>(block.inputLen);
+    // only the last block finishes the stream, the others end at a byte boundary by the sync flush
+    int flush = block.isLast ? Z_FINISH : Z_SYNC_FLUSH;
+    bool isSuccess = false;
+    while (true) {
+        size_t outPos = static_cast<size_t>(stream.total_out);
+        stream.next_out = block.output.data() + outPos;
+        stream.avail_out = static_cast<uInt>(block.output.size() - outPos);
+        int ret = deflate(&stream, flush);
+        if (ret == Z_STREAM_ERROR) {
+            break;
+        }
+        if (block.isLast ? (ret == Z_STREAM_END) : (stream.avail_in == 0 && stream.avail_out > 0)) {
+            isSuccess = true;
+            break;
+        }
+        block.output.resize(block.output.size() * 2); // 2: grow the output if the bound is not enough
+    }
+    block.output.resize(static_cast<size_t>(stream.total_out));
+    (void)deflateEnd(&stream);
+    std::vector<Bytef>().swap(block.input);
+    return isSuccess;
+}
 }
 
 HiviewZipUnit::HiviewZipUnit(const std::string& zipPath, int32_t zipMode)
@@ -46,6 +116,12 @@ HiviewZipUnit::~HiviewZipUnit()
 }
 
 int32_t HiviewZipUnit::AddFileInZip(const std::string& srcFile, ZipFileLevel zipFileLevel)
+{
+    return AddFileInZip(srcFile, zipFileLevel, ZipCompressOption());
+}
+
+int32_t HiviewZipUnit::AddFileInZip(const std::string& srcFile, ZipFileLevel zipFileLevel,
+    const ZipCompressOption& option)
 {
     if (zipFile_ == nullptr) {
         return ERROR_CREATE_ZIP;
@@ -64,10 +140,20 @@ int32_t HiviewZipUnit::AddFileInZip(const std::string& srcFile, ZipFileLevel zip
         (void)fclose(srcFp);
         return ERROR_INVALID_FILE;
     }
-    if (zipOpenNewFileInZip(zipFile_, srcFileName.c_str(),
-        nullptr, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, Z_DEFAULT_COMPRESSION) != ZIP_OK) {
+    int32_t errCode = option.threadCount > 1 ? DeflateFileInZip(srcFp, srcFileName, option) :
+        WriteFileInZip(srcFp, srcFileName, option.level);
+    if (errCode != 0) {
+        HIVIEW_LOGE("zip file failed, file: %{public}s, ret: %{public}d", srcFile.c_str(), errCode);
+    }
+    (void)fclose(srcFp);
+    return errCode;
+}
+
+int32_t HiviewZipUnit::WriteFileInZip(FILE* srcFp, const std::string& entryName, int32_t level)
+{
+    if (zipOpenNewFileInZip(zipFile_, entryName.c_str(),
+        nullptr, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, level) != ZIP_OK) {
         HIVIEW_LOGW("open new file in zip failed.");
-        (void)fclose(srcFp);
         return ERROR_OPEN_NEW_FILE;
     }
 
@@ -79,17 +165,122 @@ int32_t HiviewZipUnit::AddFileInZip(const std::string& srcFile, ZipFileLevel zip
             HIVIEW_LOGI("read an empty file.");
         }
         if (ferror(srcFp)) {
-            HIVIEW_LOGE("zip file failed, file: %{public}s, errno: %{public}d", srcFile.c_str(), errno);
             errCode = errno;
             break;
         }
         zipWriteInFileInZip(zipFile_, buf, static_cast<unsigned int>(numBytes));
     }
-    (void)fclose(srcFp);
     zipCloseFileInZip(zipFile_);
     return errCode;
 }
 
+int32_t HiviewZipUnit::DeflateFileInZip(FILE* srcFp, const std::string& entryName, const ZipCompressOption& option)
+{
+    // the entry is opened raw, the deflated blocks are written as they are with the crc and size combined here
+    if (zipOpenNewFileInZip2(zipFile_, entryName.c_str(),
+        nullptr, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, option.level, 1) != ZIP_OK) {
+        HIVIEW_LOGW("open new raw file in zip failed.");
+        return ERROR_OPEN_NEW_FILE;
+    }
+
+    uint32_t threadCount = std::min(option.threadCount, MAX_DEFLATE_THREAD_COUNT);
+    auto context = std::make_shared<DeflateContext>();
+    std::deque<std::shared_ptr<DeflateBlock>> blocks;
+    std::vector<Bytef> dict;
+    bool isReadEnd = false;
+    int32_t errCode = 0;
+    uLong crc = crc32(0L, Z_NULL, 0);
+    uLong totalSize = 0;
+    while (errCode == 0 && (!isReadEnd || !blocks.empty())) {
+        // at most threadCount blocks are in flight, the next block is read once the oldest one is written
+        while (!isReadEnd && blocks.size() < threadCount) {
+            auto block = std::make_shared<DeflateBlock>();
+            block->input.resize(DEFLATE_BLOCK_SIZE);
+            size_t numBytes = fread(block->input.data(), 1, DEFLATE_BLOCK_SIZE, srcFp);
+            if (ferror(srcFp)) {
+                errCode = errno;
+                break;
+            }
+            block->input.resize(numBytes);
+            // a short read is the end of the file, an empty last block finishes the stream of a full size file
+            block->isLast = numBytes < DEFLATE_BLOCK_SIZE;
+            isReadEnd = block->isLast;
+            block->dict = std::move(dict);
+            size_t dictLen = std::min(numBytes, DEFLATE_DICT_SIZE);
+            dict.assign(block->input.end() - dictLen, block->input.end());
+            ffrt::submit([block, context, level = option.level] {
+                bool isSuccess = DeflateBlockData(*block, level);
+                std::unique_lock<ffrt::mutex> lock(context->mutex);
+                block->isSuccess = isSuccess;
+                block->isDone = true;
+                context->cond.notify_all();
+            }, ffrt::task_attr().name("hiview_zip_deflate"));
+            blocks.push_back(block);
+        }
+        if (errCode != 0 || blocks.empty()) {
+            break;
+        }
+        auto block = blocks.front();
+        blocks.pop_front();
+        {
+            std::unique_lock<ffrt::mutex> lock(context->mutex);
+            context->cond.wait(lock, [&block] { return block->isDone; });
+        }
+        if (!block->isSuccess) {
+            errCode = ERROR_DEFLATE;
+            break;
+        }
+        if (zipWriteInFileInZip(zipFile_, block->output.data(), static_cast<unsigned int>(block->output.size()))
+            != ZIP_OK) {
+            errCode = ERROR_WRITE_FILE;
+            break;
+        }
+        crc = crc32_combine(crc, block->crc, static_cast<z_off_t>(block->inputLen));
+        totalSize += block->inputLen;
+    }
+    // the blocks still in flight after a failure are released by their tasks
+    zipCloseFileInZipRaw(zipFile_, totalSize, crc);
+    return errCode;
+}
+
+int32_t HiviewZipUnit::OpenFileInZip(const std::string& entryName)
+{
+    if (zipFile_ == nullptr) {
+        return ERROR_CREATE_ZIP;
+    }
+    if (zipOpenNewFileInZip(zipFile_, entryName.c_str(),
+        nullptr, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, Z_DEFAULT_COMPRESSION) != ZIP_OK) {
+        HIVIEW_LOGW("open new file in zip failed.");
+        return ERROR_OPEN_NEW_FILE;
+    }
+    return 0;
+}
+
+int32_t HiviewZipUnit::WriteInFileInZip(const char* data, size_t len)
+{
+    if (zipFile_ == nullptr) {
+        return ERROR_CREATE_ZIP;
+    }
+    while (len > 0) {
+        auto writeLen = static_cast<unsigned int>(std::min<size_t>(len, BUFFER_SIZE));
+        if (zipWriteInFileInZip(zipFile_, data, writeLen) != ZIP_OK) {
+            HIVIEW_LOGE("write file in zip failed.");
+            return ERROR_WRITE_FILE;
+        }
+        data += writeLen;
+        len -= writeLen;
+    }
+    return 0;
+}
+
+int32_t HiviewZipUnit::CloseFileInZip()
+{
+    if (zipFile_ == nullptr) {
+        return ERROR_CREATE_ZIP;
+    }
+    return zipCloseFileInZip(zipFile_) == ZIP_OK ? 0 : ERROR_WRITE_FILE;
+}
+
 FILE* HiviewZipUnit::GetFileHandle(const std::string& file, std::string& realPath)
 {
     if (!FileUtil::PathToRealPath(file, realPath)) {
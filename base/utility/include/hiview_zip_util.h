@@ -27,6 +27,13 @@ enum class ZipFileLevel {
     KEEP_ONE_PARENT_PATH
 };
 
+struct ZipCompressOption {
+    int32_t level = Z_DEFAULT_COMPRESSION;
+    // the file is split into blocks deflated concurrently by this number of tasks if it is more than one,
+    // the blocks are stitched into one standard deflate entry
+    uint32_t threadCount = 1;
+};
+
 class HiviewZipUnit {
 public:
     HiviewZipUnit(const std::string& zipPath, int32_t zipMode = APPEND_STATUS_CREATE);
@@ -34,10 +41,17 @@ public:
 
     bool isValid() const { return zipFile_ != nullptr; }
     int32_t AddFileInZip(const std::string& srcFile, ZipFileLevel zipFileLevel);
+    int32_t AddFileInZip(const std::string& srcFile, ZipFileLevel zipFileLevel, const ZipCompressOption& option);
+    // write an entry in pieces without a source file, the entry is compressed while being written
+    int32_t OpenFileInZip(const std::string& entryName);
+    int32_t WriteInFileInZip(const char* data, size_t len);
+    int32_t CloseFileInZip();
 
 private:
     std::string GetDstFilePath(const std::string& srcFile, ZipFileLevel zipFileLevel);
     FILE* GetFileHandle(const std::string& file, std::string& realPath);
+    int32_t WriteFileInZip(FILE* srcFp, const std::string& entryName, int32_t level);
+    int32_t DeflateFileInZip(FILE* srcFp, const std::string& entryName, const ZipCompressOption& option);
 
 private:
     zipFile zipFile_ { nullptr };
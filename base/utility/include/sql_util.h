@@ -25,6 +25,7 @@ namespace SqlUtil {
 inline constexpr char COLUMN_TYPE_INT[] = "INTEGER";
 inline constexpr char COLUMN_TYPE_STR[] = "TEXT";
 inline constexpr char COLUMN_TYPE_DOU[] = "REAL";
+inline constexpr char COLUMN_TYPE_BLOB[] = "BLOB";
 
 std::string GenerateCreateSql(const std::string& table,
     const std::vector<std::pair<std::string, std::string>>& fields);
@@ -17,6 +17,7 @@
 
 #include <fcntl.h>
 #include <fstream>
+#include <iostream>
 #include <string>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -623,6 +624,98 @@ HWTEST_F(AdapterUtilityOhosTest, ZipUtilTest002, testing::ext::TestSize.Level3)
     ASSERT_TRUE(FileUtil::FileExists(ZIP_DES_PATH + "test_data/zip_test_file2.txt"));
 }
 
+/**
+ * @tc.name: ZipUtilTest003
+ * @tc.desc: Test HiviewZipUnit deflating a file in blocks round trips through HiviewUnzipUnit
+ * @tc.type: FUNC
+ */
+HWTEST_F(AdapterUtilityOhosTest, ZipUtilTest003, testing::ext::TestSize.Level3)
+{
+    std::string traceLines;
+    const int lineCount = 60000; // 60000: more than 3 blocks of the trace like lines
+    for (int i = 0; i < lineCount; i++) {
+        // 97, 8, 7, 9973: test values to vary the lines
+        traceLines.append("  kworker/" + std::to_string(i % 97) + " [00" + std::to_string(i % 8) + "] .... " +
+            std::to_string(i) + ": sched_switch: prev_pid=" + std::to_string(i * 7 % 9973) + "\n");
+    }
+    const size_t blockSize = 1024 * 1024; // 1024 * 1024: size of the deflated block
+    // empty, exactly one block, one block and one byte, and more than three blocks
+    std::vector<size_t> fileSizes = { 0, blockSize, blockSize + 1, traceLines.size() };
+    std::vector<ZipCompressOption> options = {
+        { Z_DEFAULT_COMPRESSION, 1 },
+        { Z_DEFAULT_COMPRESSION, 4 }, // 4: deflate thread count
+        { Z_BEST_SPEED, 16 }, // 16: more threads than the blocks
+    };
+    std::string testSourceFile = SOURCE_PATH + "zip_test_block_file.txt";
+    for (size_t fileSize : fileSizes) {
+        ASSERT_LE(fileSize, traceLines.size());
+        std::string content = traceLines.substr(0, fileSize);
+        ASSERT_TRUE(FileUtil::SaveStringToFile(testSourceFile, content, true));
+        for (const auto& option : options) {
+            std::string caseName = std::to_string(fileSize) + "_" + std::to_string(option.threadCount);
+            std::string zipFile = SOURCE_PATH + "test_block_pack_" + caseName + ".zip";
+            (void)FileUtil::RemoveFile(zipFile);
+            {
+                HiviewZipUnit zipUnit(zipFile);
+                ASSERT_EQ(zipUnit.AddFileInZip(testSourceFile, ZipFileLevel::KEEP_NONE_PARENT_PATH, option), 0);
+            }
+            std::string unzipPath = ZIP_DES_PATH + "block_" + caseName + "/";
+            HiviewUnzipUnit unzipUnit(zipFile, unzipPath);
+            ASSERT_TRUE(unzipUnit.UnzipFile());
+            std::string unzipContent;
+            ASSERT_TRUE(FileUtil::LoadStringFromFile(unzipPath + "zip_test_block_file.txt", unzipContent));
+            ASSERT_EQ(unzipContent, content);
+            (void)FileUtil::RemoveFile(zipFile);
+        }
+    }
+}
+
+/**
+ * @tc.name: ZipUtilTest004
+ * @tc.desc: Benchmark of HiviewZipUnit deflating a file in blocks, compared with the single thread zip
+ * @tc.type: PERF
+ */
+HWTEST_F(AdapterUtilityOhosTest, ZipUtilTest004, testing::ext::TestSize.Level3)
+{
+    std::string testSourceFile = SOURCE_PATH + "zip_bench_block_file.txt";
+    std::string content;
+    const int lineCount = 100000; // 100000: about 6MB of the trace like lines
+    for (int i = 0; i < lineCount; i++) {
+        // 97, 8, 7, 9973: test values to vary the lines
+        content.append("  kworker/" + std::to_string(i % 97) + " [00" + std::to_string(i % 8) + "] .... " +
+            std::to_string(i) + ": sched_switch: prev_pid=" + std::to_string(i * 7 % 9973) + "\n");
+    }
+    ASSERT_TRUE(FileUtil::SaveStringToFile(testSourceFile, content, true));
+    std::vector<ZipCompressOption> options = {
+        { Z_DEFAULT_COMPRESSION, 1 },
+        { Z_DEFAULT_COMPRESSION, 2 }, // 2: deflate thread count
+        { Z_DEFAULT_COMPRESSION, 4 }, // 4: deflate thread count
+    };
+    double sizeInMb = static_cast<double>(content.size()) / 1024 / 1024; // 1024: bytes to MB
+    uint64_t singleThreadCost = 0;
+    for (const auto& option : options) {
+        std::string zipFile = SOURCE_PATH + "test_block_bench_" + std::to_string(option.threadCount) + ".zip";
+        (void)FileUtil::RemoveFile(zipFile);
+        uint64_t startTime = TimeUtil::GetMilliseconds();
+        {
+            HiviewZipUnit zipUnit(zipFile);
+            ASSERT_EQ(zipUnit.AddFileInZip(testSourceFile, ZipFileLevel::KEEP_NONE_PARENT_PATH, option), 0);
+        }
+        uint64_t costTime = std::max<uint64_t>(TimeUtil::GetMilliseconds() - startTime, 1);
+        if (singleThreadCost == 0) {
+            singleThreadCost = costTime;
+        }
+        uint64_t zipSize = FileUtil::GetFileSize(zipFile);
+        ASSERT_GT(zipSize, 0);
+        std::cout << "zip with " << option.threadCount << " threads, speed: " <<
+            sizeInMb * TimeUtil::SEC_TO_MILLISEC / costTime << " MB/s, speedup: " <<
+            static_cast<double>(singleThreadCost) / costTime << ", compression ratio: " <<
+            static_cast<double>(zipSize) / content.size() << std::endl;
+        (void)FileUtil::RemoveFile(zipFile);
+    }
+    (void)FileUtil::RemoveFile(testSourceFile);
+}
+
 /**
  * @tc.name: DbUtilTest001
  * @tc.desc: Test api of DbUtil
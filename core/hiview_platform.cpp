@@ -614,6 +614,7 @@ void HiviewPlatform::RegisterUnorderedEventListener(std::weak_ptr<EventListener>
         return;
     }
     auto name = ptr->GetListenerName();
+    std::lock_guard<std::mutex> lock(routesMutex_);
     auto itListenerInfo = listeners_.find(name);
     if (itListenerInfo == listeners_.end()) {
         auto tmp = std::make_shared<ListenerInfo>();
@@ -623,6 +624,7 @@ void HiviewPlatform::RegisterUnorderedEventListener(std::weak_ptr<EventListener>
         auto tmp = listeners_[name];
         tmp->listener_ = listener;
     }
+    listenerRoutes_.Clear();
 }
 
 bool HiviewPlatform::PostSyncEventToTarget(std::shared_ptr<Plugin> caller, const std::string& calleeName,
@@ -727,6 +729,12 @@ void HiviewPlatform::UnloadPlugin(const std::string& name)
     }
     pluginMap_.erase(name);
     target->OnUnload();
+    {
+        std::lock_guard<std::mutex> lock(routesMutex_);
+        dispatchers_.erase(name);
+        dispatcherRoutes_.Clear();
+        listenerRoutes_.Clear();
+    }
 
     // By default, reloading is not supported after unloading!
     PluginFactory::UnregisterPlugin(target->GetName());
@@ -951,6 +959,8 @@ void HiviewPlatform::AddDispatchInfo(std::weak_ptr<Plugin> plugin, const std::un
         return;
     }
     auto name = ptr->GetName();
+    std::lock_guard<std::mutex> lock(routesMutex_);
+    dispatcherRoutes_.Clear();
     auto itDispatchInfo = dispatchers_.find(name);
     std::shared_ptr<DispatchInfo> data = nullptr;
     if (itDispatchInfo == dispatchers_.end()) {
@@ -978,6 +988,8 @@ void HiviewPlatform::AddDispatchInfo(std::weak_ptr<Plugin> plugin, const std::un
 void HiviewPlatform::AddListenerInfo(uint32_t type, const std::string& name, const std::set<std::string>& eventNames,
     const std::map<std::string, DomainRule>& domainRulesMap)
 {
+    std::lock_guard<std::mutex> lock(routesMutex_);
+    listenerRoutes_.Clear();
     auto itListenerInfo = listeners_.find(name);
     std::shared_ptr<ListenerInfo> data = nullptr;
     if (itListenerInfo == listeners_.end()) {
@@ -1007,6 +1019,8 @@ void HiviewPlatform::AddListenerInfo(uint32_t type, const std::string& name, con
 
 void HiviewPlatform::AddListenerInfo(uint32_t type, const std::string& name)
 {
+    std::lock_guard<std::mutex> lock(routesMutex_);
+    listenerRoutes_.Clear();
     auto itListenerInfo = listeners_.find(name);
     std::shared_ptr<ListenerInfo> data = nullptr;
     if (itListenerInfo == listeners_.end()) {
@@ -1019,30 +1033,40 @@ void HiviewPlatform::AddListenerInfo(uint32_t type, const std::string& name)
     data->messageTypes_.push_back(type);
 }
 
-std::vector<std::weak_ptr<EventListener>> HiviewPlatform::GetListenerInfo(uint32_t type,
+std::shared_ptr<const EventListenerList> HiviewPlatform::GetListenerInfo(uint32_t type,
     const std::string& eventName, const std::string& domain)
 {
-    std::vector<std::weak_ptr<EventListener>> ret;
+    std::lock_guard<std::mutex> lock(routesMutex_);
+    if (auto targets = listenerRoutes_.Find(type, domain, eventName, ""); targets != nullptr) {
+        return targets;
+    }
+    auto targets = std::make_shared<EventListenerList>();
     for (auto& pairListener : listeners_) {
         auto listenerInfo = pairListener.second;
         if (listenerInfo->Match(type, eventName, domain)) {
-            ret.push_back(listenerInfo->listener_);
+            targets->push_back(listenerInfo->listener_);
         }
     }
-    return ret;
+    listenerRoutes_.Insert(type, domain, eventName, "", targets);
+    return targets;
 }
 
-std::vector<std::weak_ptr<Plugin>> HiviewPlatform::GetDisPatcherInfo(uint32_t type,
+std::shared_ptr<const PluginList> HiviewPlatform::GetDisPatcherInfo(uint32_t type,
     const std::string& eventName, const std::string& tag, const std::string& domain)
 {
-    std::vector<std::weak_ptr<Plugin>> ret;
+    std::lock_guard<std::mutex> lock(routesMutex_);
+    if (auto targets = dispatcherRoutes_.Find(type, domain, eventName, tag); targets != nullptr) {
+        return targets;
+    }
+    auto targets = std::make_shared<PluginList>();
     for (auto& pairDispatcher : dispatchers_) {
         auto dispatcherInfo = pairDispatcher.second;
         if (dispatcherInfo->Match(type, eventName, tag, domain)) {
-            ret.push_back(dispatcherInfo->plugin_);
+            targets->push_back(dispatcherInfo->plugin_);
         }
     }
-    return ret;
+    dispatcherRoutes_.Insert(type, domain, eventName, tag, targets);
+    return targets;
 }
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -29,6 +29,11 @@ public:
     EventReceiver() {};
     virtual ~EventReceiver() {};
     virtual void HandlerEvent(std::shared_ptr<EventRaw::RawData> rawData) = 0;
+    // the source is the name of the device node which the raw data is received from
+    virtual void HandlerSourceEvent(std::shared_ptr<EventRaw::RawData> rawData, const std::string& source)
+    {
+        HandlerEvent(rawData);
+    }
 };
 
 class DeviceNode {
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIVIEW_CORE_EVENT_ROUTE_CACHE_H
+#define HIVIEW_CORE_EVENT_ROUTE_CACHE_H
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+/*
+ * Targets resolved for (message type, domain, event name, tag) of an event. Each resolved target list is
+ * immutable and shared with the callers, so a lookup neither copies nor allocates, and the callers keep
+ * using their snapshot safely even if the cache is cleared at the same time.
+ */
+template<typename T>
+class EventRouteCache {
+public:
+    using Targets = std::vector<std::weak_ptr<T>>;
+
+    std::shared_ptr<const Targets> Find(uint32_t type, const std::string& domain, const std::string& eventName,
+        const std::string& tag) const
+    {
+        auto typeIter = routes_.find(type);
+        if (typeIter == routes_.end()) {
+            return nullptr;
+        }
+        auto domainIter = typeIter->second.find(domain);
+        if (domainIter == typeIter->second.end()) {
+            return nullptr;
+        }
+        auto nameIter = domainIter->second.find(eventName);
+        if (nameIter == domainIter->second.end()) {
+            return nullptr;
+        }
+        auto tagIter = nameIter->second.find(tag);
+        if (tagIter == nameIter->second.end()) {
+            return nullptr;
+        }
+        return tagIter->second;
+    }
+
+    void Insert(uint32_t type, const std::string& domain, const std::string& eventName, const std::string& tag,
+        std::shared_ptr<const Targets> targets)
+    {
+        if (size_ >= MAX_ROUTE_SIZE) {
+            Clear();
+        }
+        routes_[type][domain][eventName][tag] = targets;
+        ++size_;
+    }
+
+    void Clear()
+    {
+        routes_.clear();
+        size_ = 0;
+    }
+
+private:
+    static constexpr size_t MAX_ROUTE_SIZE = 4096;
+    template<typename V>
+    using StrMap = std::unordered_map<std::string, V>;
+    // <type, <domain, <eventName, <tag, targets>>>>
+    std::unordered_map<uint32_t, StrMap<StrMap<StrMap<std::shared_ptr<const Targets>>>>> routes_;
+    size_t size_ = 0;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIVIEW_CORE_EVENT_ROUTE_CACHE_H
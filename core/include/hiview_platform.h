@@ -22,6 +22,7 @@
 #include "dynamic_module.h"
 #include "event_dispatch_queue.h"
 #include "event_loop.h"
+#include "event_route_cache.h"
 #include "event_source.h"
 #include "pipeline.h"
 #include "plugin.h"
@@ -63,12 +64,12 @@ public:
     void AddDispatchInfo(std::weak_ptr<Plugin> plugin, const std::unordered_set<uint8_t>& types,
         const std::unordered_set<std::string>& eventNames, const std::unordered_set<std::string>& tags,
         const std::unordered_map<std::string, DomainRule>& domainRulesMap) override;
-    std::vector<std::weak_ptr<Plugin>> GetDisPatcherInfo(uint32_t type,
+    std::shared_ptr<const PluginList> GetDisPatcherInfo(uint32_t type,
         const std::string& eventName, const std::string& tag, const std::string& domain) override;
     void AddListenerInfo(uint32_t type, const std::string& name, const std::set<std::string>& eventNames,
         const std::map<std::string, DomainRule>& domainRulesMap) override;
     void AddListenerInfo(uint32_t type, const std::string& name) override;
-    std::vector<std::weak_ptr<EventListener>> GetListenerInfo(uint32_t type,
+    std::shared_ptr<const EventListenerList> GetListenerInfo(uint32_t type,
         const std::string& eventName, const std::string& domain) override;
 
     PipelineConfigMap& GetPipelineConfigMap()
@@ -198,6 +199,10 @@ private:
     // Listener data structure:<pluginName, <domain_eventName, Plugin>>
     std::unordered_map<std::string, std::shared_ptr<ListenerInfo>> listeners_;
     std::unordered_map<std::string, std::shared_ptr<DispatchInfo>> dispatchers_;
+    // targets resolved from listeners_ and dispatchers_, cleared once any of them changes
+    EventRouteCache<EventListener> listenerRoutes_;
+    EventRouteCache<Plugin> dispatcherRoutes_;
+    std::mutex routesMutex_;
     PipelineConfigMap pipelineRules_;
     std::vector<std::shared_ptr<Plugin>> eventSourceList_;
 
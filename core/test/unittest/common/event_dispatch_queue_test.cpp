@@ -15,6 +15,8 @@
 
 #include "event_dispatch_queue_test.h"
 
+#include <chrono>
+
 using namespace testing::ext;
 using namespace OHOS::HiviewDFX;
 
@@ -62,6 +64,24 @@ namespace {
 const std::string TEST_QUEUE_NAME = "test_queue";
 const std::string TEST_EVENT_NAME = "test_event";
 const std::string TEST_MESSAGE = "test_message";
+const std::string TEST_DOMAIN = "TEST_DOMAIN";
+const std::string TEST_LISTENER_PREFIX = "test_listener_";
+constexpr uint32_t TEST_LOOKUP_TIMES = 100000;
+constexpr uint32_t TEST_MISS_LOOKUP_TIMES = 1000;
+
+std::vector<std::shared_ptr<ExtendEventListener>> RegisterListeners(HiviewPlatform& platform, size_t count)
+{
+    std::vector<std::shared_ptr<ExtendEventListener>> listeners;
+    for (size_t i = 0; i < count; ++i) {
+        auto name = TEST_LISTENER_PREFIX + std::to_string(i);
+        auto listener = std::make_shared<ExtendEventListener>(name);
+        platform.RegisterUnorderedEventListener(listener);
+        std::set<std::string> eventNames = { TEST_EVENT_NAME + std::to_string(i) };
+        platform.AddListenerInfo(Event::MessageType::SYS_EVENT, name, eventNames, {});
+        listeners.push_back(listener);
+    }
+    return listeners;
+}
 }
 
 /**
@@ -134,3 +154,73 @@ HWTEST_F(EventDispatchQueueTest, EventDispatchQueueCreateTest003, TestSize.Level
     orderQueue->Stop();
     ASSERT_EQ(false, orderQueue->IsRunning());
 }
+
+/**
+ * @tc.name: EventDispatchQueueRouteTest001
+ * @tc.desc: resolve listeners of events through the cached routes of platform
+ * @tc.type: FUNC
+ * @tc.require: issueI9IA2M
+ */
+HWTEST_F(EventDispatchQueueTest, EventDispatchQueueRouteTest001, TestSize.Level3)
+{
+    HiviewPlatform platform;
+    auto listeners = RegisterListeners(platform, 3); // 3 listeners
+    auto targets = platform.GetListenerInfo(Event::MessageType::SYS_EVENT, TEST_EVENT_NAME + "1", TEST_DOMAIN);
+    ASSERT_NE(targets, nullptr);
+    ASSERT_EQ(targets->size(), 1);
+    ASSERT_EQ(targets->front().lock(), listeners[1]);
+
+    // same route is resolved only once
+    ASSERT_EQ(targets, platform.GetListenerInfo(Event::MessageType::SYS_EVENT, TEST_EVENT_NAME + "1", TEST_DOMAIN));
+    ASSERT_TRUE(platform.GetListenerInfo(Event::MessageType::SYS_EVENT, TEST_EVENT_NAME, TEST_DOMAIN)->empty());
+
+    // the cached routes are refreshed once the listener info changes
+    platform.AddListenerInfo(Event::MessageType::SYS_EVENT, TEST_LISTENER_PREFIX + "0");
+    auto newTargets = platform.GetListenerInfo(Event::MessageType::SYS_EVENT, TEST_EVENT_NAME + "1", TEST_DOMAIN);
+    ASSERT_NE(targets, newTargets);
+    ASSERT_EQ(newTargets->size(), 2); // listener 0 and listener 1
+    ASSERT_EQ(targets->size(), 1);
+}
+
+/**
+ * @tc.name: EventDispatchQueueRouteTest002
+ * @tc.desc: measure the cost of resolving listeners through the cached route and after the routes are cleared
+ *           by AddListenerInfo, with different count of registered listeners
+ * @tc.type: PERF
+ * @tc.require: issueI9IA2M
+ */
+HWTEST_F(EventDispatchQueueTest, EventDispatchQueueRouteTest002, TestSize.Level3)
+{
+    const std::vector<size_t> listenerCounts = { 10, 100, 1000 };
+    for (auto count : listenerCounts) {
+        HiviewPlatform platform;
+        auto listeners = RegisterListeners(platform, count);
+        auto eventName = TEST_EVENT_NAME + std::to_string(count / 2); // 2: pick the listener in the middle
+        size_t matchedCnt = 0;
+        auto beginTime = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < TEST_LOOKUP_TIMES; ++i) {
+            matchedCnt += platform.GetListenerInfo(Event::MessageType::SYS_EVENT, eventName, TEST_DOMAIN)->size();
+        }
+        auto costNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - beginTime).count();
+        ASSERT_EQ(matchedCnt, TEST_LOOKUP_TIMES);
+        printf("listeners=%zu, lookups=%u, cost per cached lookup=%lldns\n", count, TEST_LOOKUP_TIMES,
+            static_cast<long long>(costNs / TEST_LOOKUP_TIMES));
+
+        // the listener info added clears the cached routes, the next lookup walks all the listeners again
+        auto listenerName = TEST_LISTENER_PREFIX + std::to_string(count / 2); // 2: the listener in the middle
+        std::set<std::string> eventNames = { eventName };
+        matchedCnt = 0;
+        costNs = 0;
+        for (uint32_t i = 0; i < TEST_MISS_LOOKUP_TIMES; ++i) {
+            platform.AddListenerInfo(Event::MessageType::SYS_EVENT, listenerName, eventNames, {});
+            beginTime = std::chrono::steady_clock::now();
+            matchedCnt += platform.GetListenerInfo(Event::MessageType::SYS_EVENT, eventName, TEST_DOMAIN)->size();
+            costNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - beginTime).count();
+        }
+        ASSERT_EQ(matchedCnt, TEST_MISS_LOOKUP_TIMES);
+        printf("listeners=%zu, lookups=%u, cost per lookup after AddListenerInfo=%lldns\n", count,
+            TEST_MISS_LOOKUP_TIMES, static_cast<long long>(costNs / TEST_MISS_LOOKUP_TIMES));
+    }
+}
@@ -23,12 +23,11 @@
 #include <unistd.h>
 
 #include "common_util.h"
-#include "common_utils.h"
 #include "file_util.h"
 #include "hiview_logger.h"
 #include "memory_decorator.h"
 #include "memory_utils.h"
-#include "string_util.h"
+#include "proc_memory_sampler.h"
 #include "time_util.h"
 #ifdef PC_APP_STATE_COLLECT_ENABLE
 #include "process_status.h"
@@ -46,72 +45,16 @@ const int NON_PC_APP_STATE = -1;
 const int VSS_BIT = 4;
 constexpr char MEM_INFO[] = "/proc/meminfo";
 constexpr char STATM[] = "/statm";
-constexpr char SMAPS_ROLLUP[] = "/smaps_rollup";
 constexpr char PROC[] = "/proc/";
+constexpr uint32_t SAMPLE_THREAD_COUNT = 4;
 
-static void SetValueOfProcessMemory(ProcessMemory& processMemory, const std::string& attrName, int32_t value)
+static int32_t GetProcState(int32_t pid)
 {
-    static std::map<std::string, std::function<void(ProcessMemory&, int32_t)>> assignFuncMap = {
-        {"Rss", [] (ProcessMemory& memory, int32_t value) {
-            memory.rss = value;
-        }},
-        {"Pss", [] (ProcessMemory& memory, int32_t value) {
-            memory.pss = value;
-        }},
-        {"Shared_Dirty", [] (ProcessMemory& memory, int32_t value) {
-            memory.sharedDirty = value;
-        }},
-        {"Private_Dirty", [] (ProcessMemory& memory, int32_t value) {
-            memory.privateDirty = value;
-        }},
-        {"SwapPss", [] (ProcessMemory& memory, int32_t value) {
-            memory.swapPss = value;
-        }},
-        {"Shared_Clean", [] (ProcessMemory& memory, int32_t value) {
-            memory.sharedClean = value;
-        }},
-        {"Private_Clean", [] (ProcessMemory& memory, int32_t value) {
-            memory.privateClean = value;
-        }},
-    };
-    auto iter = assignFuncMap.find(attrName);
-    if (iter == assignFuncMap.end() || iter->second == nullptr) {
-        HIVIEW_LOGD("%{public}s isn't defined in ProcessMemory.", attrName.c_str());
-        return;
-    }
-    iter->second(processMemory, value);
-}
-
-static void InitSmapsOfProcessMemory(const std::string& procDir, ProcessMemory& memory)
-{
-    std::string smapsFilePath = procDir + SMAPS_ROLLUP;
-    std::string content;
-    if (!FileUtil::LoadStringFromFile(smapsFilePath, content)) {
-        HIVIEW_LOGW("failed to read smaps file:%{public}s.", smapsFilePath.c_str());
-        return;
-    }
-    std::vector<std::string> vec;
-    OHOS::SplitStr(content, "\n", vec);
-    for (const std::string& str : vec) {
-        std::string attrName;
-        int64_t value = 0;
-        if (CommonUtil::ParseTypeAndValue(str, attrName, value)) {
-            SetValueOfProcessMemory(memory, attrName, value);
-        }
-    }
-}
-
-static void InitAdjOfProcessMemory(const std::string& procDir, ProcessMemory& memory)
-{
-    std::string adjFilePath = procDir + "/oom_score_adj";
-    std::string content;
-    if (!FileUtil::LoadStringFromFile(adjFilePath, content)) {
-        HIVIEW_LOGW("failed to read adj file:%{public}s.", adjFilePath.c_str());
-        return;
-    }
-    if (!CommonUtil::StrToNum(content, memory.adj)) {
-        HIVIEW_LOGW("failed to translate \"%{public}s\" into number.", content.c_str());
-    }
+#if PC_APP_STATE_COLLECT_ENABLE
+    return ProcessStatus::GetInstance().GetProcessState(pid);
+#else
+    return NON_PC_APP_STATE;
+#endif
 }
 
 static bool InitProcessMemory(int32_t pid, ProcessMemory& memory)
@@ -121,19 +64,10 @@ static bool InitProcessMemory(int32_t pid, ProcessMemory& memory)
         HIVIEW_LOGW("%{public}s isn't exist.", procDir.c_str());
         return false;
     }
-    memory.pid = pid;
-    memory.name = CommonUtils::GetProcFullNameByPid(pid);
-    if (memory.name.empty()) {
-        HIVIEW_LOGD("process name is empty, pid=%{public}d.", pid);
+    if (!ProcMemorySampler::GetInstance().SampleProcess(pid, memory)) {
         return false;
     }
-#if PC_APP_STATE_COLLECT_ENABLE
-    memory.procState = ProcessStatus::GetInstance().GetProcessState(pid);
-#else
-    memory.procState = NON_PC_APP_STATE;
-#endif
-    InitSmapsOfProcessMemory(procDir, memory);
-    InitAdjOfProcessMemory(procDir, memory);
+    memory.procState = GetProcState(pid);
     return true;
 }
 
@@ -203,23 +137,10 @@ CollectResult<SysMemory> MemoryCollectorImpl::CollectSysMemory()
 CollectResult<std::vector<ProcessMemory>> MemoryCollectorImpl::CollectAllProcessMemory()
 {
     CollectResult<std::vector<ProcessMemory>> result;
-    std::vector<ProcessMemory> procMemoryVec;
-    std::vector<std::string> procFiles;
-    FileUtil::GetDirFiles(PROC, procFiles, false);
-    for (auto& procFile : procFiles) {
-        std::string fileName = FileUtil::ExtractFileName(procFile);
-        int value = 0;
-        if (!StringUtil::StrToInt(fileName, value)) {
-            HIVIEW_LOGD("%{public}s is not num string, value=%{public}d.", fileName.c_str(), value);
-            continue;
-        }
-        ProcessMemory procMemory;
-        if (!InitProcessMemory(value, procMemory)) {
-            continue;
-        }
-        procMemoryVec.emplace_back(procMemory);
+    result.data = ProcMemorySampler::GetInstance().SampleAllProcesses(SAMPLE_THREAD_COUNT);
+    for (auto& procMemory : result.data) {
+        procMemory.procState = GetProcState(procMemory.pid);
     }
-    result.data = procMemoryVec;
     result.retCode = UcError::SUCCESS;
     return result;
 }
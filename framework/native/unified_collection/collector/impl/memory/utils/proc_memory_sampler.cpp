@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "proc_memory_sampler.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <memory>
+#include <unistd.h>
+
+#include "hiview_logger.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace UCollectUtil {
+namespace {
+DEFINE_LOG_TAG("UCollectUtil-ProcMemorySampler");
+constexpr char DEFAULT_PROC_ROOT[] = "/proc/";
+constexpr char SMAPS_ROLLUP[] = "smaps_rollup";
+constexpr char OOM_SCORE_ADJ[] = "oom_score_adj";
+constexpr char CMDLINE[] = "cmdline";
+constexpr char STAT[] = "stat";
+constexpr size_t INIT_READ_BUFFER_SIZE = 4 * 1024;
+constexpr size_t MAX_READ_BUFFER_SIZE = 1024 * 1024;
+// every cached process holds one fd, the processes beyond the cap open their smaps_rollup per sweep, so
+// the cache takes only a small share of the fds of hiview
+constexpr size_t MAX_CACHED_FD_COUNT = 256;
+constexpr uint32_t MAX_SAMPLE_THREAD_COUNT = 4;
+constexpr int64_t DECIMAL_BASE = 10;
+constexpr size_t MAX_PID_LEN = 10;
+
+struct SmapsField {
+    const char* key;
+    size_t keyLen;
+    int32_t ProcessMemory::* field;
+};
+
+const SmapsField SMAPS_FIELDS[] = {
+    {"Rss", sizeof("Rss") - 1, &ProcessMemory::rss},
+    {"Pss", sizeof("Pss") - 1, &ProcessMemory::pss},
+    {"Shared_Dirty", sizeof("Shared_Dirty") - 1, &ProcessMemory::sharedDirty},
+    {"Private_Dirty", sizeof("Private_Dirty") - 1, &ProcessMemory::privateDirty},
+    {"SwapPss", sizeof("SwapPss") - 1, &ProcessMemory::swapPss},
+    {"Shared_Clean", sizeof("Shared_Clean") - 1, &ProcessMemory::sharedClean},
+    {"Private_Clean", sizeof("Private_Clean") - 1, &ProcessMemory::privateClean},
+};
+
+struct SampleContext {
+    ffrt::mutex mutex;
+    ffrt::condition_variable cond;
+    uint32_t remainCount = 0;
+};
+
+// reads the file from the beginning, the procfs file is generated again for every read at offset 0
+ssize_t PreadFile(int fd, std::vector<char>& buffer)
+{
+    size_t len = 0;
+    while (true) {
+        if (len == buffer.size()) {
+            if (buffer.size() >= MAX_READ_BUFFER_SIZE) {
+                return static_cast<ssize_t>(len);
+            }
+            buffer.resize(buffer.size() * 2); // 2: grow the buffer for a large file
+        }
+        ssize_t ret = TEMP_FAILURE_RETRY(pread(fd, buffer.data() + len, buffer.size() - len, len));
+        if (ret < 0) {
+            return -1;
+        }
+        if (ret == 0) {
+            return static_cast<ssize_t>(len);
+        }
+        len += static_cast<size_t>(ret);
+    }
+}
+
+ssize_t ReadFileByPath(const std::string& path, std::vector<char>& buffer)
+{
+    int fd = TEMP_FAILURE_RETRY(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t len = PreadFile(fd, buffer);
+    close(fd);
+    return len;
+}
+
+// skips the leading blanks and scans a decimal number as the stream extraction does
+bool ScanNumber(const char* begin, const char* end, int64_t& value)
+{
+    while (begin < end && isspace(static_cast<unsigned char>(*begin))) {
+        begin++;
+    }
+    bool isNegative = false;
+    if (begin < end && (*begin == '-' || *begin == '+')) {
+        isNegative = (*begin == '-');
+        begin++;
+    }
+    if (begin == end || !isdigit(static_cast<unsigned char>(*begin))) {
+        return false;
+    }
+    int64_t result = 0;
+    for (; begin < end && isdigit(static_cast<unsigned char>(*begin)); begin++) {
+        result = result * DECIMAL_BASE + (*begin - '0');
+    }
+    value = isNegative ? -result : result;
+    return true;
+}
+
+// the lines are like "Pss:    1024 kB", only the keys of ProcessMemory are matched exactly
+void ScanSmapsRollup(const char* begin, const char* end, ProcessMemory& memory)
+{
+    const char* line = begin;
+    while (line < end) {
+        auto lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        auto colon = static_cast<const char*>(memchr(line, ':', lineEnd - line));
+        if (colon != nullptr) {
+            size_t keyLen = static_cast<size_t>(colon - line);
+            for (const auto& smapsField : SMAPS_FIELDS) {
+                if (smapsField.keyLen != keyLen || memcmp(smapsField.key, line, keyLen) != 0) {
+                    continue;
+                }
+                int64_t value = 0;
+                ScanNumber(colon + 1, lineEnd, value);
+                memory.*(smapsField.field) = static_cast<int32_t>(value);
+                break;
+            }
+        }
+        line = lineEnd + 1;
+    }
+}
+
+// for the format '/system/bin/hiview' or 'hiview \0 3 \0 hiview' of the cmdline file
+std::string ParseNameFromCmdline(const char* begin, const char* end)
+{
+    auto lineEnd = static_cast<const char*>(memchr(begin, '\n', end - begin));
+    if (lineEnd != nullptr) {
+        end = lineEnd;
+    }
+    const char* nameBegin = begin;
+    const char* nameEnd = end;
+    for (const char* pos = begin; pos < end; pos++) {
+        if (*pos == '/') {
+            nameBegin = pos + 1;
+        } else if (*pos == '\0') {
+            nameEnd = pos;
+            break;
+        }
+    }
+    return nameEnd > nameBegin ? std::string(nameBegin, nameEnd) : "";
+}
+
+// for the format '40 (hiview) I ...' of the stat file
+std::string ParseNameFromStat(const char* begin, const char* end)
+{
+    auto lineEnd = static_cast<const char*>(memchr(begin, '\n', end - begin));
+    if (lineEnd != nullptr) {
+        end = lineEnd;
+    }
+    auto nameBegin = static_cast<const char*>(memchr(begin, '(', end - begin));
+    auto nameEnd = static_cast<const char*>(memchr(begin, ')', end - begin));
+    if (nameBegin == nullptr || nameEnd == nullptr || nameEnd <= nameBegin + 1) {
+        return "";
+    }
+    return std::string(nameBegin + 1, nameEnd);
+}
+}
+
+ProcMemorySampler::ProcMemorySampler() : procRoot_(DEFAULT_PROC_ROOT)
+{}
+
+ProcMemorySampler::ProcMemorySampler(const std::string& procRoot) : procRoot_(procRoot)
+{
+    if (procRoot_.empty() || procRoot_.back() != '/') {
+        procRoot_.append("/");
+    }
+}
+
+ProcMemorySampler::~ProcMemorySampler()
+{
+    for (const auto& item : smapsFds_) {
+        if (item.second >= 0) {
+            close(item.second);
+        }
+    }
+}
+
+bool ProcMemorySampler::SampleProcess(int32_t pid, ProcessMemory& memory)
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    SampleTarget target = {pid, nullptr};
+    if (auto it = smapsFds_.find(pid); it != smapsFds_.end()) {
+        target.smapsFd = &(it->second);
+    }
+    std::vector<char> buffer(INIT_READ_BUFFER_SIZE);
+    return SampleTargetProcess(target, buffer, memory);
+}
+
+std::vector<ProcessMemory> ProcMemorySampler::SampleAllProcesses(uint32_t threadCount)
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    std::vector<int32_t> pids = ListPids();
+    SyncCache(pids);
+    std::vector<SampleTarget> targets;
+    targets.reserve(pids.size());
+    for (auto pid : pids) {
+        auto it = smapsFds_.find(pid);
+        targets.push_back({pid, it != smapsFds_.end() ? &(it->second) : nullptr});
+    }
+
+    std::vector<ProcessMemory> memories(targets.size());
+    std::vector<uint8_t> isSampled(targets.size(), 0);
+    size_t partitionCount = std::min<size_t>(std::clamp<uint32_t>(threadCount, 1, MAX_SAMPLE_THREAD_COUNT),
+        std::max<size_t>(targets.size(), 1));
+    size_t partitionSize = (targets.size() + partitionCount - 1) / partitionCount;
+    auto context = std::make_shared<SampleContext>();
+    context->remainCount = static_cast<uint32_t>(partitionCount - 1);
+    // the first partition is sampled by the calling thread, the others by the tasks
+    for (size_t index = 1; index < partitionCount; index++) {
+        size_t begin = std::min(index * partitionSize, targets.size());
+        size_t end = std::min(begin + partitionSize, targets.size());
+        ffrt::submit([this, context, &targets, &memories, &isSampled, begin, end] {
+            SamplePartition(targets, begin, end, memories, isSampled);
+            std::unique_lock<ffrt::mutex> lock(context->mutex);
+            context->remainCount--;
+            context->cond.notify_all();
+        }, ffrt::task_attr().name("ucollection_mem_sample"));
+    }
+    SamplePartition(targets, 0, std::min(partitionSize, targets.size()), memories, isSampled);
+    {
+        std::unique_lock<ffrt::mutex> contextLock(context->mutex);
+        context->cond.wait(contextLock, [&context] { return context->remainCount == 0; });
+    }
+
+    std::vector<ProcessMemory> result;
+    result.reserve(memories.size());
+    for (size_t index = 0; index < memories.size(); index++) {
+        if (isSampled[index] != 0) {
+            result.emplace_back(std::move(memories[index]));
+        }
+    }
+    return result;
+}
+
+size_t ProcMemorySampler::GetCachedFdCount()
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    return std::count_if(smapsFds_.begin(), smapsFds_.end(), [] (const auto& item) { return item.second >= 0; });
+}
+
+std::vector<int32_t> ProcMemorySampler::ListPids() const
+{
+    std::vector<int32_t> pids;
+    DIR* dir = opendir(procRoot_.c_str());
+    if (dir == nullptr) {
+        HIVIEW_LOGW("failed to open %{public}s, errno=%{public}d.", procRoot_.c_str(), errno);
+        return pids;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+        if (entry->d_type != DT_DIR && entry->d_type != DT_UNKNOWN) {
+            continue;
+        }
+        const char* name = entry->d_name;
+        size_t nameLen = strlen(name);
+        int64_t pid = 0;
+        if (nameLen == 0 || nameLen > MAX_PID_LEN ||
+            !std::all_of(name, name + nameLen, [] (char c) { return isdigit(static_cast<unsigned char>(c)); }) ||
+            !ScanNumber(name, name + nameLen, pid) || pid > INT32_MAX) {
+            continue;
+        }
+        pids.push_back(static_cast<int32_t>(pid));
+    }
+    closedir(dir);
+    std::sort(pids.begin(), pids.end());
+    return pids;
+}
+
+void ProcMemorySampler::SyncCache(const std::vector<int32_t>& pids)
+{
+    // the entries of the live processes are kept, the fds of the exited ones are closed
+    std::unordered_map<int32_t, int> smapsFds;
+    smapsFds.reserve(std::min(pids.size(), MAX_CACHED_FD_COUNT));
+    for (auto pid : pids) {
+        if (auto it = smapsFds_.find(pid); it != smapsFds_.end()) {
+            smapsFds.emplace(pid, it->second);
+            smapsFds_.erase(it);
+        } else if (smapsFds.size() < MAX_CACHED_FD_COUNT) {
+            smapsFds.emplace(pid, -1);
+        }
+    }
+    for (const auto& item : smapsFds_) {
+        if (item.second >= 0) {
+            close(item.second);
+        }
+    }
+    smapsFds_.swap(smapsFds);
+}
+
+void ProcMemorySampler::SamplePartition(const std::vector<SampleTarget>& targets, size_t begin, size_t end,
+    std::vector<ProcessMemory>& memories, std::vector<uint8_t>& isSampled) const
+{
+    std::vector<char> buffer(INIT_READ_BUFFER_SIZE);
+    for (size_t index = begin; index < end; index++) {
+        isSampled[index] = SampleTargetProcess(targets[index], buffer, memories[index]) ? 1 : 0;
+    }
+}
+
+bool ProcMemorySampler::SampleTargetProcess(const SampleTarget& target, std::vector<char>& buffer,
+    ProcessMemory& memory) const
+{
+    memory.pid = target.pid;
+    if (!ReadProcName(target.pid, buffer, memory.name)) {
+        HIVIEW_LOGD("process name is empty, pid=%{public}d.", target.pid);
+        return false;
+    }
+    ReadSmapsRollup(target, buffer, memory);
+    ReadAdj(target.pid, buffer, memory);
+    return true;
+}
+
+bool ProcMemorySampler::ReadProcName(int32_t pid, std::vector<char>& buffer, std::string& name) const
+{
+    name.clear();
+    ssize_t len = ReadFileByPath(GetProcFilePath(pid, CMDLINE), buffer);
+    if (len > 0) {
+        name = ParseNameFromCmdline(buffer.data(), buffer.data() + len);
+    }
+    // the cmdline of the kernel threads is empty
+    if (name.empty()) {
+        len = ReadFileByPath(GetProcFilePath(pid, STAT), buffer);
+        if (len > 0) {
+            name = ParseNameFromStat(buffer.data(), buffer.data() + len);
+        }
+    }
+    return !name.empty();
+}
+
+bool ProcMemorySampler::ReadSmapsRollup(const SampleTarget& target, std::vector<char>& buffer,
+    ProcessMemory& memory) const
+{
+    ssize_t len = -1;
+    if (target.smapsFd == nullptr) {
+        len = ReadFileByPath(GetProcFilePath(target.pid, SMAPS_ROLLUP), buffer);
+    } else {
+        int& smapsFd = *(target.smapsFd);
+        if (smapsFd >= 0) {
+            len = PreadFile(smapsFd, buffer);
+        }
+        // the fd opened before an exec or by an exited process of the same pid fails with ESRCH, reopen it
+        if (len < 0) {
+            if (smapsFd >= 0) {
+                close(smapsFd);
+            }
+            smapsFd = TEMP_FAILURE_RETRY(open(GetProcFilePath(target.pid, SMAPS_ROLLUP).c_str(),
+                O_RDONLY | O_CLOEXEC));
+            len = smapsFd >= 0 ? PreadFile(smapsFd, buffer) : -1;
+        }
+    }
+    if (len < 0) {
+        HIVIEW_LOGW("failed to read smaps file of pid=%{public}d.", target.pid);
+        return false;
+    }
+    ScanSmapsRollup(buffer.data(), buffer.data() + len, memory);
+    return true;
+}
+
+bool ProcMemorySampler::ReadAdj(int32_t pid, std::vector<char>& buffer, ProcessMemory& memory) const
+{
+    ssize_t len = ReadFileByPath(GetProcFilePath(pid, OOM_SCORE_ADJ), buffer);
+    if (len < 0) {
+        HIVIEW_LOGW("failed to read adj file of pid=%{public}d.", pid);
+        return false;
+    }
+    int64_t adj = 0;
+    if (!ScanNumber(buffer.data(), buffer.data() + len, adj)) {
+        HIVIEW_LOGW("failed to translate the adj of pid=%{public}d into number.", pid);
+        return false;
+    }
+    memory.adj = static_cast<int32_t>(adj);
+    return true;
+}
+
+std::string ProcMemorySampler::GetProcFilePath(int32_t pid, const char* fileName) const
+{
+    return procRoot_ + std::to_string(pid) + "/" + fileName;
+}
+} // UCollectUtil
+} // HiViewDFX
+} // OHOS
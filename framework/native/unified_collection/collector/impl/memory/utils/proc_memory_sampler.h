@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAMEWORK_NATIVE_UNIFIED_COLLECTION_COLLECTOR_PROC_MEMORY_SAMPLER_H
+#define FRAMEWORK_NATIVE_UNIFIED_COLLECTION_COLLECTOR_PROC_MEMORY_SAMPLER_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ffrt.h"
+#include "memory.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace UCollectUtil {
+/*
+ * Samples the memory of the processes from procfs. The smaps_rollup file of a process is kept open between
+ * the sweeps and read by pread, every partition of a sweep reuses one read buffer for all of its processes
+ * and the values are scanned from the buffer straight into the fields of ProcessMemory.
+ */
+class ProcMemorySampler : public OHOS::DelayedRefSingleton<ProcMemorySampler> {
+public:
+    ProcMemorySampler();
+    explicit ProcMemorySampler(const std::string& procRoot);
+    ~ProcMemorySampler();
+    ProcMemorySampler& operator=(const ProcMemorySampler&) = delete;
+    ProcMemorySampler(const ProcMemorySampler&) = delete;
+
+    // the procState of the sampled memory is left to the caller
+    bool SampleProcess(int32_t pid, ProcessMemory& memory);
+    // the processes are split into partitions sampled concurrently if the thread count is more than one,
+    // the result is in the order of the pids
+    std::vector<ProcessMemory> SampleAllProcesses(uint32_t threadCount);
+    size_t GetCachedFdCount();
+
+private:
+    struct SampleTarget {
+        int32_t pid = 0;
+        // the cached fd of smaps_rollup, null if the process is beyond the capacity of the cache
+        int* smapsFd = nullptr;
+    };
+
+    std::vector<int32_t> ListPids() const;
+    void SyncCache(const std::vector<int32_t>& pids);
+    void SamplePartition(const std::vector<SampleTarget>& targets, size_t begin, size_t end,
+        std::vector<ProcessMemory>& memories, std::vector<uint8_t>& isSampled) const;
+    bool SampleTargetProcess(const SampleTarget& target, std::vector<char>& buffer, ProcessMemory& memory) const;
+    bool ReadProcName(int32_t pid, std::vector<char>& buffer, std::string& name) const;
+    bool ReadSmapsRollup(const SampleTarget& target, std::vector<char>& buffer, ProcessMemory& memory) const;
+    bool ReadAdj(int32_t pid, std::vector<char>& buffer, ProcessMemory& memory) const;
+    std::string GetProcFilePath(int32_t pid, const char* fileName) const;
+
+private:
+    std::string procRoot_;
+    // serializes the sweeps, the cache is only changed before the partitions are sampled
+    ffrt::mutex mutex_;
+    /* map<pid, fd of smaps_rollup> */
+    std::unordered_map<int32_t, int> smapsFds_;
+};
+} // UCollectUtil
+} // HiViewDFX
+} // OHOS
+#endif // FRAMEWORK_NATIVE_UNIFIED_COLLECTION_COLLECTOR_PROC_MEMORY_SAMPLER_H
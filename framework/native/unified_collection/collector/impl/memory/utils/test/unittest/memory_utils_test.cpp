@@ -13,19 +13,25 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <gtest/gtest.h>
+#include <iostream>
 #include <map>
 #include <set>
 #include <string>
 
+#include "file_util.h"
 #include "memory_utils.h"
+#include "proc_memory_sampler.h"
 
 using namespace testing::ext;
 namespace OHOS {
 namespace HiviewDFX {
 namespace {
 const char TEST_SMAPS_PATH[] = "/data/test/hiview/ucollection/smaps_example.txt";
+const char TEST_PROC_ROOT[] = "/data/test/hiview/ucollection/proc_sampler/";
 const int SUM_1_TO_43 = 946; // 946 : total sum from 1 to 43
+const int32_t KERNEL_THREAD_PID = 2; // 2 : pid of the synthetic kernel thread
 const std::map<MemoryItemType, std::string> TYPE_TO_NAME_MAP_TEST = {
     {MemoryItemType::MEMORY_ITEM_ENTITY_DB, "/data/other.db"},
     {MemoryItemType::MEMORY_ITEM_ENTITY_DB_SHM, "/data/storage/other.db-shm"},
@@ -73,6 +79,30 @@ const std::map<MemoryItemType, std::string> TYPE_TO_NAME_MAP_TEST = {
     {MemoryItemType::MEMORY_ITEM_TYPE_GRAPH_GRAPHICS, ""},
     {MemoryItemType::MEMORY_ITEM_TYPE_OTHER, "[other]"},
 };
+bool CreateSyntheticProcTree(int32_t procCount)
+{
+    FileUtil::ForceRemoveDirectory(TEST_PROC_ROOT);
+    for (int32_t pid = 1; pid <= procCount; pid++) {
+        std::string procDir = TEST_PROC_ROOT + std::to_string(pid) + "/";
+        if (!FileUtil::ForceCreateDirectory(procDir)) {
+            return false;
+        }
+        std::string pidStr = std::to_string(pid);
+        FileUtil::SaveStringToFile(procDir + "stat", pidStr + " (kthread" + pidStr + ") S 0\n");
+        if (pid == KERNEL_THREAD_PID) {
+            FileUtil::SaveStringToFile(procDir + "cmdline", "");
+            FileUtil::SaveStringToFile(procDir + "smaps_rollup", "");
+        } else {
+            FileUtil::SaveStringToFile(procDir + "cmdline", std::string("/system/bin/proc") + pidStr + '\0' + "-v");
+            FileUtil::SaveStringToFile(procDir + "smaps_rollup",
+                "00400000-ffffe000 ---p 00000000 00:00 0    [rollup]\nRss:    " + pidStr + " kB\nPss:    " +
+                pidStr + " kB\nPss_Anon:    1 kB\nShared_Clean:    2 kB\nShared_Dirty:    3 kB\n"
+                "Private_Clean:    4 kB\nPrivate_Dirty:    5 kB\nSwap:    6 kB\nSwapPss:    7 kB\n");
+        }
+        FileUtil::SaveStringToFile(procDir + "oom_score_adj", "-" + pidStr + "\n");
+    }
+    return FileUtil::ForceCreateDirectory(TEST_PROC_ROOT + std::string("self"));
+}
 }
 class MemoryUtilsTest : public testing::Test {
 public:
@@ -120,5 +150,91 @@ HWTEST_F(MemoryUtilsTest, MemoryUtilsTest001, TestSize.Level1)
     }
     ASSERT_EQ(memoryTypes.size(), 45); // 45 : max num of memory item type
 }
+
+/**
+ * @tc.name: ProcMemorySamplerTest001
+ * @tc.desc: used to test ProcMemorySampler on a synthetic proc tree, with the cached and the uncached fds
+ * @tc.type: FUNC
+*/
+HWTEST_F(MemoryUtilsTest, ProcMemorySamplerTest001, TestSize.Level1)
+{
+    const int32_t procCount = 500; // 500 : number of the synthetic processes
+    const size_t sampledCount = static_cast<size_t>(procCount);
+    const size_t maxCachedFdCount = 256; // 256 : max count of the cached smaps_rollup fds
+    ASSERT_TRUE(CreateSyntheticProcTree(procCount));
+
+    UCollectUtil::ProcMemorySampler sampler(TEST_PROC_ROOT);
+    for (uint32_t threadCount : {1, 4, 4}) { // 1, 4 : thread count, the last sweep reuses the cached fds
+        std::vector<ProcessMemory> memories = sampler.SampleAllProcesses(threadCount);
+        ASSERT_EQ(memories.size(), sampledCount);
+        for (const auto& memory : memories) {
+            if (memory.pid == KERNEL_THREAD_PID) {
+                ASSERT_EQ(memory.name, "kthread2");
+                ASSERT_EQ(memory.rss, 0);
+                continue;
+            }
+            ASSERT_EQ(memory.name, "proc" + std::to_string(memory.pid));
+            ASSERT_EQ(memory.rss, memory.pid);
+            ASSERT_EQ(memory.pss, memory.pid);
+            ASSERT_EQ(memory.sharedClean, 2); // 2 : Shared_Clean of the synthetic process
+            ASSERT_EQ(memory.privateDirty, 5); // 5 : Private_Dirty of the synthetic process
+            ASSERT_EQ(memory.swapPss, 7); // 7 : SwapPss of the synthetic process
+            ASSERT_EQ(memory.adj, -memory.pid);
+        }
+    }
+    // the processes beyond the cap are still sampled, only without a cached fd
+    ASSERT_EQ(sampler.GetCachedFdCount(), maxCachedFdCount);
+
+    // the cached fd of pid 1 and the uncached one of the last pid read the rewritten content
+    const int32_t newRss = 1000; // 1000 : test value
+    for (int32_t pid : {1, procCount - 1}) {
+        FileUtil::SaveStringToFile(TEST_PROC_ROOT + std::to_string(pid) + "/smaps_rollup",
+            "Rss:    " + std::to_string(newRss) + " kB\n", true);
+    }
+    std::vector<ProcessMemory> memories = sampler.SampleAllProcesses(1);
+    ASSERT_EQ(memories.size(), sampledCount);
+    ASSERT_EQ(memories.front().rss, newRss);
+    ASSERT_EQ(memories[sampledCount - 2].pid, procCount - 1); // 2 : index of the second to last pid
+    ASSERT_EQ(memories[sampledCount - 2].rss, newRss);
+
+    // the fd of the exited process is closed by the next sweep, and its slot is taken by an uncached process
+    FileUtil::ForceRemoveDirectory(TEST_PROC_ROOT + std::to_string(1));
+    ASSERT_EQ(sampler.SampleAllProcesses(1).size(), sampledCount - 1);
+    ASSERT_EQ(sampler.GetCachedFdCount(), maxCachedFdCount);
+    ProcessMemory memory;
+    ASSERT_FALSE(sampler.SampleProcess(1, memory));
+    ASSERT_TRUE(sampler.SampleProcess(procCount, memory));
+    ASSERT_EQ(memory.rss, procCount);
+}
+
+/**
+ * @tc.name: ProcMemorySamplerTest002
+ * @tc.desc: used to print the time of the sweeps of ProcMemorySampler over a synthetic proc tree
+ * @tc.type: PERF
+*/
+HWTEST_F(MemoryUtilsTest, ProcMemorySamplerTest002, TestSize.Level1)
+{
+    const int32_t procCount = 1000; // 1000 : number of the synthetic processes
+    const int32_t sweepCount = 10; // 10 : sweeps of each thread count
+    ASSERT_TRUE(CreateSyntheticProcTree(procCount));
+
+    UCollectUtil::ProcMemorySampler sampler(TEST_PROC_ROOT);
+    for (uint32_t threadCount : {1, 2, 4}) { // 1, 2, 4 : thread count
+        // the first sweep opens the fds, the following ones reuse the cached fds
+        auto startTime = std::chrono::steady_clock::now();
+        ASSERT_EQ(sampler.SampleAllProcesses(threadCount).size(), static_cast<size_t>(procCount));
+        auto firstCostTime = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+        startTime = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i < sweepCount; i++) {
+            ASSERT_EQ(sampler.SampleAllProcesses(threadCount).size(), static_cast<size_t>(procCount));
+        }
+        auto avgCostTime = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime).count() / sweepCount;
+        std::cout << "sample " << procCount << " processes with " << threadCount << " threads, first sweep cost " <<
+            firstCostTime << " us, following sweep cost " << avgCostTime << " us on average" << std::endl;
+    }
+    FileUtil::ForceRemoveDirectory(TEST_PROC_ROOT);
+}
 }
 }
@@ -26,6 +26,9 @@
 namespace OHOS::HiviewDFX {
 namespace {
 DEFINE_LOG_TAG("UCollectUtil-TraceCollector");
+// the zip runs only when the cpu load is low, the trace is deflated in blocks by several tasks
+constexpr uint32_t TRACE_ZIP_THREAD_COUNT = 4;
+
 void WriteTrafficLog(std::chrono::time_point<std::chrono::steady_clock> startTime, const std::string& caller,
     const std::string& srcFile, const std::string& traceFile)
 {
@@ -178,7 +181,8 @@ std::string TraceZipHandler::GetTraceZipTmpPath(const std::string &fileName)
 void TraceZipHandler::AddZipFile(const std::string &srcPath, const std::string &traceZipFile)
 {
     HiviewZipUnit zipUnit(traceZipFile);
-    if (int32_t ret = zipUnit.AddFileInZip(srcPath, ZipFileLevel::KEEP_NONE_PARENT_PATH); ret != 0) {
+    ZipCompressOption option = { Z_DEFAULT_COMPRESSION, TRACE_ZIP_THREAD_COUNT };
+    if (int32_t ret = zipUnit.AddFileInZip(srcPath, ZipFileLevel::KEEP_NONE_PARENT_PATH, option); ret != 0) {
         HIVIEW_LOGW("zip trace failed, ret: %{public}d.", ret);
     }
 }
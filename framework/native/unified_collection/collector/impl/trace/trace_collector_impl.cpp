@@ -46,6 +46,7 @@ namespace UCollectUtil {
 namespace {
 DEFINE_LOG_TAG("UCollectUtil-TraceCollector");
 constexpr uid_t HIVIEW_UID = 1201;
+constexpr uint32_t TRACE_ZIP_THREAD_COUNT = 4;
 const int64_t MS_TO_US = 1000;
 #ifndef TRACE_IMPL_UNITTEST
 constexpr char DB_PATH[] = "/data/log/hiview/unified_collection/trace/";
@@ -67,7 +68,8 @@ void ZipShareTempTraceFile(const std::string &srcFile)
     CheckCurrentCpuLoad();
     HiviewEventReport::ReportCpuScene("5");
     HiviewZipUnit zipUnit(zipTraceFile);
-    if (int32_t ret = zipUnit.AddFileInZip(srcFile, ZipFileLevel::KEEP_NONE_PARENT_PATH); ret != 0) {
+    ZipCompressOption option = { Z_DEFAULT_COMPRESSION, TRACE_ZIP_THREAD_COUNT };
+    if (int32_t ret = zipUnit.AddFileInZip(srcFile, ZipFileLevel::KEEP_NONE_PARENT_PATH, option); ret != 0) {
         HIVIEW_LOGE("zip trace failed, ret: %{public}d.", ret);
         return;
     }
@@ -42,6 +42,12 @@ bool EventWriteBaseStrategy::Write(std::string& exportContent, WroteCallback cal
     return false;
 }
 
+bool EventWriteBaseStrategy::Write(std::shared_ptr<ExportFileBaseBuilder> builder, const CachedEventMap& events,
+    WroteCallback callback)
+{
+    return false;
+}
+
 std::shared_ptr<EventWriteBaseStrategy> EventWriteStrategyFactory::GetWriteStrategy(StrategyType type)
 {
     static std::unordered_map<StrategyType, StrategyBuilderFunc> strategyBuilderMap = {
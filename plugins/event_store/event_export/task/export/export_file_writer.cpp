@@ -20,24 +20,20 @@
 namespace OHOS {
 namespace HiviewDFX {
 DEFINE_LOG_TAG("HiView-EventExportFlow");
-bool ExportFileWriter::Write(std::shared_ptr<ExportFileBaseBuilder> fileBuilder, CachedEventMap events,
+bool ExportFileWriter::Write(std::shared_ptr<ExportFileBaseBuilder> fileBuilder, const CachedEventMap& events,
     WriteStrategyParam& param)
 {
     if (fileBuilder == nullptr) {
         HIVIEW_LOGE("invalid export file builder");
         return false;
     }
-    std::string buildStr;
-    if (!fileBuilder->Build(events, buildStr)) {
-        return false;
-    }
     auto strategy = EventWriteStrategyFactory::GetWriteStrategy(StrategyType::ZIP_JSON_FILE);
     if (strategy == nullptr) {
         HIVIEW_LOGE("write strategy is null");
         return false;
     }
     strategy->SetWriteStrategyParam(param);
-    return strategy->Write(buildStr,
+    return strategy->Write(fileBuilder, events,
         [this] (const std::string& srcPath, const std::string& destPath) {
             if (exportFileWroteListener_ == nullptr) {
                 return;
@@ -44,6 +44,7 @@ constexpr char EVENTS_KEY[] = "EVENTS";
 constexpr char DATA_KEY[] = "DATA";
 constexpr char DEFAULT_MSG_ID[] = "00000000000000000000000000000000";
 constexpr char CUR_HEADER_VERSION[] = "1.0";
+constexpr size_t BUILD_BUFFER_SIZE = 64 * 1024; // 64K
 
 cJSON* CreateHeaderJsonObj()
 {
@@ -96,153 +97,176 @@ cJSON* CreateSystemObj(const EventVersion& eventVersion)
     return system;
 }
 
-cJSON* CreateEventsJsonArray(const std::string& domain,
-    const std::vector<std::pair<std::string, std::string>>& events)
+cJSON* CreateDomainInfoJsonObj(const std::string& domain)
 {
-    // events
-    cJSON* eventsJsonArray = cJSON_CreateArray();
-    if (eventsJsonArray == nullptr) {
-        HIVIEW_LOGE("failed to create events json array");
+    cJSON* domainInfo = cJSON_CreateObject();
+    if (domainInfo == nullptr) {
+        HIVIEW_LOGE("failed to create domain info json object");
         return nullptr;
     }
-    cJSON* dataJsonArray = cJSON_CreateArray();
-    if (dataJsonArray == nullptr) {
-        HIVIEW_LOGE("failed to create data json array");
-        cJSON_Delete(eventsJsonArray);
-        return nullptr;
+    cJSON_AddStringToObject(domainInfo, H_NAME_KEY, domain.c_str());
+    return domainInfo;
+}
+
+// prints the json item unformatted and deletes it, the same as it is printed in the whole json tree
+bool PersistJsonStr(cJSON* item, std::string& ret)
+{
+    if (item == nullptr) {
+        return false;
+    }
+    char* parsedJsonStr = cJSON_PrintUnformatted(item);
+    cJSON_Delete(item);
+    if (parsedJsonStr == nullptr) {
+        HIVIEW_LOGE("formatted json str is null");
+        return false;
+    }
+    ret = std::string(parsedJsonStr);
+    cJSON_free(parsedJsonStr);
+    return true;
+}
+
+bool AppendJsonItem(BufferedContentWriter& writer, const std::string& key, cJSON* item)
+{
+    std::string itemStr;
+    if (!PersistJsonStr(item, itemStr)) {
+        return false;
     }
+    writer.Append("\"" + key + "\":" + itemStr);
+    return true;
+}
+
+void CreateEventsJsonArray(BufferedContentWriter& writer, const std::string& domain,
+    const std::vector<std::pair<std::string, std::string>>& events)
+{
+    writer.Append("[{\"" + std::string(DATA_KEY) + "\":[");
+    bool isFirstEvent = true;
     for (const auto& event : events) {
+        // each event is parsed and printed alone, so only one event tree is alive at a time
         cJSON* eventItem = cJSON_Parse(event.second.c_str());
         if (FocusedEventUtil::IsFocusedEvent(domain, event.first)) {
             HIVIEW_LOGI("write event to json: [%{public}s|%{public}s]", domain.c_str(),
                 event.first.c_str());
         }
-        if (eventItem == nullptr) {
+        std::string eventStr;
+        if (eventItem == nullptr || !PersistJsonStr(eventItem, eventStr)) {
             HIVIEW_LOGW("failed to create json for event: [%{public}s|%{public}s]", domain.c_str(),
                 event.first.c_str());
             continue;
         }
-        cJSON_AddItemToArray(dataJsonArray, eventItem);
-    }
-    cJSON* anonymousJsonObj = cJSON_CreateObject();
-    if (anonymousJsonObj == nullptr) {
-        HIVIEW_LOGE("failed to create anonymousJsonObj json object");
-        cJSON_Delete(dataJsonArray);
-        cJSON_Delete(eventsJsonArray);
-        return nullptr;
+        if (!isFirstEvent) {
+            writer.Append(",");
+        }
+        writer.Append(eventStr);
+        isFirstEvent = false;
     }
-    cJSON_AddItemToObjectCS(anonymousJsonObj, DATA_KEY, dataJsonArray);
-    cJSON_AddItemToArray(eventsJsonArray, anonymousJsonObj);
-    return eventsJsonArray;
+    writer.Append("]}]");
+}
 }
 
-cJSON* CreateDomainsJson(const CachedEventMap& sysEvents)
+BufferedContentWriter::BufferedContentWriter(BuildContentWriter writer, size_t bufferSize)
+    : writer_(writer), bufferSize_(bufferSize)
 {
-    cJSON* domainsArrayJson = cJSON_CreateArray();
-    if (domainsArrayJson == nullptr) {
-        HIVIEW_LOGE("failed to create json array");
-        return nullptr;
+    buffer_.reserve(bufferSize_);
+}
+
+void BufferedContentWriter::Append(const std::string& content)
+{
+    if (!isSucc_) {
+        return;
     }
-    for (const auto& sysEvent : sysEvents) {
-        cJSON* domainJsonObj = cJSON_CreateObject();
-        if (domainJsonObj == nullptr) {
-            continue;
-        }
-        // domain info
-        cJSON* domainInfoJsonObj = cJSON_CreateObject();
-        if (domainInfoJsonObj == nullptr) {
-            HIVIEW_LOGE("failed to create domain info json object");
-            cJSON_Delete(domainJsonObj);
-            continue;
-        }
-        cJSON_AddStringToObject(domainInfoJsonObj, H_NAME_KEY, sysEvent.first.c_str());
-        cJSON_AddItemToObjectCS(domainJsonObj, DOMAIN_INFO_KEY, domainInfoJsonObj);
-        cJSON* eventsJsonObj = CreateEventsJsonArray(sysEvent.first, sysEvent.second);
-        if (eventsJsonObj == nullptr) {
-            HIVIEW_LOGE("failed to create json object for event array");
-            cJSON_Delete(domainJsonObj);
-            continue;
-        }
-        cJSON_AddItemToObjectCS(domainJsonObj, EVENTS_KEY, eventsJsonObj);
-        cJSON_AddItemToArray(domainsArrayJson, domainJsonObj);
+    if (buffer_.size() + content.size() > bufferSize_ && !Flush()) {
+        return;
     }
-    return domainsArrayJson;
+    // the content larger than the buffer is handed to the writer directly
+    if (content.size() > bufferSize_) {
+        isSucc_ = writer_(content.c_str(), content.size());
+        return;
+    }
+    buffer_.append(content);
 }
 
-bool PersistJsonStr(cJSON* root, std::string& ret)
+bool BufferedContentWriter::Flush()
 {
-    char* parsedJsonStr = cJSON_PrintUnformatted(root);
-    if (parsedJsonStr == nullptr) {
-        HIVIEW_LOGE("formatted json str is null");
-        return false;
+    if (isSucc_ && !buffer_.empty()) {
+        isSucc_ = writer_(buffer_.c_str(), buffer_.size());
     }
-    ret = std::string(parsedJsonStr);
-    cJSON_free(parsedJsonStr);
-    return true;
-}
+    buffer_.clear();
+    return isSucc_;
 }
 
 bool ExportJsonFileBuilder::Build(const CachedEventMap& eventMap, std::string& buildStr)
 {
-    cJSON* root = cJSON_CreateObject();
-    if (root == nullptr) {
-        HIVIEW_LOGE("failed to create event json root");
+    buildStr.clear();
+    return Build(eventMap, [&buildStr] (const char* data, size_t len) {
+        buildStr.append(data, len);
+        return true;
+    });
+}
+
+bool ExportJsonFileBuilder::Build(const CachedEventMap& eventMap, BuildContentWriter writer)
+{
+    if (writer == nullptr) {
+        HIVIEW_LOGE("content writer is null");
         return false;
     }
-
-    if (!BuildHeader(root)) {
+    BufferedContentWriter bufferedWriter(writer, BUILD_BUFFER_SIZE);
+    bufferedWriter.Append("{");
+    if (!BuildHeader(bufferedWriter)) {
         HIVIEW_LOGE("failed to build event json file header");
-        cJSON_Delete(root);
         return false;
     }
-    if (!BuildContent(root, eventMap)) {
-        HIVIEW_LOGE("failed to build event json file content");
-        cJSON_Delete(root);
+    bufferedWriter.Append(",");
+    BuildContent(bufferedWriter, eventMap);
+    bufferedWriter.Append("}");
+    if (!bufferedWriter.Flush()) {
+        HIVIEW_LOGE("failed to write event json file");
         return false;
     }
-    bool peristRet = PersistJsonStr(root, buildStr);
-    cJSON_Delete(root);
-    return peristRet;
+    return true;
 }
 
-bool ExportJsonFileBuilder::BuildHeader(cJSON* root)
+bool ExportJsonFileBuilder::BuildHeader(BufferedContentWriter& writer)
 {
     // add header
-    auto headerObj = CreateHeaderJsonObj();
-    if (headerObj == nullptr) {
+    if (!AppendJsonItem(writer, H_HEADER_KEY, CreateHeaderJsonObj())) {
         return false;
     }
-    cJSON_AddItemToObjectCS(root, H_HEADER_KEY, headerObj);
+    writer.Append(",");
     // add manufacturer
-    auto manufacturerObj = CreateManufacturerJsonObj();
-    if (manufacturerObj == nullptr) {
+    if (!AppendJsonItem(writer, H_MANUFACTURE_KEY, CreateManufacturerJsonObj())) {
         return false;
     }
-    cJSON_AddItemToObjectCS(root, H_MANUFACTURE_KEY, manufacturerObj);
+    writer.Append(",");
     // add device info
-    auto deviceObj = CreateDeviceJsonObj();
-    if (deviceObj == nullptr) {
+    if (!AppendJsonItem(writer, H_DEVICE_KEY, CreateDeviceJsonObj())) {
         return false;
     }
-    cJSON_AddItemToObjectCS(root, H_DEVICE_KEY, deviceObj);
+    writer.Append(",");
     // add system version info
-    auto systemObj = CreateSystemObj(eventVersion_);
-    if (systemObj == nullptr) {
-        return false;
-    }
-    cJSON_AddItemToObjectCS(root, H_SYSTEM_KEY, systemObj);
-    return true;
+    return AppendJsonItem(writer, H_SYSTEM_KEY, CreateSystemObj(eventVersion_));
 }
 
-bool ExportJsonFileBuilder::BuildContent(cJSON* root, const CachedEventMap& eventMap)
+void ExportJsonFileBuilder::BuildContent(BufferedContentWriter& writer, const CachedEventMap& eventMap)
 {
     // add domains
-    cJSON* domainsJson = CreateDomainsJson(eventMap);
-    if (domainsJson == nullptr) {
-        return false;
+    writer.Append("\"" + std::string(DOMAINS_KEY) + "\":[");
+    bool isFirstDomain = true;
+    for (const auto& sysEvent : eventMap) {
+        std::string domainInfoStr;
+        if (!PersistJsonStr(CreateDomainInfoJsonObj(sysEvent.first), domainInfoStr)) {
+            continue;
+        }
+        if (!isFirstDomain) {
+            writer.Append(",");
+        }
+        // domain info
+        writer.Append("{\"" + std::string(DOMAIN_INFO_KEY) + "\":" + domainInfoStr + ",");
+        writer.Append("\"" + std::string(EVENTS_KEY) + "\":");
+        CreateEventsJsonArray(writer, sysEvent.first, sysEvent.second);
+        writer.Append("}");
+        isFirstDomain = false;
     }
-    cJSON_AddItemToObjectCS(root, DOMAINS_KEY, domainsJson);
-    return true;
+    writer.Append("]");
 }
 } // HiviewDFX
-} // OHOS
\ No newline at end of file
+} // OHOS
@@ -118,6 +118,27 @@ bool ZipExportFile(const std::string& src, const std::string& dest)
     return true;
 }
 
+bool ZipExportContent(std::shared_ptr<ExportFileBaseBuilder> builder, const CachedEventMap& events,
+    const std::string& dest)
+{
+    {
+        HiviewZipUnit zipUnit(dest);
+        if (int32_t ret = zipUnit.OpenFileInZip(EXPORT_JSON_FILE_NAME); ret != 0) {
+            HIVIEW_LOGW("open json file in zip failed, ret: %{public}d.", ret);
+            return false;
+        }
+        // the json content is compressed into the zip file while being built
+        bool isBuilt = builder->Build(events, [&zipUnit] (const char* data, size_t len) {
+            return zipUnit.WriteInFileInZip(data, len) == 0;
+        });
+        if (zipUnit.CloseFileInZip() != 0 || !isBuilt) {
+            HIVIEW_LOGW("failed to write json file in zip.");
+            return false;
+        }
+    }
+    return ChangeFileModeAndGid(dest, EVENT_EXPORT_FILE_MODE, LOG_GID);
+}
+
 void WriteContentToFile(std::string& content, const std::string& localFile)
 {
     FILE* file = fopen(localFile.c_str(), "w+");
@@ -163,5 +184,28 @@ bool WriteZipFileStrategy::Write(std::string& exportContent, WroteCallback callb
     callback(tmpZipFile, zipFile);
     return true;
 }
+
+bool WriteZipFileStrategy::Write(std::shared_ptr<ExportFileBaseBuilder> builder, const CachedEventMap& events,
+    WroteCallback callback)
+{
+    if (builder == nullptr || callback == nullptr) {
+        HIVIEW_LOGE("file builder or wrote call back is invalid");
+        return false;
+    }
+    auto tmpZipFile = GetTmpZipFile(param_.exportDir, param_.moduleName, param_.version, param_.uid);
+    if (tmpZipFile.empty()) {
+        return false;
+    }
+    auto zipFileName = FileUtil::ExtractFileName(tmpZipFile);
+    if (!ZipExportContent(builder, events, tmpZipFile)) {
+        HIVIEW_LOGE("failed to zip %{public}s", StringUtil::HideDeviceIdInfo(zipFileName).c_str());
+        FileUtil::RemoveFile(tmpZipFile);
+        return false;
+    }
+    auto zipFile = GetZipFile(param_.exportDir, zipFileName);
+    HIVIEW_LOGD("dest file: %{public}s", StringUtil::HideDeviceIdInfo(zipFileName).c_str());
+    callback(tmpZipFile, zipFile);
+    return true;
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
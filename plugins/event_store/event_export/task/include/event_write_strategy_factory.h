@@ -20,6 +20,7 @@
 #include <functional>
 
 #include "cached_event.h"
+#include "export_file_base_builder.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -40,6 +41,9 @@ public:
 
     virtual std::string GetPackagerKey(std::shared_ptr<CachedEvent> cachedEvent);
     virtual bool Write(std::string& exportContent, WroteCallback callback);
+    // the content is written while being built by the builder
+    virtual bool Write(std::shared_ptr<ExportFileBaseBuilder> builder, const CachedEventMap& events,
+        WroteCallback callback);
 
 protected:
     WriteStrategyParam param_;
@@ -16,6 +16,7 @@
 #ifndef HIVIEW_BASE_EVENT_EXPORT_EXPORT_FILE_BASE_BUILDER_H
 #define HIVIEW_BASE_EVENT_EXPORT_EXPORT_FILE_BASE_BUILDER_H
 
+#include <functional>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -26,11 +27,15 @@ namespace OHOS {
 namespace HiviewDFX {
 // <domain, <name, list if eventJsonStr>>
 using CachedEventMap = std::unordered_map<std::string, std::vector<std::pair<std::string, std::string>>>;
+// writes a piece of the built content, return false if failed
+using BuildContentWriter = std::function<bool(const char* data, size_t len)>;
 class ExportFileBaseBuilder {
 public:
     ExportFileBaseBuilder() = default;
     virtual ~ExportFileBaseBuilder() = default;
     virtual bool Build(const CachedEventMap& eventMap, std::string& buildStr) = 0;
+    // the content is handed to the writer piece by piece instead of being built as a whole in memory
+    virtual bool Build(const CachedEventMap& eventMap, BuildContentWriter writer) = 0;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -21,6 +21,20 @@
 
 namespace OHOS {
 namespace HiviewDFX {
+// gathers the small pieces of the content and hands them to the writer in blocks of bounded size
+class BufferedContentWriter {
+public:
+    BufferedContentWriter(BuildContentWriter writer, size_t bufferSize);
+    void Append(const std::string& content);
+    bool Flush();
+
+private:
+    BuildContentWriter writer_;
+    size_t bufferSize_ = 0;
+    std::string buffer_;
+    bool isSucc_ = true;
+};
+
 class ExportJsonFileBuilder : public ExportFileBaseBuilder {
 public:
     ExportJsonFileBuilder(const EventVersion& eventVersion) : ExportFileBaseBuilder()
@@ -29,10 +43,11 @@ public:
     }
 
     bool Build(const CachedEventMap& eventMap, std::string& buildStr) override;
+    bool Build(const CachedEventMap& eventMap, BuildContentWriter writer) override;
 
 protected:
-    bool BuildHeader(cJSON* root);
-    bool BuildContent(cJSON* root, const CachedEventMap& eventMap);
+    bool BuildHeader(BufferedContentWriter& writer);
+    void BuildContent(BufferedContentWriter& writer, const CachedEventMap& eventMap);
 
 private:
     EventVersion eventVersion_;
@@ -26,6 +26,8 @@ class WriteZipFileStrategy : public EventWriteBaseStrategy {
 public:
     std::string GetPackagerKey(std::shared_ptr<CachedEvent> cachedEvent) override;
     bool Write(std::string& exportContent, WroteCallback callback) override;
+    bool Write(std::shared_ptr<ExportFileBaseBuilder> builder, const CachedEventMap& events,
+        WroteCallback callback) override;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
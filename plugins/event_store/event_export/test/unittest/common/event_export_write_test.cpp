@@ -15,19 +15,26 @@
 
 #include "event_export_write_test.h"
 
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
 #include <memory>
 
+#include "cJSON.h"
 #include "event_export_util.h"
 #include "event_write_strategy_factory.h"
 #include "export_event_packager.h"
 #include "export_file_writer.h"
 #include "export_json_file_builder.h"
 #include "file_util.h"
+#include "hiview_logger.h"
 #include "parameter.h"
 #include "parameter_ex.h"
 
 namespace OHOS {
 namespace HiviewDFX {
+DEFINE_LOG_TAG("EventExportWriteTest");
 namespace {
 const std::string MODULE_NAME = "TEST_MODULE";
 const std::string EXPORT_DIR = "/data/test/";
@@ -77,6 +84,19 @@ void AssertWroteFiles(const std::string& srcFile, const std::string& destFile)
     ASSERT_EQ(FileUtil::ExtractFileName(srcFile).size(), FileUtil::ExtractFileName(destFile).size());
 }
 
+// peak resident set size of the process in KB
+int64_t GetPeakRss()
+{
+    std::ifstream statusFile("/proc/self/status");
+    std::string line;
+    while (std::getline(statusFile, line)) {
+        if (line.find("VmHWM:") == 0) {
+            return std::stoll(line.substr(strlen("VmHWM:")));
+        }
+    }
+    return 0;
+}
+
 std::string GenerateDevId()
 {
     constexpr int32_t idLen = 65;
@@ -198,5 +218,90 @@ HWTEST_F(EventExportWriteTest, EventExportWriteTest005, testing::ext::TestSize.L
         ASSERT_EQ(deviceId, GenerateDevId());
     }
 }
+
+/**
+ * @tc.name: EventExportWriteTest006
+ * @tc.desc: Test the content built piece by piece is the same as the one built as a whole
+ * @tc.type: FUNC
+ * @tc.require: issueIC607P
+ */
+HWTEST_F(EventExportWriteTest, EventExportWriteTest006, testing::ext::TestSize.Level3)
+{
+    constexpr int eventNum = 1000; // 1000 : test event count, the content is larger than the build buffer
+    CachedEventMap events;
+    for (int i = 0; i < eventNum; ++i) {
+        events[TEST_DOMAIN].emplace_back(TEST_EVENT_NAME, BuildEventStr());
+    }
+    events[TEST_DOMAIN].emplace_back(TEST_EVENT_NAME, "{\"domain_\":\"TEST_DOMAIN\",");
+    ExportJsonFileBuilder builder(EVENT_VER);
+    std::string buildStr;
+    ASSERT_TRUE(builder.Build(events, buildStr));
+    std::string streamedStr;
+    size_t pieceCnt = 0;
+    ASSERT_TRUE(builder.Build(events, [&streamedStr, &pieceCnt] (const char* data, size_t len) {
+        streamedStr.append(data, len);
+        ++pieceCnt;
+        return true;
+    }));
+    ASSERT_GT(pieceCnt, 1); // 1 : the content is handed to the writer in more than one piece
+    ASSERT_EQ(streamedStr, buildStr);
+
+    // the invalid event is dropped and the others are printed unformatted by cJSON
+    cJSON* root = cJSON_Parse(buildStr.c_str());
+    ASSERT_NE(root, nullptr);
+    cJSON* domains = cJSON_GetObjectItem(root, "DOMAINS");
+    ASSERT_EQ(cJSON_GetArraySize(domains), 1); // 1 : expected domain count
+    cJSON* eventsJson = cJSON_GetObjectItem(cJSON_GetArrayItem(domains, 0), "EVENTS");
+    cJSON* dataJson = cJSON_GetObjectItem(cJSON_GetArrayItem(eventsJson, 0), "DATA");
+    ASSERT_EQ(cJSON_GetArraySize(dataJson), eventNum);
+    char* firstEventStr = cJSON_PrintUnformatted(cJSON_GetArrayItem(dataJson, 0));
+    cJSON_Delete(root);
+    ASSERT_NE(firstEventStr, nullptr);
+    std::string firstEvent(firstEventStr);
+    cJSON_free(firstEventStr);
+    ASSERT_NE(firstEvent, BuildEventStr());
+    ASSERT_NE(buildStr.find("[" + firstEvent + "," + firstEvent), std::string::npos);
+
+    ASSERT_FALSE(builder.Build(events, [] (const char* data, size_t len) {
+        return false;
+    }));
+}
+
+/**
+ * @tc.name: EventExportWriteTest007
+ * @tc.desc: Test the throughput and the peak memory of streaming the events into the export zip file
+ * @tc.type: PERF
+ * @tc.require: issueIC607P
+ */
+HWTEST_F(EventExportWriteTest, EventExportWriteTest007, testing::ext::TestSize.Level3)
+{
+    constexpr size_t eventNum = 20000; // 20000 : test event count
+    CachedEventMap events;
+    uint64_t totalSize = 0;
+    for (size_t i = 0; i < eventNum; ++i) {
+        auto eventStr = BuildEventStr();
+        totalSize += eventStr.size();
+        events[TEST_DOMAIN].emplace_back(TEST_EVENT_NAME, eventStr);
+    }
+    std::vector<std::string> wroteFiles;
+    ExportFileWriter fileWriter;
+    fileWriter.SetExportFileWroteListener([&wroteFiles] (const std::string& srcPath, const std::string& destPath) {
+        wroteFiles.emplace_back(srcPath);
+    });
+    auto strategyParam = BuildWriteStrategyParam();
+    int64_t beginRss = GetPeakRss();
+    auto begin = std::chrono::steady_clock::now();
+    ASSERT_TRUE(fileWriter.Write(std::make_shared<ExportJsonFileBuilder>(EVENT_VER), events, strategyParam));
+    auto costTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin).count();
+    double throughput = costTime > 0 ? static_cast<double>(totalSize) / costTime : 0.0; // byte/us equals MB/s
+    int64_t peakRss = GetPeakRss();
+    HIVIEW_LOGI("export size=%{public}" PRIu64 ", cost=%{public}" PRId64 "us, throughput=%{public}.2fMB/s, "
+        "peak rss=%{public}" PRId64 "KB, increased=%{public}" PRId64 "KB", totalSize, static_cast<int64_t>(costTime),
+        throughput, peakRss, peakRss - beginRss);
+    ASSERT_EQ(wroteFiles.size(), 1); // 1 is the expected zip file num
+    ASSERT_GT(FileUtil::GetFileSize(wroteFiles.front()), 0);
+    FileUtil::RemoveFile(wroteFiles.front());
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
@@ -31,6 +31,7 @@ public:
     void SaveToStore(std::shared_ptr<SysEvent> event) const;
     void StartCheckStoreTask(std::shared_ptr<EventLoop> looper);
     void CheckStore();
+    void FlushStore();
 }; // SysEventDbMgr
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -28,7 +28,6 @@ namespace OHOS {
 namespace HiviewDFX {
 using EventStore::SysEventDao;
 DEFINE_LOG_TAG("HiView-SysEventDbMgr");
-
 void SysEventDbMgr::SaveToStore(std::shared_ptr<SysEvent> event) const
 {
     SysEventDao::Insert(event);
@@ -45,6 +44,15 @@ void SysEventDbMgr::StartCheckStoreTask(std::shared_ptr<EventLoop> looper)
     auto statusTask = std::bind(&SysEventDbMgr::CheckStore, this);
     int delay = TimeUtil::SECONDS_PER_HOUR; // 1 hour
     looper->AddTimerEvent(nullptr, nullptr, statusTask, delay, true);
+
+    // the staged events are flushed periodically to bound the loss of them on crash
+    uint32_t flushInterval = SysEventDao::GetFlushInterval();
+    if (flushInterval == 0) {
+        HIVIEW_LOGI("no event is staged, no need to flush store");
+        return;
+    }
+    auto flushTask = std::bind(&SysEventDbMgr::FlushStore, this);
+    looper->AddTimerEvent(nullptr, nullptr, flushTask, flushInterval, true);
 }
 
 void SysEventDbMgr::CheckStore()
@@ -52,5 +60,10 @@ void SysEventDbMgr::CheckStore()
     HIVIEW_LOGI("start to check store");
     SysEventDao::Clear();
 }
+
+void SysEventDbMgr::FlushStore()
+{
+    SysEventDao::Flush();
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
@@ -86,6 +86,7 @@ void SysEventStore::OnUnload()
 {
     HIVIEW_LOGI("sys event service unload");
     EventExportEngine::GetInstance().Stop();
+    sysEventDbMgr_->FlushStore();
 }
 
 bool SysEventStore::IsNeedBackup(const std::string& dateStr)
@@ -134,14 +135,13 @@ bool SysEventStore::OnEvent(std::shared_ptr<Event>& event)
     std::shared_ptr<SysEvent> sysEvent = Convert2SysEvent(event);
     if (sysEvent != nullptr && sysEvent->preserve_) {
         // add seq to sys event and save it to local file
-        int64_t eventSeq = EventStore::SysEventSequenceManager::GetInstance().GetSequence();
+        int64_t eventSeq = EventStore::SysEventSequenceManager::GetInstance().AllocSequence();
         sysEvent->SetEventSeq(eventSeq);
         sysEvent->SetEventValue("period_seq_", sysEvent->GetValue("period_seq_"));
         if (FocusedEventUtil::IsFocusedEvent(sysEvent->domain_, sysEvent->eventName_)) {
             HIVIEW_LOGI("event[%{public}s|%{public}s|%{public}" PRId64 "] is valid.",
                 sysEvent->domain_.c_str(), sysEvent->eventName_.c_str(), eventSeq);
         }
-        EventStore::SysEventSequenceManager::GetInstance().SetSequence(++eventSeq);
         sysEventDbMgr_->SaveToStore(sysEvent);
 
         TriggerExportEngine::GetInstance().ProcessEvent(sysEvent);
@@ -371,6 +371,7 @@ void EventLogger::WriteInfoToLog(std::shared_ptr<SysEvent> event, int fd, int js
         HandleEventLoggerCmd(cmd, event, fd, logTask);
     }
 
+    logTask->SetConcurrentCompose(true);
     auto ret = logTask->StartCompose();
     if (ret != EventLogTask::TASK_SUCCESS) {
         HIVIEW_LOGE("capture fail %{public}d", ret);
@@ -1320,43 +1321,24 @@ void EventLogger::GetFailedDumpStackMsg(std::string& stack, std::shared_ptr<SysE
 bool EventLogger::JudgmentRateLimiting(std::shared_ptr<SysEvent> event)
 {
     int32_t interval = event->GetIntValue("eventLog_interval");
-    if (interval == 0) {
+    if (interval <= 0) {
         return true;
     }
 
     int64_t pid = event->GetEventIntValue("PID");
     pid = pid ? pid : event->GetPid();
     std::string eventName = event->eventName_;
-    std::string eventPid = std::to_string(pid);
-
-    intervalMutex_.lock();
-    std::time_t now = std::time(0);
-    for (auto it = eventTagTime_.begin(); it != eventTagTime_.end();) {
-        if (it->first.find(eventName) != it->first.npos) {
-            if ((now - it->second) >= interval) {
-                it = eventTagTime_.erase(it);
-                continue;
-            }
-        }
-        ++it;
-    }
-
-    std::string tagTimeName = eventName + eventPid;
-    auto it = eventTagTime_.find(tagTimeName);
-    if (it != eventTagTime_.end()) {
-        if ((now - it->second) < interval) {
-            HIVIEW_LOGE("event: id:0x%{public}d, eventName:%{public}s pid:%{public}s. \
-                interval:%{public}" PRId32 " There's not enough interval",
-                event->eventId_, eventName.c_str(), eventPid.c_str(), interval);
-            intervalMutex_.unlock();
-            return false;
-        }
+    RateLimitKey key = { rateLimiter_.GetEventId(eventName), pid };
+    uint64_t now = static_cast<uint64_t>(std::time(0));
+    if (!rateLimiter_.TryAcquire(key, now, static_cast<uint32_t>(interval))) {
+        HIVIEW_LOGE("event: id:0x%{public}d, eventName:%{public}s pid:%{public}" PRId64 ". \
+            interval:%{public}" PRId32 " There's not enough interval",
+            event->eventId_, eventName.c_str(), pid, interval);
+        return false;
     }
-    eventTagTime_[tagTimeName] = now;
-    HIVIEW_LOGD("event: id:0x%{public}d, eventName:%{public}s pid:%{public}s. \
+    HIVIEW_LOGD("event: id:0x%{public}d, eventName:%{public}s pid:%{public}" PRId64 ". \
         interval:%{public}" PRId32 " normal interval",
-        event->eventId_, eventName.c_str(), eventPid.c_str(), interval);
-    intervalMutex_.unlock();
+        event->eventId_, eventName.c_str(), pid, interval);
     return true;
 }
 
@@ -1522,6 +1504,10 @@ void EventLogger::OnLoad()
     HIVIEW_LOGI("EventLogger OnLoad.");
     SetName("EventLogger");
     SetVersion("1.0");
+    rateLimiter_.SetSuppressedReporter([](const std::string& eventName, int64_t pid, uint32_t count) {
+        HIVIEW_LOGI("eventName:%{public}s pid:%{public}" PRId64 " suppressed %{public}" PRIu32 " times",
+            eventName.c_str(), pid, count);
+    });
     FreezeManager::GetInstance()->InitLogStore();
     InitQueue();
     threadLoop_ = GetWorkLoop();
@@ -1534,7 +1520,7 @@ void EventLogger::OnLoad()
         return;
     }
 
-    std::set<std::string> freezeeventNames = freezeCommon.GetPrincipalStringIds();
+    std::set<std::string> freezeeventNames = freezeCommon.GetRelevantStringIds();
     std::unordered_set<std::string> eventNames;
     for (auto& i : freezeeventNames) {
         eventNames.insert(i);
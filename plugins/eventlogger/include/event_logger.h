@@ -33,6 +33,7 @@
 #include "db_helper.h"
 #include "event_logger_config.h"
 #include "freeze_common.h"
+#include "freeze_rate_limiter.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -61,12 +62,11 @@ private:
     std::shared_ptr<FreezeCommon> freezeCommon_ = nullptr;
     long lastPid_ = 0;
     uint64_t startTime_;
-    std::unordered_map<std::string, std::time_t> eventTagTime_;
+    FreezeRateLimiter rateLimiter_;
     std::unordered_map<int, std::string> fileMap_;
     std::unordered_map<std::string, EventLoggerConfig::EventLoggerConfigData> eventLoggerConfig_;
     std::shared_ptr<EventLoop> threadLoop_ = nullptr;
     int const maxEventPoolCount = 5;
-    ffrt::mutex intervalMutex_;
     std::string cmdlinePath_ = "/proc/cmdline";
     std::string cmdlineContent_ = "";
     std::string lastEventName_ = "";
@@ -14,9 +14,19 @@
  */
 #include "event_log_task.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <condition_variable>
+#include <iomanip>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "common_utils.h"
+#include "ffrt.h"
+#include "file_util.h"
 #include "hiview_logger.h"
 #include "parameter_ex.h"
 #include "securec.h"
@@ -69,6 +79,79 @@ namespace {
     constexpr int DELAY_OUT_OF_TIME = 15; // 15s
     constexpr int DEFAULT_LOG_SIZE = 3 * 1024 * 1024; // 3M
     constexpr uint64_t MILLISEC_TO_SEC = 1000;
+    constexpr int COMPOSE_DEADLINE = 20; // 20s
+    constexpr int TIME_MS_WIDTH = 3;
+    constexpr size_t COPY_BUF_SIZE = 4096;
+    // catchers which write the json fd or whose result is used by the following catchers keep running in order
+    const char* SERIAL_CATCHERS[] = { "PeerBinderCatcher", "LightHilogCatcher", "OpenStacktraceCatcher" };
+
+    struct CatcherResult {
+        int fd = -1;
+        int logSize = 0;
+        uint64_t beginTime = 0;
+        uint64_t endTime = 0;
+        bool isFinished = false;
+    };
+
+    struct ComposeContext {
+        ffrt::mutex mutex;
+        ffrt::condition_variable cond;
+        std::vector<CatcherResult> results;
+
+        ~ComposeContext()
+        {
+            for (auto& result : results) {
+                if (result.fd >= 0) {
+                    close(result.fd);
+                }
+            }
+        }
+    };
+
+    bool IsSerialCatcher(const std::string& name)
+    {
+        for (auto serialCatcher : SERIAL_CATCHERS) {
+            if (name == serialCatcher) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // same layout as FreezeCommon::WriteTimeInfoToFd, but with the time recorded by the concurrent catcher
+    void WriteCatcherTimeToFd(int fd, const std::string& msg, const CatcherResult& result, bool isStart)
+    {
+        if (isStart) {
+            FileUtil::SaveStringToFd(fd, "\n---------------------------------------------------\n");
+        }
+        uint64_t ms = isStart ? result.beginTime : result.endTime;
+        std::ostringstream timeStr;
+        timeStr << msg << TimeUtil::TimestampFormatToDate(ms / TimeUtil::SEC_TO_MILLISEC, "%Y/%m/%d-%H:%M:%S")
+            << ":" << std::setw(TIME_MS_WIDTH) << std::setfill('0') << (ms % TimeUtil::SEC_TO_MILLISEC);
+        if (!isStart) {
+            timeStr << ", cost: " << (result.endTime > result.beginTime ? result.endTime - result.beginTime : 0)
+                << "ms";
+        }
+        timeStr << std::endl;
+        FileUtil::SaveStringToFd(fd, timeStr.str());
+        if (!isStart) {
+            FileUtil::SaveStringToFd(fd, "---------------------------------------------------\n");
+        }
+    }
+
+    void CopyFdContent(int srcFd, int dstFd, size_t maxSize)
+    {
+        char buf[COPY_BUF_SIZE] = {0};
+        off_t offset = 0;
+        while (static_cast<size_t>(offset) < maxSize) {
+            size_t readSize = std::min(sizeof(buf), maxSize - static_cast<size_t>(offset));
+            ssize_t ret = pread(srcFd, buf, readSize, offset);
+            if (ret <= 0 || write(dstFd, buf, static_cast<size_t>(ret)) != ret) {
+                return;
+            }
+            offset += ret;
+        }
+    }
 }
 DEFINE_LOG_LABEL(0xD002D01, "EventLogger-EventLogTask");
 EventLogTask::EventLogTask(int fd, int jsonFd, std::shared_ptr<SysEvent> event)
@@ -200,6 +283,11 @@ void EventLogTask::SetFocusWindowId(const WindowIdInfo& windowIdInfo)
     windowIdInfo_ = windowIdInfo;
 }
 
+void EventLogTask::SetConcurrentCompose(bool isConcurrent)
+{
+    isConcurrentCompose_ = isConcurrent;
+}
+
 EventLogTask::Status EventLogTask::StartCompose()
 {
     // nothing to do, return success
@@ -219,14 +307,31 @@ EventLogTask::Status EventLogTask::StartCompose()
         dupedJsonFd = dup(targetJsonFd_);
         fdsan_exchange_owner_tag(dupedJsonFd, 0, FREEZE_DOMAIN);
     }
+    if (dupedFd < 0) {
+        status_ = Status::TASK_FAIL;
+        AddStopReason(targetFd_, tasks_.front(), "Fail to dup file descriptor, exit!");
+        return TASK_FAIL;
+    }
+    if (isConcurrentCompose_) {
+        ComposeConcurrently(dupedFd, dupedJsonFd);
+    } else {
+        ComposeSerially(dupedFd, dupedJsonFd);
+    }
+    fdsan_close_with_tag(dupedFd, FREEZE_DOMAIN);
+    if (dupedJsonFd >= 0) {
+        fdsan_close_with_tag(dupedJsonFd, FREEZE_DOMAIN);
+    }
+    if (status_ == Status::TASK_RUNNING) {
+        status_ = Status::TASK_SUCCESS;
+    }
+    return status_;
+}
+
+void EventLogTask::ComposeSerially(int dupedFd, int dupedJsonFd)
+{
     uint32_t catcherIndex = 0;
     for (auto& catcher : tasks_) {
         catcherIndex++;
-        if (dupedFd < 0) {
-            status_ = Status::TASK_FAIL;
-            AddStopReason(targetFd_, catcher, "Fail to dup file descriptor, exit!");
-            return TASK_FAIL;
-        }
         std::string description = catcher->GetDescription();
         description.erase(description.find_last_not_of(" \n\r\t") + 1);
         FreezeCommon::WriteTimeInfoToFd(dupedFd, description + " start time: ");
@@ -241,14 +346,123 @@ EventLogTask::Status EventLogTask::StartCompose()
             break;
         }
     }
-    fdsan_close_with_tag(dupedFd, FREEZE_DOMAIN);
-    if (dupedJsonFd >= 0) {
-        fdsan_close_with_tag(dupedJsonFd, FREEZE_DOMAIN);
+}
+
+void EventLogTask::ComposeConcurrently(int fd, int jsonFd)
+{
+    auto context = std::make_shared<ComposeContext>();
+    context->results.resize(tasks_.size());
+    for (size_t i = 0; i < tasks_.size(); i++) {
+        auto catcher = tasks_[i];
+        if (IsSerialCatcher(catcher->GetName())) {
+            continue;
+        }
+        int catcherFd = memfd_create(catcher->GetName().c_str(), MFD_CLOEXEC);
+        if (catcherFd < 0) {
+            HIVIEW_LOGW("failed to create memfd for %{public}s, errno: %{public}d, run it in order",
+                catcher->GetName().c_str(), errno);
+            continue;
+        }
+        context->results[i].fd = catcherFd;
+        ffrt::submit([context, catcher, i, catcherFd] {
+            {
+                std::unique_lock<ffrt::mutex> lock(context->mutex);
+                context->results[i].beginTime = TimeUtil::GetMilliseconds();
+            }
+            int logSize = catcher->Catch(catcherFd, -1);
+            std::unique_lock<ffrt::mutex> lock(context->mutex);
+            auto& result = context->results[i];
+            result.logSize = logSize;
+            result.endTime = TimeUtil::GetMilliseconds();
+            result.isFinished = true;
+            context->cond.notify_all();
+        }, {}, {}, ffrt::task_attr().name("log_catcher").qos(ffrt::qos_default));
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(COMPOSE_DEADLINE);
+    for (size_t i = 0; i < tasks_.size(); i++) {
+        auto catcher = tasks_[i];
+        std::string description = catcher->GetDescription();
+        description.erase(description.find_last_not_of(" \n\r\t") + 1);
+        int catcherFd = context->results[i].fd;
+        if (catcherFd < 0) {
+            // the catcher not run in parallel keeps the original way, writes the target fd directly
+            FreezeCommon::WriteTimeInfoToFd(fd, description + " start time: ");
+            AddSeparator(fd, catcher);
+            int curLogSize = catcher->Catch(fd, jsonFd);
+            if (catcher->name_ == "PeerBinderCatcher") {
+                terminalThreadStack_ = catcher->terminalBinder_.threadStack;
+            }
+            HIVIEW_LOGI("finish catcher: %{public}s, curLogSize: %{public}d", description.c_str(), curLogSize);
+            FreezeCommon::WriteTimeInfoToFd(fd, description + " end time: ", false);
+            if (ShouldStopLogTask(fd, static_cast<uint32_t>(i + 1), curLogSize, catcher)) {
+                break;
+            }
+            continue;
+        }
+
+        CatcherResult result;
+        {
+            std::unique_lock<ffrt::mutex> lock(context->mutex);
+            context->cond.wait_until(lock, deadline, [&context, i] { return context->results[i].isFinished; });
+            result = context->results[i];
+        }
+        if (!result.isFinished) {
+            catcher->Stop();
+            result.endTime = TimeUtil::GetMilliseconds();
+            // the catcher has not even been scheduled before the deadline
+            result.beginTime = (result.beginTime == 0) ? result.endTime : result.beginTime;
+        }
+        WriteCatcherTimeToFd(fd, description + " start time: ", result, true);
+        AddSeparator(fd, catcher);
+        bool isStopped = StitchCatcherLog(fd, catcherFd, result.logSize, static_cast<uint32_t>(i + 1), catcher);
+        HIVIEW_LOGI("finish catcher: %{public}s, curLogSize: %{public}d, cost: %{public}" PRIu64 "ms",
+            description.c_str(), result.logSize, result.endTime - result.beginTime);
+        if (!result.isFinished) {
+            WriteStopReason(fd, catcher, "Exceed compose deadline");
+            status_ = Status::TASK_TIMEOUT;
+        }
+        WriteCatcherTimeToFd(fd, description + " end time: ", result, false);
+        if (isStopped) {
+            break;
+        }
     }
-    if (status_ == Status::TASK_RUNNING) {
-        status_ = Status::TASK_SUCCESS;
+
+    // the catchers left behind after a break are not waited for, stop them and let the memfd go with the context
+    std::vector<std::shared_ptr<EventLogCatcher>> unfinishedCatchers;
+    {
+        std::unique_lock<ffrt::mutex> lock(context->mutex);
+        for (size_t i = 0; i < tasks_.size(); i++) {
+            if (context->results[i].fd >= 0 && !context->results[i].isFinished) {
+                unfinishedCatchers.push_back(tasks_[i]);
+            }
+        }
+    }
+    for (auto& catcher : unfinishedCatchers) {
+        catcher->Stop();
     }
-    return status_;
+}
+
+bool EventLogTask::StitchCatcherLog(int fd, int catcherFd, int curLogSize, uint32_t curTaskIndex,
+    std::shared_ptr<EventLogCatcher> catcher)
+{
+    struct stat st;
+    uint32_t contentSize = (fstat(catcherFd, &st) == 0 && st.st_size > 0) ? static_cast<uint32_t>(st.st_size) : 0;
+    uint32_t remainSize = (maxLogSize_ > taskLogSize_) ? (maxLogSize_ - taskLogSize_) : 0;
+    uint32_t copySize = std::min(contentSize, remainSize);
+    CopyFdContent(catcherFd, fd, copySize);
+    taskLogSize_ += copySize;
+
+    if (contentSize > remainSize && curTaskIndex != tasks_.size()) {
+        WriteStopReason(fd, catcher, "Exceed max log size");
+        status_ = Status::TASK_EXCEED_SIZE;
+        return true;
+    }
+    if (curLogSize < 0) {
+        WriteStopReason(fd, catcher, "Log catcher not successful");
+        HIVIEW_LOGE("catcher %{public}s, Log catcher not successful", catcher->GetDescription().c_str());
+    }
+    return false;
 }
 
 bool EventLogTask::ShouldStopLogTask(int fd, uint32_t curTaskIndex, int curLogSize,
@@ -280,12 +494,19 @@ bool EventLogTask::ShouldStopLogTask(int fd, uint32_t curTaskIndex, int curLogSi
 
 void EventLogTask::AddStopReason(int fd, std::shared_ptr<EventLogCatcher> catcher, const std::string& reason)
 {
-    char buf[BUF_SIZE_512] = {0};
-    int ret = -1;
     if (catcher != nullptr) {
         catcher->Stop();
         // sleep 1s for syncing log to the fd, then we could append failure reason ?
         sleep(1);
+    }
+    WriteStopReason(fd, catcher, reason);
+}
+
+void EventLogTask::WriteStopReason(int fd, std::shared_ptr<EventLogCatcher> catcher, const std::string& reason) const
+{
+    char buf[BUF_SIZE_512] = {0};
+    int ret = -1;
+    if (catcher != nullptr) {
         std::string summary = catcher->GetDescription();
         ret = snprintf_s(buf, BUF_SIZE_512, BUF_SIZE_512 - 1, "\nTask stopped when running catcher:%s, Reason:%s \n",
                          summary.c_str(), reason.c_str());
@@ -58,6 +58,7 @@ public:
     EventLogTask::Status GetTaskStatus() const;
     long GetLogSize() const;
     void SetFocusWindowId(const WindowIdInfo& focusWindowId);
+    void SetConcurrentCompose(bool isConcurrent);
 private:
     static constexpr uint32_t MAX_DUMP_TRACE_LIMIT = 15;
 
@@ -75,12 +76,18 @@ private:
     std::set<int> catchedPids_;
     WindowIdInfo windowIdInfo_;
     bool memoryCatched_ = false;
+    bool isConcurrentCompose_ = false;
     uint64_t faultTime_ = 0;
     ffrt::mutex faultTimeMutex_;
 
     void AddCapture();
     bool ShouldStopLogTask(int fd, uint32_t curTaskIndex, int curLogSize, std::shared_ptr<EventLogCatcher> catcher);
     void AddStopReason(int fd, std::shared_ptr<EventLogCatcher> catcher, const std::string& reason);
+    void WriteStopReason(int fd, std::shared_ptr<EventLogCatcher> catcher, const std::string& reason) const;
+    void ComposeSerially(int dupedFd, int dupedJsonFd);
+    void ComposeConcurrently(int fd, int jsonFd);
+    bool StitchCatcherLog(int fd, int catcherFd, int curLogSize, uint32_t curTaskIndex,
+        std::shared_ptr<EventLogCatcher> catcher);
     void AddSeparator(int fd, std::shared_ptr<EventLogCatcher> catcher) const;
     void RecordCatchedPids(const std::string& packageName);
     void GetThermalInfoCapture();
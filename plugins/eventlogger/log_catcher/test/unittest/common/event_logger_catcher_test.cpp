@@ -14,10 +14,12 @@
  */
 #include "event_logger_catcher_test.h"
 
+#include <chrono>
 #include <ctime>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <thread>
 
 #include <fcntl.h>
 #include <sys/prctl.h>
@@ -69,6 +71,43 @@ using namespace OHOS::HiviewDFX;
 
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+class ComposeTestCatcher : public EventLogCatcher {
+public:
+    ComposeTestCatcher(const std::string& name, const std::string& content, int delayMs)
+        : content_(content), delayMs_(delayMs)
+    {
+        name_ = name;
+        description_ = name + " description\n";
+    }
+
+    int Catch(int fd, int jsonFd) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delayMs_));
+        FileUtil::SaveStringToFd(fd, content_);
+        return static_cast<int>(content_.size());
+    }
+
+private:
+    std::string content_;
+    int delayMs_ = 0;
+};
+
+int64_t GetCatcherCost(const std::string& content, const std::string& name)
+{
+    size_t pos = content.find(name + " description end time: ");
+    if (pos == std::string::npos) {
+        return -1;
+    }
+    const std::string costKey = "cost: ";
+    pos = content.find(costKey, pos);
+    if (pos == std::string::npos) {
+        return -1;
+    }
+    return std::stoll(content.substr(pos + costKey.size()));
+}
+}
+
 void EventloggerCatcherTest::SetUp()
 {
     /**
@@ -349,6 +388,52 @@ HWTEST_F(EventloggerCatcherTest, EventlogTask_006, TestSize.Level3)
 }
 #endif
 
+/**
+ * @tc.name: EventlogTask
+ * @tc.desc: test StartCompose with the catchers running concurrently
+ * @tc.type: FUNC
+ */
+HWTEST_F(EventloggerCatcherTest, EventlogTask_007, TestSize.Level3)
+{
+    auto fd = open("/data/test/testFile", O_CREAT | O_WRONLY | O_TRUNC, DEFAULT_MODE);
+    if (fd < 0) {
+        printf("Fail to create testFile. errno: %d\n", errno);
+        FAIL();
+    }
+    SysEventCreator sysEventCreator("HIVIEWDFX", "EventlogTask", SysEventCreator::FAULT);
+    std::shared_ptr<SysEvent> sysEvent = std::make_shared<SysEvent>("EventlogTask", nullptr, sysEventCreator);
+    std::unique_ptr<EventLogTask> logTask = std::make_unique<EventLogTask>(fd, -1, sysEvent);
+    constexpr int catchDelayMs = 200; // 200 : test value
+    logTask->tasks_.push_back(std::make_shared<ComposeTestCatcher>("FirstCatcher", "first catcher log\n",
+        catchDelayMs));
+    logTask->tasks_.push_back(std::make_shared<ComposeTestCatcher>("SecondCatcher", "second catcher log\n",
+        catchDelayMs));
+    logTask->SetConcurrentCompose(true);
+    EXPECT_EQ(logTask->StartCompose(), EventLogTask::Status::TASK_SUCCESS);
+    close(fd);
+
+    // the logs are stitched in the task order, each between its own start and end time
+    std::string content;
+    FileUtil::LoadStringFromFile("/data/test/testFile", content);
+    size_t firstStart = content.find("FirstCatcher description start time: ");
+    size_t firstLog = content.find("\nFirstCatcher description\n\nfirst catcher log\n");
+    size_t firstEnd = content.find("FirstCatcher description end time: ");
+    size_t secondStart = content.find("SecondCatcher description start time: ");
+    size_t secondLog = content.find("\nSecondCatcher description\n\nsecond catcher log\n");
+    size_t secondEnd = content.find("SecondCatcher description end time: ");
+    ASSERT_NE(secondEnd, std::string::npos);
+    EXPECT_LT(firstStart, firstLog);
+    EXPECT_LT(firstLog, firstEnd);
+    EXPECT_LT(firstEnd, secondStart);
+    EXPECT_LT(secondStart, secondLog);
+    EXPECT_LT(secondLog, secondEnd);
+    EXPECT_EQ(content.find("Exceed"), std::string::npos);
+
+    // the cost is the time the catcher itself took
+    EXPECT_GE(GetCatcherCost(content, "FirstCatcher"), catchDelayMs);
+    EXPECT_GE(GetCatcherCost(content, "SecondCatcher"), catchDelayMs);
+}
+
 #ifdef SCB_CATCHER_ENABLE
 /**
  * @tc.name: EventlogTask
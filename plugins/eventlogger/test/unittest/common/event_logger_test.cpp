@@ -368,13 +368,16 @@ HWTEST_F(EventLoggerTest, EventLoggerTest_JudgmentRateLimiting_001, TestSize.Lev
     auto eventLogger = std::make_shared<EventLogger>();
     bool ret = eventLogger->JudgmentRateLimiting(sysEvent);
     EXPECT_EQ(ret, true);
-    sysEvent->SetEventValue("eventLog_interval", 1);
+    sysEvent->SetValue("eventLog_interval", 60); // 60: test interval
     sysEvent->SetEventValue("PID", getpid());
     sysEvent->SetEventValue("NAME", testName);
-    eventLogger->eventTagTime_["NAME"] = 100;
-    eventLogger->eventTagTime_[testName] = 100;
+    RateLimitKey key = { eventLogger->rateLimiter_.GetEventId(testName), getpid() };
+    eventLogger->rateLimiter_.TryAcquire(key, 100, 1); // 100: stale time of the last event
     ret = eventLogger->JudgmentRateLimiting(sysEvent);
     EXPECT_EQ(ret, true);
+    ret = eventLogger->JudgmentRateLimiting(sysEvent);
+    EXPECT_EQ(ret, false);
+    EXPECT_EQ(eventLogger->rateLimiter_.GetSuppressedCount(key), 1);
     sysEvent->SetValue("eventLog_interval", 0);
     ret = eventLogger->JudgmentRateLimiting(sysEvent);
     EXPECT_EQ(ret, true);
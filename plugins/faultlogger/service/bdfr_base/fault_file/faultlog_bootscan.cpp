@@ -14,11 +14,20 @@
  */
 #include "faultlog_bootscan.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_set>
+#include <vector>
+
 #include "constants.h"
 #include "faultlog_bundle_util.h"
 #include "faultlog_formatter.h"
 #include "faultlog_util.h"
 #include "faultlog_event_factory.h"
+#include "ffrt.h"
 #include "file_util.h"
 #include "hisysevent.h"
 #include "hiview_logger.h"
@@ -30,9 +39,82 @@ DEFINE_LOG_LABEL(0xD002D11, "Faultlogger");
 
 namespace {
 constexpr time_t FORTYEIGHT_HOURS = 48 * 60 * 60;
+constexpr uint64_t TEMP_MAX_FILE_SIZE = 1024 * 1024 * 5;
+constexpr size_t SCAN_WORKER_CNT = 4;
+// the parsed files waiting to be reported are bounded, so a big backlog does not hold all of the logs in memory
+constexpr size_t SCAN_WINDOW_SIZE = 16;
+constexpr const char* const BOOT_SCAN_CHECKPOINT = "/data/log/faultlog/bootscan_checkpoint";
+constexpr mode_t CHECKPOINT_FILE_MODE = 0640;
+
+// a rewritten temp file gets a new key and is scanned again
+std::string GetCheckpointKey(const std::string& file, const struct stat& fileInfo)
+{
+    return FileUtil::ExtractFileName(file) + " " + std::to_string(fileInfo.st_size) + " " +
+        std::to_string(fileInfo.st_mtime);
+}
+
+std::unordered_set<std::string> LoadCheckpoint()
+{
+    std::vector<std::string> lines;
+    if (!FileUtil::LoadLinesFromFile(BOOT_SCAN_CHECKPOINT, lines)) {
+        return {};
+    }
+    return std::unordered_set<std::string>(lines.begin(), lines.end());
+}
+
+bool WriteCheckpointLine(int fd, const std::string& key)
+{
+    std::string line = key + "\n";
+    if (write(fd, line.c_str(), line.size()) != static_cast<ssize_t>(line.size())) {
+        return false;
+    }
+    return fdatasync(fd) == 0;
+}
+
+// drop the keys of the files which are gone, and reopen the checkpoint for appending
+int ResetCheckpoint(const std::vector<std::string>& keys)
+{
+    std::string tmpPath = std::string(BOOT_SCAN_CHECKPOINT) + ".tmp";
+    int fd = open(tmpPath.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, CHECKPOINT_FILE_MODE);
+    if (fd < 0) {
+        HIVIEW_LOGW("failed to create boot scan checkpoint, errno=%{public}d", errno);
+        return -1;
+    }
+    std::string content;
+    for (const auto& key : keys) {
+        content += key + "\n";
+    }
+    bool isSaved = content.empty() ||
+        write(fd, content.c_str(), content.size()) == static_cast<ssize_t>(content.size());
+    isSaved = isSaved && fsync(fd) == 0;
+    close(fd);
+    if (!isSaved || rename(tmpPath.c_str(), BOOT_SCAN_CHECKPOINT) != 0) {
+        HIVIEW_LOGW("failed to save boot scan checkpoint, errno=%{public}d", errno);
+        FileUtil::RemoveFile(tmpPath);
+        return -1;
+    }
+    return open(BOOT_SCAN_CHECKPOINT, O_WRONLY | O_APPEND | O_CLOEXEC);
+}
+
+struct ScanItem {
+    std::string file;
+    std::string key;
+    FaultLogInfo info;
+    bool isParsed = false;
+    bool needReport = false;
+};
 }
 using namespace FaultLogger;
 
+struct FaultLogBootScan::ScanContext {
+    ffrt::mutex mutex;
+    ffrt::condition_variable cond;
+    std::vector<ScanItem> items;
+    size_t nextIndex = 0;
+    // the items before it have been taken by the reporter
+    size_t reportIndex = 0;
+};
+
 bool FaultLogBootScan::IsCrashType(const std::string& file)
 {
     // if file type is not cppcrash, skip!
@@ -45,7 +127,11 @@ bool FaultLogBootScan::IsCrashType(const std::string& file)
 
 bool FaultLogBootScan::IsInValidTime(const std::string& file, const time_t& now)
 {
-    time_t lastAccessTime = GetFileLastAccessTimeStamp(file);
+    return IsInValidTime(file, GetFileLastAccessTimeStamp(file), now);
+}
+
+bool FaultLogBootScan::IsInValidTime(const std::string& file, time_t lastAccessTime, const time_t& now)
+{
     if (now < lastAccessTime) {
         HIVIEW_LOGI("Skip this file(%{public}s) that current time may be incorrect.", file.c_str());
         return false;
@@ -59,9 +145,12 @@ bool FaultLogBootScan::IsInValidTime(const std::string& file, const time_t& now)
 
 bool FaultLogBootScan::IsCrashTempBigFile(const std::string& file)
 {
-    constexpr uint64_t tempMaxFileSize = 1024 * 1024 * 5;
-    auto fileSize = FileUtil::GetFileSize(file);
-    if (fileSize > tempMaxFileSize) {
+    return IsCrashTempBigFile(file, FileUtil::GetFileSize(file));
+}
+
+bool FaultLogBootScan::IsCrashTempBigFile(const std::string& file, uint64_t fileSize)
+{
+    if (fileSize > TEMP_MAX_FILE_SIZE) {
         HIVIEW_LOGI("Skip this file(%{public}s) that file size(%{public}" PRIu64 ") exceeds limit.",
                     file.c_str(), fileSize);
         FileUtil::RemoveFile(file);
@@ -109,26 +198,98 @@ bool FaultLogBootScan::IsReported(FaultLogInfo& info)
     return false;
 }
 
+bool FaultLogBootScan::ParseCrashFile(const std::string& file, FaultLogInfo& info)
+{
+    info = ParseCppCrashFromFile(file);
+    return !IsEmptyStack(file, info) && !IsReported(info);
+}
+
+void FaultLogBootScan::RunScanWorker(std::shared_ptr<ScanContext> context)
+{
+    while (true) {
+        std::unique_lock<ffrt::mutex> lock(context->mutex);
+        context->cond.wait(lock, [&context] {
+            return context->nextIndex < context->reportIndex + SCAN_WINDOW_SIZE ||
+                context->nextIndex >= context->items.size();
+        });
+        if (context->nextIndex >= context->items.size()) {
+            return;
+        }
+        ScanItem& item = context->items[context->nextIndex++];
+        lock.unlock();
+
+        // the items are only touched by their worker until they are marked as parsed
+        bool needReport = ParseCrashFile(item.file, item.info);
+
+        lock.lock();
+        item.needReport = needReport;
+        item.isParsed = true;
+        context->cond.notify_all();
+    }
+}
+
+void FaultLogBootScan::ReportCrashFile(FaultLogInfo& info)
+{
+    auto processor = FaultLogEventFactory::CreateFaultLogEvent(static_cast<FaultLogType>(info.faultLogType));
+    if (processor) {
+        info.sectionMap["START_BOOT_SCAN"] = "true";
+        processor->AddFaultLog(info);
+    }
+}
+
 void FaultLogBootScan::StartBootScan()
 {
     std::vector<std::string> files;
     time_t now = time(nullptr);
     FileUtil::GetDirFiles(FAULTLOG_TEMP_FOLDER, files);
+    auto checkpoint = LoadCheckpoint();
+    std::vector<std::string> scannedKeys;
+    auto context = std::make_shared<ScanContext>();
     for (const auto& file : files) {
-        if (!IsCrashType(file) || !IsInValidTime(file, now) || IsCrashTempBigFile(file)) {
+        // classify by the name and a single stat, only the files left are read and parsed
+        struct stat fileInfo {};
+        if (!IsCrashType(file) || stat(file.c_str(), &fileInfo) != 0 ||
+            !IsInValidTime(file, fileInfo.st_atime, now) ||
+            IsCrashTempBigFile(file, static_cast<uint64_t>(fileInfo.st_size))) {
             continue;
         }
-
-        auto info = ParseCppCrashFromFile(file);
-        if (IsEmptyStack(file, info) || IsReported(info)) {
+        std::string key = GetCheckpointKey(file, fileInfo);
+        if (checkpoint.find(key) != checkpoint.end()) {
+            scannedKeys.push_back(key);
             continue;
         }
-        auto processor = FaultLogEventFactory::CreateFaultLogEvent(static_cast<FaultLogType>(info.faultLogType));
-        if (processor) {
-            info.sectionMap["START_BOOT_SCAN"] = "true";
-            processor->AddFaultLog(info);
+        ScanItem& item = context->items.emplace_back();
+        item.file = file;
+        item.key = key;
+    }
+    HIVIEW_LOGI("boot scan %{public}zu files, %{public}zu files skipped by checkpoint",
+        context->items.size(), scannedKeys.size());
+    int checkpointFd = ResetCheckpoint(scannedKeys);
+    size_t workerCnt = std::min(SCAN_WORKER_CNT, context->items.size());
+    for (size_t i = 0; i < workerCnt; i++) {
+        ffrt::submit([context] { RunScanWorker(context); }, ffrt::task_attr().name("faultlog_bootscan"));
+    }
+
+    // report in the order of the files, a file is checkpointed only after it has been handled
+    for (size_t i = 0; i < context->items.size(); i++) {
+        std::unique_lock<ffrt::mutex> lock(context->mutex);
+        ScanItem& item = context->items[i];
+        context->cond.wait(lock, [&item] { return item.isParsed; });
+        FaultLogInfo info = std::move(item.info);
+        context->reportIndex = i + 1;
+        context->cond.notify_all();
+        lock.unlock();
+
+        if (item.needReport) {
+            ReportCrashFile(info);
+        }
+        if (checkpointFd >= 0 && !WriteCheckpointLine(checkpointFd, item.key)) {
+            HIVIEW_LOGW("failed to append boot scan checkpoint, errno=%{public}d", errno);
         }
     }
+    if (checkpointFd >= 0) {
+        close(checkpointFd);
+    }
 }
 } // namespace HiviewDFX
 } // namespace OHOS
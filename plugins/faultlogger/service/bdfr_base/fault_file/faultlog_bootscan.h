@@ -15,6 +15,10 @@
 #ifndef FAULTLOG_BOOTSCAN_H
 #define FAULTLOG_BOOTSCAN_H
 
+#include <ctime>
+#include <memory>
+#include <string>
+
 #include "event.h"
 #include "faultlog_info_inner.h"
 #include "faultlog_manager.h"
@@ -25,11 +29,18 @@ class FaultLogBootScan {
 public:
     static void StartBootScan();
 private:
+    struct ScanContext;
+
     static bool IsCrashTempBigFile(const std::string& file);
+    static bool IsCrashTempBigFile(const std::string& file, uint64_t fileSize);
     static bool IsCrashType(const std::string& file);
     static bool IsInValidTime(const std::string& file, const time_t& now);
+    static bool IsInValidTime(const std::string& file, time_t lastAccessTime, const time_t& now);
     static bool IsEmptyStack(const std::string& file, const FaultLogInfo& info);
     static bool IsReported(FaultLogInfo& info);
+    static bool ParseCrashFile(const std::string& file, FaultLogInfo& info);
+    static void RunScanWorker(std::shared_ptr<ScanContext> context);
+    static void ReportCrashFile(FaultLogInfo& info);
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -18,6 +18,7 @@
 #include <cstdlib>
 #include <fcntl.h>
 #include <fstream>
+#include <queue>
 #include <string>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -113,6 +114,8 @@ constexpr uintptr_t OFFSET_HAP = 0x1000; // default hap offset
 constexpr uintptr_t OFFSET_HEAD = 0x4; // head offset
 constexpr mode_t DEFAULT_LOG_FILE_MODE = 0664; // parse arkts info temp file mode
 
+constexpr size_t WRITE_BUFFER_SIZE = 64 * 1024;
+
 const std::string APP_SANDBOX_PREFIX = "/data/storage/el1/bundle/";
 const std::string STACK_FRAME_PREFIX = " ";
 
@@ -373,9 +376,9 @@ void FillSectionMapFromJson(const Json::Value& root, std::map<std::string, std::
     }
 }
 
-std::vector<SectionLog> GetLogParseSections(int32_t logType)
+const std::unordered_map<int32_t, std::function<decltype(GetCppCrashSectionLogs)>>& GetLogParseSectionsTable()
 {
-    std::unordered_map<int32_t, std::function<decltype(GetCppCrashSectionLogs)>> table = {
+    static const std::unordered_map<int32_t, std::function<decltype(GetCppCrashSectionLogs)>> table = {
         {FaultLogType::CPP_CRASH, GetCppCrashSectionLogs},
         {FaultLogType::JS_CRASH, GetJsCrashSectionLogs},
         {FaultLogType::CJ_ERROR, GetCjCrashSectionLogs},
@@ -386,43 +389,279 @@ std::vector<SectionLog> GetLogParseSections(int32_t logType)
         {FaultLogType::RUST_PANIC, GetRustPanicSectionLogs},
         {FaultLogType::ADDR_SANITIZER, GetAddrSanitizerSectionLogs},
     };
+    return table;
+}
+
+std::vector<SectionLog> GetLogParseSections(int32_t logType)
+{
+    const auto& table = GetLogParseSectionsTable();
     if (auto iter = table.find(logType); iter != table.end()) {
         return iter->second();
     }
     return {};
 }
 
-bool ParseFaultLogLine(const std::vector<SectionLog>& parseList, const std::string& line,
+namespace {
+/*
+ * Aho-Corasick automaton over the section heads of a parse list. One scan of a line finds the first section
+ * of the list whose head is contained in the line, instead of searching the line once for every section.
+ */
+class SectionMatcher {
+public:
+    explicit SectionMatcher(const std::vector<SectionLog>& parseList);
+
+    // returns the index of the matched section in the parse list, or -1 if none matches
+    int32_t Match(const std::string& line) const;
+    const SectionLog& GetSection(int32_t index) const
+    {
+        return parseList_[index];
+    }
+    const std::string& GetSectionHead(int32_t index) const
+    {
+        return heads_[index];
+    }
+
+private:
+    struct Node {
+        std::vector<std::pair<char, int32_t>> children;
+        int32_t fail = 0;
+        // the minimal index of the sections which end at this node or at any node on its fail chain
+        int32_t matched = -1;
+    };
+
+    int32_t FindChild(int32_t node, char ch) const;
+    void AddPattern(const std::string& pattern, int32_t index);
+    void BuildFailLinks();
+
+    std::vector<SectionLog> parseList_;
+    std::vector<std::string> heads_;
+    std::vector<Node> nodes_;
+};
+
+SectionMatcher::SectionMatcher(const std::vector<SectionLog>& parseList) : parseList_(parseList), nodes_(1)
+{
+    for (size_t i = 0; i < parseList_.size(); i++) {
+        std::string sectionHead = parseList_[i].logName;
+        if (sectionHead.size() > 1) {
+            sectionHead = sectionHead.back() == '\n' ? sectionHead.substr(0, sectionHead.size() - 1) : sectionHead;
+            AddPattern(sectionHead, static_cast<int32_t>(i));
+        }
+        heads_.emplace_back(std::move(sectionHead));
+    }
+    BuildFailLinks();
+}
+
+int32_t SectionMatcher::FindChild(int32_t node, char ch) const
+{
+    for (const auto& child : nodes_[node].children) {
+        if (child.first == ch) {
+            return child.second;
+        }
+    }
+    return -1;
+}
+
+void SectionMatcher::AddPattern(const std::string& pattern, int32_t index)
+{
+    int32_t node = 0;
+    for (char ch : pattern) {
+        int32_t next = FindChild(node, ch);
+        if (next < 0) {
+            next = static_cast<int32_t>(nodes_.size());
+            nodes_[node].children.emplace_back(ch, next);
+            nodes_.emplace_back();
+        }
+        node = next;
+    }
+    if (nodes_[node].matched < 0) {
+        nodes_[node].matched = index;
+    }
+}
+
+void SectionMatcher::BuildFailLinks()
+{
+    std::queue<int32_t> nodeQueue;
+    for (const auto& child : nodes_[0].children) {
+        nodeQueue.push(child.second);
+    }
+    while (!nodeQueue.empty()) {
+        int32_t node = nodeQueue.front();
+        nodeQueue.pop();
+        for (const auto& [ch, next] : nodes_[node].children) {
+            int32_t fail = nodes_[node].fail;
+            while (fail != 0 && FindChild(fail, ch) < 0) {
+                fail = nodes_[fail].fail;
+            }
+            int32_t failNext = FindChild(fail, ch);
+            nodes_[next].fail = failNext >= 0 ? failNext : 0;
+            int32_t failMatched = nodes_[nodes_[next].fail].matched;
+            if (failMatched >= 0 && (nodes_[next].matched < 0 || failMatched < nodes_[next].matched)) {
+                nodes_[next].matched = failMatched;
+            }
+            nodeQueue.push(next);
+        }
+    }
+}
+
+int32_t SectionMatcher::Match(const std::string& line) const
+{
+    int32_t result = -1;
+    int32_t node = 0;
+    for (char ch : line) {
+        int32_t next = FindChild(node, ch);
+        while (next < 0 && node != 0) {
+            node = nodes_[node].fail;
+            next = FindChild(node, ch);
+        }
+        node = next >= 0 ? next : 0;
+        int32_t matched = nodes_[node].matched;
+        if (matched >= 0 && (result < 0 || matched < result)) {
+            result = matched;
+        }
+    }
+    return result;
+}
+
+// the automatons are built once for every log type and shared by the concurrent parsers
+const SectionMatcher& GetSectionMatcher(int32_t logType)
+{
+    static const auto matchers = [] {
+        std::unordered_map<int32_t, SectionMatcher> result;
+        for (const auto& [type, getSections] : GetLogParseSectionsTable()) {
+            result.emplace(type, SectionMatcher(getSections()));
+        }
+        return result;
+    }();
+    static const SectionMatcher emptyMatcher {std::vector<SectionLog>()};
+    auto iter = matchers.find(logType);
+    return iter != matchers.end() ? iter->second : emptyMatcher;
+}
+
+bool ParseFaultLogLine(const SectionMatcher& matcher, const std::string& line,
     const std::string& multline, std::string& multlineName, FaultLogInfo& info)
 {
-    for (const auto &item : parseList) {
-        if (strlen(item.logName) <= 1) {
-            continue;
+    int32_t index = matcher.Match(line);
+    if (index < 0) {
+        return true;
+    }
+    const SectionLog& item = matcher.GetSection(index);
+    // when scan new label, store old multi line info.
+    if ((item.sectionName != multlineName) && (!multline.empty())) {
+        info.sectionMap[multlineName] = multline;
+    }
+    if (line == matcher.GetSectionHead(index)) {
+        multlineName = item.sectionName;
+    } else {
+        info.sectionMap[item.sectionName] = line.substr(line.find_first_of(":") + 1);
+    }
+    return false;
+}
+
+// collects the small pieces of a fault log and writes them to the fd in large chunks
+class FdWriteBuffer {
+public:
+    explicit FdWriteBuffer(int32_t fd) : fd_(fd) {}
+    ~FdWriteBuffer()
+    {
+        Flush();
+    }
+    FdWriteBuffer(const FdWriteBuffer&) = delete;
+    FdWriteBuffer& operator=(const FdWriteBuffer&) = delete;
+
+    void Append(const char* data, size_t len);
+    void Append(const std::string& content)
+    {
+        Append(content.data(), content.size());
+    }
+    void Flush();
+
+private:
+    void WriteToFd(const char* data, size_t len);
+
+    int32_t fd_;
+    std::string buffer_;
+};
+
+void FdWriteBuffer::Append(const char* data, size_t len)
+{
+    if (buffer_.size() + len > WRITE_BUFFER_SIZE) {
+        Flush();
+    }
+    if (len >= WRITE_BUFFER_SIZE) {
+        WriteToFd(data, len);
+        return;
+    }
+    if (buffer_.capacity() < WRITE_BUFFER_SIZE) {
+        buffer_.reserve(WRITE_BUFFER_SIZE);
+    }
+    buffer_.append(data, len);
+}
+
+void FdWriteBuffer::Flush()
+{
+    if (!buffer_.empty()) {
+        WriteToFd(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+}
+
+void FdWriteBuffer::WriteToFd(const char* data, size_t len)
+{
+    while (len > 0) {
+        ssize_t ret = TEMP_FAILURE_RETRY(write(fd_, data, len));
+        if (ret <= 0) {
+            return;
         }
-        std::string sectionHead = item.logName;
-        sectionHead = sectionHead.back() == '\n' ? sectionHead.substr(0, sectionHead.size() - 1) : sectionHead;
-        if (line.find(sectionHead) == std::string::npos) {
-            continue;
+        data += ret;
+        len -= static_cast<size_t>(ret);
+    }
+}
+
+void JumpBuildInfoToBuffer(FdWriteBuffer& buffer, std::ifstream& logFile)
+{
+    std::string line;
+    if (std::getline(logFile, line)) {
+        if (line.find("Build info:") != std::string::npos) {
+            return;
         }
-        // when scan new label, store old multi line info.
-        if ((item.sectionName != multlineName) && (!multline.empty())) {
-            info.sectionMap[multlineName] = multline;
+    }
+    buffer.Append(line);
+    buffer.Append("\n", 1);
+}
+
+bool WriteLogToBuffer(FdWriteBuffer& buffer, const std::string& path,
+    const std::map<std::string, std::string>& sections)
+{
+    std::string line;
+    std::ifstream logFile(path);
+    JumpBuildInfoToBuffer(buffer, logFile);
+
+    auto memInfoIter = sections.find("DEVICE_MEMINFO");
+    bool hasFindRssInfo = false;
+    while (std::getline(logFile, line)) {
+        if (logFile.eof()) {
+            break;
         }
-        if (line == sectionHead) {
-            multlineName = item.sectionName;
-        } else {
-            info.sectionMap[item.sectionName] = line.substr(line.find_first_of(":") + 1);
+        if (!logFile.good()) {
+            return false;
+        }
+        buffer.Append(line);
+        buffer.Append("\n", 1);
+        if (!hasFindRssInfo && memInfoIter != sections.end() &&
+            line.find("Process Memory(kB):") != std::string::npos) {
+            buffer.Append(memInfoIter->second);
+            buffer.Append("\n", 1);
+            hasFindRssInfo = true;
         }
-        return false;
     }
     return true;
 }
 
-bool WriteStackTraceFromLog(int32_t fd, const std::string& pidStr, const std::string& path)
+bool WriteStackTraceToBuffer(FdWriteBuffer& buffer, const std::string& pidStr, const std::string& path)
 {
     std::string realPath;
     if (!FileUtil::PathToRealPath(path, realPath)) {
-        FileUtil::SaveStringToFd(fd, "Log file not exist.\n");
+        buffer.Append("Log file not exist.\n");
         return false;
     }
 
@@ -445,16 +684,25 @@ bool WriteStackTraceFromLog(int32_t fd, const std::string& pidStr, const std::st
 
         if ((line.find("----- end") != std::string::npos) &&
             (line.find(pidStr) != std::string::npos)) {
-            FileUtil::SaveStringToFd(fd, line + "\n");
+            buffer.Append(line);
+            buffer.Append("\n", 1);
             break;
         }
 
         if (startWrite) {
-            FileUtil::SaveStringToFd(fd, line + "\n");
+            buffer.Append(line);
+            buffer.Append("\n", 1);
         }
     }
     return true;
 }
+} // namespace
+
+bool WriteStackTraceFromLog(int32_t fd, const std::string& pidStr, const std::string& path)
+{
+    FdWriteBuffer buffer(fd);
+    return WriteStackTraceToBuffer(buffer, pidStr, path);
+}
 
 void WriteDfxLogToFile(int32_t fd)
 {
@@ -466,33 +714,35 @@ void WriteDfxLogToFile(int32_t fd)
 
 void WriteFaultLogToFile(int32_t fd, int32_t logType, const std::map<std::string, std::string>& sections)
 {
+    FdWriteBuffer buffer(fd);
     auto seq = GetLogParseSections(logType);
     for (const auto &item : seq) {
         auto iter = sections.find(item.sectionName);
         if (iter == sections.end() || iter->second.empty()) {
             continue;
         }
-        auto value = iter->second;
+        const std::string& value = iter->second;
         std::string keyStr = item.sectionName;
-        if (keyStr.find(APPEND_ORIGIN_LOG.sectionName) != std::string::npos && WriteLogToFile(fd, value, sections)) {
+        if (keyStr.find(APPEND_ORIGIN_LOG.sectionName) != std::string::npos && fd >= 0 &&
+            WriteLogToBuffer(buffer, value, sections)) {
             break;
         }
 
         // Does not require adding an identifier header for Summary section
         if (keyStr.find(SUMMARY.sectionName) == std::string::npos) {
-            FileUtil::SaveStringToFd(fd, item.logName);
+            buffer.Append(item.logName, strlen(item.logName));
         }
 
+        buffer.Append(value);
         if (value.back() != '\n') {
-            value.append("\n");
+            buffer.Append("\n", 1);
         }
-        FileUtil::SaveStringToFd(fd, value);
     }
 
     if (auto logIter = sections.find("KEYLOGFILE"); logIter != sections.end() && !logIter->second.empty()) {
         if (auto pidIter = sections.find(FaultKey::MODULE_PID); pidIter != sections.end()) {
-            FileUtil::SaveStringToFd(fd, "Additional Logs:\n");
-            WriteStackTraceFromLog(fd, pidIter->second, logIter->second);
+            buffer.Append("Additional Logs:\n");
+            WriteStackTraceToBuffer(buffer, pidIter->second, logIter->second);
         }
     }
 }
@@ -566,7 +816,7 @@ FaultLogInfo ParseCppCrashFromFile(const std::string& path)
 
 void ParseCppCrashFromTextFile(const std::string& path, FaultLogInfo& info)
 {
-    auto parseList = GetLogParseSections(info.faultLogType);
+    const SectionMatcher& matcher = GetSectionMatcher(info.faultLogType);
     std::ifstream logFile(path);
     std::string line;
     std::string multline;
@@ -580,7 +830,7 @@ void ParseCppCrashFromTextFile(const std::string& path, FaultLogInfo& info)
             continue;
         }
 
-        if (ParseFaultLogLine(parseList, line, multline, multlineName, info)) {
+        if (ParseFaultLogLine(matcher, line, multline, multlineName, info)) {
             multline.append(line).append("\n");
         } else {
             multline.clear();
@@ -614,13 +864,8 @@ bool ParseJsonFromFile(const std::string& path, Json::Value& root)
 
 void JumpBuildInfo(int32_t fd, std::ifstream& logFile)
 {
-    std::string line;
-    if (std::getline(logFile, line)) {
-        if (line.find("Build info:") != std::string::npos) {
-            return;
-        }
-    }
-    FileUtil::SaveStringToFd(fd, line + "\n");
+    FdWriteBuffer buffer(fd);
+    JumpBuildInfoToBuffer(buffer, logFile);
 }
 
 bool WriteLogToFile(int32_t fd, const std::string& path, const std::map<std::string, std::string>& sections)
@@ -628,29 +873,8 @@ bool WriteLogToFile(int32_t fd, const std::string& path, const std::map<std::str
     if ((fd < 0) || path.empty()) {
         return false;
     }
-
-    std::string line;
-    std::ifstream logFile(path);
-    JumpBuildInfo(fd, logFile);
-
-    bool hasFindRssInfo = false;
-    while (std::getline(logFile, line)) {
-        if (logFile.eof()) {
-            break;
-        }
-        if (!logFile.good()) {
-            return false;
-        }
-        FileUtil::SaveStringToFd(fd, line);
-        FileUtil::SaveStringToFd(fd, "\n");
-        if (!hasFindRssInfo && line.find("Process Memory(kB):") != std::string::npos &&
-            sections.find("DEVICE_MEMINFO") != sections.end()) {
-            FileUtil::SaveStringToFd(fd, sections.at("DEVICE_MEMINFO"));
-            FileUtil::SaveStringToFd(fd, "\n");
-            hasFindRssInfo = true;
-        }
-    }
-    return true;
+    FdWriteBuffer buffer(fd);
+    return WriteLogToBuffer(buffer, path, sections);
 }
 
 bool IsFaultLogLimit()
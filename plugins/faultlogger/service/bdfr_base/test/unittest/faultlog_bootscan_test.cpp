@@ -262,5 +262,32 @@ HWTEST(FaultLogBootScanTest, IsReportedTest002, testing::ext::TestSize.Level3)
     EXPECT_FALSE(info.module.find("arkwebcore") != std::string::npos);
     EXPECT_EQ(info.id, tmpUid);
 }
+
+/**
+ * @tc.name: StartBootScanCheckpointTest001
+ * @tc.desc: Test the scanned file is checkpointed and is removed from checkpoint after the file is gone
+ * @tc.type: FUNC
+ */
+HWTEST(FaultLogBootScanTest, StartBootScanCheckpointTest001, testing::ext::TestSize.Level3)
+{
+    time_t now = time(nullptr);
+    std::string content = "Pid:121\nUid:0\nProcess name:BootScanUnittest\nReason:unittest for StartBootScan\n"
+        "Fault thread info:\nTid:121, Name:BootScanUnittest\n#00 xxxxxxx\n#01 xxxxxxx\n";
+    std::string fileName = "cppcrash-121-" + std::to_string(now);
+    std::string filePath = "/data/log/faultlog/temp/" + fileName;
+    ASSERT_TRUE(FileUtil::SaveStringToFile(filePath, content));
+    FaultLogBootScan::StartBootScan();
+
+    std::string checkpointPath = "/data/log/faultlog/bootscan_checkpoint";
+    std::string checkpoint;
+    ASSERT_TRUE(FileUtil::LoadStringFromFile(checkpointPath, checkpoint));
+    ASSERT_NE(checkpoint.find(fileName + " "), std::string::npos);
+
+    ASSERT_TRUE(FileUtil::RemoveFile(filePath));
+    FaultLogBootScan::StartBootScan();
+    checkpoint.clear();
+    FileUtil::LoadStringFromFile(checkpointPath, checkpoint);
+    ASSERT_EQ(checkpoint.find(fileName + " "), std::string::npos);
+}
 } // namespace HiviewDFX
 } // namespace OHOS
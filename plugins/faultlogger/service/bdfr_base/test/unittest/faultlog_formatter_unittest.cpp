@@ -950,5 +950,57 @@ HWTEST(FaultlogFormatterUnittest, FormatOtherThreadInfoTest004, testing::ext::Te
     EXPECT_TRUE(result.empty());
 }
 
+/**
+ * @tc.name: ParseCppCrashFromTextFileTest001
+ * @tc.desc: Test ParseCppCrashFromTextFile recognizes the single line and the multi line sections
+ * @tc.type: FUNC
+ */
+HWTEST(FaultlogFormatterUnittest, ParseCppCrashFromTextFileTest001, testing::ext::TestSize.Level1)
+{
+    std::string path = "/data/test/ParseCppCrashFromTextFileTest001";
+    std::string content = "Pid:131\nUid:0\nProcess name:FormatterUnittest\nReason:Signal:SIGSEGV\n"
+        "Fault thread info:\nTid:131, Name:FormatterUnittest\n#00 pc 0000 /system/lib/libc.so\n"
+        "Registers:\nr0:00000019 r1:0097cd3c\n";
+    ASSERT_TRUE(FileUtil::SaveStringToFile(path, content));
+    FaultLogInfo info;
+    info.faultLogType = FaultLogType::CPP_CRASH;
+    FaultLogger::ParseCppCrashFromTextFile(path, info);
+    EXPECT_EQ(info.sectionMap[FaultKey::P_NAME], "FormatterUnittest");
+    EXPECT_EQ(info.sectionMap[FaultKey::REASON], "Signal:SIGSEGV");
+    EXPECT_EQ(info.sectionMap[FaultKey::KEY_THREAD_INFO],
+        "Tid:131, Name:FormatterUnittest\n#00 pc 0000 /system/lib/libc.so\n");
+    EXPECT_EQ(info.sectionMap[FaultKey::KEY_THREAD_REGISTERS], "r0:00000019 r1:0097cd3c\n");
+    FileUtil::RemoveFile(path);
+}
+
+/**
+ * @tc.name: WriteLogToFileTest001
+ * @tc.desc: Test WriteLogToFile copies the origin log and inserts the device meminfo
+ * @tc.type: FUNC
+ */
+HWTEST(FaultlogFormatterUnittest, WriteLogToFileTest001, testing::ext::TestSize.Level1)
+{
+    std::string srcPath = "/data/test/WriteLogToFileTest001_src";
+    std::string dstPath = "/data/test/WriteLogToFileTest001_dst";
+    std::string content = "Build info:test\nProcess Memory(kB): 100\n";
+    for (int i = 0; i < 10000; i++) { // 10000: make the log larger than the write buffer
+        content += "line " + std::to_string(i) + "\n";
+    }
+    ASSERT_TRUE(FileUtil::SaveStringToFile(srcPath, content));
+    std::map<std::string, std::string> sections = {{"DEVICE_MEMINFO", "Device Memory(kB): 200"}};
+    int fd = open(dstPath.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644); // 0644: test file mode
+    ASSERT_GE(fd, 0);
+    ASSERT_TRUE(FaultLogger::WriteLogToFile(fd, srcPath, sections));
+    close(fd);
+
+    std::string result;
+    ASSERT_TRUE(FileUtil::LoadStringFromFile(dstPath, result));
+    std::string expect = "Process Memory(kB): 100\nDevice Memory(kB): 200\n";
+    EXPECT_EQ(result.find(expect), 0u);
+    EXPECT_NE(result.find("line 9999\n"), std::string::npos);
+    FileUtil::RemoveFile(srcPath);
+    FileUtil::RemoveFile(dstPath);
+}
+
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -24,6 +24,33 @@
 namespace OHOS {
 namespace HiviewDFX {
 DEFINE_LOG_LABEL(0xD002D01, "FreezeDetector");
+namespace {
+// keeps the nearest event before the watch point, or the nearest one since the watch point if none is before it
+class NearestEventSelector {
+public:
+    explicit NearestEventSelector(unsigned long long timestamp) : timestamp_(timestamp) {};
+
+    // returns true if the event replaces the one selected before
+    bool Offer(unsigned long long happenTime)
+    {
+        if (happenTime < timestamp_ && timestamp_ - happenTime < frontInterval_) {
+            frontInterval_ = timestamp_ - happenTime;
+            return true;
+        }
+        if (frontInterval_ == UINT64_MAX && happenTime - timestamp_ < rearInterval_) {
+            rearInterval_ = happenTime - timestamp_;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    unsigned long long timestamp_;
+    unsigned long long frontInterval_ = UINT64_MAX;
+    unsigned long long rearInterval_ = UINT64_MAX;
+};
+}
+
 std::string DBHelper::SearchLogFile(const std::string& info)
 {
     const char* prefix = "logPath:";
@@ -42,54 +69,95 @@ std::string DBHelper::SearchLogFile(const std::string& info)
     return logFile;
 }
 
+WatchPoint DBHelper::MakeResultWatchPoint(SysEvent& record, const std::string& domain, const std::string& stringId)
+{
+    std::string packageName = record.GetEventValue(FreezeCommon::EVENT_PACKAGE_NAME);
+    packageName = packageName.empty() ?
+        record.GetEventValue(FreezeCommon::EVENT_PROCESS_NAME) : packageName;
+    long pid = record.GetEventIntValue(FreezeCommon::EVENT_PID);
+    pid = pid ? pid : record.GetPid();
+    long tid = record.GetEventIntValue(FreezeCommon::EVENT_TID);
+    long uid = record.GetEventIntValue(FreezeCommon::EVENT_UID);
+    uid = uid ? uid : record.GetUid();
+    WatchPoint watchPoint = WatchPoint::Builder()
+        .InitSeq(record.GetSeq()).InitDomain(domain).InitStringId(stringId)
+        .InitTimestamp(record.happenTime_).InitPid(pid).InitUid(uid).InitTid(tid).InitPackageName(packageName)
+        .InitProcessName(record.GetEventValue(FreezeCommon::EVENT_PROCESS_NAME))
+        .InitMsg(StringUtil::ReplaceStr(record.GetEventValue(FreezeCommon::EVENT_MSG), "\\n", "\n"))
+        .InitFreezeExtFile(record.GetEventValue(FreezeCommon::FREEZE_INFO_PATH))
+        .InitExternalLog(record.GetEventValue(FreezeCommon::EVENT_EXTERNAL_LOG)).Build();
+    std::string info = record.GetEventValue(EventStore::EventCol::INFO);
+    std::string logPath = SearchLogFile(info);
+    if (!logPath.empty()) {
+        watchPoint.SetLogPath(logPath);
+    }
+    return watchPoint;
+}
+
+bool DBHelper::IsResultMatched(const struct WatchParams& watchParams, const FreezeResult& result,
+    const WatchPoint& watchPoint) const
+{
+    long pid = watchPoint.GetPid();
+    long tid = watchPoint.GetTid();
+    if (result.GetSamePackage() == "true" && (watchParams.pid != pid ||
+        (watchParams.tid > 0 && tid > 0 && watchParams.tid != tid))) {
+        HIVIEW_LOGE("failed to match query result, watchPoint = [%{public}s, %{public}ld, %{public}ld], "
+            "record = [%{public}s, %{public}ld, %{public}ld]", watchParams.packageName.c_str(),
+            watchParams.pid, watchParams.tid, watchPoint.GetPackageName().c_str(), pid, tid);
+        return false;
+    }
+    return true;
+}
+
 void DBHelper::GetResultWatchPoint(const struct WatchParams& watchParams, const FreezeResult& result,
     EventStore::ResultSet& set, WatchPoint& resultWatchPoint)
 {
-    unsigned long long timestamp = watchParams.timestamp;
-    unsigned long long frontInterval = UINT64_MAX;
-    unsigned long long rearInterval = UINT64_MAX;
+    NearestEventSelector selector(watchParams.timestamp);
     while (set.HasNext()) {
         auto record = set.Next();
-        std::string packageName = record->GetEventValue(FreezeCommon::EVENT_PACKAGE_NAME);
-        packageName = packageName.empty() ?
-            record->GetEventValue(FreezeCommon::EVENT_PROCESS_NAME) : packageName;
-        long pid = record->GetEventIntValue(FreezeCommon::EVENT_PID);
-        pid = pid ? pid : record->GetPid();
-        long tid = record->GetEventIntValue(FreezeCommon::EVENT_TID);
-        if (result.GetSamePackage() == "true" && (watchParams.pid != pid ||
-            (watchParams.tid > 0 && tid > 0 && watchParams.tid != tid))) {
-            HIVIEW_LOGE("failed to match query result, watchPoint = [%{public}s, %{public}ld, %{public}ld], "
-                "record = [%{public}s, %{public}ld, %{public}ld]",
-                watchParams.packageName.c_str(), watchParams.pid, watchParams.tid, packageName.c_str(), pid, tid);
-            continue;
+        WatchPoint watchPoint = MakeResultWatchPoint(*record, result.GetDomain(), result.GetStringId());
+        if (IsResultMatched(watchParams, result, watchPoint) && selector.Offer(watchPoint.GetTimestamp())) {
+            resultWatchPoint = watchPoint;
         }
+    }
+}
 
-        if (record->happenTime_ < timestamp && timestamp - record->happenTime_ < frontInterval) {
-            frontInterval = timestamp - record->happenTime_;
-        } else if (frontInterval == UINT64_MAX) {
-            if (record->happenTime_ - timestamp >= rearInterval) {
-                continue;
-            }
-            rearInterval = record->happenTime_ - timestamp;
-        } else {
-            continue;
-        }
+void DBHelper::SetEventCache(std::shared_ptr<FreezeEventCache> eventCache)
+{
+    eventCache_ = eventCache;
+}
+
+void DBHelper::CacheEvent(SysEvent& sysEvent)
+{
+    if (eventCache_ != nullptr) {
+        eventCache_->AddEvent(MakeResultWatchPoint(sysEvent, sysEvent.domain_, sysEvent.eventName_));
+    }
+}
 
-        long uid = record->GetEventIntValue(FreezeCommon::EVENT_UID);
-        uid = uid ? uid : record->GetUid();
-        resultWatchPoint = WatchPoint::Builder()
-            .InitSeq(record->GetSeq()).InitDomain(result.GetDomain()).InitStringId(result.GetStringId())
-            .InitTimestamp(record->happenTime_).InitPid(pid).InitUid(uid).InitTid(tid).InitPackageName(packageName)
-            .InitProcessName(record->GetEventValue(FreezeCommon::EVENT_PROCESS_NAME))
-            .InitMsg(StringUtil::ReplaceStr(record->GetEventValue(FreezeCommon::EVENT_MSG), "\\n", "\n"))
-            .InitFreezeExtFile(record->GetEventValue(FreezeCommon::FREEZE_INFO_PATH))
-            .InitExternalLog(record->GetEventValue(FreezeCommon::EVENT_EXTERNAL_LOG)).Build();
-        std::string info = record->GetEventValue(EventStore::EventCol::INFO);
-        std::string logPath = SearchLogFile(info);
-        if (!logPath.empty()) {
-            resultWatchPoint.SetLogPath(logPath);
+bool DBHelper::SelectEventFromCache(unsigned long long start, unsigned long long end, std::vector<WatchPoint>& list,
+    const struct WatchParams& watchParams, const FreezeResult& result)
+{
+    // only the freeze events are dispatched to the cache
+    if (eventCache_ == nullptr || !freezeCommon_->IsFreezeEvent(result.GetDomain(), result.GetStringId())) {
+        return false;
+    }
+    long pid = result.GetSamePackage() == "true" ? watchParams.pid : FreezeEventCache::ANY_PID;
+    std::vector<WatchPoint> events;
+    if (!eventCache_->GetEvents(result.GetDomain(), result.GetStringId(), pid, start, end, events)) {
+        return false;
+    }
+    NearestEventSelector selector(watchParams.timestamp);
+    const WatchPoint* resultWatchPoint = nullptr;
+    for (const auto& watchPoint : events) {
+        if (IsResultMatched(watchParams, result, watchPoint) && selector.Offer(watchPoint.GetTimestamp())) {
+            resultWatchPoint = &watchPoint;
         }
     }
+    if (resultWatchPoint != nullptr) {
+        list.push_back(*resultWatchPoint);
+        HIVIEW_LOGI("select event from cache, size =%{public}zu.", list.size());
+    }
+    return true;
 }
 
 void DBHelper::SelectEventFromDB(unsigned long long start, unsigned long long end, std::vector<WatchPoint>& list,
@@ -101,6 +169,9 @@ void DBHelper::SelectEventFromDB(unsigned long long start, unsigned long long en
     if (start > end) {
         return;
     }
+    if (SelectEventFromCache(start, end, list, watchParams, result)) {
+        return;
+    }
 
     auto eventQuery = EventStore::SysEventDao::BuildQuery(result.GetDomain(), {result.GetStringId()});
     std::vector<std::string> selections { EventStore::EventCol::TS };
@@ -22,6 +22,7 @@
 
 #include "sys_event_dao.h"
 #include "freeze_common.h"
+#include "freeze_event_cache.h"
 #include "watch_point.h"
 
 namespace OHOS {
@@ -37,6 +38,9 @@ public:
 
     explicit DBHelper(std::shared_ptr<FreezeCommon> fc) : freezeCommon_(fc) {};
     ~DBHelper() {};
+    // the events are selected from the cache only if it is set, the owner of the cache needs to feed it
+    void SetEventCache(std::shared_ptr<FreezeEventCache> eventCache);
+    void CacheEvent(SysEvent& sysEvent);
     void GetResultWatchPoint(const struct WatchParams& watchParams, const FreezeResult& result,
         EventStore::ResultSet& set, WatchPoint& resultWatchPoint);
     void SelectEventFromDB(unsigned long long start, unsigned long long end, std::vector<WatchPoint>& list,
@@ -47,7 +51,14 @@ public:
         const std::vector<std::string>& eventNames);
     std::string SearchLogFile(const std::string& info);
 private:
+    WatchPoint MakeResultWatchPoint(SysEvent& record, const std::string& domain, const std::string& stringId);
+    bool IsResultMatched(const struct WatchParams& watchParams, const FreezeResult& result,
+        const WatchPoint& watchPoint) const;
+    bool SelectEventFromCache(unsigned long long start, unsigned long long end, std::vector<WatchPoint>& list,
+        const struct WatchParams& watchParams, const FreezeResult& result);
+
     std::shared_ptr<FreezeCommon> freezeCommon_;
+    std::shared_ptr<FreezeEventCache> eventCache_ = nullptr;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -146,6 +146,22 @@ std::set<std::string> FreezeCommon::GetPrincipalStringIds() const
     return set;
 }
 
+std::set<std::string> FreezeCommon::GetRelevantStringIds() const
+{
+    std::set<std::string> set;
+    if (freezeRuleCluster_ == nullptr) {
+        HIVIEW_LOGW("freezeRuleCluster_ == nullptr.");
+        return set;
+    }
+    for (const auto& pairs : { freezeRuleCluster_->GetApplicationPairs(), freezeRuleCluster_->GetSystemPairs(),
+        freezeRuleCluster_->GetSysWarningPairs(), freezeRuleCluster_->GetAppFreezeWarningPairs() }) {
+        for (auto const &pair : pairs) {
+            set.insert(pair.first);
+        }
+    }
+    return set;
+}
+
 std::shared_ptr<FreezeRuleCluster> FreezeCommon::GetFreezeRuleCluster() const
 {
     return freezeRuleCluster_;
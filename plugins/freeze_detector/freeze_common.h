@@ -104,6 +104,7 @@ public:
     bool IsSysWarningEvent(const std::string& domain, const std::string& stringId) const;
     bool IsAppFreezeWarningEvent(const std::string& domain, const std::string& stringId) const;
     std::set<std::string> GetPrincipalStringIds() const;
+    std::set<std::string> GetRelevantStringIds() const;
     std::shared_ptr<FreezeRuleCluster> GetFreezeRuleCluster() const;
     static void WriteTimeInfoToFd(int fd, const std::string& msg, bool isStart = true);
     static time_t GetFaultTime(const std::string& msg);
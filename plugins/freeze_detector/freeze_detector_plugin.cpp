@@ -53,6 +53,7 @@ bool FreezeDetectorPlugin::ReadyToLoad()
 {
     freezeCommon_ = std::make_shared<FreezeCommon>();
     bool ret1 = freezeCommon_->Init();
+    principalStringIds_ = freezeCommon_->GetPrincipalStringIds();
     freezeResolver_ = std::make_unique<FreezeResolver>(freezeCommon_);
     bool ret2 = freezeResolver_->Init();
     return ret1 && ret2;
@@ -74,6 +75,7 @@ void FreezeDetectorPlugin::OnLoad()
         freezeCommon_ = nullptr;
         return;
     }
+    principalStringIds_ = freezeCommon_->GetPrincipalStringIds();
     freezeResolver_ = std::make_unique<FreezeResolver>(freezeCommon_);
     ret = freezeResolver_->Init();
     if (!ret) {
@@ -244,6 +246,15 @@ void FreezeDetectorPlugin::OnEventListeningCallback(const Event& event)
         return;
     }
 
+    // the related events are dispatched as well, they are only kept for the correlation of the watch points
+    SysEvent& sysEvent = static_cast<SysEvent&>(const_cast<Event&>(event));
+    if (freezeResolver_ != nullptr) {
+        freezeResolver_->CacheEvent(sysEvent);
+    }
+    if (principalStringIds_.find(event.eventName_) == principalStringIds_.end()) {
+        return;
+    }
+
     HIVIEW_LOGD("received event domain=%{public}s, stringid=%{public}s",
         event.domain_.c_str(), event.eventName_.c_str());
     this->AddUseCount();
@@ -17,6 +17,7 @@
 #define FREEZE_DETECTOR_PLUGIN_H
 
 #include <memory>
+#include <set>
 
 #include "event.h"
 #include "event_loop.h"
@@ -90,6 +91,7 @@ private:
     std::shared_ptr<FreezeCommon> freezeCommon_ = nullptr;
     std::unique_ptr<FreezeResolver> freezeResolver_ = nullptr;
     std::unique_ptr<ffrt::queue> warningQueue_ = nullptr;
+    std::set<std::string> principalStringIds_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freeze_event_cache.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+    // the widest rule window is a few minutes, plus the delay of the watch point processing
+    constexpr uint64_t RETENTION_TIME = 10 * 60 * 1000;
+    constexpr uint64_t SWEEP_INTERVAL = 60 * 1000;
+    constexpr size_t MAX_EVENTS_PER_KEY = 64;
+}
+
+void FreezeEventCache::AddEvent(const WatchPoint& watchPoint)
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    CacheKey key = {watchPoint.GetDomain(), watchPoint.GetStringId(), watchPoint.GetPid()};
+    auto& ring = rings_[key];
+    if (ring.size() >= MAX_EVENTS_PER_KEY) {
+        Evict(ring);
+    }
+    ring.push_back(watchPoint);
+    isFed_ = true;
+    latestTime_ = std::max(latestTime_, static_cast<uint64_t>(watchPoint.GetTimestamp()));
+    if (latestTime_ >= lastSweepTime_ + SWEEP_INTERVAL) {
+        Sweep();
+        lastSweepTime_ = latestTime_;
+    }
+}
+
+bool FreezeEventCache::GetEvents(const std::string& domain, const std::string& stringId, long pid,
+    uint64_t start, uint64_t end, std::vector<WatchPoint>& events)
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    if (!isFed_ || start < coveredFrom_) {
+        return false;
+    }
+    if (pid != ANY_PID) {
+        auto it = rings_.find({domain, stringId, pid});
+        if (it != rings_.end()) {
+            SelectFromRing(it->second, start, end, events);
+        }
+        return true;
+    }
+    for (auto it = rings_.lower_bound({domain, stringId, LONG_MIN});
+        it != rings_.end() && it->first.domain == domain && it->first.stringId == stringId; ++it) {
+        SelectFromRing(it->second, start, end, events);
+    }
+    return true;
+}
+
+uint64_t FreezeEventCache::GetCoveredFrom()
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    return coveredFrom_;
+}
+
+size_t FreezeEventCache::GetKeyCount()
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    return rings_.size();
+}
+
+void FreezeEventCache::Evict(std::deque<WatchPoint>& ring)
+{
+    coveredFrom_ = std::max(coveredFrom_, static_cast<uint64_t>(ring.front().GetTimestamp()) + 1);
+    ring.pop_front();
+}
+
+void FreezeEventCache::Sweep()
+{
+    if (latestTime_ < RETENTION_TIME) {
+        return;
+    }
+    uint64_t expireTime = latestTime_ - RETENTION_TIME;
+    for (auto it = rings_.begin(); it != rings_.end();) {
+        auto& ring = it->second;
+        while (!ring.empty() && ring.front().GetTimestamp() < expireTime) {
+            Evict(ring);
+        }
+        it = ring.empty() ? rings_.erase(it) : std::next(it);
+    }
+}
+
+void FreezeEventCache::SelectFromRing(const std::deque<WatchPoint>& ring, uint64_t start, uint64_t end,
+    std::vector<WatchPoint>& events) const
+{
+    for (const auto& watchPoint : ring) {
+        if (watchPoint.GetTimestamp() >= start && watchPoint.GetTimestamp() <= end) {
+            events.push_back(watchPoint);
+        }
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FREEZE_EVENT_CACHE_H
+#define FREEZE_EVENT_CACHE_H
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ffrt.h"
+#include "watch_point.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+/*
+ * Keeps the freeze events received in the last minutes in rings keyed by (domain, stringId, pid), so the
+ * related events of a watch point are selected in memory instead of querying the event db.
+ * A time window is answered only if the cache has been fed and no event in it could have been dropped,
+ * the caller falls back to the db otherwise.
+ */
+class FreezeEventCache {
+public:
+    static constexpr long ANY_PID = -1;
+
+    explicit FreezeEventCache(uint64_t startTime) : coveredFrom_(startTime) {};
+    ~FreezeEventCache() = default;
+    FreezeEventCache& operator=(const FreezeEventCache&) = delete;
+    FreezeEventCache(const FreezeEventCache&) = delete;
+
+    void AddEvent(const WatchPoint& watchPoint);
+    // selects the events happened in [start, end] in the order they were received, the events of all pids
+    // are selected if the pid is ANY_PID; returns false if no event has been added or the window is not covered
+    bool GetEvents(const std::string& domain, const std::string& stringId, long pid,
+        uint64_t start, uint64_t end, std::vector<WatchPoint>& events);
+    uint64_t GetCoveredFrom();
+    size_t GetKeyCount();
+
+private:
+    struct CacheKey {
+        std::string domain;
+        std::string stringId;
+        long pid = 0;
+
+        bool operator<(const CacheKey& other) const
+        {
+            if (domain != other.domain) {
+                return domain < other.domain;
+            }
+            if (stringId != other.stringId) {
+                return stringId < other.stringId;
+            }
+            return pid < other.pid;
+        }
+    };
+
+    void Evict(std::deque<WatchPoint>& ring);
+    void Sweep();
+    void SelectFromRing(const std::deque<WatchPoint>& ring, uint64_t start, uint64_t end,
+        std::vector<WatchPoint>& events) const;
+
+    ffrt::mutex mutex_;
+    // the events happened before it may have been dropped
+    uint64_t coveredFrom_ = 0;
+    uint64_t latestTime_ = 0;
+    uint64_t lastSweepTime_ = 0;
+    bool isFed_ = false;
+    std::map<CacheKey, std::deque<WatchPoint>> rings_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // FREEZE_EVENT_CACHE_H
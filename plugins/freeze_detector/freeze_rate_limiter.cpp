@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freeze_rate_limiter.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace HiviewDFX {
+uint32_t FreezeRateLimiter::GetEventId(const std::string& eventName)
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    auto it = eventIds_.find(eventName);
+    if (it != eventIds_.end()) {
+        return it->second;
+    }
+    uint32_t eventId = static_cast<uint32_t>(eventNames_.size());
+    eventNames_.push_back(eventName);
+    eventIds_[eventName] = eventId;
+    return eventId;
+}
+
+void FreezeRateLimiter::SetSuppressedReporter(SuppressedReporter reporter)
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    reporter_ = reporter;
+}
+
+bool FreezeRateLimiter::TryAcquire(const RateLimitKey& key, uint64_t now, uint32_t interval)
+{
+    if (interval == 0) {
+        return true;
+    }
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    Advance(now);
+    // the wheel never goes back, a time earlier than the current tick is treated as the current tick
+    now = std::max(now, currentTick_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        if (it->second.expireTick > now) {
+            it->second.suppressedCnt++;
+            return false;
+        }
+        Expire(key, it->second);
+        RemoveFromWheel(it->second);
+        entries_.erase(it);
+    }
+    Entry& entry = entries_[key];
+    entry.expireTick = now + interval;
+    AddToWheel(key, entry);
+    return true;
+}
+
+uint32_t FreezeRateLimiter::GetSuppressedCount(const RateLimitKey& key)
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    return it != entries_.end() ? it->second.suppressedCnt : 0;
+}
+
+size_t FreezeRateLimiter::GetKeyCount()
+{
+    std::unique_lock<ffrt::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void FreezeRateLimiter::Advance(uint64_t now)
+{
+    if (!isTickInited_) {
+        currentTick_ = now;
+        isTickInited_ = true;
+        return;
+    }
+    if (now <= currentTick_) {
+        return;
+    }
+    // the wheel is empty when no key is alive, the idle time is skipped at once
+    if (entries_.empty()) {
+        currentTick_ = now;
+        return;
+    }
+    // stepping costs one tick each and placing the keys again costs one key each, the cheaper one is taken
+    if (now - currentTick_ >= WHEEL_SPAN || now - currentTick_ > entries_.size()) {
+        Rebuild(now);
+        return;
+    }
+    while (currentTick_ < now) {
+        currentTick_++;
+        // cascade from the top level, the keys moved down may be cascaded again at the same tick
+        for (uint32_t level = WHEEL_LEVEL_CNT - 1; level > 0; level--) {
+            uint32_t shift = WHEEL_SLOT_BITS * level;
+            if ((currentTick_ & ((1ULL << shift) - 1)) == 0) {
+                Cascade(level, static_cast<uint32_t>((currentTick_ >> shift) & WHEEL_SLOT_MASK));
+            }
+        }
+        ExpireSlot(static_cast<uint32_t>(currentTick_ & WHEEL_SLOT_MASK));
+    }
+}
+
+void FreezeRateLimiter::Rebuild(uint64_t now)
+{
+    currentTick_ = now;
+    for (auto& slots : wheel_) {
+        for (auto& slot : slots) {
+            slot.clear();
+        }
+    }
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.expireTick <= now) {
+            Expire(it->first, it->second);
+            it = entries_.erase(it);
+            continue;
+        }
+        AddToWheel(it->first, it->second);
+        ++it;
+    }
+}
+
+void FreezeRateLimiter::Cascade(uint32_t level, uint32_t slot)
+{
+    WheelSlot keys;
+    keys.splice(keys.end(), wheel_[level][slot]);
+    for (const auto& key : keys) {
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            AddToWheel(key, it->second);
+        }
+    }
+}
+
+void FreezeRateLimiter::ExpireSlot(uint32_t slot)
+{
+    WheelSlot keys;
+    keys.splice(keys.end(), wheel_[0][slot]);
+    for (const auto& key : keys) {
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            continue;
+        }
+        if (it->second.expireTick > currentTick_) {
+            AddToWheel(key, it->second);
+            continue;
+        }
+        Expire(key, it->second);
+        entries_.erase(it);
+    }
+}
+
+void FreezeRateLimiter::AddToWheel(const RateLimitKey& key, Entry& entry)
+{
+    uint64_t expireTick = std::max(entry.expireTick, currentTick_);
+    // the key expires too late is parked in the farthest slot and placed again when it is cascaded
+    expireTick = std::min(expireTick, currentTick_ + WHEEL_SPAN - 1);
+    uint64_t delta = expireTick - currentTick_;
+    uint32_t level = 0;
+    while (level + 1 < WHEEL_LEVEL_CNT && delta >= (1ULL << (WHEEL_SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    entry.level = level;
+    entry.slot = static_cast<uint32_t>((expireTick >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK);
+    auto& slot = wheel_[entry.level][entry.slot];
+    entry.pos = slot.insert(slot.end(), key);
+}
+
+void FreezeRateLimiter::RemoveFromWheel(const Entry& entry)
+{
+    wheel_[entry.level][entry.slot].erase(entry.pos);
+}
+
+void FreezeRateLimiter::Expire(const RateLimitKey& key, const Entry& entry)
+{
+    if (entry.suppressedCnt > 0 && reporter_) {
+        reporter_(key.eventId < eventNames_.size() ? eventNames_[key.eventId] : "", key.pid, entry.suppressedCnt);
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
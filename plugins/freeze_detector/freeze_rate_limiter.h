@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FREEZE_RATE_LIMITER_H
+#define FREEZE_RATE_LIMITER_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ffrt.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+struct RateLimitKey {
+    uint32_t eventId = 0;
+    int64_t pid = 0;
+
+    bool operator==(const RateLimitKey& other) const
+    {
+        return eventId == other.eventId && pid == other.pid;
+    }
+};
+
+struct RateLimitKeyHash {
+    size_t operator()(const RateLimitKey& key) const
+    {
+        return std::hash<uint64_t>()((static_cast<uint64_t>(key.eventId) << 32) ^ static_cast<uint64_t>(key.pid));
+    }
+};
+
+/*
+ * Keyed rate limiter, a key is accepted once per interval and the keys suppressed in the interval are counted.
+ * The expiry of the keys is driven by a hierarchical timing wheel with the tick of one second, so both the
+ * lookup and the expiry are O(1) amortized no matter how many keys are alive.
+ */
+class FreezeRateLimiter {
+public:
+    // called with the suppressed count when the interval of a key which has suppressed any event is over,
+    // it runs with the limiter locked and must not call back into the limiter
+    using SuppressedReporter = std::function<void(const std::string& eventName, int64_t pid, uint32_t count)>;
+
+    FreezeRateLimiter() = default;
+    ~FreezeRateLimiter() = default;
+    FreezeRateLimiter& operator=(const FreezeRateLimiter&) = delete;
+    FreezeRateLimiter(const FreezeRateLimiter&) = delete;
+
+    uint32_t GetEventId(const std::string& eventName);
+    void SetSuppressedReporter(SuppressedReporter reporter);
+    bool TryAcquire(const RateLimitKey& key, uint64_t now, uint32_t interval);
+    uint32_t GetSuppressedCount(const RateLimitKey& key);
+    size_t GetKeyCount();
+
+private:
+    static constexpr uint32_t WHEEL_SLOT_BITS = 6;
+    static constexpr uint32_t WHEEL_SLOT_CNT = 1 << WHEEL_SLOT_BITS;
+    static constexpr uint32_t WHEEL_SLOT_MASK = WHEEL_SLOT_CNT - 1;
+    static constexpr uint32_t WHEEL_LEVEL_CNT = 3;
+    static constexpr uint64_t WHEEL_SPAN = 1ULL << (WHEEL_SLOT_BITS * WHEEL_LEVEL_CNT);
+
+    using WheelSlot = std::list<RateLimitKey>;
+
+    struct Entry {
+        uint64_t expireTick = 0;
+        uint32_t suppressedCnt = 0;
+        uint32_t level = 0;
+        uint32_t slot = 0;
+        WheelSlot::iterator pos;
+    };
+
+    void Advance(uint64_t now);
+    void Rebuild(uint64_t now);
+    void Cascade(uint32_t level, uint32_t slot);
+    void ExpireSlot(uint32_t slot);
+    void AddToWheel(const RateLimitKey& key, Entry& entry);
+    void RemoveFromWheel(const Entry& entry);
+    void Expire(const RateLimitKey& key, const Entry& entry);
+
+    ffrt::mutex mutex_;
+    bool isTickInited_ = false;
+    uint64_t currentTick_ = 0;
+    std::array<std::array<WheelSlot, WHEEL_SLOT_CNT>, WHEEL_LEVEL_CNT> wheel_;
+    std::unordered_map<RateLimitKey, Entry, RateLimitKeyHash> entries_;
+    std::unordered_map<std::string, uint32_t> eventIds_;
+    std::vector<std::string> eventNames_;
+    SuppressedReporter reporter_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // FREEZE_RATE_LIMITER_H
@@ -24,6 +24,7 @@
 #include "sys_event.h"
 #include "sys_event_dao.h"
 #include "parameter_ex.h"
+#include "time_util.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -46,6 +47,8 @@ bool FreezeResolver::Init()
         return false;
     }
     dBHelper_ = std::make_shared<DBHelper>(freezeCommon_);
+    // the cache is fed by the plugin through CacheEvent from now on
+    dBHelper_->SetEventCache(std::make_shared<FreezeEventCache>(TimeUtil::GetMilliseconds()));
     vendor_ = std::make_unique<Vendor>(freezeCommon_, dBHelper_);
     return vendor_->Init();
 }
@@ -149,6 +152,14 @@ bool FreezeResolver::IsAppFreezeWarning(const WatchPoint& watchPoint,
             watchPoint.GetStringId() == "LIFECYCLE_HALF_TIMEOUT") &&
             (list.size() == result.size() - APP_MATCH_NUM);
 }
+
+void FreezeResolver::CacheEvent(SysEvent& sysEvent) const
+{
+    if (dBHelper_ != nullptr) {
+        dBHelper_->CacheEvent(sysEvent);
+    }
+}
+
 int FreezeResolver::ProcessEvent(const WatchPoint &watchPoint) const
 {
     HIVIEW_LOGI("process event [%{public}s, %{public}s, %{public}lu]",
@@ -41,6 +41,7 @@ public:
     bool Init();
     std::string GetTimeZone() const;
     int ProcessEvent(const WatchPoint &watchPoint) const;
+    void CacheEvent(SysEvent& sysEvent) const;
 
 private:
     bool ResolveEvent(const WatchPoint& watchPoint,
@@ -31,6 +31,8 @@
 #include "resolver.h"
 #include "vendor.h"
 #include "freeze_detector_plugin.h"
+#include "freeze_event_cache.h"
+#include "freeze_rate_limiter.h"
 #undef private
 #include "sys_event.h"
 #include "sys_event_dao.h"
@@ -1675,6 +1677,43 @@ HWTEST_F(FreezeDetectorUnittest, FreezeDBHelper_004, TestSize.Level3)
     ASSERT_TRUE(result.size() > 0);
 }
 
+/**
+ * @tc.name: FreezeDBHelper_005
+ * @tc.desc: Test the events are selected from the cache only if it is set and fed
+ */
+HWTEST_F(FreezeDetectorUnittest, FreezeDBHelper_005, TestSize.Level3)
+{
+    auto freezeCommon = std::make_shared<FreezeCommon>();
+    ASSERT_TRUE(freezeCommon->Init());
+    unsigned long long now = TimeUtil::GetMilliseconds();
+    std::string jsonStr = R"~({"domain_":"AAFWK", "name_":"THREAD_BLOCK_3S", "type_":1, "time_":)~" +
+        std::to_string(now) + R"~(, "tz_":"+0800", "pid_":13000, "tid_":13000, "uid_":0, "PID":13000,
+        "UID":0, "PACKAGE_NAME":"FreezeDBHelperCacheTest", "MSG":"test msg", "level_":"CRITICAL"})~";
+    SysEvent sysEvent("SysEventSource", nullptr, jsonStr);
+    unsigned long long start = now - 1000; // 1000: test window
+    unsigned long long end = now + 1000; // 1000: test window
+    DBHelper::WatchParams params = {13000, 0, now, "FreezeDBHelperCacheTest"}; // 13000: test pid
+    auto result = FreezeResult(5, "AAFWK", "THREAD_BLOCK_3S"); // 5: test window
+    result.SetSamePackage("true");
+
+    // the event is not in the db, so it is only selected from the cache
+    auto db = std::make_unique<DBHelper>(freezeCommon);
+    db->CacheEvent(sysEvent);
+    std::vector<WatchPoint> list;
+    db->SelectEventFromDB(start, end, list, params, result);
+    EXPECT_TRUE(list.empty());
+
+    db->SetEventCache(std::make_shared<FreezeEventCache>(start));
+    db->SelectEventFromDB(start, end, list, params, result);
+    EXPECT_TRUE(list.empty());
+    db->CacheEvent(sysEvent);
+    db->SelectEventFromDB(start, end, list, params, result);
+    ASSERT_EQ(list.size(), 1);
+    EXPECT_EQ(list[0].GetPid(), 13000); // 13000: test pid
+    EXPECT_EQ(list[0].GetTimestamp(), now);
+    EXPECT_EQ(list[0].GetPackageName(), "FreezeDBHelperCacheTest");
+}
+
 /**
  * @tc.name: FreezeResolver_IsAppFreezeWarning_001
  * @tc.desc: Test IsAppFreezeWarning with THREAD_BLOCK_3S event
@@ -2092,5 +2131,108 @@ HWTEST_F(FreezeDetectorUnittest, FreezeDetectorPlugin_SearchLogFile_001, TestSiz
     plugin->SearchLogFile(info, logFile);
     EXPECT_EQ(logFile, info);
 }
+
+/**
+ * @tc.name: FreezeRateLimiter_TryAcquire_001
+ * @tc.desc: FreezeRateLimiter_TryAcquire_001
+ */
+HWTEST_F(FreezeDetectorUnittest, FreezeRateLimiter_TryAcquire_001, TestSize.Level3)
+{
+    FreezeRateLimiter rateLimiter;
+    uint32_t reportedCount = 0;
+    rateLimiter.SetSuppressedReporter([&reportedCount](const std::string& eventName, int64_t pid, uint32_t count) {
+        reportedCount += count;
+    });
+    RateLimitKey key = { rateLimiter.GetEventId("APP_INPUT_BLOCK"), 1000 }; // 1000: test pid
+    RateLimitKey otherKey = { rateLimiter.GetEventId("THREAD_BLOCK_6S"), 1000 }; // 1000: test pid
+    EXPECT_NE(key.eventId, otherKey.eventId);
+    uint64_t now = 100; // 100: test time
+    uint32_t interval = 10; // 10: test interval
+    EXPECT_TRUE(rateLimiter.TryAcquire(key, now, interval));
+    EXPECT_FALSE(rateLimiter.TryAcquire(key, now + 1, interval));
+    EXPECT_FALSE(rateLimiter.TryAcquire(key, now + interval - 1, interval));
+    EXPECT_TRUE(rateLimiter.TryAcquire(otherKey, now + 1, interval));
+    EXPECT_EQ(rateLimiter.GetSuppressedCount(key), 2);
+    EXPECT_TRUE(rateLimiter.TryAcquire(key, now + interval, interval));
+    EXPECT_EQ(reportedCount, 2);
+    EXPECT_EQ(rateLimiter.GetSuppressedCount(key), 0);
+
+    // the keys expire by the wheel even if no more event comes for them
+    EXPECT_TRUE(rateLimiter.TryAcquire({ key.eventId, 1001 }, now + 100000, interval)); // 1001: test pid
+    EXPECT_EQ(rateLimiter.GetKeyCount(), 1);
+}
+
+/**
+ * @tc.name: FreezeRateLimiter_TryAcquire_002
+ * @tc.desc: FreezeRateLimiter_TryAcquire_002
+ */
+HWTEST_F(FreezeDetectorUnittest, FreezeRateLimiter_TryAcquire_002, TestSize.Level3)
+{
+    FreezeRateLimiter rateLimiter;
+    std::vector<int64_t> reportedPids;
+    rateLimiter.SetSuppressedReporter([&reportedPids](const std::string& eventName, int64_t pid, uint32_t count) {
+        reportedPids.push_back(pid);
+    });
+    uint32_t eventId = rateLimiter.GetEventId("APP_INPUT_BLOCK");
+    uint64_t now = 100; // 100: test time
+    uint32_t interval = 100; // 100: test interval
+    // the idle gap shorter than the span of the wheel is skipped while no key is alive
+    EXPECT_TRUE(rateLimiter.TryAcquire({ eventId, 1000 }, now, interval)); // 1000: test pid
+    EXPECT_TRUE(rateLimiter.TryAcquire({ eventId, 1000 }, now + interval, interval)); // 1000: test pid
+    now += 5000; // 5000: test idle gap
+    EXPECT_TRUE(rateLimiter.TryAcquire({ eventId, 1000 }, now, interval)); // 1000: test pid
+    EXPECT_EQ(rateLimiter.GetKeyCount(), 1);
+
+    // the keys placed again after a gap longer than the key count still expire at their own tick
+    EXPECT_FALSE(rateLimiter.TryAcquire({ eventId, 1000 }, now + 1, interval)); // 1000: test pid
+    EXPECT_TRUE(rateLimiter.TryAcquire({ eventId, 1001 }, now + 10, interval)); // 1001, 10: test pid and time
+    EXPECT_FALSE(rateLimiter.TryAcquire({ eventId, 1001 }, now + 11, interval)); // 1001, 11: test pid and time
+    EXPECT_FALSE(rateLimiter.TryAcquire({ eventId, 1001 }, now + interval + 9, interval)); // 1001, 9: test values
+    EXPECT_EQ(rateLimiter.GetKeyCount(), 1);
+    EXPECT_EQ(reportedPids, std::vector<int64_t>({ 1000 })); // 1000: test pid
+    EXPECT_TRUE(rateLimiter.TryAcquire({ eventId, 1001 }, now + interval + 10, interval)); // 1001, 10: test values
+    EXPECT_EQ(reportedPids, std::vector<int64_t>({ 1000, 1001 })); // 1000, 1001: test pids
+}
+
+/**
+ * @tc.name: FreezeEventCache_GetEvents_001
+ * @tc.desc: FreezeEventCache_GetEvents_001
+ */
+HWTEST_F(FreezeDetectorUnittest, FreezeEventCache_GetEvents_001, TestSize.Level3)
+{
+    FreezeEventCache eventCache(1000); // 1000: test start time
+    auto makeWatchPoint = [](long pid, unsigned long long timestamp) {
+        return WatchPoint::Builder().InitDomain("AAFWK").InitStringId("THREAD_BLOCK_3S")
+            .InitPid(pid).InitTimestamp(timestamp).Build();
+    };
+    std::vector<WatchPoint> events;
+    // the cache not fed yet does not answer any window
+    EXPECT_FALSE(eventCache.GetEvents("AAFWK", "THREAD_BLOCK_3S", 100, 1500, 3000, events)); // 1500, 3000: window
+    eventCache.AddEvent(makeWatchPoint(100, 2000)); // 100: test pid, 2000: test time
+    eventCache.AddEvent(makeWatchPoint(100, 2001)); // 100: test pid, 2001: test time
+    eventCache.AddEvent(makeWatchPoint(200, 2002)); // 200: test pid, 2002: test time
+    // the events before the cache is started are not covered
+    EXPECT_FALSE(eventCache.GetEvents("AAFWK", "THREAD_BLOCK_3S", 100, 500, 3000, events)); // 500, 3000: window
+    EXPECT_TRUE(eventCache.GetEvents("AAFWK", "THREAD_BLOCK_3S", 100, 1500, 3000, events)); // 1500, 3000: window
+    EXPECT_EQ(events.size(), 2);
+    events.clear();
+    EXPECT_TRUE(eventCache.GetEvents("AAFWK", "THREAD_BLOCK_3S", FreezeEventCache::ANY_PID,
+        1500, 3000, events)); // 1500, 3000: window
+    EXPECT_EQ(events.size(), 3);
+    events.clear();
+    EXPECT_TRUE(eventCache.GetEvents("AAFWK", "THREAD_BLOCK_6S", FreezeEventCache::ANY_PID,
+        1500, 3000, events)); // 1500, 3000: window
+    EXPECT_TRUE(events.empty());
+
+    // the events evicted by the capacity of the key are no longer covered
+    for (unsigned long long i = 0; i < 64; i++) { // 64: the capacity of a key
+        eventCache.AddEvent(makeWatchPoint(100, 3000 + i)); // 100: test pid, 3000: test time
+    }
+    EXPECT_EQ(eventCache.GetCoveredFrom(), 2002);
+    EXPECT_FALSE(eventCache.GetEvents("AAFWK", "THREAD_BLOCK_3S", 200, 2001, 2002, events)); // 2001, 2002: window
+    EXPECT_TRUE(eventCache.GetEvents("AAFWK", "THREAD_BLOCK_3S", 200, 2002, 2002, events)); // 2002: window
+    EXPECT_EQ(events.size(), 1);
+    EXPECT_EQ(eventCache.GetKeyCount(), 2);
+}
 }
 }
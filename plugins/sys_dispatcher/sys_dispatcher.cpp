@@ -42,7 +42,10 @@ void SysEventDispatcher::DispatchEvent(std::shared_ptr<SysEvent>& sysEvent)
 {
     auto dispatchList = GetHiviewContext()->GetDisPatcherInfo(sysEvent->eventType_, sysEvent->eventName_,
         sysEvent->GetTag(), sysEvent->domain_);
-    for (auto& dispatcher : dispatchList) {
+    if (dispatchList == nullptr) {
+        return;
+    }
+    for (const auto& dispatcher : *dispatchList) {
         auto ptr = dispatcher.lock();
         if (ptr != nullptr) {
             ptr->OnEventListeningCallback(*sysEvent);
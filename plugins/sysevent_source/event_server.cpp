@@ -15,13 +15,17 @@
 
 #include "event_server.h"
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <fcntl.h>
 #include <sys/epoll.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -40,11 +44,21 @@ namespace HiviewDFX {
 DEFINE_LOG_TAG("HiView-EventServer");
 namespace {
 constexpr int BUFFER_SIZE = 384 * 1024;
+// a slab is handed over to the event received into it, so it is allocated in size classes to waste less
+constexpr std::array<size_t, 4> SLAB_SIZE_CLASSES = {256, 512, 1024, 2048}; // most of the events are in 2048 bytes
+constexpr size_t CONTROL_SIZE = CMSG_SPACE(sizeof(struct ucred));
+// header of the event sent by hisysevent client, which has no log flag yet
+constexpr size_t MSG_HEADER_SIZE = sizeof(int32_t) + sizeof(EventRaw::HiSysEventHeader) - sizeof(uint8_t);
+constexpr size_t OVERFLOW_SIZE = RECV_BATCH_SIZE * BUFFER_SIZE;
 #ifndef KERNEL_DEVICE_BUFFER
 constexpr int EVENT_READ_BUFFER = 2048;
 #else
 constexpr int EVENT_READ_BUFFER = KERNEL_DEVICE_BUFFER;
 #endif
+// reading slows down in proportion once the pressure of the in-flight events is over this percentage
+constexpr uint32_t THROTTLE_PRESSURE_PCT = 50;
+constexpr uint32_t FULL_PRESSURE_PCT = 100;
+constexpr uint32_t MAX_THROTTLE_DELAY_MS = 100;
 
 struct Header {
     unsigned short len;
@@ -78,6 +92,16 @@ void InitRecvBuffer(int socketId)
     InitSocketBuf(socketId, SO_RCVBUF);
 }
 
+size_t GetSlabSizeClass(size_t dataLen)
+{
+    for (size_t slabSize : SLAB_SIZE_CLASSES) {
+        if (dataLen <= slabSize) {
+            return slabSize;
+        }
+    }
+    return SLAB_SIZE_CLASSES.back();
+}
+
 std::shared_ptr<EventRaw::RawData> ConverRawData(char* source)
 {
     if (source == nullptr) {
@@ -148,6 +172,9 @@ int SocketDevice::Open()
     if (socketId_ >= 0) {
         fdsan_exchange_owner_tag(socketId_, 0, logLabelDomain);
         InitRecvBuffer(socketId_);
+        if (isBatchRecv_ && !InitSlabRing()) {
+            isBatchRecv_ = false;
+        }
     }
     return socketId_;
 }
@@ -158,6 +185,7 @@ int SocketDevice::Close()
         fdsan_close_with_tag(socketId_, logLabelDomain);
         socketId_ = -1;
     }
+    ReleaseSlabRing();
     return 0;
 }
 
@@ -171,36 +199,242 @@ std::string SocketDevice::GetName()
     return socketName_;
 }
 
+SocketDevice::~SocketDevice()
+{
+    ReleaseSlabRing();
+}
+
+bool SocketDevice::InitSlabRing()
+{
+    if (overflow_ != nullptr) {
+        return true;
+    }
+    // only the pages really written by oversized events take physical memory
+    void* overflow = mmap(nullptr, OVERFLOW_SIZE, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (overflow == MAP_FAILED) {
+        HIVIEW_LOGE("failed to map overflow area, error=%{public}d", errno);
+        return false;
+    }
+    overflow_ = reinterpret_cast<uint8_t*>(overflow);
+    controls_.assign(RECV_BATCH_SIZE * CONTROL_SIZE, 0);
+    refillSlabSize_ = SLAB_SIZE_CLASSES.back();
+    for (size_t i = 0; i < RECV_BATCH_SIZE; ++i) {
+        AllocSlab(i);
+    }
+    return true;
+}
+
+bool SocketDevice::AllocSlab(size_t index)
+{
+    slabs_[index].reset(new(std::nothrow) uint8_t[refillSlabSize_]);
+    if (slabs_[index] == nullptr) {
+        slabSizes_[index] = 0;
+        return false;
+    }
+    slabSizes_[index] = refillSlabSize_;
+    ++recvStat_.slabAllocCnt;
+    recvStat_.slabBytes += refillSlabSize_;
+    return true;
+}
+
+void SocketDevice::ReleaseSlabRing()
+{
+    if (overflow_ != nullptr) {
+        munmap(overflow_, OVERFLOW_SIZE);
+        overflow_ = nullptr;
+    }
+    for (auto& slab : slabs_) {
+        slab.reset();
+    }
+    slabSizes_.fill(0);
+}
+
+SocketRecvStat SocketDevice::GetRecvStat() const
+{
+    return recvStat_;
+}
+
 bool SocketDevice::IsValidMsg(char* msg, int32_t len)
+{
+    if (!IsValidMsgHeader(msg, len)) {
+        return false;
+    }
+    msg[len] = '\0';
+    return true;
+}
+
+bool SocketDevice::IsValidMsgHeader(const char* msg, int32_t len)
 {
     if (len < static_cast<int32_t>(EventRaw::GetValidDataMinimumByteCount())) {
         HIVIEW_LOGD("the data length=%{public}d is invalid", len);
         return false;
     }
-    int32_t dataByteCnt = *(reinterpret_cast<int32_t*>(msg));
+    int32_t dataByteCnt = *(reinterpret_cast<const int32_t*>(msg));
     if (dataByteCnt != len) {
         HIVIEW_LOGW("the data byte count=%{public}d are not equal to read length %{public}d", dataByteCnt, len);
         return false;
     }
-    uid_t uid = static_cast<uid_t>(*(reinterpret_cast<uint32_t*>(msg + sizeof(int32_t) +
+    uid_t uid = static_cast<uid_t>(*(reinterpret_cast<const uint32_t*>(msg + sizeof(int32_t) +
         EventRaw::POS_OF_UID_IN_HEADER)));
     if (uid != uCredUid_) {
         HIVIEW_LOGW("failed to verify the consistensy of uid: [%{public}" PRId32
             ", %{public}" PRId32 "]", uid, uCredUid_);
         return false;
     }
-    pid_t pid = static_cast<pid_t>(*(reinterpret_cast<uint32_t*>(msg + sizeof(int32_t) +
+    pid_t pid = static_cast<pid_t>(*(reinterpret_cast<const uint32_t*>(msg + sizeof(int32_t) +
         EventRaw::POS_OF_PID_IN_HEADER)));
     if (pid != uCredPid_) {
         HIVIEW_LOGW("failed to verify the consistensy of process id: [%{public}" PRId32
             ", %{public}" PRId32 "]", pid, uCredPid_);
         return false;
     }
-    msg[len] = '\0';
     return true;
 }
 
 int SocketDevice::ReceiveMsg(std::vector<std::shared_ptr<EventReceiver>> &receivers)
+{
+    if (isBatchRecv_) {
+        return ReceiveMsgInBatch(receivers);
+    }
+    return ReceiveMsgOneByOne(receivers);
+}
+
+void SocketDevice::PrepareBatchSlot(size_t index)
+{
+    uint8_t* slab = slabs_[index].get();
+    auto& iov = iovs_[index];
+    // leave one byte between header and body of the slab to hold the log flag
+    iov[0].iov_base = slab;
+    iov[0].iov_len = MSG_HEADER_SIZE;
+    iov[1].iov_base = slab + MSG_HEADER_SIZE + sizeof(uint8_t);
+    iov[1].iov_len = slabSizes_[index] - MSG_HEADER_SIZE - sizeof(uint8_t);
+    iov[2].iov_base = overflow_ + index * BUFFER_SIZE;
+    iov[2].iov_len = BUFFER_SIZE;
+
+    struct msghdr& msgh = msgs_[index].msg_hdr;
+    msgh.msg_name = nullptr;
+    msgh.msg_namelen = 0;
+    msgh.msg_iov = iov.data();
+    msgh.msg_iovlen = iov.size();
+    msgh.msg_control = controls_.data() + index * CONTROL_SIZE;
+    msgh.msg_controllen = CONTROL_SIZE;
+    msgh.msg_flags = 0;
+    msgs_[index].msg_len = 0;
+}
+
+std::shared_ptr<EventRaw::RawData> SocketDevice::TakeBatchSlot(size_t index, uint32_t len)
+{
+    uint32_t desLen = len + sizeof(uint8_t);
+    size_t slabSize = slabSizes_[index];
+    if (desLen <= slabSize) {
+        uint8_t* slab = slabs_[index].get();
+        *(slab + MSG_HEADER_SIZE) = 0; // init header.log flag
+        *(reinterpret_cast<int32_t*>(slab)) = static_cast<int32_t>(desLen);
+        return std::make_shared<EventRaw::RawData>(std::move(slabs_[index]), desLen, slabSize);
+    }
+
+    // the tail of an event larger than the slab has been scattered into the overflow area, join them together
+    uint8_t* overflow = overflow_ + index * BUFFER_SIZE;
+    std::unique_ptr<uint8_t[]> des(new(std::nothrow) uint8_t[desLen]);
+    if (des == nullptr ||
+        memcpy_s(des.get(), desLen, slabs_[index].get(), slabSize) != EOK ||
+        memcpy_s(des.get() + slabSize, desLen - slabSize, overflow, desLen - slabSize) != EOK) {
+        HIVIEW_LOGE("failed to join oversized event, len=%{public}u", len);
+        des = nullptr;
+    }
+    (void)madvise(overflow, BUFFER_SIZE, MADV_DONTNEED);
+    // the slab is too small for the events of now, so it is replaced by one of the refill size class
+    slabs_[index].reset();
+    if (des == nullptr) {
+        return nullptr;
+    }
+    recvStat_.copiedBytes += desLen;
+    *(des.get() + MSG_HEADER_SIZE) = 0; // init header.log flag
+    *(reinterpret_cast<int32_t*>(des.get())) = static_cast<int32_t>(desLen);
+    return std::make_shared<EventRaw::RawData>(std::move(des), desLen, desLen);
+}
+
+void SocketDevice::DispatchRawData(std::shared_ptr<EventRaw::RawData> rawData,
+    std::vector<std::shared_ptr<EventReceiver>> &receivers)
+{
+    if (rawData == nullptr || receivers.empty()) {
+        return;
+    }
+    // sys event updates its raw data in place, so only the last receiver takes over the received buffer
+    for (size_t i = 0; i + 1 < receivers.size(); ++i) {
+        receivers[i]->HandlerSourceEvent(std::make_shared<EventRaw::RawData>(*rawData), socketName_);
+        recvStat_.copiedBytes += rawData->GetDataLength();
+    }
+    receivers.back()->HandlerSourceEvent(rawData, socketName_);
+}
+
+int SocketDevice::ReceiveMsgInBatch(std::vector<std::shared_ptr<EventReceiver>> &receivers)
+{
+    uint32_t eventCount = 0;
+    while (true) {
+        size_t vlen = RECV_BATCH_SIZE;
+        if (eventCountPerCycle_ != 0) {
+            vlen = std::min(vlen, static_cast<size_t>(eventCountPerCycle_ - eventCount));
+        }
+        for (size_t i = 0; i < vlen; ++i) {
+            if (slabs_[i] == nullptr && !AllocSlab(i)) {
+                vlen = i;
+                break;
+            }
+            PrepareBatchSlot(i);
+        }
+        if (vlen == 0) {
+            HIVIEW_LOGE("no slab to receive msg");
+            return -1;
+        }
+        int ret = recvmmsg(socketId_, msgs_.data(), vlen, MSG_DONTWAIT, nullptr);
+        ++recvStat_.recvCallCnt;
+        if (ret < 0 && errno == ENOSYS) {
+            HIVIEW_LOGW("recvmmsg is not supported, receive msg one by one");
+            isBatchRecv_ = false;
+            return ReceiveMsgOneByOne(receivers);
+        }
+        if (ret <= 0) {
+            HIVIEW_LOGD("failed to recv msg from socket");
+            break;
+        }
+        size_t maxDataLen = 0;
+        for (int i = 0; i < ret; ++i) {
+            struct msghdr& msgh = msgs_[i].msg_hdr;
+            if ((msgh.msg_flags & MSG_TRUNC) != 0) {
+                HIVIEW_LOGW("msg is truncated, len=%{public}u", msgs_[i].msg_len);
+                continue;
+            }
+            if (!ReadUcredInfoFromMsgh(msgh, uCredPid_, uCredUid_)) {
+                HIVIEW_LOGE("failed to read pid & uid from socket header");
+                continue;
+            }
+            int32_t len = static_cast<int32_t>(msgs_[i].msg_len);
+            if (!IsValidMsgHeader(reinterpret_cast<char*>(slabs_[i].get()), len)) {
+                continue;
+            }
+            maxDataLen = std::max(maxDataLen, static_cast<size_t>(len) + sizeof(uint8_t));
+            DispatchRawData(TakeBatchSlot(i, static_cast<uint32_t>(len)), receivers);
+            ++recvStat_.eventCnt;
+        }
+        // the slabs handed over are refilled in the size class of the largest event just received
+        if (maxDataLen > 0) {
+            refillSlabSize_ = GetSlabSizeClass(maxDataLen);
+        }
+        eventCount += static_cast<uint32_t>(ret);
+        if (static_cast<size_t>(ret) < vlen) {
+            break;
+        }
+        if (eventCountPerCycle_ != 0 && eventCount >= eventCountPerCycle_) {
+            HIVIEW_LOGD("reach cycle count: %{public}u, socket: %{public}s", eventCount, socketName_.c_str());
+            break;
+        }
+    }
+    return 0;
+}
+
+int SocketDevice::ReceiveMsgOneByOne(std::vector<std::shared_ptr<EventReceiver>> &receivers)
 {
     char* buffer = new char[BUFFER_SIZE + 1]();
     std::array<char, CMSG_SPACE(sizeof(struct ucred))> control = {0};
@@ -225,8 +459,11 @@ int SocketDevice::ReceiveMsg(std::vector<std::shared_ptr<EventReceiver>> &receiv
             break;
         }
         for (auto receiver = receivers.begin(); receiver != receivers.end(); receiver++) {
-            (*receiver)->HandlerEvent(ConverRawData(buffer));
+            (*receiver)->HandlerSourceEvent(ConverRawData(buffer), socketName_);
+            recvStat_.copiedBytes += static_cast<uint64_t>(ret + sizeof(uint8_t)) * 2; // 2: copied twice
         }
+        ++recvStat_.recvCallCnt;
+        ++recvStat_.eventCnt;
         ++eventCount;
         if (eventCountPerCycle_ != 0 && eventCount >= eventCountPerCycle_) {
             HIVIEW_LOGD("reach cycle count: %{public}u, socket: %{public}s", eventCount, socketName_.c_str());
@@ -298,7 +535,7 @@ int BBoxDevice::ReceiveMsg(std::vector<std::shared_ptr<EventReceiver>> &receiver
         return -1;
     }
     for (auto receiver = receivers.begin(); receiver != receivers.end(); receiver++) {
-        (*receiver)->HandlerEvent(ConverRawData(buffer));
+        (*receiver)->HandlerSourceEvent(ConverRawData(buffer), GetName());
     }
     return 0;
 }
@@ -390,6 +627,7 @@ void EventServer::Start()
                 it->second->ReceiveMsg(receivers_);
             }
         }
+        Throttle();
     }
     close(pollFd);
     CloseDevs();
@@ -411,5 +649,26 @@ void EventServer::AddReceiver(std::shared_ptr<EventReceiver> receiver)
 {
     receivers_.emplace_back(receiver);
 }
+
+void EventServer::SetPressureGetter(std::function<uint32_t()> pressureGetter)
+{
+    pressureGetter_ = pressureGetter;
+}
+
+void EventServer::Throttle()
+{
+    if (pressureGetter_ == nullptr) {
+        return;
+    }
+    uint32_t pressure = pressureGetter_();
+    if (pressure <= THROTTLE_PRESSURE_PCT) {
+        return;
+    }
+    // leave the pending events in the socket buffers for a while, rather than taking them into memory
+    uint32_t delay = MAX_THROTTLE_DELAY_MS * (std::min(pressure, FULL_PRESSURE_PCT) - THROTTLE_PRESSURE_PCT) /
+        (FULL_PRESSURE_PCT - THROTTLE_PRESSURE_PCT);
+    HIVIEW_LOGD("throttle %{public}u ms for pressure %{public}u", delay, pressure);
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+}
 } // namespace HiviewDFX
 } // namespace OHOS
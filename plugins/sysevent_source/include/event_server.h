@@ -16,11 +16,15 @@
 #ifndef COER_EVENT_SERVER_H
 #define COER_EVENT_SERVER_H
 
+#include <array>
 #include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <vector>
 
 #include "device_node.h"
@@ -29,27 +33,65 @@ struct epoll_event;
 namespace OHOS {
 namespace HiviewDFX {
 constexpr int UN_INIT_INT_TYPE_VAL = -1;
+constexpr size_t RECV_BATCH_SIZE = 16;
+constexpr size_t RECV_IOV_CNT = 3; // header, body in slab, tail of oversized event
+
+struct SocketRecvStat {
+    uint64_t eventCnt = 0;
+    uint64_t recvCallCnt = 0;
+    uint64_t copiedBytes = 0;
+    uint64_t slabAllocCnt = 0;
+    uint64_t slabBytes = 0;
+};
+
 class SocketDevice : public DeviceNode {
 public:
-    SocketDevice(const std::string& socketName, uint8_t eventCountPerCycle)
-        : socketName_(socketName), eventCountPerCycle_(eventCountPerCycle) {};
-    virtual ~SocketDevice() {};
+    SocketDevice(const std::string& socketName, uint8_t eventCountPerCycle, bool isBatchRecv = true)
+        : socketName_(socketName), eventCountPerCycle_(eventCountPerCycle), isBatchRecv_(isBatchRecv) {};
+    virtual ~SocketDevice();
     int Close() override;
     int Open() override;
     uint32_t GetEvents() override;
     std::string GetName() override;
     int ReceiveMsg(std::vector<std::shared_ptr<EventReceiver>> &receivers) override;
     bool IsValidMsg(char* msg, int32_t len) override;
+    SocketRecvStat GetRecvStat() const;
+
+protected:
+    bool InitSlabRing();
+    void ReleaseSlabRing();
 
 private:
     void InitSocket(int &socketId);
+    bool IsValidMsgHeader(const char* msg, int32_t len);
+    int ReceiveMsgOneByOne(std::vector<std::shared_ptr<EventReceiver>> &receivers);
+    int ReceiveMsgInBatch(std::vector<std::shared_ptr<EventReceiver>> &receivers);
+    bool AllocSlab(size_t index);
+    void PrepareBatchSlot(size_t index);
+    std::shared_ptr<EventRaw::RawData> TakeBatchSlot(size_t index, uint32_t len);
+    void DispatchRawData(std::shared_ptr<EventRaw::RawData> rawData,
+        std::vector<std::shared_ptr<EventReceiver>> &receivers);
 
-private:
+protected:
     int socketId_ = UN_INIT_INT_TYPE_VAL;
+
+private:
     pid_t uCredPid_ = 0;
     uid_t uCredUid_ = 0;
     std::string socketName_;
     uint8_t eventCountPerCycle_;
+    bool isBatchRecv_ = true;
+    SocketRecvStat recvStat_;
+
+    // preallocated receive slabs, a slab is handed over to the raw data of the event received into it and
+    // refilled before the next receiving, only the event larger than its slab is copied
+    std::array<std::unique_ptr<uint8_t[]>, RECV_BATCH_SIZE> slabs_;
+    std::array<size_t, RECV_BATCH_SIZE> slabSizes_ {};
+    size_t refillSlabSize_ = 0;
+    std::array<struct mmsghdr, RECV_BATCH_SIZE> msgs_ {};
+    std::array<std::array<struct iovec, RECV_IOV_CNT>, RECV_BATCH_SIZE> iovs_ {};
+    std::vector<char> controls_;
+    uint8_t* overflow_ = nullptr;
 };
 
 class BBoxDevice : public DeviceNode {
@@ -75,14 +117,17 @@ public:
     void Start();
     void Stop();
     void AddReceiver(std::shared_ptr<EventReceiver> receiver);
+    void SetPressureGetter(std::function<uint32_t()> pressureGetter);
 private:
     void AddDev(std::shared_ptr<DeviceNode> dev);
     int OpenDevs();
     void CloseDevs();
     int AddToMonitor(int pollFd, struct epoll_event pollEvents[]);
+    void Throttle();
     std::map<int, std::shared_ptr<DeviceNode>> devs_;
     std::vector<std::shared_ptr<EventReceiver>> receivers_;
     std::atomic<bool> isStart_;
+    std::function<uint32_t()> pressureGetter_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -49,13 +49,29 @@ struct PerfMeasure {
     uint32_t overProcessTotalCount;
     uint32_t realPercent;
     uint32_t processpercent;
+    uint32_t maxPressure;
+    uint32_t shedCount;
+    uint64_t shedSize;
+};
+
+struct FlowControlStat {
+    uint32_t pressure = 0;
+    uint32_t maxPressure = 0;
+    uint32_t shedCount = 0;
+    uint64_t shedSize = 0;
+    std::map<std::string, int64_t> sourceInflightSizes;
+    std::map<std::string, int64_t> domainInflightSizes;
+    std::map<std::string, uint32_t> domainShedCounts;
 };
 
 class PlatformMonitor {
 public:
-    PlatformMonitor(): maxTotalCount_(0), maxTotalSize_(0), looper_(nullptr) {}
+    PlatformMonitor(): maxTotalCount_(0), maxTotalSize_(0), inflightSize_(0), maxPressure_(0), looper_(nullptr) {}
     ~PlatformMonitor() {}
-    void Breaking();
+    bool AcquireCredit(const std::string& source, const std::string& domain, int eventType, uint32_t size);
+    void ReleaseCredit(const std::string& source, const std::string& domain, uint32_t size);
+    uint32_t GetPressure();
+    FlowControlStat GetFlowControlStat();
     void CollectCostTime(PipelineEvent *event);
     void CollectEvent(std::shared_ptr<PipelineEvent> event);
     void CollectPerfProfiler();
@@ -73,9 +89,12 @@ private:
     void GetMaxSpeed(PerfMeasure &perfMeasure) const;
     void GetMaxTotalMeasure(PerfMeasure &perfMeasure);
     void GetBreakStat(PerfMeasure &perfMeasure);
+    void GetFlowControlMeasure(PerfMeasure &perfMeasure);
     void GetTopDomains(std::vector<std::string> &domains, std::vector<uint32_t> &counts);
     void GetTopEvents(std::vector<std::string> &events, std::vector<uint32_t> &counts);
     void InitData();
+    bool IsSheddable(const std::string& domain, int eventType, uint32_t pressure);
+    void UpdateBreakState(uint32_t pressure);
 
 private:
     static constexpr uint8_t PCT = 100;
@@ -106,6 +125,17 @@ private:
     uint64_t recoverTimestamp_ = 0;
     uint8_t breakCount_ = 0;
     uint64_t breakDuration_ = 0;
+    std::atomic<bool> isBreaking_ = false;
+
+    // flow control, the credit of an event is taken when it is received and given back when it is released
+    std::mutex creditMutex_;
+    std::atomic<int64_t> inflightSize_;
+    std::atomic<uint32_t> maxPressure_;
+    uint32_t shedCount_ = 0;
+    uint64_t shedSize_ = 0;
+    std::map<std::string, int64_t> sourceInflightSizes_;
+    std::map<std::string, int64_t> domainInflightSizes_;
+    std::map<std::string, uint32_t> domainShedCounts_;
 
     // over brenchmark
     uint32_t finishedCount_ = 0;
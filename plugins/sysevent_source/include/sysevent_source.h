@@ -32,6 +32,7 @@ public:
     explicit SysEventReceiver(SysEventSource& source): eventSource(source) {};
     ~SysEventReceiver() override {};
     void HandlerEvent(std::shared_ptr<EventRaw::RawData> rawData) override;
+    void HandlerSourceEvent(std::shared_ptr<EventRaw::RawData> rawData, const std::string& source) override;
 private:
     SysEventSource& eventSource;
 };
@@ -44,6 +45,8 @@ public:
     void Recycle(PipelineEvent *event) override;
     void PauseDispatch(std::weak_ptr<Plugin> plugin) override;
     bool PublishPipelineEvent(std::shared_ptr<PipelineEvent> event);
+    std::shared_ptr<PipelineEvent> CreateSysEvent(std::shared_ptr<EventRaw::RawData> rawData,
+        const std::string& source);
 
 private:
     EventServer eventServer_;
@@ -34,7 +34,23 @@ namespace OHOS {
 namespace HiviewDFX {
 DEFINE_LOG_TAG("HiView-Monitor");
 namespace {
-constexpr uint8_t SLEEP_TEN_SECONDS = 10;
+// low priority events of the domains holding no less than their fair share of the in-flight size are shed first
+constexpr uint32_t SHED_PRESSURE_PCT = 80;
+// any event is shed to keep memory bounded
+constexpr uint32_t HARD_LIMIT_PRESSURE_PCT = 120;
+constexpr uint32_t RECOVER_PRESSURE_PCT = 80;
+
+void ReleaseInflightSize(std::map<std::string, int64_t>& inflightSizes, const std::string& key, uint32_t size)
+{
+    auto it = inflightSizes.find(key);
+    if (it == inflightSizes.end()) {
+        return;
+    }
+    it->second -= static_cast<int64_t>(size);
+    if (it->second <= 0) {
+        inflightSizes.erase(it);
+    }
+}
 };
 
 void PlatformMonitor::AccumulateTimeInterval(uint64_t costTime, std::map<int8_t, uint32_t> &stat)
@@ -220,6 +236,19 @@ void PlatformMonitor::GetBreakStat(PerfMeasure &perfMeasure)
     breakDuration_ = 0;
 }
 
+void PlatformMonitor::GetFlowControlMeasure(PerfMeasure &perfMeasure)
+{
+    perfMeasure.maxPressure = maxPressure_.exchange(0);
+
+    std::lock_guard<std::mutex> lock(creditMutex_);
+    perfMeasure.shedCount = shedCount_;
+    shedCount_ = 0;
+
+    perfMeasure.shedSize = shedSize_;
+    shedSize_ = 0;
+    domainShedCounts_.clear();
+}
+
 void PlatformMonitor::GetMaxSpeed(PerfMeasure &perfMeasure) const
 {
     perfMeasure.minSpeed = minSpeed_;
@@ -249,6 +278,9 @@ void PlatformMonitor::ReportProfile(const PerfMeasure& perfMeasure)
         BUILD_PARAM("OVER_REAL_PCT", HISYSEVENT_UINT32, ui32, perfMeasure.realPercent),
         BUILD_PARAM("OVER_PROC_COUNT", HISYSEVENT_UINT32, ui32, perfMeasure.overProcessTotalCount),
         BUILD_PARAM("OVER_PROC_PCT", HISYSEVENT_UINT32, ui32, perfMeasure.processpercent),
+        BUILD_PARAM("MAX_PRESSURE", HISYSEVENT_UINT32, ui32, perfMeasure.maxPressure),
+        BUILD_PARAM("SHED_COUNT", HISYSEVENT_UINT32, ui32, perfMeasure.shedCount),
+        BUILD_PARAM("SHED_SIZE", HISYSEVENT_UINT64, ui64, perfMeasure.shedSize),
     };
     int ret = OH_HiSysEvent_Write(HiSysEvent::Domain::HIVIEWDFX, "PROFILE_STAT", HISYSEVENT_STATISTIC,
         params, sizeof(params) / sizeof(HiSysEventParam));
@@ -269,6 +301,9 @@ void PlatformMonitor::ReportCycleProfile()
     // report total number of event, time of break, duration of break
     GetBreakStat(perfMeasure);
 
+    // report max pressure, number and size of the shed events
+    GetFlowControlMeasure(perfMeasure);
+
     // report min speed, max speed
     GetMaxSpeed(perfMeasure);
 
@@ -400,28 +435,99 @@ void PlatformMonitor::ReportRecoverProfile()
     }
 }
 
-void PlatformMonitor::Breaking()
+uint32_t PlatformMonitor::GetPressure()
 {
-    // collect break count and duration every break
-    if (SysEvent::totalSize_ <= totalSizeBenchMark_) {
+    int64_t totalSize = std::max(SysEvent::totalSize_.load(), inflightSize_.load());
+    if (totalSize <= 0 || totalSizeBenchMark_ == 0) {
+        return 0;
+    }
+    uint32_t pressure = static_cast<uint32_t>(totalSize * PCT / totalSizeBenchMark_);
+    uint32_t maxPressure = maxPressure_.load();
+    while (maxPressure < pressure && !maxPressure_.compare_exchange_weak(maxPressure, pressure)) {
+    }
+    return pressure;
+}
+
+bool PlatformMonitor::IsSheddable(const std::string& domain, int eventType, uint32_t pressure)
+{
+    if (pressure >= HARD_LIMIT_PRESSURE_PCT) {
+        return true;
+    }
+    if (eventType == SysEventCreator::FAULT || eventType == SysEventCreator::SECURITY) {
+        return false;
+    }
+    if (pressure >= PCT) {
+        return true;
+    }
+    auto it = domainInflightSizes_.find(domain);
+    if (it == domainInflightSizes_.end()) {
+        return false;
+    }
+    return it->second * static_cast<int64_t>(domainInflightSizes_.size()) >= inflightSize_.load();
+}
+
+void PlatformMonitor::UpdateBreakState(uint32_t pressure)
+{
+    // events are shed instead of blocking the pipeline since the break, till the pressure falls back.
+    // only the thread switching the state reports it
+    bool isBreaking = false;
+    if (pressure >= PCT && isBreaking_.compare_exchange_strong(isBreaking, true)) {
+        HIVIEW_LOGE("break as event reach critical size %{public}" PRId64, SysEvent::totalSize_.load());
+        breakTimestamp_ = TimeUtil::GenerateTimestamp();
+        ReportBreakProfile();
         return;
     }
+    isBreaking = true;
+    if (pressure <= RECOVER_PRESSURE_PCT && isBreaking_.compare_exchange_strong(isBreaking, false)) {
+        breakCount_++;
+        recoverTimestamp_ = TimeUtil::GenerateTimestamp();
+        breakDuration_ += recoverTimestamp_ - breakTimestamp_;
+        HIVIEW_LOGW("recover after break duration %{public}" PRIu64, breakDuration_);
+        ReportRecoverProfile();
+    }
+}
 
-    HIVIEW_LOGE("break as event reach critical size %{public}" PRId64, SysEvent::totalSize_.load());
-    breakTimestamp_ = TimeUtil::GenerateTimestamp();
-    ReportBreakProfile();
-    int64_t recoveryBenchMark = static_cast<int64_t>(totalSizeBenchMark_ * 0.8); // 0.8 of total size will recover
-    while (true) {
-        if (SysEvent::totalSize_ <= recoveryBenchMark) {
-            break;
-        }
-        TimeUtil::Sleep(SLEEP_TEN_SECONDS);
+bool PlatformMonitor::AcquireCredit(const std::string& source, const std::string& domain, int eventType,
+    uint32_t size)
+{
+    uint32_t pressure = GetPressure();
+    UpdateBreakState(pressure);
+
+    std::lock_guard<std::mutex> lock(creditMutex_);
+    if (pressure >= SHED_PRESSURE_PCT && IsSheddable(domain, eventType, pressure)) {
+        HIVIEW_LOGD("shed event of %{public}s from %{public}s for pressure %{public}u",
+            domain.c_str(), source.c_str(), pressure);
+        shedCount_++;
+        shedSize_ += size;
+        domainShedCounts_[domain]++;
+        return false;
     }
-    breakCount_++;
-    recoverTimestamp_ = TimeUtil::GenerateTimestamp();
-    breakDuration_ += recoverTimestamp_ - breakTimestamp_;
-    HIVIEW_LOGW("recover after break duration %{public}" PRIu64, breakDuration_);
-    ReportRecoverProfile();
+    inflightSize_ += static_cast<int64_t>(size);
+    sourceInflightSizes_[source] += static_cast<int64_t>(size);
+    domainInflightSizes_[domain] += static_cast<int64_t>(size);
+    return true;
+}
+
+void PlatformMonitor::ReleaseCredit(const std::string& source, const std::string& domain, uint32_t size)
+{
+    std::lock_guard<std::mutex> lock(creditMutex_);
+    inflightSize_ -= static_cast<int64_t>(size);
+    ReleaseInflightSize(sourceInflightSizes_, source, size);
+    ReleaseInflightSize(domainInflightSizes_, domain, size);
+}
+
+FlowControlStat PlatformMonitor::GetFlowControlStat()
+{
+    FlowControlStat stat;
+    stat.pressure = GetPressure();
+    stat.maxPressure = maxPressure_.load();
+    std::lock_guard<std::mutex> lock(creditMutex_);
+    stat.shedCount = shedCount_;
+    stat.shedSize = shedSize_;
+    stat.sourceInflightSizes = sourceInflightSizes_;
+    stat.domainInflightSizes = domainInflightSizes_;
+    stat.domainShedCounts = domainShedCounts_;
+    return stat;
 }
 
 void PlatformMonitor::InitData()
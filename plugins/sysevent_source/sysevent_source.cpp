@@ -15,6 +15,8 @@
 
 #include "sysevent_source.h"
 
+#include <cstring>
+
 #include "event_json_parser.h"
 #include "hiview_logger.h"
 #include "hiview_platform.h"
@@ -25,15 +27,25 @@ namespace OHOS {
 namespace HiviewDFX {
 REGISTER(SysEventSource);
 DEFINE_LOG_TAG("SysEventSource");
+namespace {
+const std::string UNKNOWN_SOURCE = "unknown";
+}
 
 void SysEventReceiver::HandlerEvent(std::shared_ptr<EventRaw::RawData> rawData)
+{
+    HandlerSourceEvent(rawData, UNKNOWN_SOURCE);
+}
+
+void SysEventReceiver::HandlerSourceEvent(std::shared_ptr<EventRaw::RawData> rawData, const std::string& source)
 {
     if (rawData == nullptr || rawData->GetData() == nullptr) {
         HIVIEW_LOGW("raw data of sys event is null");
         return;
     }
-    std::shared_ptr<PipelineEvent> event = std::make_shared<SysEvent>("SysEventSource",
-        static_cast<PipelineEventProducer*>(&eventSource), rawData);
+    std::shared_ptr<PipelineEvent> event = eventSource.CreateSysEvent(rawData, source);
+    if (event == nullptr) {
+        return;
+    }
     eventSource.PublishPipelineEvent(event);
 }
 
@@ -60,6 +72,9 @@ void SysEventSource::StartEventSource()
     EventJsonParser::GetInstance()->ReadDefFile();
     std::shared_ptr<EventReceiver> sysEventReceiver = std::make_shared<SysEventReceiver>(*this);
     eventServer_.AddReceiver(sysEventReceiver);
+    eventServer_.SetPressureGetter([this] {
+        return platformMonitor_.GetPressure();
+    });
     eventServer_.Start();
 }
 
@@ -76,10 +91,35 @@ void SysEventSource::PauseDispatch(std::weak_ptr<Plugin> plugin)
     }
 }
 
+std::shared_ptr<PipelineEvent> SysEventSource::CreateSysEvent(std::shared_ptr<EventRaw::RawData> rawData,
+    const std::string& source)
+{
+    if (rawData->GetDataLength() < EventRaw::GetValidDataMinimumByteCount()) {
+        return std::make_shared<SysEvent>("SysEventSource", static_cast<PipelineEventProducer*>(this), rawData);
+    }
+    auto header = reinterpret_cast<EventRaw::HiSysEventHeader*>(rawData->GetData() + sizeof(int32_t));
+    std::string domain(header->domain, strnlen(header->domain, sizeof(header->domain)));
+    int eventType = static_cast<int>(header->type) + 1; // 1: the type in header starts from 0
+    uint32_t size = static_cast<uint32_t>(rawData->GetDataLength());
+    if (!platformMonitor_.AcquireCredit(source, domain, eventType, size)) {
+        return nullptr;
+    }
+    SysEvent* sysEvent = new(std::nothrow) SysEvent("SysEventSource",
+        static_cast<PipelineEventProducer*>(this), rawData);
+    if (sysEvent == nullptr) {
+        platformMonitor_.ReleaseCredit(source, domain, size);
+        return nullptr;
+    }
+    // the credit is given back once the last reference to the event is released
+    return std::shared_ptr<PipelineEvent>(sysEvent, [this, source, domain, size] (SysEvent* event) {
+        delete event;
+        platformMonitor_.ReleaseCredit(source, domain, size);
+    });
+}
+
 bool SysEventSource::PublishPipelineEvent(std::shared_ptr<PipelineEvent> event)
 {
     platformMonitor_.CollectEvent(event);
-    platformMonitor_.Breaking();
 
     auto context = GetHiviewContext();
     HiviewPlatform* hiviewPlatform = static_cast<HiviewPlatform*>(context);
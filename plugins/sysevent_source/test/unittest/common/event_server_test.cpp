@@ -14,14 +14,144 @@
  */
 #include "event_server_test.h"
 
+#include <chrono>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <securec.h>
+
+#include "base/raw_data_base_def.h"
 #include "event_server.h"
 #include "file_util.h"
+#include "platform_monitor.h"
 
 using namespace testing::ext;
 using namespace OHOS::HiviewDFX;
 
 namespace {
 const std::string BBOX_PATH = "/dev/bbox";
+constexpr size_t MSG_HEADER_SIZE = sizeof(int32_t) + sizeof(EventRaw::HiSysEventHeader) - sizeof(uint8_t);
+constexpr size_t SMALL_BODY_SIZE = 200;
+constexpr size_t MEDIUM_BODY_SIZE = 1500;
+constexpr size_t OVERSIZED_BODY_SIZE = 8 * 1024;
+
+class TestSocketDevice : public SocketDevice {
+public:
+    TestSocketDevice(int socketId, uint8_t eventCountPerCycle, bool isBatchRecv)
+        : SocketDevice("test_socket", eventCountPerCycle, isBatchRecv)
+    {
+        socketId_ = socketId;
+        if (isBatchRecv) {
+            InitSlabRing();
+        }
+    }
+
+    int Open() override
+    {
+        return socketId_;
+    }
+
+    int Close() override
+    {
+        ReleaseSlabRing();
+        return 0;
+    }
+};
+
+class TestEventReceiver : public EventReceiver {
+public:
+    void HandlerEvent(std::shared_ptr<EventRaw::RawData> rawData) override
+    {
+        rawDatas.emplace_back(rawData);
+    }
+
+    std::vector<std::shared_ptr<EventRaw::RawData>> rawDatas;
+};
+
+std::vector<uint8_t> BuildSocketMsg(size_t bodySize)
+{
+    std::vector<uint8_t> msg(MSG_HEADER_SIZE + bodySize, 0);
+    *(reinterpret_cast<int32_t*>(msg.data())) = static_cast<int32_t>(msg.size());
+    auto header = reinterpret_cast<EventRaw::HiSysEventHeader*>(msg.data() + sizeof(int32_t));
+    (void)strcpy_s(header->domain, sizeof(header->domain), "TEST_DOMAIN");
+    (void)strcpy_s(header->name, sizeof(header->name), "TEST_NAME");
+    header->uid = static_cast<uint32_t>(getuid());
+    header->pid = static_cast<uint32_t>(getpid());
+    for (size_t i = MSG_HEADER_SIZE; i < msg.size(); ++i) {
+        msg[i] = static_cast<uint8_t>(i);
+    }
+    return msg;
+}
+
+bool CreateSocketPair(int fds[2])
+{
+    if (socketpair(AF_UNIX, SOCK_DGRAM, 0, fds) != 0) {
+        return false;
+    }
+    int passCred = 1;
+    (void)setsockopt(fds[0], SOL_SOCKET, SO_PASSCRED, &passCred, sizeof(passCred));
+    (void)fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    return true;
+}
+
+bool IsSameAsSocketMsg(std::shared_ptr<EventRaw::RawData> rawData, const std::vector<uint8_t>& msg)
+{
+    if (rawData == nullptr || rawData->GetDataLength() != msg.size() + sizeof(uint8_t)) {
+        return false;
+    }
+    uint8_t* data = rawData->GetData();
+    return *(reinterpret_cast<int32_t*>(data)) == static_cast<int32_t>(msg.size() + sizeof(uint8_t)) &&
+        memcmp(data + sizeof(int32_t), msg.data() + sizeof(int32_t), MSG_HEADER_SIZE - sizeof(int32_t)) == 0 &&
+        data[MSG_HEADER_SIZE] == 0 &&
+        memcmp(data + MSG_HEADER_SIZE + 1, msg.data() + MSG_HEADER_SIZE, msg.size() - MSG_HEADER_SIZE) == 0;
+}
+
+void SendAndReceive(int fd, TestSocketDevice& device, const std::vector<uint8_t>& msg, size_t sendCnt)
+{
+    auto receiver = std::make_shared<TestEventReceiver>();
+    std::vector<std::shared_ptr<EventReceiver>> receivers = {receiver};
+    for (size_t i = 0; i < sendCnt; ++i) {
+        ASSERT_EQ(send(fd, msg.data(), msg.size(), 0), static_cast<ssize_t>(msg.size()));
+    }
+    ASSERT_EQ(device.ReceiveMsg(receivers), 0);
+    ASSERT_EQ(receiver->rawDatas.size(), sendCnt);
+    for (const auto& rawData : receiver->rawDatas) {
+        ASSERT_TRUE(IsSameAsSocketMsg(rawData, msg));
+    }
+}
+
+void RunReceiveBenchmark(bool isBatchRecv, size_t bodySize)
+{
+    int fds[2] = {-1, -1};
+    ASSERT_TRUE(CreateSocketPair(fds));
+    TestSocketDevice device(fds[0], 0, isBatchRecv);
+    auto receiver = std::make_shared<TestEventReceiver>();
+    std::vector<std::shared_ptr<EventReceiver>> receivers = {receiver};
+    auto msg = BuildSocketMsg(bodySize);
+    constexpr int roundCnt = 500;
+    constexpr int eventCntPerRound = 64;
+    std::chrono::nanoseconds cost(0);
+    for (int round = 0; round < roundCnt; ++round) {
+        for (int i = 0; i < eventCntPerRound; ++i) {
+            ASSERT_EQ(send(fds[1], msg.data(), msg.size(), 0), static_cast<ssize_t>(msg.size()));
+        }
+        auto begin = std::chrono::steady_clock::now();
+        device.ReceiveMsg(receivers);
+        cost += std::chrono::steady_clock::now() - begin;
+        receiver->rawDatas.clear();
+    }
+    SocketRecvStat stat = device.GetRecvStat();
+    ASSERT_EQ(stat.eventCnt, static_cast<uint64_t>(roundCnt * eventCntPerRound));
+    double seconds = std::chrono::duration<double>(cost).count();
+    printf("%s receive of %zu bytes: %.0f events/s, %.1f bytes copied/event, %.1f slab bytes/event, "
+        "%.2f events/syscall\n", isBatchRecv ? "batch" : "legacy", msg.size(), stat.eventCnt / seconds,
+        static_cast<double>(stat.copiedBytes) / stat.eventCnt, static_cast<double>(stat.slabBytes) / stat.eventCnt,
+        static_cast<double>(stat.eventCnt) / stat.recvCallCnt);
+    device.Close();
+    close(fds[0]);
+    close(fds[1]);
+}
 }
 
 void EventServerTest::SetUp()
@@ -51,3 +181,159 @@ HWTEST_F(EventServerTest, EventServerTest001, TestSize.Level3)
     res = bbox.Close();
     ASSERT_TRUE(res >= 0);
 }
+
+/**
+ * @tc.name: EventServerTest002
+ * @tc.desc: SocketDevice receives events in batch without copying them.
+ * @tc.type: FUNC
+ * @tc.require: issueI5NULM
+ */
+HWTEST_F(EventServerTest, EventServerTest002, TestSize.Level1)
+{
+    int fds[2] = {-1, -1};
+    ASSERT_TRUE(CreateSocketPair(fds));
+    TestSocketDevice device(fds[0], 0, true);
+    auto receiver = std::make_shared<TestEventReceiver>();
+    std::vector<std::shared_ptr<EventReceiver>> receivers = {receiver};
+    std::vector<std::vector<uint8_t>> msgs = {
+        BuildSocketMsg(SMALL_BODY_SIZE), BuildSocketMsg(OVERSIZED_BODY_SIZE), BuildSocketMsg(1),
+        BuildSocketMsg(MEDIUM_BODY_SIZE),
+    };
+    for (const auto& msg : msgs) {
+        ASSERT_EQ(send(fds[1], msg.data(), msg.size(), 0), static_cast<ssize_t>(msg.size()));
+    }
+    ASSERT_EQ(device.ReceiveMsg(receivers), 0);
+    ASSERT_EQ(receiver->rawDatas.size(), msgs.size());
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        ASSERT_TRUE(IsSameAsSocketMsg(receiver->rawDatas[i], msgs[i]));
+    }
+    SocketRecvStat stat = device.GetRecvStat();
+    ASSERT_EQ(stat.eventCnt, msgs.size());
+    ASSERT_EQ(stat.copiedBytes, msgs[1].size() + sizeof(uint8_t)); // only the oversized one is copied
+    device.Close();
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/**
+ * @tc.name: EventServerTest003
+ * @tc.desc: SocketDevice stops batch receiving when reaching event count per cycle.
+ * @tc.type: FUNC
+ * @tc.require: issueI5NULM
+ */
+HWTEST_F(EventServerTest, EventServerTest003, TestSize.Level1)
+{
+    int fds[2] = {-1, -1};
+    ASSERT_TRUE(CreateSocketPair(fds));
+    constexpr uint8_t eventCountPerCycle = 20;
+    TestSocketDevice device(fds[0], eventCountPerCycle, true);
+    auto receiver = std::make_shared<TestEventReceiver>();
+    std::vector<std::shared_ptr<EventReceiver>> receivers = {receiver};
+    auto msg = BuildSocketMsg(SMALL_BODY_SIZE);
+    constexpr size_t sendCnt = 30;
+    for (size_t i = 0; i < sendCnt; ++i) {
+        ASSERT_EQ(send(fds[1], msg.data(), msg.size(), 0), static_cast<ssize_t>(msg.size()));
+    }
+    device.ReceiveMsg(receivers);
+    ASSERT_EQ(receiver->rawDatas.size(), eventCountPerCycle);
+    device.ReceiveMsg(receivers);
+    ASSERT_EQ(receiver->rawDatas.size(), sendCnt);
+    device.Close();
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/**
+ * @tc.name: EventServerTest004
+ * @tc.desc: SocketDevice hands every slab over and refills it in the size class of the events received.
+ * @tc.type: FUNC
+ * @tc.require: issueI5NULM
+ */
+HWTEST_F(EventServerTest, EventServerTest004, TestSize.Level1)
+{
+    int fds[2] = {-1, -1};
+    ASSERT_TRUE(CreateSocketPair(fds));
+    TestSocketDevice device(fds[0], 0, true);
+    constexpr size_t largeSlabSize = 2048; // 2048 : the largest slab size class
+    constexpr size_t smallSlabSize = 512; // 512 : the slab size class of the small event
+    ASSERT_EQ(device.GetRecvStat().slabAllocCnt, RECV_BATCH_SIZE);
+    ASSERT_EQ(device.GetRecvStat().slabBytes, RECV_BATCH_SIZE * largeSlabSize);
+
+    // the small events take over their slabs, which are refilled in a smaller size class
+    constexpr size_t eventCnt = 4;
+    SendAndReceive(fds[1], device, BuildSocketMsg(SMALL_BODY_SIZE), eventCnt);
+    SendAndReceive(fds[1], device, BuildSocketMsg(SMALL_BODY_SIZE), eventCnt);
+    ASSERT_EQ(device.GetRecvStat().slabAllocCnt, RECV_BATCH_SIZE + eventCnt);
+    ASSERT_EQ(device.GetRecvStat().slabBytes, RECV_BATCH_SIZE * largeSlabSize + eventCnt * smallSlabSize);
+    ASSERT_EQ(device.GetRecvStat().copiedBytes, 0U);
+
+    // the medium events are joined out of the small slabs, and the slabs are refilled in a larger size class
+    auto mediumMsg = BuildSocketMsg(MEDIUM_BODY_SIZE);
+    SendAndReceive(fds[1], device, mediumMsg, eventCnt);
+    ASSERT_EQ(device.GetRecvStat().copiedBytes, eventCnt * (mediumMsg.size() + sizeof(uint8_t)));
+    SendAndReceive(fds[1], device, mediumMsg, eventCnt);
+    ASSERT_EQ(device.GetRecvStat().copiedBytes, eventCnt * (mediumMsg.size() + sizeof(uint8_t)));
+    ASSERT_EQ(device.GetRecvStat().slabBytes,
+        RECV_BATCH_SIZE * largeSlabSize + eventCnt * smallSlabSize * 2 + eventCnt * largeSlabSize); // 2 : rounds
+    ASSERT_EQ(device.GetRecvStat().eventCnt, eventCnt * 4); // 4 : rounds of receiving
+    device.Close();
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/**
+ * @tc.name: EventServerTest005
+ * @tc.desc: PlatformMonitor sheds low priority events in proportion to the pressure of in-flight events.
+ * @tc.type: FUNC
+ * @tc.require: issueI5NULM
+ */
+HWTEST_F(EventServerTest, EventServerTest005, TestSize.Level1)
+{
+    PlatformMonitor monitor;
+    constexpr uint32_t heavySize = 170 * 1024 * 1024; // test value, 85% of the default benchmark
+    constexpr uint32_t extraSize = 40 * 1024 * 1024; // test value, 105% of the default benchmark in total
+    constexpr uint32_t lightSize = 1024; // test value
+    const std::string source = "test_socket";
+    ASSERT_TRUE(monitor.AcquireCredit(source, "DOMAIN_A", SysEventCreator::FAULT, heavySize));
+    ASSERT_EQ(monitor.GetPressure(), 85); // 85: percentage of the heavy size
+
+    // the domain holding most of the in-flight size is shed first
+    ASSERT_FALSE(monitor.AcquireCredit(source, "DOMAIN_A", SysEventCreator::STATISTIC, lightSize));
+    ASSERT_TRUE(monitor.AcquireCredit(source, "DOMAIN_B", SysEventCreator::STATISTIC, lightSize));
+
+    // all of the low priority events are shed when the pressure is full
+    ASSERT_TRUE(monitor.AcquireCredit(source, "DOMAIN_A", SysEventCreator::FAULT, extraSize));
+    ASSERT_FALSE(monitor.AcquireCredit(source, "DOMAIN_B", SysEventCreator::BEHAVIOR, lightSize));
+    ASSERT_TRUE(monitor.AcquireCredit(source, "DOMAIN_B", SysEventCreator::SECURITY, lightSize));
+
+    FlowControlStat stat = monitor.GetFlowControlStat();
+    ASSERT_GE(stat.pressure, 100); // 100: full pressure
+    ASSERT_EQ(stat.shedCount, 2); // 2: shed event count
+    ASSERT_EQ(stat.shedSize, lightSize * 2); // 2: shed event count
+    ASSERT_EQ(stat.domainShedCounts["DOMAIN_A"], 1);
+    ASSERT_EQ(stat.domainShedCounts["DOMAIN_B"], 1);
+    ASSERT_EQ(stat.sourceInflightSizes[source], static_cast<int64_t>(heavySize) + extraSize + lightSize * 2);
+
+    monitor.ReleaseCredit(source, "DOMAIN_A", heavySize);
+    monitor.ReleaseCredit(source, "DOMAIN_A", extraSize);
+    monitor.ReleaseCredit(source, "DOMAIN_B", lightSize);
+    monitor.ReleaseCredit(source, "DOMAIN_B", lightSize);
+    stat = monitor.GetFlowControlStat();
+    ASSERT_TRUE(stat.sourceInflightSizes.empty());
+    ASSERT_TRUE(stat.domainInflightSizes.empty());
+    ASSERT_TRUE(monitor.AcquireCredit(source, "DOMAIN_A", SysEventCreator::STATISTIC, lightSize));
+}
+
+/**
+ * @tc.name: EventServerTest006
+ * @tc.desc: benchmark of receiving events in batch and one by one.
+ * @tc.type: PERF
+ * @tc.require: issueI5NULM
+ */
+HWTEST_F(EventServerTest, EventServerTest006, TestSize.Level3)
+{
+    for (size_t bodySize : {SMALL_BODY_SIZE, MEDIUM_BODY_SIZE}) {
+        RunReceiveBenchmark(false, bodySize);
+        RunReceiveBenchmark(true, bodySize);
+    }
+}
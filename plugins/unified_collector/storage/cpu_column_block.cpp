@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_column_block.h"
+
+#include <cmath>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr uint32_t VARINT_PAYLOAD_BITS = 7;
+constexpr uint8_t VARINT_PAYLOAD_MASK = 0x7F;
+constexpr uint8_t VARINT_MORE_FLAG = 0x80;
+constexpr uint32_t MAX_VARINT_SHIFT = 63;
+
+uint64_t ZigZagEncode(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> MAX_VARINT_SHIFT);
+}
+
+int64_t ZigZagDecode(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void PutVarint(std::vector<uint8_t>& column, uint64_t value)
+{
+    while (value > VARINT_PAYLOAD_MASK) {
+        column.push_back(static_cast<uint8_t>(value & VARINT_PAYLOAD_MASK) | VARINT_MORE_FLAG);
+        value >>= VARINT_PAYLOAD_BITS;
+    }
+    column.push_back(static_cast<uint8_t>(value));
+}
+
+void PutSigned(std::vector<uint8_t>& column, int64_t value)
+{
+    PutVarint(column, ZigZagEncode(value));
+}
+
+class ColumnReader {
+public:
+    explicit ColumnReader(const std::vector<uint8_t>& column) : column_(column) {}
+
+    bool GetVarint(uint64_t& value)
+    {
+        value = 0;
+        for (uint32_t shift = 0; shift <= MAX_VARINT_SHIFT; shift += VARINT_PAYLOAD_BITS) {
+            if (pos_ >= column_.size()) {
+                return false;
+            }
+            uint8_t byte = column_[pos_++];
+            value |= static_cast<uint64_t>(byte & VARINT_PAYLOAD_MASK) << shift;
+            if ((byte & VARINT_MORE_FLAG) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool GetSigned(int64_t& value)
+    {
+        uint64_t encoded = 0;
+        if (!GetVarint(encoded)) {
+            return false;
+        }
+        value = ZigZagDecode(encoded);
+        return true;
+    }
+
+    bool IsEnd() const
+    {
+        return pos_ == column_.size();
+    }
+
+private:
+    const std::vector<uint8_t>& column_;
+    size_t pos_ = 0;
+};
+
+bool DecodeRow(std::array<ColumnReader, CPU_COLUMN_CNT>& readers, uint64_t& lastStartTime, int32_t& lastPid,
+    CpuColumnRow& row)
+{
+    int64_t startDelta = 0;
+    int64_t duration = 0;
+    int64_t pidDelta = 0;
+    int64_t procState = 0;
+    uint64_t nameId = 0;
+    int64_t threadCount = 0;
+    if (!readers[CPU_COLUMN_START_TIME].GetSigned(startDelta) || !readers[CPU_COLUMN_DURATION].GetSigned(duration) ||
+        !readers[CPU_COLUMN_PID].GetSigned(pidDelta) || !readers[CPU_COLUMN_PROC_STATE].GetSigned(procState) ||
+        !readers[CPU_COLUMN_NAME_ID].GetVarint(nameId) || !readers[CPU_COLUMN_CPU_LOAD].GetVarint(row.cpuLoad) ||
+        !readers[CPU_COLUMN_CPU_USAGE].GetVarint(row.cpuUsage) ||
+        !readers[CPU_COLUMN_THREAD_CNT].GetSigned(threadCount)) {
+        return false;
+    }
+    row.startTime = lastStartTime + static_cast<uint64_t>(startDelta);
+    row.endTime = row.startTime + static_cast<uint64_t>(duration);
+    row.pid = static_cast<int32_t>(lastPid + pidDelta);
+    row.procState = static_cast<int32_t>(procState);
+    row.nameId = static_cast<uint32_t>(nameId);
+    row.threadCount = static_cast<int32_t>(threadCount);
+    lastStartTime = row.startTime;
+    lastPid = row.pid;
+    return true;
+}
+}
+
+void CpuColumnBlock::Append(const CpuColumnRow& row)
+{
+    if (rowCount_ == 0) {
+        baseTime_ = row.startTime;
+        lastStartTime_ = row.startTime;
+        lastPid_ = 0;
+    }
+    PutSigned(columns_[CPU_COLUMN_START_TIME], static_cast<int64_t>(row.startTime - lastStartTime_));
+    PutSigned(columns_[CPU_COLUMN_DURATION], static_cast<int64_t>(row.endTime - row.startTime));
+    PutSigned(columns_[CPU_COLUMN_PID], static_cast<int64_t>(row.pid) - lastPid_);
+    PutSigned(columns_[CPU_COLUMN_PROC_STATE], row.procState);
+    PutVarint(columns_[CPU_COLUMN_NAME_ID], row.nameId);
+    PutVarint(columns_[CPU_COLUMN_CPU_LOAD], row.cpuLoad);
+    PutVarint(columns_[CPU_COLUMN_CPU_USAGE], row.cpuUsage);
+    PutSigned(columns_[CPU_COLUMN_THREAD_CNT], row.threadCount);
+    lastStartTime_ = row.startTime;
+    lastPid_ = row.pid;
+    rowCount_++;
+}
+
+void CpuColumnBlock::Clear()
+{
+    rowCount_ = 0;
+    baseTime_ = 0;
+    lastStartTime_ = 0;
+    lastPid_ = 0;
+    for (auto& column : columns_) {
+        column.clear();
+    }
+}
+
+uint32_t CpuColumnBlock::GetRowCount() const
+{
+    return rowCount_;
+}
+
+uint64_t CpuColumnBlock::GetBaseTime() const
+{
+    return baseTime_;
+}
+
+const CpuColumnData& CpuColumnBlock::GetColumns() const
+{
+    return columns_;
+}
+
+uint64_t CpuColumnBlock::ToFixedPoint(double value)
+{
+    if (!(value > 0)) {
+        return 0;
+    }
+    return static_cast<uint64_t>(std::floor(value * CPU_FIXED_POINT_SCALE));
+}
+
+double CpuColumnBlock::FromFixedPoint(uint64_t value)
+{
+    return static_cast<double>(value) / CPU_FIXED_POINT_SCALE;
+}
+
+bool CpuColumnBlock::Decode(uint64_t baseTime, uint32_t rowCount, const CpuColumnData& columns,
+    std::vector<CpuColumnRow>& rows)
+{
+    std::array<ColumnReader, CPU_COLUMN_CNT> readers = {
+        ColumnReader(columns[CPU_COLUMN_START_TIME]), ColumnReader(columns[CPU_COLUMN_DURATION]),
+        ColumnReader(columns[CPU_COLUMN_PID]), ColumnReader(columns[CPU_COLUMN_PROC_STATE]),
+        ColumnReader(columns[CPU_COLUMN_NAME_ID]), ColumnReader(columns[CPU_COLUMN_CPU_LOAD]),
+        ColumnReader(columns[CPU_COLUMN_CPU_USAGE]), ColumnReader(columns[CPU_COLUMN_THREAD_CNT]),
+    };
+    uint64_t lastStartTime = baseTime;
+    int32_t lastPid = 0;
+    rows.clear();
+    rows.reserve(rowCount);
+    for (uint32_t i = 0; i < rowCount; i++) {
+        CpuColumnRow row;
+        if (!DecodeRow(readers, lastStartTime, lastPid, row)) {
+            return false;
+        }
+        rows.push_back(row);
+    }
+    for (const auto& reader : readers) {
+        if (!reader.IsEnd()) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
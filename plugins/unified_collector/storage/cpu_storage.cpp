@@ -14,7 +14,9 @@
  */
 #include "cpu_storage.h"
 
-#include <dirent.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
 
 #include "file_util.h"
 #include "hisysevent_util.h"
@@ -27,17 +29,20 @@
 #include "process_status.h"
 #include "rdb_predicates.h"
 #include "sql_util.h"
-#include "string_util.h"
 
 namespace OHOS {
 namespace HiviewDFX {
 DEFINE_LOG_TAG("HiView-CpuStorage");
 using namespace OHOS::HiviewDFX::UCollectUtil;
 namespace {
-constexpr int32_t DB_VERSION = 2;
+constexpr int32_t DB_VERSION = 3;
+constexpr int32_t DB_VERSION_OF_COLUMN_BLOCK = 3;
 constexpr char CPU_COLLECTION_TABLE_NAME[] = "unified_collection_cpu";
 constexpr char THREAD_CPU_COLLECTION_TABLE_NAME[] = "unified_collection_hiview_cpu";
+constexpr char CPU_BLOCK_TABLE_NAME[] = "unified_collection_cpu_block";
+constexpr char PROC_NAME_DICT_TABLE_NAME[] = "unified_collection_cpu_proc_name";
 constexpr char SYS_VERSION_TABLE_NAME[] = "version";
+constexpr char COLUMN_ID[] = "id";
 constexpr char COLUMN_START_TIME[] = "start_time";
 constexpr char COLUMN_END_TIME[] = "end_time";
 constexpr char COLUMN_PID[] = "pid";
@@ -49,8 +54,22 @@ constexpr char COLUMN_CPU_LOAD[] = "cpu_load";
 constexpr char COLUMN_CPU_USAGE[] = "cpu_usage";
 constexpr char COLUMN_THREAD_CNT[] = "thread_cnt";
 constexpr char COLUMN_VERSION_NAME[] = "name";
+constexpr char COLUMN_NAME_ID[] = "name_id";
+constexpr char COLUMN_BASE_TIME[] = "base_time";
+constexpr char COLUMN_ROW_CNT[] = "row_cnt";
+constexpr char COLUMN_DURATION[] = "duration";
 constexpr uint32_t DEFAULT_PRECISION_OF_DECIMAL = 6; // 0.123456
 constexpr int32_t MEM_CG_PROCESS_FLAG = 100;
+constexpr uint32_t MAX_ROW_CNT_OF_COLUMN_BLOCK = 2048;
+// the buffered rows are flushed once they span 5 minutes, which bounds the rows lost by a crash of hiview
+constexpr uint64_t MAX_TIME_SPAN_OF_COLUMN_BLOCK = 5 * 60 * 1000;
+constexpr int32_t FIRST_BLOB_INDEX_OF_BLOCK = 2;
+
+// the names of the blob columns of the block table, in the order of CpuColumn
+const std::vector<std::string> CPU_BLOCK_COLUMNS = {
+    COLUMN_START_TIME, COLUMN_DURATION, COLUMN_PID, COLUMN_PROC_STATE, COLUMN_NAME_ID, COLUMN_CPU_LOAD,
+    COLUMN_CPU_USAGE, COLUMN_THREAD_CNT,
+};
 
 std::string CreateDbFileName()
 {
@@ -113,7 +132,7 @@ bool IsForegroundStateInCollectionPeriod(const ProcessCpuStatInfo& cpuCollection
 }
 
 int32_t GetPowerProcessStateInCollectionPeriod(const ProcessCpuStatInfo& cpuCollectionInfo,
-    const std::unordered_set<int32_t>& memCgProcs)
+    const MemCgProcessCache& memCgProcs)
 {
     int32_t processState = IsForegroundStateInCollectionPeriod(cpuCollectionInfo) ? static_cast<int32_t>(FOREGROUND) :
         static_cast<int32_t>(ProcessStatus::GetInstance().GetProcessState(cpuCollectionInfo.pid));
@@ -121,10 +140,160 @@ int32_t GetPowerProcessStateInCollectionPeriod(const ProcessCpuStatInfo& cpuColl
     int32_t powerState = PowerStatusManager::GetInstance().GetPowerState();
     processState += powerState;
 #endif
-    processState += (memCgProcs.find(cpuCollectionInfo.pid) != memCgProcs.end() ? MEM_CG_PROCESS_FLAG : 0);
+    processState += (memCgProcs.Contains(cpuCollectionInfo.pid) ? MEM_CG_PROCESS_FLAG : 0);
     return processState;
 }
 
+NativeRdb::ValuesBucket BuildCpuCollectionBucket(const CpuColumnRow& row, const std::string& procName)
+{
+    NativeRdb::ValuesBucket bucket;
+    bucket.PutLong(COLUMN_START_TIME, static_cast<int64_t>(row.startTime));
+    bucket.PutLong(COLUMN_END_TIME, static_cast<int64_t>(row.endTime));
+    bucket.PutInt(COLUMN_PID, row.pid);
+    bucket.PutInt(COLUMN_PROC_STATE, row.procState);
+    bucket.PutString(COLUMN_PROC_NAME, procName);
+    bucket.PutDouble(COLUMN_CPU_LOAD, CpuColumnBlock::FromFixedPoint(row.cpuLoad));
+    bucket.PutDouble(COLUMN_CPU_USAGE, CpuColumnBlock::FromFixedPoint(row.cpuUsage));
+    bucket.PutInt(COLUMN_THREAD_CNT, row.threadCount);
+    return bucket;
+}
+
+bool ReadColumnBlock(NativeRdb::ResultSet& resultSet, std::vector<CpuColumnRow>& rows)
+{
+    int64_t baseTime = 0;
+    int32_t rowCnt = 0;
+    if (resultSet.GetLong(0, baseTime) != NativeRdb::E_OK || resultSet.GetInt(1, rowCnt) != NativeRdb::E_OK ||
+        rowCnt < 0) {
+        return false;
+    }
+    CpuColumnData columns;
+    for (uint32_t i = 0; i < CPU_COLUMN_CNT; i++) {
+        if (resultSet.GetBlob(FIRST_BLOB_INDEX_OF_BLOCK + static_cast<int32_t>(i), columns[i]) != NativeRdb::E_OK) {
+            return false;
+        }
+    }
+    return CpuColumnBlock::Decode(static_cast<uint64_t>(baseTime), static_cast<uint32_t>(rowCnt), columns, rows);
+}
+
+bool QueryProcNameDict(RestorableDbStore& dbStore, std::unordered_map<std::string, uint32_t>& procNameIds)
+{
+    NativeRdb::RdbPredicates predicates(PROC_NAME_DICT_TABLE_NAME);
+    std::vector<std::string> columns = {COLUMN_NAME_ID, COLUMN_PROC_NAME};
+    std::shared_ptr<NativeRdb::ResultSet> resultSet = dbStore.Query(predicates, columns);
+    if (resultSet == nullptr) {
+        HIVIEW_LOGE("failed to query %{public}s", PROC_NAME_DICT_TABLE_NAME);
+        return false;
+    }
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        int32_t nameId = 0;
+        std::string procName;
+        if (resultSet->GetInt(0, nameId) != NativeRdb::E_OK || resultSet->GetString(1, procName) != NativeRdb::E_OK) {
+            continue;
+        }
+        procNameIds[procName] = static_cast<uint32_t>(nameId);
+    }
+    resultSet->Close();
+    return true;
+}
+
+bool QueryColumnBlockIds(RestorableDbStore& dbStore, std::vector<int64_t>& blockIds)
+{
+    NativeRdb::RdbPredicates predicates(CPU_BLOCK_TABLE_NAME);
+    std::vector<std::string> columns = {COLUMN_ID};
+    std::shared_ptr<NativeRdb::ResultSet> resultSet = dbStore.Query(predicates, columns);
+    if (resultSet == nullptr) {
+        HIVIEW_LOGE("failed to query %{public}s", CPU_BLOCK_TABLE_NAME);
+        return false;
+    }
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        int64_t blockId = 0;
+        if (resultSet->GetLong(0, blockId) == NativeRdb::E_OK) {
+            blockIds.push_back(blockId);
+        }
+    }
+    resultSet->Close();
+    return true;
+}
+
+bool QueryColumnBlock(RestorableDbStore& dbStore, int64_t blockId, std::vector<CpuColumnRow>& rows)
+{
+    NativeRdb::RdbPredicates predicates(CPU_BLOCK_TABLE_NAME);
+    predicates.EqualTo(COLUMN_ID, blockId);
+    std::vector<std::string> columns = {COLUMN_BASE_TIME, COLUMN_ROW_CNT};
+    columns.insert(columns.end(), CPU_BLOCK_COLUMNS.begin(), CPU_BLOCK_COLUMNS.end());
+    std::shared_ptr<NativeRdb::ResultSet> resultSet = dbStore.Query(predicates, columns);
+    if (resultSet == nullptr) {
+        HIVIEW_LOGE("failed to query %{public}s", CPU_BLOCK_TABLE_NAME);
+        return false;
+    }
+    bool isDecoded = resultSet->GoToFirstRow() == NativeRdb::E_OK && ReadColumnBlock(*resultSet, rows);
+    resultSet->Close();
+    return isDecoded;
+}
+
+bool MaterializeColumnBlock(NativeRdb::Transaction& transaction, int64_t blockId,
+    const std::vector<CpuColumnRow>& rows, const std::unordered_map<uint32_t, std::string>& procNames)
+{
+    std::vector<NativeRdb::ValuesBucket> valuesBuckets;
+    for (const auto& row : rows) {
+        if (auto it = procNames.find(row.nameId); it != procNames.end()) {
+            valuesBuckets.push_back(BuildCpuCollectionBucket(row, it->second));
+        }
+    }
+    if (auto [ret, insertNum] = transaction.BatchInsert(CPU_COLLECTION_TABLE_NAME, valuesBuckets);
+        ret != NativeRdb::E_OK) {
+        HIVIEW_LOGE("Insert rows of cpu block failed, ret is %{public}d", ret);
+        return false;
+    }
+    NativeRdb::RdbPredicates predicates(CPU_BLOCK_TABLE_NAME);
+    predicates.EqualTo(COLUMN_ID, blockId);
+    if (auto [ret, deleteRow] = transaction.Delete(predicates); ret != NativeRdb::E_OK) {
+        HIVIEW_LOGE("Delete cpu block failed, ret is %{public}d", ret);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Decode the column blocks into the cpu collection table. Each block is deleted with its rows inserted in one
+ * transaction, and a block failed to decode is kept, so no row is lost or inserted twice.
+ */
+uint32_t MaterializeColumnBlocks(RestorableDbStore& dbStore)
+{
+    std::unordered_map<std::string, uint32_t> procNameIds;
+    std::vector<int64_t> blockIds;
+    if (!QueryProcNameDict(dbStore, procNameIds) || !QueryColumnBlockIds(dbStore, blockIds) || blockIds.empty()) {
+        return 0;
+    }
+    std::unordered_map<uint32_t, std::string> procNames;
+    for (const auto& [procName, nameId] : procNameIds) {
+        procNames[nameId] = procName;
+    }
+    auto [ret, transaction] = dbStore.CreateTransaction(NativeRdb::Transaction::DEFERRED);
+    if (ret != NativeRdb::E_OK || transaction == nullptr) {
+        HIVIEW_LOGE("CreateTransaction failed, error:%{public}d", ret);
+        return 0;
+    }
+    uint32_t blockCnt = 0;
+    for (int64_t blockId : blockIds) {
+        std::vector<CpuColumnRow> rows;
+        if (!QueryColumnBlock(dbStore, blockId, rows)) {
+            HIVIEW_LOGW("failed to decode cpu block %{public}" PRId64 ", keep it", blockId);
+            continue;
+        }
+        if (!MaterializeColumnBlock(*transaction, blockId, rows, procNames)) {
+            transaction->Rollback();
+            return 0;
+        }
+        blockCnt++;
+    }
+    if (int commitRet = transaction->Commit(); commitRet != NativeRdb::E_OK) {
+        HIVIEW_LOGE("failed to commit cpu blocks, ret is %{public}d", commitRet);
+        return 0;
+    }
+    return blockCnt;
+}
+
 int32_t CreateTable(NativeRdb::RdbStore& dbStore, const std::string& tableName,
     const std::vector<std::pair<std::string, std::string>>& fields)
 {
@@ -199,6 +368,61 @@ int32_t CreateThreadCpuCollectionTable(NativeRdb::RdbStore& dbStore)
     return NativeRdb::E_OK;
 }
 
+int32_t CreateCpuBlockTable(NativeRdb::RdbStore& dbStore)
+{
+    /**
+     * table: unified_collection_cpu_block
+     *
+     * |-----|-----------|---------|----------------------------------------------------------------------------|
+     * |  id | base_time | row_cnt | start_time/duration/pid/proc_state/name_id/cpu_load/cpu_usage/thread_cnt |
+     * |-----|-----------|---------|----------------------------------------------------------------------------|
+     * | INT |   INT64   |   INT   |                             BLOB for each column                           |
+     * |-----|-----------|---------|----------------------------------------------------------------------------|
+     */
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {COLUMN_BASE_TIME, SqlUtil::COLUMN_TYPE_INT},
+        {COLUMN_ROW_CNT, SqlUtil::COLUMN_TYPE_INT},
+    };
+    for (const auto& column : CPU_BLOCK_COLUMNS) {
+        fields.emplace_back(column, SqlUtil::COLUMN_TYPE_BLOB);
+    }
+    if (auto ret = CreateTable(dbStore, CPU_BLOCK_TABLE_NAME, fields); ret != NativeRdb::E_OK) {
+        HIVIEW_LOGE("failed to create %{public}s table", CPU_BLOCK_TABLE_NAME);
+        return ret;
+    }
+    return NativeRdb::E_OK;
+}
+
+int32_t CreateProcNameDictTable(NativeRdb::RdbStore& dbStore)
+{
+    /**
+     * table: unified_collection_cpu_proc_name
+     *
+     * |-----|---------|-----------|
+     * |  id | name_id | proc_name |
+     * |-----|---------|-----------|
+     * | INT |   INT   |  VARCHAR  |
+     * |-----|---------|-----------|
+     */
+    const std::vector<std::pair<std::string, std::string>> fields = {
+        {COLUMN_NAME_ID, SqlUtil::COLUMN_TYPE_INT},
+        {COLUMN_PROC_NAME, SqlUtil::COLUMN_TYPE_STR},
+    };
+    if (auto ret = CreateTable(dbStore, PROC_NAME_DICT_TABLE_NAME, fields); ret != NativeRdb::E_OK) {
+        HIVIEW_LOGE("failed to create %{public}s table", PROC_NAME_DICT_TABLE_NAME);
+        return ret;
+    }
+    return NativeRdb::E_OK;
+}
+
+int32_t CreateColumnBlockTables(NativeRdb::RdbStore& dbStore)
+{
+    if (auto ret = CreateCpuBlockTable(dbStore); ret != NativeRdb::E_OK) {
+        return ret;
+    }
+    return CreateProcNameDictTable(dbStore);
+}
+
 int32_t CreateVersionTable(NativeRdb::RdbStore& dbStore)
 {
     /**
@@ -235,48 +459,21 @@ int CreateTables(NativeRdb::RdbStore& rdbStore)
     if (auto ret = CreateThreadCpuCollectionTable(rdbStore); ret != NativeRdb::E_OK) {
         return ret;
     }
-    return NativeRdb::E_OK;
-}
-
-void LoadPidFromProcs(const std::string &procsFile, std::unordered_set<int32_t> &memCgProcs)
-{
-    std::vector<std::string> procsArray;
-    FileUtil::LoadLinesFromFile(procsFile, procsArray);
-    for (auto& proc : procsArray) {
-        int32_t pid = StringUtil::StrToInt(proc);
-        if (pid < 0) {
-            HIVIEW_LOGE("pid %{public}d is invalid", pid);
-            continue;
-        }
-        memCgProcs.insert(pid);
-    }
+    return CreateColumnBlockTables(rdbStore);
 }
 
-void GetMemCgInner(const std::string &path, std::unordered_set<int32_t> &memCgProcs)
+int UpgradeTables(NativeRdb::RdbStore& rdbStore, int oldVersion, int newVersion)
 {
-    DIR *dir = opendir(path.c_str());
-    if (dir == nullptr) {
-        HIVIEW_LOGD("open dir:%{public}s failed", path.c_str());
-        return;
-    }
-    struct dirent *entry;
-    std::string delimiterDir = FileUtil::IncludeTrailingPathDelimiter(path);
-    while ((entry = readdir(dir)) != nullptr) {
-        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-            continue;
-        }
-        if (entry->d_type == DT_DIR) {
-            std::string filePath = delimiterDir + std::string(entry->d_name);
-            GetMemCgInner(filePath, memCgProcs);
-        } else if (strcmp(entry->d_name, "procs") == 0) {
-            LoadPidFromProcs(delimiterDir + "procs", memCgProcs);
-        }
+    HIVIEW_LOGD("oldVersion=%{public}d, newVersion=%{public}d", oldVersion, newVersion);
+    if (oldVersion < DB_VERSION_OF_COLUMN_BLOCK) {
+        return CreateColumnBlockTables(rdbStore);
     }
-    closedir(dir);
+    return NativeRdb::E_OK;
 }
 }
 
-CpuStorage::CpuStorage(const std::string& workPath) : workPath_(workPath)
+CpuStorage::CpuStorage(const std::string& workPath, bool isCompactMode)
+    : workPath_(workPath), isCompactMode_(isCompactMode)
 {
     InitDbStorePath();
     InitDbStore();
@@ -286,6 +483,11 @@ CpuStorage::CpuStorage(const std::string& workPath) : workPath_(workPath)
     }
 }
 
+CpuStorage::~CpuStorage()
+{
+    FlushColumnBlock();
+}
+
 void CpuStorage::InitDbStorePath()
 {
     std::string tempDbStorePath = FileUtil::IncludeTrailingPathDelimiter(workPath_);
@@ -303,13 +505,13 @@ void CpuStorage::InitDbStorePath()
 void CpuStorage::InitDbStore()
 {
     dbStore_ = std::make_shared<RestorableDbStore>(dbStorePath_, dbFileName_, DB_VERSION, "cpu information storage");
-    int ret = dbStore_->Initialize(CreateTables,
-        [] (NativeRdb::RdbStore& rdbStore, int oldVersion, int newVersion) {
-            HIVIEW_LOGD("oldVersion=%{public}d, newVersion=%{public}d", oldVersion, newVersion);
-            return NativeRdb::E_OK;
-        }, nullptr);
+    int ret = dbStore_->Initialize(CreateTables, UpgradeTables, nullptr);
     if (ret != NativeRdb::E_OK) {
         dbStore_ = nullptr;
+        return;
+    }
+    if (isCompactMode_) {
+        LoadProcNameDict();
     }
 }
 
@@ -319,8 +521,16 @@ void CpuStorage::StoreProcessDatas(const std::vector<ProcessCpuStatInfo>& cpuCol
         HIVIEW_LOGW("db store is null, name=%{public}s", dbFileName_.c_str());
         return;
     }
-    std::unordered_set<int32_t> memCgProcs;
-    GetMemCgProcesses(memCgProcs);
+    RefreshMemCgProcesses();
+    if (isCompactMode_) {
+        StoreColumnRows(cpuCollectionInfos);
+    } else {
+        StoreRows(cpuCollectionInfos);
+    }
+}
+
+void CpuStorage::StoreRows(const std::vector<ProcessCpuStatInfo>& cpuCollectionInfos)
+{
     std::vector<NativeRdb::ValuesBucket> valuesBuckets;
     for (auto& cpuCollectionInfo : cpuCollectionInfos) {
         if (!NeedStoreInDb(cpuCollectionInfo)) {
@@ -330,7 +540,8 @@ void CpuStorage::StoreProcessDatas(const std::vector<ProcessCpuStatInfo>& cpuCol
         bucket.PutLong(COLUMN_START_TIME, static_cast<int64_t>(cpuCollectionInfo.startTime));
         bucket.PutLong(COLUMN_END_TIME, static_cast<int64_t>(cpuCollectionInfo.endTime));
         bucket.PutInt(COLUMN_PID, cpuCollectionInfo.pid);
-        bucket.PutInt(COLUMN_PROC_STATE, GetPowerProcessStateInCollectionPeriod(cpuCollectionInfo, memCgProcs));
+        bucket.PutInt(COLUMN_PROC_STATE,
+            GetPowerProcessStateInCollectionPeriod(cpuCollectionInfo, memCgProcessCache_));
         bucket.PutString(COLUMN_PROC_NAME, cpuCollectionInfo.procName);
         bucket.PutDouble(COLUMN_CPU_LOAD, TruncateDecimalWithNBitPrecision(cpuCollectionInfo.cpuLoad));
         bucket.PutDouble(COLUMN_CPU_USAGE, TruncateDecimalWithNBitPrecision(cpuCollectionInfo.cpuUsage));
@@ -344,6 +555,121 @@ void CpuStorage::StoreProcessDatas(const std::vector<ProcessCpuStatInfo>& cpuCol
     }
 }
 
+void CpuStorage::StoreColumnRows(const std::vector<ProcessCpuStatInfo>& cpuCollectionInfos)
+{
+    uint64_t lastEndTime = 0;
+    for (auto& cpuCollectionInfo : cpuCollectionInfos) {
+        if (!NeedStoreInDb(cpuCollectionInfo)) {
+            continue;
+        }
+        CpuColumnRow row = {
+            .startTime = cpuCollectionInfo.startTime,
+            .endTime = cpuCollectionInfo.endTime,
+            .pid = cpuCollectionInfo.pid,
+            .procState = GetPowerProcessStateInCollectionPeriod(cpuCollectionInfo, memCgProcessCache_),
+            .nameId = GetProcNameId(cpuCollectionInfo.procName),
+            .cpuLoad = CpuColumnBlock::ToFixedPoint(cpuCollectionInfo.cpuLoad),
+            .cpuUsage = CpuColumnBlock::ToFixedPoint(cpuCollectionInfo.cpuUsage),
+            .threadCount = cpuCollectionInfo.threadCount,
+        };
+        columnBlock_.Append(row);
+        lastEndTime = std::max(lastEndTime, cpuCollectionInfo.endTime);
+    }
+    if (columnBlock_.GetRowCount() >= MAX_ROW_CNT_OF_COLUMN_BLOCK ||
+        (columnBlock_.GetRowCount() > 0 && lastEndTime >= columnBlock_.GetBaseTime() + MAX_TIME_SPAN_OF_COLUMN_BLOCK)) {
+        FlushColumnBlock();
+    }
+}
+
+uint32_t CpuStorage::GetProcNameId(const std::string& procName)
+{
+    if (auto it = procNameIds_.find(procName); it != procNameIds_.end()) {
+        return it->second;
+    }
+    uint32_t nameId = static_cast<uint32_t>(procNameIds_.size());
+    procNameIds_[procName] = nameId;
+    pendingProcNames_.emplace_back(nameId, procName);
+    return nameId;
+}
+
+void CpuStorage::LoadProcNameDict()
+{
+    procNameIds_.clear();
+    pendingProcNames_.clear();
+    QueryProcNameDict(*dbStore_, procNameIds_);
+    HIVIEW_LOGI("load %{public}zu proc names of %{public}s", procNameIds_.size(), dbFileName_.c_str());
+}
+
+bool CpuStorage::StoreProcNameDict()
+{
+    if (pendingProcNames_.empty()) {
+        return true;
+    }
+    std::vector<NativeRdb::ValuesBucket> valuesBuckets;
+    for (const auto& [nameId, procName] : pendingProcNames_) {
+        NativeRdb::ValuesBucket bucket;
+        bucket.PutInt(COLUMN_NAME_ID, static_cast<int32_t>(nameId));
+        bucket.PutString(COLUMN_PROC_NAME, procName);
+        valuesBuckets.push_back(bucket);
+    }
+    int64_t outInsertNum = 0;
+    if (int ret = dbStore_->BatchInsert(outInsertNum, PROC_NAME_DICT_TABLE_NAME, valuesBuckets);
+        ret != NativeRdb::E_OK) {
+        HIVIEW_LOGE("Insert proc names failed, ret is %{public}d", ret);
+        return false;
+    }
+    pendingProcNames_.clear();
+    return true;
+}
+
+void CpuStorage::FlushColumnBlock()
+{
+    if (columnBlock_.GetRowCount() == 0) {
+        return;
+    }
+    if (dbStore_ == nullptr) {
+        HIVIEW_LOGW("db store is null, drop %{public}u rows", columnBlock_.GetRowCount());
+        columnBlock_.Clear();
+        return;
+    }
+    // the names are kept pending if failed to store, the block is dropped for it could not be decoded
+    if (StoreProcNameDict()) {
+        NativeRdb::ValuesBucket bucket;
+        bucket.PutLong(COLUMN_BASE_TIME, static_cast<int64_t>(columnBlock_.GetBaseTime()));
+        bucket.PutInt(COLUMN_ROW_CNT, static_cast<int32_t>(columnBlock_.GetRowCount()));
+        const CpuColumnData& columns = columnBlock_.GetColumns();
+        for (uint32_t i = 0; i < CPU_COLUMN_CNT; i++) {
+            bucket.PutBlob(CPU_BLOCK_COLUMNS[i], columns[i]);
+        }
+        int64_t seq = 0;
+        if (int ret = dbStore_->Insert(seq, CPU_BLOCK_TABLE_NAME, bucket); ret != NativeRdb::E_OK) {
+            HIVIEW_LOGE("Insert cpu block failed, ret is %{public}d", ret);
+        }
+    }
+    columnBlock_.Clear();
+}
+
+void CpuStorage::MaterializeUploadedColumnBlocks()
+{
+    // the blocks are decoded only in the db file to upload, which is read by the consumers of the event,
+    // so the db file being written is kept compact
+    if (dbStoreUploadPath_.empty()) {
+        return;
+    }
+    std::string uploadDbFile = FileUtil::IncludeTrailingPathDelimiter(dbStoreUploadPath_).append(dbFileName_);
+    if (!FileUtil::FileExists(uploadDbFile)) {
+        HIVIEW_LOGW("db file to upload not exists, name=%{public}s", dbFileName_.c_str());
+        return;
+    }
+    RestorableDbStore uploadDbStore(dbStoreUploadPath_, dbFileName_, DB_VERSION, "cpu information upload");
+    if (int ret = uploadDbStore.Initialize(CreateTables, UpgradeTables, nullptr); ret != NativeRdb::E_OK) {
+        HIVIEW_LOGE("failed to open db file to upload, ret is %{public}d", ret);
+        return;
+    }
+    uint32_t blockCnt = MaterializeColumnBlocks(uploadDbStore);
+    HIVIEW_LOGI("materialize %{public}u cpu blocks of %{public}s", blockCnt, dbFileName_.c_str());
+}
+
 void CpuStorage::StoreThreadDatas(const std::vector<ThreadCpuStatInfo>& cpuCollections)
 {
     if (dbStore_ == nullptr) {
@@ -379,22 +705,27 @@ void CpuStorage::Report()
 void CpuStorage::ReportDbRecords()
 {
     HIVIEW_LOGI("start to report cpu collection event");
+    // the rows of the report window are written to the db file before it is moved
+    FlushColumnBlock();
     PrepareOldDbFilesBeforeReport();
+    MaterializeUploadedColumnBlocks();
     ReportCpuCollectionEvent();
     PrepareNewDbFilesAfterReport();
 }
 
-void CpuStorage::GetMemCgProcesses(std::unordered_set<int32_t> &memCgProcs)
+void CpuStorage::RefreshMemCgProcesses()
 {
+    std::vector<std::string> memCgDirs;
     std::string rgmId = Parameter::GetString("virt_service.rgm_id.rgm_hmos", "");
     if (rgmId.empty()) {
         HIVIEW_LOGD("rgm_id is empty");
-        return;
+    } else {
+        memCgDirs.push_back("/dev/memcg/isulad/" + rgmId + "/anco_memcg");
+        memCgDirs.push_back("/dev/memcg/isulad/" + rgmId + "/anco_union_memcg");
+        memCgDirs.push_back("/dev/memcg/isulad/" + rgmId + "/anco_perf_critical");
+        memCgDirs.push_back("/dev/memcg/isulad/" + rgmId + "/anco_perf_sensitive");
     }
-    GetMemCgInner("/dev/memcg/isulad/" + rgmId + "/anco_memcg", memCgProcs);
-    GetMemCgInner("/dev/memcg/isulad/" + rgmId + "/anco_union_memcg", memCgProcs);
-    GetMemCgInner("/dev/memcg/isulad/" + rgmId + "/anco_perf_critical", memCgProcs);
-    GetMemCgInner("/dev/memcg/isulad/" + rgmId + "/anco_perf_sensitive", memCgProcs);
+    memCgProcessCache_.Refresh(memCgDirs);
 }
 
 std::string CpuStorage::GetStoredSysVersion()
@@ -451,6 +782,8 @@ void CpuStorage::PrepareOldDbFilesBeforeReport()
 void CpuStorage::ResetDbStore()
 {
     dbStore_ = nullptr;
+    procNameIds_.clear();
+    pendingProcNames_.clear();
 }
 
 void CpuStorage::ReportCpuCollectionEvent()
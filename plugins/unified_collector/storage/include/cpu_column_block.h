@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIVIEW_PLUGINS_UNIFIED_COLLECTOR_STORAGE_INCLUDE_CPU_COLUMN_BLOCK_H
+#define HIVIEW_PLUGINS_UNIFIED_COLLECTOR_STORAGE_INCLUDE_CPU_COLUMN_BLOCK_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+enum CpuColumn : uint32_t {
+    CPU_COLUMN_START_TIME = 0,
+    CPU_COLUMN_DURATION,
+    CPU_COLUMN_PID,
+    CPU_COLUMN_PROC_STATE,
+    CPU_COLUMN_NAME_ID,
+    CPU_COLUMN_CPU_LOAD,
+    CPU_COLUMN_CPU_USAGE,
+    CPU_COLUMN_THREAD_CNT,
+    CPU_COLUMN_CNT,
+};
+
+struct CpuColumnRow {
+    uint64_t startTime = 0;
+    uint64_t endTime = 0;
+    int32_t pid = 0;
+    int32_t procState = 0;
+    // id of the process name in the name dictionary of the report window
+    uint32_t nameId = 0;
+    // fixed-point values in the unit of CPU_FIXED_POINT_SCALE
+    uint64_t cpuLoad = 0;
+    uint64_t cpuUsage = 0;
+    int32_t threadCount = 0;
+};
+
+using CpuColumnData = std::array<std::vector<uint8_t>, CPU_COLUMN_CNT>;
+
+/*
+ * Append-only block of the process cpu rows stored column by column. Every value is written as a varint, the
+ * start time is the delta from the previous row(the first row from the base time), the end time is stored as
+ * the duration and the pid as the delta from the previous pid, signed values are zigzag encoded.
+ */
+class CpuColumnBlock {
+public:
+    static constexpr uint64_t CPU_FIXED_POINT_SCALE = 1000000; // 0.000001
+
+    void Append(const CpuColumnRow& row);
+    void Clear();
+    uint32_t GetRowCount() const;
+    uint64_t GetBaseTime() const;
+    const CpuColumnData& GetColumns() const;
+    static uint64_t ToFixedPoint(double value);
+    static double FromFixedPoint(uint64_t value);
+    static bool Decode(uint64_t baseTime, uint32_t rowCount, const CpuColumnData& columns,
+        std::vector<CpuColumnRow>& rows);
+
+private:
+    uint32_t rowCount_ = 0;
+    uint64_t baseTime_ = 0;
+    uint64_t lastStartTime_ = 0;
+    int32_t lastPid_ = 0;
+    CpuColumnData columns_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIVIEW_PLUGINS_UNIFIED_COLLECTOR_STORAGE_INCLUDE_CPU_COLUMN_BLOCK_H
@@ -17,8 +17,11 @@
 #define HIVIEW_PLUGINS_UNIFIED_COLLECTOR_STORAGE_INCLUDE_CPU_STORAGE_H
 
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
+#include "cpu_column_block.h"
+#include "mem_cg_process_cache.h"
 #include "resource/cpu.h"
 #include "restorable_db_store.h"
 
@@ -27,7 +30,8 @@ namespace HiviewDFX {
 using GetMemCgProcessFunc = bool (*)(std::unordered_set<int32_t>&);
 class CpuStorage {
 public:
-    CpuStorage(const std::string& workPath);
+    CpuStorage(const std::string& workPath, bool isCompactMode = false);
+    ~CpuStorage();
     void StoreProcessDatas(const std::vector<ProcessCpuStatInfo>& cpuCollections);
     void StoreThreadDatas(const std::vector<ThreadCpuStatInfo>& cpuCollections);
     void Report();
@@ -42,7 +46,14 @@ private:
     void PrepareNewDbFilesAfterReport();
     std::string GetStoredSysVersion();
     void ReportDbRecords();
-    void GetMemCgProcesses(std::unordered_set<int32_t>& memCgProcs);
+    void RefreshMemCgProcesses();
+    void StoreRows(const std::vector<ProcessCpuStatInfo>& cpuCollectionInfos);
+    void StoreColumnRows(const std::vector<ProcessCpuStatInfo>& cpuCollectionInfos);
+    uint32_t GetProcNameId(const std::string& procName);
+    void LoadProcNameDict();
+    void FlushColumnBlock();
+    void MaterializeUploadedColumnBlocks();
+    bool StoreProcNameDict();
 
 private:
     std::string workPath_;
@@ -50,6 +61,13 @@ private:
     std::string dbStoreUploadPath_;
     std::string dbFileName_;
     std::shared_ptr<RestorableDbStore> dbStore_;
+    MemCgProcessCache memCgProcessCache_;
+    // the process rows of the compact mode are buffered in a column block and flushed to the db by block
+    bool isCompactMode_ = false;
+    CpuColumnBlock columnBlock_;
+    /* map<proc name, name id>, the dictionary of the current db file */
+    std::unordered_map<std::string, uint32_t> procNameIds_;
+    std::vector<std::pair<uint32_t, std::string>> pendingProcNames_;
 }; // CpuStorage
 } // namespace HiviewDFX
 } // namespace OHOS
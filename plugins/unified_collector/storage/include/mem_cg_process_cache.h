@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIVIEW_PLUGINS_UNIFIED_COLLECTOR_STORAGE_INCLUDE_MEM_CG_PROCESS_CACHE_H
+#define HIVIEW_PLUGINS_UNIFIED_COLLECTOR_STORAGE_INCLUDE_MEM_CG_PROCESS_CACHE_H
+
+#include <string>
+#include <sys/stat.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+/*
+ * Cache of the processes in the memcg directories. A refresh stats the cached directories and procs files,
+ * a directory is listed again only if its stat changed, and so is a procs file reloaded, so a refresh reads
+ * nothing when the memcg processes are not changed.
+ */
+class MemCgProcessCache {
+public:
+    void Refresh(const std::vector<std::string>& memCgDirs);
+    bool Contains(int32_t pid) const;
+    size_t GetProcsFileCount() const;
+
+private:
+    struct FileStamp {
+        ino_t ino = 0;
+        nlink_t nlink = 0;
+        off_t size = 0;
+        int64_t mtimeSec = 0;
+        int64_t mtimeNsec = 0;
+
+        bool operator==(const FileStamp& other) const;
+    };
+
+    struct MemCgDir {
+        FileStamp stamp;
+        std::vector<std::string> subDirs;
+        bool hasProcsFile = false;
+    };
+
+    struct ProcsFile {
+        FileStamp stamp;
+        std::vector<int32_t> pids;
+    };
+
+    static bool GetFileStamp(const std::string& path, FileStamp& stamp);
+    void RefreshDir(const std::string& dir, std::unordered_set<std::string>& visitedDirs,
+        std::unordered_set<std::string>& visitedProcsFiles);
+    bool RefreshProcsFile(const std::string& procsFile);
+    void AddPids(const std::vector<int32_t>& pids);
+    void RemovePids(const std::vector<int32_t>& pids);
+
+    std::unordered_map<std::string, MemCgDir> dirs_;
+    std::unordered_map<std::string, ProcsFile> procsFiles_;
+    /* map<pid, count of the procs files with the pid> */
+    std::unordered_map<int32_t, uint32_t> pidRefCnts_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIVIEW_PLUGINS_UNIFIED_COLLECTOR_STORAGE_INCLUDE_MEM_CG_PROCESS_CACHE_H
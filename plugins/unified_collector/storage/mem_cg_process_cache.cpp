@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mem_cg_process_cache.h"
+
+#include <cstring>
+#include <dirent.h>
+
+#include "file_util.h"
+#include "hiview_logger.h"
+#include "string_util.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+DEFINE_LOG_TAG("HiView-MemCgProcessCache");
+namespace {
+constexpr char PROCS_FILE_NAME[] = "procs";
+
+void ListDir(const std::string& path, std::vector<std::string>& subDirs, bool& hasProcsFile)
+{
+    subDirs.clear();
+    hasProcsFile = false;
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        HIVIEW_LOGD("open dir:%{public}s failed", path.c_str());
+        return;
+    }
+    struct dirent *entry;
+    std::string delimiterDir = FileUtil::IncludeTrailingPathDelimiter(path);
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        if (entry->d_type == DT_DIR) {
+            subDirs.push_back(delimiterDir + std::string(entry->d_name));
+        } else if (strcmp(entry->d_name, PROCS_FILE_NAME) == 0) {
+            hasProcsFile = true;
+        }
+    }
+    closedir(dir);
+}
+
+void LoadPids(const std::string& procsFile, std::vector<int32_t>& pids)
+{
+    pids.clear();
+    std::vector<std::string> procsArray;
+    FileUtil::LoadLinesFromFile(procsFile, procsArray);
+    for (const auto& proc : procsArray) {
+        int32_t pid = StringUtil::StrToInt(proc);
+        if (pid < 0) {
+            HIVIEW_LOGE("pid %{public}d is invalid", pid);
+            continue;
+        }
+        pids.push_back(pid);
+    }
+}
+}
+
+bool MemCgProcessCache::FileStamp::operator==(const FileStamp& other) const
+{
+    return ino == other.ino && nlink == other.nlink && size == other.size && mtimeSec == other.mtimeSec &&
+        mtimeNsec == other.mtimeNsec;
+}
+
+bool MemCgProcessCache::GetFileStamp(const std::string& path, FileStamp& stamp)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return false;
+    }
+    stamp.ino = st.st_ino;
+    stamp.nlink = st.st_nlink;
+    stamp.size = st.st_size;
+    stamp.mtimeSec = static_cast<int64_t>(st.st_mtim.tv_sec);
+    stamp.mtimeNsec = static_cast<int64_t>(st.st_mtim.tv_nsec);
+    return true;
+}
+
+void MemCgProcessCache::Refresh(const std::vector<std::string>& memCgDirs)
+{
+    std::unordered_set<std::string> visitedDirs;
+    std::unordered_set<std::string> visitedProcsFiles;
+    for (const auto& memCgDir : memCgDirs) {
+        RefreshDir(FileUtil::IncludeTrailingPathDelimiter(memCgDir), visitedDirs, visitedProcsFiles);
+    }
+    // the directories and procs files not found by this refresh are removed with their processes
+    for (auto it = dirs_.begin(); it != dirs_.end();) {
+        it = visitedDirs.count(it->first) == 0 ? dirs_.erase(it) : std::next(it);
+    }
+    for (auto it = procsFiles_.begin(); it != procsFiles_.end();) {
+        if (visitedProcsFiles.count(it->first) == 0) {
+            RemovePids(it->second.pids);
+            it = procsFiles_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void MemCgProcessCache::RefreshDir(const std::string& dir, std::unordered_set<std::string>& visitedDirs,
+    std::unordered_set<std::string>& visitedProcsFiles)
+{
+    FileStamp stamp;
+    if (!GetFileStamp(dir, stamp) || !visitedDirs.insert(dir).second) {
+        return;
+    }
+    // a child memcg created or removed changes the stat of the directory, so it is listed again
+    auto [it, isNewDir] = dirs_.try_emplace(dir);
+    MemCgDir& memCgDir = it->second;
+    if (isNewDir || !(memCgDir.stamp == stamp)) {
+        memCgDir.stamp = stamp;
+        ListDir(dir, memCgDir.subDirs, memCgDir.hasProcsFile);
+    }
+    if (memCgDir.hasProcsFile) {
+        std::string procsFile = dir + PROCS_FILE_NAME;
+        if (RefreshProcsFile(procsFile)) {
+            visitedProcsFiles.insert(procsFile);
+        }
+    }
+    // the reference is kept valid by the map while the sub directories are added to it
+    for (const auto& subDir : memCgDir.subDirs) {
+        RefreshDir(FileUtil::IncludeTrailingPathDelimiter(subDir), visitedDirs, visitedProcsFiles);
+    }
+}
+
+bool MemCgProcessCache::RefreshProcsFile(const std::string& procsFile)
+{
+    FileStamp stamp;
+    if (!GetFileStamp(procsFile, stamp)) {
+        return false;
+    }
+    auto [it, isNewFile] = procsFiles_.try_emplace(procsFile);
+    ProcsFile& cachedFile = it->second;
+    if (!isNewFile && cachedFile.stamp == stamp) {
+        return true;
+    }
+    RemovePids(cachedFile.pids);
+    cachedFile.stamp = stamp;
+    LoadPids(procsFile, cachedFile.pids);
+    AddPids(cachedFile.pids);
+    return true;
+}
+
+void MemCgProcessCache::AddPids(const std::vector<int32_t>& pids)
+{
+    for (int32_t pid : pids) {
+        pidRefCnts_[pid]++;
+    }
+}
+
+void MemCgProcessCache::RemovePids(const std::vector<int32_t>& pids)
+{
+    for (int32_t pid : pids) {
+        auto it = pidRefCnts_.find(pid);
+        if (it == pidRefCnts_.end()) {
+            continue;
+        }
+        if (--(it->second) == 0) {
+            pidRefCnts_.erase(it);
+        }
+    }
+}
+
+bool MemCgProcessCache::Contains(int32_t pid) const
+{
+    return pidRefCnts_.find(pid) != pidRefCnts_.end();
+}
+
+size_t MemCgProcessCache::GetProcsFileCount() const
+{
+    return procsFiles_.size();
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -30,6 +30,10 @@ using namespace OHOS::HiviewDFX::UCollectUtil;
 namespace OHOS {
 namespace HiviewDFX {
 DEFINE_LOG_TAG("HiView-UnifiedCollector");
+namespace {
+constexpr char KEY_CPU_STORAGE_COMPACT_MODE[] = "persist.hiview.cpu_storage.compact";
+}
+
 CpuCollectionTask::CpuCollectionTask(const std::string& workPath) : workPath_(workPath)
 {
     InitCpuCollector();
@@ -62,7 +66,9 @@ void CpuCollectionTask::InitCpuCollector()
 
 void CpuCollectionTask::InitCpuStorage()
 {
-    cpuStorage_ = std::make_shared<CpuStorage>(workPath_);
+    bool isCompactMode = Parameter::GetBoolean(KEY_CPU_STORAGE_COMPACT_MODE, false);
+    HIVIEW_LOGI("cpu storage compact mode=%{public}d", isCompactMode);
+    cpuStorage_ = std::make_shared<CpuStorage>(workPath_, isCompactMode);
 }
 
 void CpuCollectionTask::ReportCpuCollectionEvent()
@@ -34,6 +34,8 @@ using namespace OHOS::NativeRdb;
 
 namespace {
 const std::string CPU_COLLECTION_TABLE_NAME = "unified_collection_cpu";
+const std::string CPU_BLOCK_TABLE_NAME = "unified_collection_cpu_block";
+const std::string PROC_NAME_DICT_TABLE_NAME = "unified_collection_cpu_proc_name";
 const std::string DB_PATH = "/data/test/cpu_storage";
 const std::string DB_FILE_DIR = "/cpu/";
 const std::string DB_FILE_PREIFIX = "cpu_stat_";
@@ -145,3 +147,196 @@ HWTEST_F(CpuStorageTest, CpuStorageTest004, TestSize.Level3)
     ASSERT_EQ(powerState3, UCollectUtil::SCREEN_OFF);
 }
 #endif
+
+/**
+ * @tc.name: CpuStorageTest005
+ * @tc.desc: CpuStorage store process datas in compact mode
+ * @tc.type: FUNC
+ */
+HWTEST_F(CpuStorageTest, CpuStorageTest005, TestSize.Level3)
+{
+    FileUtil::ForceRemoveDirectory(DB_PATH);
+    CpuStorage cpuStorage(DB_PATH, true);
+    ASSERT_NE(cpuStorage.dbStore_, nullptr);
+    std::vector<ProcessCpuStatInfo> processCpuStatInfos;
+    constexpr int32_t procCnt = 100; // 100 : test process count
+    constexpr int32_t procNameCnt = 10; // 10 : test process name count
+    constexpr uint64_t startTime = 1700000000000; // 1700000000000 : test start time
+    constexpr uint64_t period = 60000; // 60000 : one minute
+    for (int32_t pid = 1; pid <= procCnt; pid++) {
+        ProcessCpuStatInfo processCpuStatInfo = {
+            .startTime = startTime + pid,
+            .endTime = startTime + pid + period,
+            .pid = pid,
+            .cpuLoad = 0.001 * pid, // 0.001 : test cpu load step
+            .cpuUsage = 0.002 * pid, // 0.002 : test cpu usage step
+            .procName = "proc_" + std::to_string(pid % procNameCnt),
+            .threadCount = pid,
+        };
+        processCpuStatInfos.push_back(processCpuStatInfo);
+    }
+    cpuStorage.StoreProcessDatas(processCpuStatInfos);
+    ASSERT_EQ(cpuStorage.columnBlock_.GetRowCount(), static_cast<uint32_t>(procCnt));
+    cpuStorage.FlushColumnBlock();
+    ASSERT_EQ(cpuStorage.columnBlock_.GetRowCount(), 0U);
+
+    RdbPredicates blockPredicates(CPU_BLOCK_TABLE_NAME);
+    std::vector<std::string> columns = {"base_time", "row_cnt", "start_time", "duration", "pid", "proc_state",
+        "name_id", "cpu_load", "cpu_usage", "thread_cnt"};
+    std::shared_ptr<ResultSet> blocks = cpuStorage.dbStore_->Query(blockPredicates, columns);
+    ASSERT_NE(blocks, nullptr);
+    ASSERT_EQ(blocks->GoToFirstRow(), E_OK);
+    int64_t baseTime = 0;
+    int32_t rowCnt = 0;
+    ASSERT_EQ(blocks->GetLong(0, baseTime), E_OK);
+    ASSERT_EQ(blocks->GetInt(1, rowCnt), E_OK);
+    CpuColumnData columnData;
+    for (uint32_t i = 0; i < CPU_COLUMN_CNT; i++) {
+        // 2 : index of the first blob column
+        ASSERT_EQ(blocks->GetBlob(i + 2, columnData[i]), E_OK);
+    }
+    std::vector<CpuColumnRow> rows;
+    ASSERT_TRUE(CpuColumnBlock::Decode(static_cast<uint64_t>(baseTime), rowCnt, columnData, rows));
+    ASSERT_EQ(rows.size(), processCpuStatInfos.size());
+    for (size_t i = 0; i < rows.size(); i++) {
+        ASSERT_EQ(rows[i].startTime, processCpuStatInfos[i].startTime);
+        ASSERT_EQ(rows[i].endTime, processCpuStatInfos[i].endTime);
+        ASSERT_EQ(rows[i].pid, processCpuStatInfos[i].pid);
+        ASSERT_EQ(rows[i].nameId, cpuStorage.procNameIds_[processCpuStatInfos[i].procName]);
+        ASSERT_EQ(rows[i].cpuLoad, CpuColumnBlock::ToFixedPoint(processCpuStatInfos[i].cpuLoad));
+        ASSERT_EQ(rows[i].threadCount, processCpuStatInfos[i].threadCount);
+    }
+
+    RdbPredicates dictPredicates(PROC_NAME_DICT_TABLE_NAME);
+    int64_t procNameCount = 0;
+    ASSERT_EQ(cpuStorage.dbStore_->Count(procNameCount, dictPredicates), E_OK);
+    ASSERT_EQ(procNameCount, procNameCnt);
+}
+
+/**
+ * @tc.name: CpuStorageTest006
+ * @tc.desc: CpuStorage flush the column block by the time span and materialize it into the db file to upload
+ * @tc.type: FUNC
+ */
+HWTEST_F(CpuStorageTest, CpuStorageTest006, TestSize.Level3)
+{
+    FileUtil::ForceRemoveDirectory(DB_PATH);
+    CpuStorage cpuStorage(DB_PATH, true);
+    ASSERT_NE(cpuStorage.dbStore_, nullptr);
+    constexpr uint64_t startTime = 1700000000000; // 1700000000000 : test start time
+    constexpr uint64_t period = 60000; // 60000 : one minute
+    constexpr uint32_t periodCnt = 5; // 5 : the periods to reach the max time span of a block
+    ProcessCpuStatInfo processCpuStatInfo = {
+        .startTime = startTime,
+        .endTime = startTime + period,
+        .pid = 100, // 100 : test pid
+        .cpuLoad = 0.25, // 0.25 : test cpu load
+        .cpuUsage = 0.5, // 0.5 : test cpu usage
+        .procName = "proc_test",
+        .threadCount = 3, // 3 : test thread count
+    };
+    for (uint32_t i = 1; i < periodCnt; i++) {
+        cpuStorage.StoreProcessDatas({processCpuStatInfo});
+        ASSERT_EQ(cpuStorage.columnBlock_.GetRowCount(), i);
+        processCpuStatInfo.startTime += period;
+        processCpuStatInfo.endTime += period;
+    }
+    cpuStorage.StoreProcessDatas({processCpuStatInfo});
+    ASSERT_EQ(cpuStorage.columnBlock_.GetRowCount(), 0U);
+    RdbPredicates blockPredicates(CPU_BLOCK_TABLE_NAME);
+    int64_t blockCount = 0;
+    ASSERT_EQ(cpuStorage.dbStore_->Count(blockCount, blockPredicates), E_OK);
+    ASSERT_EQ(blockCount, 1);
+
+    RdbPredicates predicates(CPU_COLLECTION_TABLE_NAME);
+    int64_t rowCount = 0;
+    ASSERT_EQ(cpuStorage.dbStore_->Count(rowCount, predicates), E_OK);
+    ASSERT_EQ(rowCount, 0);
+
+    // the db file being written is kept compact, the blocks are decoded only in the db file to upload
+    std::string dbFileName = cpuStorage.dbFileName_;
+    cpuStorage.ReportDbRecords();
+    ASSERT_FALSE(cpuStorage.dbStoreUploadPath_.empty());
+    constexpr int32_t dbVersion = 3; // 3 : version of the cpu db
+    RestorableDbStore uploadDbStore(cpuStorage.dbStoreUploadPath_, dbFileName, dbVersion);
+    ASSERT_EQ(uploadDbStore.Initialize(nullptr, nullptr, nullptr), E_OK);
+    ASSERT_EQ(uploadDbStore.Count(blockCount, blockPredicates), E_OK);
+    ASSERT_EQ(blockCount, 0);
+    predicates.OrderByAsc("start_time");
+    std::vector<std::string> columns = {"start_time", "end_time", "pid", "proc_name", "cpu_load", "cpu_usage",
+        "thread_cnt"};
+    std::shared_ptr<ResultSet> resultSet = uploadDbStore.Query(predicates, columns);
+    ASSERT_NE(resultSet, nullptr);
+    uint64_t expectedStartTime = startTime;
+    while (resultSet->GoToNextRow() == E_OK) {
+        int64_t rowStartTime = 0;
+        int64_t rowEndTime = 0;
+        int32_t pid = 0;
+        std::string procName;
+        double cpuLoad = 0;
+        double cpuUsage = 0;
+        int32_t threadCount = 0;
+        ASSERT_EQ(resultSet->GetLong(0, rowStartTime), E_OK);
+        ASSERT_EQ(resultSet->GetLong(1, rowEndTime), E_OK);
+        ASSERT_EQ(resultSet->GetInt(2, pid), E_OK); // 2 : index of pid
+        ASSERT_EQ(resultSet->GetString(3, procName), E_OK); // 3 : index of proc_name
+        ASSERT_EQ(resultSet->GetDouble(4, cpuLoad), E_OK); // 4 : index of cpu_load
+        ASSERT_EQ(resultSet->GetDouble(5, cpuUsage), E_OK); // 5 : index of cpu_usage
+        ASSERT_EQ(resultSet->GetInt(6, threadCount), E_OK); // 6 : index of thread_cnt
+        ASSERT_EQ(static_cast<uint64_t>(rowStartTime), expectedStartTime);
+        ASSERT_EQ(static_cast<uint64_t>(rowEndTime), expectedStartTime + period);
+        ASSERT_EQ(pid, processCpuStatInfo.pid);
+        ASSERT_EQ(procName, processCpuStatInfo.procName);
+        ASSERT_DOUBLE_EQ(cpuLoad, processCpuStatInfo.cpuLoad);
+        ASSERT_DOUBLE_EQ(cpuUsage, processCpuStatInfo.cpuUsage);
+        ASSERT_EQ(threadCount, processCpuStatInfo.threadCount);
+        expectedStartTime += period;
+    }
+    resultSet->Close();
+    ASSERT_EQ(expectedStartTime, startTime + periodCnt * period);
+}
+
+/**
+ * @tc.name: CpuStorageTest007
+ * @tc.desc: MemCgProcessCache refresh the processes in the memcg directories
+ * @tc.type: FUNC
+ */
+HWTEST_F(CpuStorageTest, CpuStorageTest007, TestSize.Level3)
+{
+    const std::string memCgDir = DB_PATH + "/memcg/";
+    FileUtil::ForceRemoveDirectory(memCgDir);
+    ASSERT_TRUE(FileUtil::ForceCreateDirectory(memCgDir + "child/"));
+    ASSERT_TRUE(FileUtil::SaveStringToFile(memCgDir + "procs", "1\n2\n"));
+    ASSERT_TRUE(FileUtil::SaveStringToFile(memCgDir + "child/procs", "3\n"));
+    MemCgProcessCache memCgProcessCache;
+    memCgProcessCache.Refresh({memCgDir});
+    ASSERT_EQ(memCgProcessCache.GetProcsFileCount(), 2U); // 2 : procs files of the memcg and its child
+    ASSERT_TRUE(memCgProcessCache.Contains(1));
+    ASSERT_TRUE(memCgProcessCache.Contains(2)); // 2 : test pid
+    ASSERT_TRUE(memCgProcessCache.Contains(3)); // 3 : test pid
+    ASSERT_FALSE(memCgProcessCache.Contains(4)); // 4 : test pid
+
+    // the exited or reused pids are dropped by the next refresh
+    ASSERT_TRUE(FileUtil::SaveStringToFile(memCgDir + "procs", "4\n"));
+    memCgProcessCache.Refresh({memCgDir});
+    ASSERT_FALSE(memCgProcessCache.Contains(1));
+    ASSERT_FALSE(memCgProcessCache.Contains(2)); // 2 : test pid
+    ASSERT_TRUE(memCgProcessCache.Contains(3)); // 3 : test pid
+    ASSERT_TRUE(memCgProcessCache.Contains(4)); // 4 : test pid
+
+    // the new memcg directory is found by the next refresh
+    ASSERT_TRUE(FileUtil::ForceCreateDirectory(memCgDir + "new_child/"));
+    ASSERT_TRUE(FileUtil::SaveStringToFile(memCgDir + "new_child/procs", "5\n"));
+    memCgProcessCache.Refresh({memCgDir});
+    ASSERT_EQ(memCgProcessCache.GetProcsFileCount(), 3U); // 3 : procs files with the new child
+    ASSERT_TRUE(memCgProcessCache.Contains(5)); // 5 : test pid
+
+    // the processes of the removed memcg directory are dropped at once
+    FileUtil::ForceRemoveDirectory(memCgDir + "child/");
+    memCgProcessCache.Refresh({memCgDir});
+    ASSERT_FALSE(memCgProcessCache.Contains(3)); // 3 : test pid
+    memCgProcessCache.Refresh({});
+    ASSERT_EQ(memCgProcessCache.GetProcsFileCount(), 0U);
+    ASSERT_FALSE(memCgProcessCache.Contains(4)); // 4 : test pid
+    FileUtil::ForceRemoveDirectory(memCgDir);
+}
@@ -18,6 +18,7 @@
 #include <list>
 #include <regex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "file_util.h"
@@ -55,52 +56,58 @@ bool FeatureAnalysis::AnalysisLog()
 
 void FeatureAnalysis::Extract()
 {
-    stringstream buffer("");
-    if (!LogUtil::ReadFileBuff(featureSet_.fullPath, buffer) || !buffer.good() || buffer.eof()) {
+    LogFileBuffer logFile(featureSet_.fullPath);
+    if (!logFile.IsValid()) {
         errorCode_ = BUFFER_ERROR;
         HIVIEW_LOGE("<%{public}d> file is invalid", taskId_);
         return;
     }
 
     // extract info
-    RawInfoPosition(buffer);
+    RawInfoPosition(logFile.GetContent());
 }
 
 void FeatureAnalysis::RawInfoPosition(stringstream& buffer)
 {
+    RawInfoPosition(string_view(buffer.str()));
+}
+
+void FeatureAnalysis::RawInfoPosition(string_view content)
+{
+    LoadRuleProgram();
     int skipStep = (featureSet_.skipStep > 0) ? featureSet_.skipStep : MAX_SKIP_LINE;
     int dismatchCount = 1; // default : countDismatch - 1 >= skipSpace
-    string line;
+    string_view line;
+    size_t pos = 0;
     bool segmentStart = false;
+    uint64_t segmentCheckSeq = 0;
     HIVIEW_LOGI("<%{public}d> skipStep is %{public}d. size:%{public}zu", taskId_, skipStep, featureSet_.rules.size());
-    while (getline(buffer, line)) {
+    while (GetNextLine(content, pos, line)) {
+        // the segment can only be started by a new param record
+        if (!segmentStart && segmentCheckSeq != paramRecordSeq_) {
+            segmentCheckSeq = paramRecordSeq_;
+            CheckStartSegment(segmentStart);
+        }
         if (line.length() > 2048 || // 2048 : max length of line
-            (CheckStartSegment(segmentStart) && (line.empty() || line[0] == ' ' || line[0] == '\t'))) {
+            (segmentStart && (line.empty() || line[0] == ' ' || line[0] == '\t'))) {
             continue;
         }
-        GetCursorInfo(buffer, line);
-        for (auto iterCmd = featureSet_.rules.begin(); iterCmd != featureSet_.rules.end();) {
-            // Check the variable symbol and replace it with the parameter value of the variable
-            FeatureRule& featureCmd = *iterCmd;
-
-            if (CheckDepend(featureCmd) || (!CheckVariableParam(featureCmd)) || (!IsSourceMatch(line, featureCmd))) {
-                iterCmd++;
-                continue;
-            }
+        RuleState* state = MatchRule(line);
+        if (state != nullptr) {
+            FeatureRule& featureCmd = *(state->rule);
+            GetCursorInfo(content, line);
             int num = featureCmd.num;
             bool matchFlag = ParseElementForParam(line, featureCmd);
-            while (--num > 0 && getline(buffer, line)) {
-                GetCursorInfo(buffer, line);
+            while (--num > 0 && GetNextLine(content, pos, line)) {
+                GetCursorInfo(content, line);
                 ParseElementForParam(line, featureCmd);
             }
 
             if (matchFlag && featureCmd.cmdType == L2_RULES) {
-                iterCmd = featureSet_.rules.erase(iterCmd); // erase will iterCmd++, but break avoid out of range
-            } else {
-                iterCmd++;
+                featureSet_.rules.erase(state->rule);
+                state->isErased = true;
             }
             dismatchCount = 0;
-            break;
         }
         dismatchCount++;
         if (featureSet_.rules.empty() || dismatchCount - 1 >= skipStep) {
@@ -109,10 +116,104 @@ void FeatureAnalysis::RawInfoPosition(stringstream& buffer)
     }
 }
 
-void FeatureAnalysis::GetCursorInfo(stringstream& buff, const string& line)
+void FeatureAnalysis::LoadRuleProgram()
+{
+    if (program_ != nullptr) {
+        return;
+    }
+    program_ = FeatureRuleProgram::GetProgram(featureSet_.rules);
+    size_t index = 0;
+    for (auto iter = featureSet_.rules.begin(); iter != featureSet_.rules.end(); ++iter, ++index) {
+        RuleState state;
+        state.rule = iter;
+        state.hasVariable = CheckVariable(*iter, L3_DESCRIPTOR_LEFT, L3_DESCRIPTOR_RIGHT);
+        // the rule without any keyword never matches, it is not the candidate of any line
+        if (program_->GetSource(index).type != SourceMatchType::NEVER &&
+            (state.hasVariable || !program_->IsIndexed(index))) {
+            visitRules_.push_back(index);
+        }
+        ruleStates_.push_back(std::move(state));
+    }
+}
+
+/*
+ * the candidates of a line are the rules whose keywords are found by the automaton and the rules which can't be
+ * indexed, they are checked in the order of the rules and the first matched one wins like the rules are walked
+ */
+FeatureAnalysis::RuleState* FeatureAnalysis::MatchRule(string_view line)
+{
+    lineStamp_++;
+    hitRules_.clear();
+    candidateRules_.clear();
+    program_->FindKeywordRules(line, hitRules_);
+    for (auto index : hitRules_) {
+        RuleState& state = ruleStates_[index];
+        if (!state.isErased && state.hitStamp != lineStamp_) {
+            state.hitStamp = lineStamp_;
+            candidateRules_.push_back(index);
+        }
+    }
+    for (auto index : visitRules_) {
+        RuleState& state = ruleStates_[index];
+        if (state.isErased || state.hitStamp == lineStamp_ || (!state.hasVariable && program_->IsIndexed(index))) {
+            continue;
+        }
+        state.hitStamp = lineStamp_;
+        candidateRules_.push_back(index);
+    }
+    sort(candidateRules_.begin(), candidateRules_.end());
+    for (auto index : candidateRules_) {
+        RuleState& state = ruleStates_[index];
+        // Check the variable symbol and replace it with the parameter value of the variable
+        if (CheckDepend(*(state.rule)) || !IsVariableResolved(state, index) || !IsSourceMatch(line, state, index)) {
+            continue;
+        }
+        return &state;
+    }
+    return nullptr;
+}
+
+bool FeatureAnalysis::IsVariableResolved(RuleState& state, size_t index)
+{
+    if (!state.hasVariable) {
+        return true;
+    }
+    // nothing would be replaced until a new param record is set
+    if (state.variableCheckSeq == paramRecordSeq_) {
+        return false;
+    }
+    bool isReplaced = false;
+    if (!CheckVariableParam(*(state.rule), isReplaced)) {
+        if (!isReplaced) {
+            state.variableCheckSeq = paramRecordSeq_;
+        }
+        return false;
+    }
+    state.hasVariable = false;
+    if (program_->GetSource(index).type == SourceMatchType::VARIABLE) {
+        state.source = make_shared<CompiledSource>(FeatureRuleProgram::CompileSource(state.rule->source));
+    }
+    return true;
+}
+
+bool FeatureAnalysis::GetNextLine(string_view content, size_t& pos, string_view& line) const
+{
+    if (pos >= content.size()) {
+        return false;
+    }
+    size_t end = content.find('\n', pos);
+    if (end == string_view::npos) {
+        end = content.size();
+    }
+    line = content.substr(pos, end - pos);
+    pos = end + 1;
+    return true;
+}
+
+void FeatureAnalysis::GetCursorInfo(string_view content, string_view line)
 {
     line_ = line;
-    lineCursor_ = static_cast<int>(buff.tellg()) - static_cast<int>(line.length()) - 1;
+    lineCursor_ = static_cast<int>(line.data() - content.data());
 }
 
 bool FeatureAnalysis::CheckStartSegment(bool& segmentStart) const
@@ -120,8 +221,7 @@ bool FeatureAnalysis::CheckStartSegment(bool& segmentStart) const
     if (segmentStart) {
         return segmentStart;
     }
-    vector<std::pair<std::string, LineFeature>> info = paramSeekRecord_;
-    for (const auto& one : info) {
+    for (const auto& one : paramSeekRecord_) {
         if (one.first.find("LayerTwoCmd") != string::npos ||
             one.first.find("LayerOneCmd") != string::npos) {
             segmentStart = true;
@@ -132,57 +232,27 @@ bool FeatureAnalysis::CheckStartSegment(bool& segmentStart) const
 }
 
 // line match source or not
-bool FeatureAnalysis::IsSourceMatch(const string& line, const FeatureRule& rule) const
+bool FeatureAnalysis::IsSourceMatch(string_view line, const RuleState& state, size_t index)
 {
-    string cmdSrc = rule.source;
-    // if startwith "@R@"
-    if (L3_REGULAR_DESCRIPTOR == cmdSrc.substr(0, strlen(L3_REGULAR_DESCRIPTOR))) {
-        cmdSrc = cmdSrc.substr(strlen(L3_REGULAR_DESCRIPTOR));
-        return regex_search(line, regex(cmdSrc));
-    }
-
-    // handle OR or AND expression
-    bool isOrExp = (cmdSrc.find(L3_OR_DESCRIPTOR) == string::npos) ? false : true;
-    bool isAndExp = (cmdSrc.find(L3_AND_DESCRIPTOR) == string::npos) ? false : true;
-    if (!isOrExp && !isAndExp) {
-        return line.find(cmdSrc) != string::npos;
-    } else if (isOrExp) {
-        return IsMatchOrExpression(line, cmdSrc);
-    } else if (isAndExp) {
-        return IsMatchAndExpression(line, cmdSrc);
-    }
-    return false;
+    // the source referring to the variables is compiled after they are replaced
+    const CompiledSource& source = (state.source != nullptr) ? *(state.source) : program_->GetSource(index);
+    const regex* sourceRegex = (source.type == SourceMatchType::REGEX) ? &GetRegex(source.pattern) : nullptr;
+    return FeatureRuleProgram::IsSourceMatch(source, line, sourceRegex);
 }
 
-bool FeatureAnalysis::IsMatchOrExpression(const string& line, const string& src) const
+// the regex is compiled at its first use like the walk of the rules did, the one of the program is shared
+const regex& FeatureAnalysis::GetRegex(const string& pattern)
 {
-    vector<string> srcSplit;
-    StringUtil::SplitStr(src, L3_OR_DESCRIPTOR, srcSplit, false, false);
-    for (auto str : srcSplit) {
-        if (line.find(str) != string::npos) {
-            return true;
-        }
+    auto iter = regexCache_.find(pattern);
+    if (iter == regexCache_.end()) {
+        auto compiled = program_->FindRegex(pattern);
+        iter = regexCache_.emplace(pattern,
+            (compiled != nullptr) ? compiled : make_shared<const regex>(pattern)).first;
     }
-    return false;
+    return *(iter->second);
 }
 
-bool FeatureAnalysis::IsMatchAndExpression(const string& line, const string& src) const
-{
-    string lineCpy = line;
-    size_t pos;
-    vector<string> srcSplit;
-    StringUtil::SplitStr(src, L3_AND_DESCRIPTOR, srcSplit, false, false);
-    for (auto str : srcSplit) {
-        pos = lineCpy.find(str);
-        if (pos == string::npos) {
-            return false;
-        }
-        lineCpy = lineCpy.substr(pos + str.length());
-    }
-    return true;
-}
-
-bool FeatureAnalysis::ParseElementForParam(const string& src, FeatureRule& rule)
+bool FeatureAnalysis::ParseElementForParam(string_view src, FeatureRule& rule)
 {
     if (rule.param.empty()) {
         return true; // if param is empty, erase the rule
@@ -192,11 +262,13 @@ bool FeatureAnalysis::ParseElementForParam(const string& src, FeatureRule& rule)
     for (auto iter = rule.param.begin(); iter != rule.param.end();) {
         // subParam.first: parameter name; subParam.second: the expression to match
         string reg = "";
-        smatch result;
+        cmatch result;
         int seekType = GetSeekInfo(iter->second, reg);
         hasContinue = (seekType == LAST_MATCH) ? true : hasContinue;
-        if (reg.find(L3_VARIABLE_TRACE_BLOCK) != string::npos || regex_search(src, result, regex(reg))) {
-            string value = result.str(1).empty() ? "" : string(result.str(1));
+        if (reg.find(L3_VARIABLE_TRACE_BLOCK) != string::npos ||
+            regex_search(src.data(), src.data() + src.size(), result, GetRegex(reg))) {
+            // the result is empty if the regex is not searched for the trace block
+            string value = (result.size() > 1) ? string(result.str(1)) : "";
             SetParamRecord(rule.name + "." + iter->first, FormatLineFeature(value, reg), seekType);
             SetStackRegex(rule.name + "." + iter->first, reg);
             if (seekType == FIRST_MATCH && rule.cmdType == L2_RULES) {
@@ -223,6 +295,12 @@ int FeatureAnalysis::GetSeekInfo(const string& param, string& value) const
 }
 
 bool FeatureAnalysis::CheckVariableParam(FeatureRule& rule) const
+{
+    bool isReplaced = false;
+    return CheckVariableParam(rule, isReplaced);
+}
+
+bool FeatureAnalysis::CheckVariableParam(FeatureRule& rule, bool& isReplaced) const
 {
     // Check whether there is a variable operator &@& in the command
     string symbol = "";
@@ -235,7 +313,7 @@ bool FeatureAnalysis::CheckVariableParam(FeatureRule& rule) const
     for (const auto& param : paramSeekRecord_) {
         symbol = L3_DESCRIPTOR_LEFT + param.first + L3_DESCRIPTOR_RIGHT;
         value = param.second.value;
-        ReplaceVariable(rule, symbol, value);
+        isReplaced = ReplaceVariable(rule, symbol, value) || isReplaced;
     }
     return !CheckVariable(rule, L3_DESCRIPTOR_LEFT, L3_DESCRIPTOR_RIGHT); // check var in config
 }
@@ -255,15 +333,17 @@ bool FeatureAnalysis::CheckVariable(const FeatureRule& rule, const string& leftT
     return false;
 }
 
-void FeatureAnalysis::ReplaceVariable(FeatureRule& rule, const string& symbol, const string& value) const
+bool FeatureAnalysis::ReplaceVariable(FeatureRule& rule, const string& symbol, const string& value) const
 {
-    ReplaceVariable(rule.source, symbol, value, rule.source);
-    ReplaceVariable(rule.depend, symbol, value, rule.depend);
+    bool isReplaced = ReplaceVariable(rule.source, symbol, value, rule.source);
+    isReplaced = ReplaceVariable(rule.depend, symbol, value, rule.depend) || isReplaced;
     for (auto subParam : rule.param) {
         if (ReplaceVariable(subParam.second, symbol, value, subParam.second)) {
             rule.param[subParam.first] = subParam.second;
+            isReplaced = true;
         }
     }
+    return isReplaced;
 }
 
 bool FeatureAnalysis::ReplaceVariable(const string& src, const string& param,
@@ -354,7 +434,7 @@ string FeatureAnalysis::ComposeTrace(const string& filePath, const string& param
 
 string FeatureAnalysis::ComposeParam(const string& param) const
 {
-    std::vector<std::pair<std::string, LineFeature>> lineFeatures = paramSeekRecord_;
+    const auto& lineFeatures = paramSeekRecord_;
     vector<string> params = SplitParam(param);
     vector<string> results;
     for (const auto& key : params) {
@@ -418,6 +498,7 @@ void FeatureAnalysis::SetParamRecord(const std::string& key, const LineFeature&
         }
     }
     paramSeekRecord_.emplace_back(pair<string, LineFeature>(key, value));
+    paramRecordSeq_++;
 }
 
 void FeatureAnalysis::SetStackRegex(const std::string& key, const std::string& regex)
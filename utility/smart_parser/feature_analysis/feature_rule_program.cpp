@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "feature_rule_program.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <queue>
+
+#include "hiview_logger.h"
+#include "string_util.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+DEFINE_LOG_TAG("FeatureRuleProgram");
+namespace {
+constexpr size_t MAX_CACHED_PROGRAM_CNT = 32;
+constexpr char PROGRAM_KEY_SEPARATOR = '\0';
+
+bool HasVariable(const std::string& str)
+{
+    return str.find(L3_DESCRIPTOR_LEFT) != std::string::npos && str.find(L3_DESCRIPTOR_RIGHT) != std::string::npos;
+}
+
+std::string GenerateProgramKey(const std::list<FeatureRule>& rules)
+{
+    std::string key;
+    for (const auto& rule : rules) {
+        key.append(rule.source).push_back(PROGRAM_KEY_SEPARATOR);
+        for (const auto& param : rule.param) {
+            key.append(param.second).push_back(PROGRAM_KEY_SEPARATOR);
+        }
+        key.push_back(PROGRAM_KEY_SEPARATOR);
+    }
+    return key;
+}
+}
+
+FeatureRuleProgram::FeatureRuleProgram(const std::list<FeatureRule>& rules) : nodes_(1)
+{
+    for (const auto& rule : rules) {
+        uint32_t index = static_cast<uint32_t>(sources_.size());
+        CompiledSource source = CompileSource(rule.source);
+        if (source.type == SourceMatchType::LITERAL || source.type == SourceMatchType::OR) {
+            for (const auto& keyword : source.keywords) {
+                AddKeyword(keyword, index);
+            }
+        } else if (source.type == SourceMatchType::AND) {
+            // the longest part is the most selective one, the order of the parts is checked on the hit lines
+            auto longest = std::max_element(source.keywords.begin(), source.keywords.end(),
+                [](const std::string& one, const std::string& other) { return one.size() < other.size(); });
+            AddKeyword(*longest, index);
+        } else if (source.type == SourceMatchType::REGEX) {
+            AddRegex(source.pattern);
+        }
+        for (const auto& param : rule.param) {
+            AddRegex(param.second.find(L3_SEEK_LAST) != std::string::npos ?
+                StringUtil::GetRightSubstr(param.second, L3_SEEK_LAST) : param.second);
+        }
+        sources_.push_back(std::move(source));
+    }
+    for (const auto& [ch, child] : nodes_[0].children) {
+        rootNext_[static_cast<uint8_t>(ch)] = child;
+    }
+    BuildFailLinks();
+    HIVIEW_LOGD("compiled %{public}zu rules, %{public}zu keywords", sources_.size(), keywordRules_.size());
+}
+
+std::shared_ptr<const FeatureRuleProgram> FeatureRuleProgram::GetProgram(const std::list<FeatureRule>& rules)
+{
+    static std::mutex programMutex;
+    static std::unordered_map<std::string, std::shared_ptr<const FeatureRuleProgram>> programs;
+    std::string key = GenerateProgramKey(rules);
+    std::lock_guard<std::mutex> lock(programMutex);
+    auto iter = programs.find(key);
+    if (iter != programs.end()) {
+        return iter->second;
+    }
+    if (programs.size() >= MAX_CACHED_PROGRAM_CNT) {
+        programs.clear();
+    }
+    auto program = std::make_shared<const FeatureRuleProgram>(rules);
+    programs.emplace(std::move(key), program);
+    return program;
+}
+
+CompiledSource FeatureRuleProgram::CompileSource(const std::string& source)
+{
+    CompiledSource result;
+    if (HasVariable(source)) {
+        result.type = SourceMatchType::VARIABLE;
+    } else if (source.compare(0, strlen(L3_REGULAR_DESCRIPTOR), L3_REGULAR_DESCRIPTOR) == 0) {
+        result.type = SourceMatchType::REGEX;
+        result.pattern = source.substr(strlen(L3_REGULAR_DESCRIPTOR));
+    } else if (source.find(L3_OR_DESCRIPTOR) != std::string::npos) {
+        StringUtil::SplitStr(source, L3_OR_DESCRIPTOR, result.keywords, false, false);
+        result.type = result.keywords.empty() ? SourceMatchType::NEVER : SourceMatchType::OR;
+    } else if (source.find(L3_AND_DESCRIPTOR) != std::string::npos) {
+        StringUtil::SplitStr(source, L3_AND_DESCRIPTOR, result.keywords, false, false);
+        result.type = result.keywords.empty() ? SourceMatchType::ALWAYS : SourceMatchType::AND;
+    } else if (source.empty()) {
+        result.type = SourceMatchType::ALWAYS;
+    } else {
+        result.type = SourceMatchType::LITERAL;
+        result.keywords.push_back(source);
+    }
+    return result;
+}
+
+bool FeatureRuleProgram::IsSourceMatch(const CompiledSource& source, std::string_view line, const std::regex* regex)
+{
+    switch (source.type) {
+        case SourceMatchType::ALWAYS:
+            return true;
+        case SourceMatchType::LITERAL:
+            return line.find(source.keywords.front()) != std::string_view::npos;
+        case SourceMatchType::OR:
+            return std::any_of(source.keywords.begin(), source.keywords.end(),
+                [line](const std::string& keyword) { return line.find(keyword) != std::string_view::npos; });
+        case SourceMatchType::AND: {
+            size_t pos = 0;
+            for (const auto& keyword : source.keywords) {
+                pos = line.find(keyword, pos);
+                if (pos == std::string_view::npos) {
+                    return false;
+                }
+                pos += keyword.size();
+            }
+            return true;
+        }
+        case SourceMatchType::REGEX:
+            return regex != nullptr && std::regex_search(line.data(), line.data() + line.size(), *regex);
+        default:
+            return false;
+    }
+}
+
+const CompiledSource& FeatureRuleProgram::GetSource(size_t index) const
+{
+    return sources_[index];
+}
+
+bool FeatureRuleProgram::IsIndexed(size_t index) const
+{
+    SourceMatchType type = sources_[index].type;
+    return type == SourceMatchType::LITERAL || type == SourceMatchType::OR || type == SourceMatchType::AND;
+}
+
+void FeatureRuleProgram::FindKeywordRules(std::string_view line, std::vector<uint32_t>& ruleIndexes) const
+{
+    int32_t node = 0;
+    for (char ch : line) {
+        node = GetNext(node, ch);
+        for (int32_t out = nodes_[node].keyword >= 0 ? node : nodes_[node].output; out != 0;
+            out = nodes_[out].output) {
+            const auto& rules = keywordRules_[nodes_[out].keyword];
+            ruleIndexes.insert(ruleIndexes.end(), rules.begin(), rules.end());
+        }
+    }
+}
+
+std::shared_ptr<const std::regex> FeatureRuleProgram::FindRegex(const std::string& pattern) const
+{
+    std::lock_guard<std::mutex> lock(regexMutex_);
+    auto iter = regexes_.find(pattern);
+    if (iter == regexes_.end()) {
+        return nullptr;
+    }
+    if (iter->second == nullptr) {
+        iter->second = std::make_shared<const std::regex>(pattern);
+    }
+    return iter->second;
+}
+
+int32_t FeatureRuleProgram::FindChild(int32_t node, char ch) const
+{
+    for (const auto& child : nodes_[node].children) {
+        if (child.first == ch) {
+            return child.second;
+        }
+    }
+    return -1;
+}
+
+int32_t FeatureRuleProgram::GetNext(int32_t node, char ch) const
+{
+    while (node != 0) {
+        int32_t next = FindChild(node, ch);
+        if (next >= 0) {
+            return next;
+        }
+        node = nodes_[node].fail;
+    }
+    return rootNext_[static_cast<uint8_t>(ch)];
+}
+
+void FeatureRuleProgram::AddKeyword(const std::string& keyword, uint32_t ruleIndex)
+{
+    auto iter = keywordIds_.find(keyword);
+    if (iter != keywordIds_.end()) {
+        auto& rules = keywordRules_[iter->second];
+        if (rules.empty() || rules.back() != ruleIndex) {
+            rules.push_back(ruleIndex);
+        }
+        return;
+    }
+    int32_t node = 0;
+    for (char ch : keyword) {
+        int32_t next = FindChild(node, ch);
+        if (next < 0) {
+            next = static_cast<int32_t>(nodes_.size());
+            nodes_[node].children.emplace_back(ch, next);
+            nodes_.emplace_back();
+        }
+        node = next;
+    }
+    int32_t keywordId = static_cast<int32_t>(keywordRules_.size());
+    nodes_[node].keyword = keywordId;
+    keywordIds_.emplace(keyword, keywordId);
+    keywordRules_.push_back({ruleIndex});
+}
+
+void FeatureRuleProgram::BuildFailLinks()
+{
+    std::queue<int32_t> nodeQueue;
+    for (const auto& child : nodes_[0].children) {
+        nodeQueue.push(child.second);
+    }
+    while (!nodeQueue.empty()) {
+        int32_t node = nodeQueue.front();
+        nodeQueue.pop();
+        for (const auto& [ch, next] : nodes_[node].children) {
+            int32_t fail = GetNext(nodes_[node].fail, ch);
+            nodes_[next].fail = fail;
+            nodes_[next].output = nodes_[fail].keyword >= 0 ? fail : nodes_[fail].output;
+            nodeQueue.push(next);
+        }
+    }
+}
+
+void FeatureRuleProgram::AddRegex(const std::string& pattern)
+{
+    if (pattern.find(L3_VARIABLE_TRACE_BLOCK) != std::string::npos || HasVariable(pattern) ||
+        regexes_.find(pattern) != regexes_.end()) {
+        return;
+    }
+    // only the pattern is kept, the regex is compiled by the first FindRegex
+    regexes_.emplace(pattern, nullptr);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
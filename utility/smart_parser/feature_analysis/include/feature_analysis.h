@@ -19,10 +19,14 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <regex>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "feature_rule_program.h"
 #include "syntax_rules.h"
 namespace OHOS {
 namespace HiviewDFX {
@@ -59,23 +63,42 @@ public:
     // interface
     bool AnalysisLog();
     void RawInfoPosition(std::stringstream& buffer);
+    void RawInfoPosition(std::string_view content);
     bool CheckStartSegment(bool& segmentStart) const;
     int GetErrorCode() const { return errorCode_; };
     std::map<std::string, std::string> GetReasult() const { return eventInfo_; };
     std::vector<std::pair<std::string, LineFeature>> GetParamSeekRecord() {return paramSeekRecord_;};
 
 private:
+    struct RuleState {
+        std::list<FeatureRule>::iterator rule;
+        bool isErased {false};
+        bool hasVariable {false};
+        // the seq of the param records when nothing is left to be replaced in the unresolved variables
+        uint64_t variableCheckSeq {0};
+        // the stamp of the last line in which the rule is a candidate
+        uint64_t hitStamp {0};
+        // compiled after the variables of the source are replaced
+        std::shared_ptr<CompiledSource> source;
+    };
+
     void Extract();
-    bool IsSourceMatch(const std::string& line, const FeatureRule& rule) const;
-    bool ParseElementForParam(const std::string& src, FeatureRule& rule);
+    void LoadRuleProgram();
+    RuleState* MatchRule(std::string_view line);
+    bool IsVariableResolved(RuleState& state, size_t index);
+    bool IsSourceMatch(std::string_view line, const RuleState& state, size_t index);
+    const std::regex& GetRegex(const std::string& pattern);
+    bool ParseElementForParam(std::string_view src, FeatureRule& rule);
     int GetSeekInfo(const std::string& param, std::string& value) const;
     bool CheckVariableParam(FeatureRule& rule) const;
+    bool CheckVariableParam(FeatureRule& rule, bool& isReplaced) const;
     bool CheckVariable(const FeatureRule& rule, const std::string& leftTag, const std::string& rightTag) const;
-    void ReplaceVariable(FeatureRule& rule, const std::string& symbol, const std::string& value) const;
+    bool ReplaceVariable(FeatureRule& rule, const std::string& symbol, const std::string& value) const;
     bool ReplaceVariable(const std::string& src, const std::string& param, const std::string& value,
         std::string& des) const;
     bool CheckDepend(const FeatureRule& rule) const;
-    void GetCursorInfo(std::stringstream& buff, const std::string& line);
+    bool GetNextLine(std::string_view content, size_t& pos, std::string_view& line) const;
+    void GetCursorInfo(std::string_view content, std::string_view line);
     LineFeature FormatLineFeature(const std::string& value, const std::string& regex) const;
     void Compose();
     std::string ComposeTrace(const std::string& filePath, const std::string& param,
@@ -83,8 +106,6 @@ private:
     std::string ComposeParam(const std::string& param) const;
     std::vector<std::string> SplitParam(const std::string& param) const;
     void ProcessReason(std::map<std::string, std::string>& info);
-    bool IsMatchOrExpression(const std::string& line, const std::string& src) const;
-    bool IsMatchAndExpression(const std::string& line, const std::string& src) const;
     void SetStackRegex(const std::string& key, const std::string& regex);
     void SetParamRecord(const std::string& key, const LineFeature& value, const int type);
 
@@ -101,6 +122,16 @@ private:
     FeatureSet featureSet_;
     std::map<std::string, std::string> stackRegex_;
     std::vector<std::pair<std::string, LineFeature>> paramSeekRecord_;
+    // increased whenever a param record is set
+    uint64_t paramRecordSeq_{1};
+    std::shared_ptr<const FeatureRuleProgram> program_;
+    std::vector<RuleState> ruleStates_;
+    // the rules can't be found by the keywords, they are checked on every line
+    std::vector<size_t> visitRules_;
+    std::vector<uint32_t> hitRules_;
+    std::vector<size_t> candidateRules_;
+    uint64_t lineStamp_{0};
+    std::unordered_map<std::string, std::shared_ptr<const std::regex>> regexCache_;
     std::map<std::string, std::string> composeRule_;
     std::map<std::string, std::string> eventInfo_;
 };
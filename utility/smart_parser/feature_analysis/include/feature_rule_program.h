@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FEATURE_RULE_PROGRAM_H
+#define FEATURE_RULE_PROGRAM_H
+
+#include <array>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "syntax_rules.h"
+namespace OHOS {
+namespace HiviewDFX {
+enum class SourceMatchType {
+    ALWAYS = 0, // the source is empty, every line matches
+    NEVER, // no keyword is left in the source
+    LITERAL,
+    OR,
+    AND,
+    REGEX,
+    VARIABLE, // the source refers to the variables, it is compiled after they are replaced
+};
+
+struct CompiledSource {
+    SourceMatchType type {SourceMatchType::NEVER};
+    // the literal, the alternatives of OR or the ordered parts of AND
+    std::vector<std::string> keywords;
+    // the regex of the REGEX source, it is compiled at the first use
+    std::string pattern;
+};
+
+/*
+ * The extract rules of a feature set compiled once: the keywords of the literal, OR and AND sources are put
+ * into an Aho-Corasick automaton, so one scan of a line finds all the rules which may match it, and the boolean
+ * expressions are split in advance. The regexes of the sources and the params are compiled only when a rule
+ * first needs them, so an invalid regex of a rule which never matches is tolerated as the walk of the rules did.
+ */
+class FeatureRuleProgram {
+public:
+    explicit FeatureRuleProgram(const std::list<FeatureRule>& rules);
+    ~FeatureRuleProgram() = default;
+    FeatureRuleProgram(const FeatureRuleProgram&) = delete;
+    FeatureRuleProgram& operator=(const FeatureRuleProgram&) = delete;
+
+    // the programs are cached by the content of the rules and shared by the analysis of all the logs
+    static std::shared_ptr<const FeatureRuleProgram> GetProgram(const std::list<FeatureRule>& rules);
+    static CompiledSource CompileSource(const std::string& source);
+    // the regex of a REGEX source is given by the caller, which compiles it at the first use
+    static bool IsSourceMatch(const CompiledSource& source, std::string_view line, const std::regex* regex);
+
+    const CompiledSource& GetSource(size_t index) const;
+    // an indexed rule can only match the lines in which the automaton finds its keyword
+    bool IsIndexed(size_t index) const;
+    // appends the index of the rule once for every occurrence of its keywords in the line
+    void FindKeywordRules(std::string_view line, std::vector<uint32_t>& ruleIndexes) const;
+    // compiles the regex of the rules at the first call, null if the pattern is not one of the rules
+    std::shared_ptr<const std::regex> FindRegex(const std::string& pattern) const;
+
+private:
+    struct Node {
+        std::vector<std::pair<char, int32_t>> children;
+        int32_t fail = 0;
+        // the nearest node on the fail chain which ends a keyword
+        int32_t output = 0;
+        int32_t keyword = -1;
+    };
+
+    int32_t FindChild(int32_t node, char ch) const;
+    int32_t GetNext(int32_t node, char ch) const;
+    void AddKeyword(const std::string& keyword, uint32_t ruleIndex);
+    void BuildFailLinks();
+    void AddRegex(const std::string& pattern);
+
+private:
+    std::vector<CompiledSource> sources_;
+    std::vector<Node> nodes_;
+    std::array<int32_t, 256> rootNext_ {}; // 256 : count of the byte values
+    /* vector<indexes of the rules having the keyword>, indexed by the keyword id */
+    std::vector<std::vector<uint32_t>> keywordRules_;
+    std::unordered_map<std::string, int32_t> keywordIds_;
+    // the program is shared by the analysis of the logs, the regexes are compiled under the lock
+    mutable std::mutex regexMutex_;
+    /* map<pattern, regex compiled at the first use> */
+    mutable std::unordered_map<std::string, std::shared_ptr<const std::regex>> regexes_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif /* FEATURE_RULE_PROGRAM_H */
@@ -18,6 +18,7 @@
 #include <map>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -55,8 +56,27 @@ public:
     static constexpr int TOTAL_LINE_NUM = 200;
 
 private:
+    friend class LogFileBuffer;
     static int GetFileFd(const std::string& file);
 };
+
+/*
+ * Content of a log file read into the memory once, the lines are scanned in place instead of being copied into
+ * a stream. The file is not mapped, for a log truncated by its writer during the scan would fault the mapping.
+ */
+class LogFileBuffer {
+public:
+    explicit LogFileBuffer(const std::string& file);
+    ~LogFileBuffer() = default;
+    LogFileBuffer(const LogFileBuffer&) = delete;
+    LogFileBuffer& operator=(const LogFileBuffer&) = delete;
+
+    bool IsValid() const;
+    std::string_view GetContent() const;
+
+private:
+    std::string content_;
+};
 } // namespace HiviewDFX
 } // namespace OHOS
 #endif /* LOG_UTIL_H */
@@ -123,6 +123,30 @@ int LogUtil::GetFileFd(const string& file)
     return fd;
 }
 
+LogFileBuffer::LogFileBuffer(const string& file)
+{
+    int fd = LogUtil::GetFileFd(file);
+    if (fd < 0) {
+        HIVIEW_LOGE("%{public}s get fd fail, fd is %{public}d.", file.c_str(), fd);
+        return;
+    }
+    if (!FileUtil::LoadStringFromFd(fd, content_)) {
+        HIVIEW_LOGE("read file: %{public}s failed, fd is %{public}d.", file.c_str(), fd);
+        content_.clear();
+    }
+    fdsan_close_with_tag(fd, fdsan_create_owner_tag(FDSAN_OWNER_TYPE_FILE, FDSAN_DOMAIN));
+}
+
+bool LogFileBuffer::IsValid() const
+{
+    return !content_.empty();
+}
+
+string_view LogFileBuffer::GetContent() const
+{
+    return content_;
+}
+
 bool LogUtil::FileExist(const string& file)
 {
     return FileUtil::FileExists(file);
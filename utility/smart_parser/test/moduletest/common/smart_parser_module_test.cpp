@@ -15,17 +15,23 @@
 
 #include "smart_parser_module_test.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <errors.h>
 #include <map>
+#include <regex>
 #include <string>
 
 #include "compose_rule.h"
 #include "extract_rule.h"
 #include "feature_analysis.h"
+#include "feature_rule_program.h"
 #include "file_util.h"
 #include "log_util.h"
+#include "rule.h"
 #include "smart_parser.h"
 #include "string_util.h"
 
@@ -37,6 +43,44 @@ static const std::string TEST_CONFIG = "/data/test/test_data/SmartParser/common/
 static const std::string TEST_COMPOSE_CONFIG = "test_compose_rule.json";
 static const std::string TEST_EXTRACT_CONFIG = "test_extract_rule.json";
 
+namespace {
+// the representative fault logs of every type, relative to the test dir of smart parser
+const std::vector<std::pair<std::string, std::string>> FAULT_FILES = {
+    {"CPP_CRASH", "/SmartParserTest001/cppcrash-com.ohos.launcher-20010025-19700324235211000.log"},
+    {"JS_ERROR", "/SmartParserTest002/jscrash-com.example.jsinject-20010041-19700424183123000.log"},
+    {"APP_FREEZE", "/SmartParserTest003/appfreeze-com.example.jsinject-20010039-19700326211815000.log"},
+    {"RUST_PANIC", "/SmartParserTest006/rustpanic-rustpanic_maker-0-20230419222113000.log"},
+    {"PANIC", "/SmartParserTest018/last_kmsg"},
+};
+
+// the source check of the walk of the rules, which parsed the source of the rule on every line
+bool IsSourceMatchByWalk(const std::string& line, const std::string& source)
+{
+    if (source.compare(0, strlen(L3_REGULAR_DESCRIPTOR), L3_REGULAR_DESCRIPTOR) == 0) {
+        return std::regex_search(line, std::regex(source.substr(strlen(L3_REGULAR_DESCRIPTOR))));
+    }
+    std::vector<std::string> parts;
+    if (source.find(L3_OR_DESCRIPTOR) != std::string::npos) {
+        StringUtil::SplitStr(source, L3_OR_DESCRIPTOR, parts, false, false);
+        return std::any_of(parts.begin(), parts.end(),
+            [&line](const std::string& part) { return line.find(part) != std::string::npos; });
+    }
+    if (source.find(L3_AND_DESCRIPTOR) != std::string::npos) {
+        StringUtil::SplitStr(source, L3_AND_DESCRIPTOR, parts, false, false);
+        std::string rest = line;
+        for (const auto& part : parts) {
+            size_t pos = rest.find(part);
+            if (pos == std::string::npos) {
+                return false;
+            }
+            rest = rest.substr(pos + part.length());
+        }
+        return true;
+    }
+    return line.find(source) != std::string::npos;
+}
+}
+
 void SmartParserModuleTest::SetUpTestCase(void) {}
 
 void SmartParserModuleTest::TearDownTestCase(void) {}
@@ -951,5 +995,141 @@ HWTEST_F(SmartParserModuleTest, SmartParserTest024, TestSize.Level1)
     auto eventInfos = SmartParser::Analysis(faultFile, TEST_CONFIG, "DPACRASH");
     ASSERT_EQ(eventInfos.empty(), false);
 }
+
+/**
+ * @tc.name: SmartParserTest025
+ * @tc.desc: the rules found by the compiled program are the ones matched by the walk of the rules.
+ *           1. every line of the fault logs is checked against every extract rule of every type;
+ *           2. a rule matches the line through the program if and only if its source matches by the walk.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SmartParserModuleTest, SmartParserTest025, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. load the lines of the fault logs.
+     */
+    std::vector<std::string> lines;
+    for (const auto& faultFile : FAULT_FILES) {
+        std::vector<std::string> fileLines;
+        ASSERT_TRUE(FileUtil::LoadLinesFromFile(std::string{LogUtil::SMART_PARSER_TEST_DIR} + faultFile.second,
+            fileLines));
+        lines.insert(lines.end(), fileLines.begin(), fileLines.end());
+    }
+
+    /**
+     * @tc.steps: step2. check the lines against the program and the walk of the extract rules of every type.
+     */
+    size_t matchedCount = 0;
+    for (const auto& faultFile : FAULT_FILES) {
+        Rule rule(std::string{LogUtil::SMART_PARSER_TEST_DIR} + faultFile.second, TEST_CONFIG, faultFile.first);
+        rule.ParseRule();
+        for (const auto& [featureId, featureSet] : rule.GetExtractRule()) {
+            FeatureRuleProgram program(featureSet.rules);
+            std::vector<uint32_t> hitRules;
+            for (const auto& line : lines) {
+                hitRules.clear();
+                program.FindKeywordRules(line, hitRules);
+                size_t index = 0;
+                for (auto iter = featureSet.rules.begin(); iter != featureSet.rules.end(); ++iter, ++index) {
+                    const CompiledSource& source = program.GetSource(index);
+                    // the source referring to the variables is compiled after they are replaced
+                    if (source.type == SourceMatchType::VARIABLE) {
+                        continue;
+                    }
+                    auto sourceRegex = (source.type == SourceMatchType::REGEX) ?
+                        program.FindRegex(source.pattern) : nullptr;
+                    bool isMatched = FeatureRuleProgram::IsSourceMatch(source, line, sourceRegex.get()) &&
+                        (!program.IsIndexed(index) ||
+                        std::find(hitRules.begin(), hitRules.end(), index) != hitRules.end());
+                    ASSERT_EQ(isMatched, IsSourceMatchByWalk(line, iter->source)) << featureId << ", " <<
+                        iter->source << ", " << line;
+                    matchedCount += isMatched ? 1 : 0;
+                }
+            }
+        }
+    }
+    ASSERT_GT(matchedCount, 0U);
+}
+
+/**
+ * @tc.name: SmartParserTest026
+ * @tc.desc: the invalid regexes of the rules are not compiled until a rule needs them.
+ *           1. the program is built from the rules with the invalid regexes;
+ *           2. the valid regex is compiled at its first use and shared by the later ones.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SmartParserModuleTest, SmartParserTest026, TestSize.Level1)
+{
+    std::list<FeatureRule> rules(3); // 3 : count of the test rules
+    auto iter = rules.begin();
+    iter->source = std::string(L3_REGULAR_DESCRIPTOR) + "([";
+    (++iter)->source = "never matched";
+    iter->param.emplace("invalid", "(]");
+    (++iter)->source = "valid";
+    iter->param.emplace("valid", "valid (\\d+)");
+    FeatureRuleProgram program(rules);
+    ASSERT_EQ(program.GetSource(0).type, SourceMatchType::REGEX);
+    ASSERT_EQ(program.GetSource(0).pattern, "([");
+    ASSERT_EQ(program.FindRegex("not a pattern of the rules"), nullptr);
+    auto regex = program.FindRegex("valid (\\d+)");
+    ASSERT_NE(regex, nullptr);
+    ASSERT_EQ(program.FindRegex("valid (\\d+)"), regex);
+    std::smatch result;
+    std::string line = "valid 10";
+    ASSERT_TRUE(std::regex_search(line, result, *regex));
+    ASSERT_EQ(result.str(1), "10");
+}
+
+/**
+ * @tc.name: SmartParserTest027
+ * @tc.desc: benchmark the extraction on a corpus made of the representative fault logs.
+ *           1. the corpus should be analysed as every type of the fault logs;
+ *           2. the throughput of the extraction is printed.
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(SmartParserModuleTest, SmartParserTest027, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. build the corpus by repeating the fault logs.
+     */
+    std::vector<std::string> contents;
+    std::string logs;
+    for (const auto& faultFile : FAULT_FILES) {
+        std::string content;
+        ASSERT_TRUE(FileUtil::LoadStringFromFile(std::string{LogUtil::SMART_PARSER_TEST_DIR} + faultFile.second,
+            content));
+        logs.append(content).append("\n");
+        contents.emplace_back(content);
+    }
+    std::string corpusDir = std::string{LogUtil::SMART_PARSER_TEST_DIR} + "/SmartParserTest027";
+    ASSERT_TRUE(FileUtil::ForceCreateDirectory(corpusDir));
+
+    /**
+     * @tc.steps: step2. smart parser process the corpus as every type of the fault logs
+     */
+    const size_t corpusSize = 8 * 1024 * 1024; // 8 * 1024 * 1024 : 8M bytes
+    for (size_t i = 0; i < FAULT_FILES.size(); i++) {
+        const auto& faultFile = FAULT_FILES[i];
+        // the fault log heads the corpus to be found within the skip step of the extract rule
+        std::string corpus = contents[i] + "\n";
+        while (corpus.size() < corpusSize) {
+            corpus.append(logs);
+        }
+        // the corpus is named after the fault log to match the extract rule of the type
+        std::string corpusFile = corpusDir + "/" + StringUtil::GetRrightSubstr(faultFile.second, "/");
+        ASSERT_TRUE(FileUtil::SaveStringToFile(corpusFile, corpus));
+        auto begin = std::chrono::steady_clock::now();
+        auto eventInfos = SmartParser::Analysis(corpusFile, TEST_CONFIG, faultFile.first);
+        auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+        printf("%s: %zu bytes in %lld us\n", faultFile.first.c_str(), corpus.size(),
+            static_cast<long long>(cost.count()));
+        FileUtil::RemoveFile(corpusFile);
+        ASSERT_EQ(eventInfos.empty(), false);
+    }
+    FileUtil::ForceRemoveDirectory(corpusDir);
+}
 }  // namespace HiviewDFX
 }  // namespace OHOS